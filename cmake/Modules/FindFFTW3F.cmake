@@ -0,0 +1,92 @@
+# Copyright (C) 2011-2019 (see AUTHORS file for a list of contributors)
+#
+# This file is part of GNSS-SDR.
+#
+# GNSS-SDR is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# GNSS-SDR is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+
+#
+# Find the single-precision FFTW3 library
+#
+#  FFTW3F_FOUND - True if FFTW3F found.
+#  FFTW3F_LIBRARIES - FFTW3F libraries.
+#  FFTW3F_INCLUDE_DIRS - where to find fftw3.h
+#
+# Provides the following imported target:
+# Fftw3f::fftw3f
+#
+
+include(FindPkgConfig)
+pkg_check_modules(PC_FFTW3F "fftw3f >= 3.0")
+
+find_path(FFTW3F_INCLUDE_DIRS
+    NAMES fftw3.h
+    HINTS $ENV{FFTW3_DIR}/include
+          ${PC_FFTW3F_INCLUDEDIR}
+    PATHS /usr/local/include
+          /usr/include
+          ${CMAKE_INSTALL_PREFIX}/include
+          ${FFTW3F_ROOT}/include
+          $ENV{FFTW3F_ROOT}/include
+)
+
+find_library(FFTW3F_LIBRARIES
+    NAMES fftw3f libfftw3f
+    HINTS $ENV{FFTW3_DIR}/lib
+          ${PC_FFTW3F_LIBDIR}
+    PATHS /usr/local/lib
+          /usr/local/lib64
+          /usr/lib
+          /usr/lib/x86_64-linux-gnu
+          /usr/lib/i386-linux-gnu
+          /usr/lib/arm-linux-gnueabihf
+          /usr/lib/arm-linux-gnueabi
+          /usr/lib/aarch64-linux-gnu
+          /usr/lib/mipsel-linux-gnu
+          /usr/lib/mips-linux-gnu
+          /usr/lib/mips64el-linux-gnuabi64
+          /usr/lib/powerpc-linux-gnu
+          /usr/lib/powerpc64-linux-gnu
+          /usr/lib/powerpc64le-linux-gnu
+          /usr/lib/powerpc-linux-gnuspe
+          /usr/lib/hppa-linux-gnu
+          /usr/lib/s390x-linux-gnu
+          /usr/lib/i386-gnu
+          /usr/lib/x86_64-kfreebsd-gnu
+          /usr/lib/i386-kfreebsd-gnu
+          /usr/lib/m68k-linux-gnu
+          /usr/lib/sh4-linux-gnu
+          /usr/lib/sparc64-linux-gnu
+          /usr/lib/x86_64-linux-gnux32
+          /usr/lib/alpha-linux-gnu
+          /usr/lib64
+          ${CMAKE_INSTALL_PREFIX}/lib
+          ${FFTW3F_ROOT}/lib
+          $ENV{FFTW3F_ROOT}/lib
+          ${FFTW3F_ROOT}/lib64
+          $ENV{FFTW3F_ROOT}/lib64
+)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(FFTW3F DEFAULT_MSG FFTW3F_LIBRARIES FFTW3F_INCLUDE_DIRS)
+mark_as_advanced(FFTW3F_LIBRARIES FFTW3F_INCLUDE_DIRS)
+
+if(FFTW3F_FOUND AND NOT TARGET Fftw3f::fftw3f)
+    add_library(Fftw3f::fftw3f SHARED IMPORTED)
+    set_target_properties(Fftw3f::fftw3f PROPERTIES
+        IMPORTED_LINK_INTERFACE_LANGUAGES "CXX"
+        IMPORTED_LOCATION "${FFTW3F_LIBRARIES}"
+        INTERFACE_INCLUDE_DIRECTORIES "${FFTW3F_INCLUDE_DIRS}"
+        INTERFACE_LINK_LIBRARIES "${FFTW3F_LIBRARIES}"
+    )
+endif()
@@ -777,6 +777,16 @@ bool Rtklib_Pvt::get_latest_PVT(double* longitude_deg,
 }
 
 
+bool Rtklib_Pvt::get_predicted_doppler(const Gnss_Signal& signal, double* doppler_hz, double* age_s)
+{
+    return pvt_->get_predicted_doppler(signal.get_satellite().get_system_short().c_str()[0],
+        signal.get_satellite().get_PRN(),
+        signal.get_signal_str(),
+        doppler_hz,
+        age_s);
+}
+
+
 void Rtklib_Pvt::clear_ephemeris()
 {
     pvt_->clear_ephemeris();
@@ -101,6 +101,8 @@ public:
         double* course_over_ground_deg,
         time_t* UTC_time) override;
 
+    bool get_predicted_doppler(const Gnss_Signal& signal, double* doppler_hz, double* age_s) override;
+
 private:
     rtklib_pvt_gs_sptr pvt_;
     rtk_t rtk{};
@@ -956,6 +956,7 @@ rtklib_pvt_gs::~rtklib_pvt_gs()
 
 void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
 {
+    std::lock_guard<std::mutex> lock(d_solver_mutex);
     try
         {
             // ************* GPS telemetry *****************
@@ -1170,42 +1171,49 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
 
 std::map<int, Gps_Ephemeris> rtklib_pvt_gs::get_gps_ephemeris_map() const
 {
+    std::lock_guard<std::mutex> lock(d_solver_mutex);
     return d_pvt_solver->gps_ephemeris_map;
 }
 
 
 std::map<int, Gps_Almanac> rtklib_pvt_gs::get_gps_almanac_map() const
 {
+    std::lock_guard<std::mutex> lock(d_solver_mutex);
     return d_pvt_solver->gps_almanac_map;
 }
 
 
 std::map<int, Galileo_Ephemeris> rtklib_pvt_gs::get_galileo_ephemeris_map() const
 {
+    std::lock_guard<std::mutex> lock(d_solver_mutex);
     return d_pvt_solver->galileo_ephemeris_map;
 }
 
 
 std::map<int, Galileo_Almanac> rtklib_pvt_gs::get_galileo_almanac_map() const
 {
+    std::lock_guard<std::mutex> lock(d_solver_mutex);
     return d_pvt_solver->galileo_almanac_map;
 }
 
 
 std::map<int, Beidou_Dnav_Ephemeris> rtklib_pvt_gs::get_beidou_dnav_ephemeris_map() const
 {
+    std::lock_guard<std::mutex> lock(d_solver_mutex);
     return d_pvt_solver->beidou_dnav_ephemeris_map;
 }
 
 
 std::map<int, Beidou_Dnav_Almanac> rtklib_pvt_gs::get_beidou_dnav_almanac_map() const
 {
+    std::lock_guard<std::mutex> lock(d_solver_mutex);
     return d_pvt_solver->beidou_dnav_almanac_map;
 }
 
 
 void rtklib_pvt_gs::clear_ephemeris()
 {
+    std::lock_guard<std::mutex> lock(d_solver_mutex);
     d_pvt_solver->gps_ephemeris_map.clear();
     d_pvt_solver->gps_almanac_map.clear();
     d_pvt_solver->galileo_ephemeris_map.clear();
@@ -1305,6 +1313,7 @@ bool rtklib_pvt_gs::get_latest_PVT(double* longitude_deg,
     double* course_over_ground_deg,
     time_t* UTC_time) const
 {
+    std::lock_guard<std::mutex> lock(d_solver_mutex);
     if (d_pvt_solver->is_valid_position())
         {
             *latitude_deg = d_pvt_solver->get_latitude();
@@ -1321,9 +1330,23 @@ bool rtklib_pvt_gs::get_latest_PVT(double* longitude_deg,
 }
 
 
+bool rtklib_pvt_gs::get_predicted_doppler(char system, uint32_t PRN, const std::string& signal, double* doppler_hz, double* age_s) const
+{
+    return d_pvt_solver->get_predicted_doppler(system, PRN, signal, doppler_hz, age_s);
+}
+
+
+bool rtklib_pvt_gs::stop()
+{
+    d_pvt_solver->flush_dump();
+    return true;
+}
+
+
 int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items __attribute__((unused)))
 {
+    std::lock_guard<std::mutex> lock(d_solver_mutex);
     for (int32_t epoch = 0; epoch < noutput_items; epoch++)
         {
             bool flag_display_pvt = false;
@@ -44,6 +44,7 @@
 #include <ctime>                  // for time_t
 #include <map>                    // for map
 #include <memory>                 // for shared_ptr, unique_ptr
+#include <mutex>                  // for mutex
 #include <string>                 // for string
 #include <sys/types.h>            // for key_t
 #include <utility>                // for pair
@@ -129,6 +130,7 @@ private:
     bool d_nmea_output_file_enabled;
 
     std::shared_ptr<Rtklib_Solver> d_pvt_solver;
+    mutable std::mutex d_solver_mutex;  // the solver maps and fix are also read by the control thread
 
     std::map<int, Gnss_Synchro> gnss_observables_map;
     bool observables_pairCompare_min(const std::pair<int, Gnss_Synchro>& a, const std::pair<int, Gnss_Synchro>& b);
@@ -214,6 +216,13 @@ public:
         double* course_over_ground_deg,
         time_t* UTC_time) const;
 
+    /*!
+     * \brief Get the Doppler of a satellite signal predicted from the latest fix, if available
+     */
+    bool get_predicted_doppler(char system, uint32_t PRN, const std::string& signal, double* doppler_hz, double* age_s) const;
+
+    bool stop();  //!< Completes the dump file when the flowgraph stops
+
     int work(int noutput_items, gr_vector_const_void_star& input_items,
         gr_vector_void_star& output_items);  //!< PVT Signal Processing
 };
@@ -57,13 +57,83 @@
 #include "GLONASS_L1_L2_CA.h"
 #include "GPS_L1_CA.h"
 #include "Galileo_E1.h"
+#include "gnss_sdr_dump.h"
 #include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
 #include "rtklib_rtkpos.h"
 #include "rtklib_solution.h"
 #include <glog/logging.h>
 #include <matio.h>
+#include <cmath>
+#include <cstddef>
 #include <exception>
 #include <utility>
+#include <vector>
+
+
+static double rtklib_carrier_frequency(const std::string &signal)
+{
+    if (signal == "1C" or signal == "1B")
+        {
+            return FREQ1;
+        }
+    if (signal == "2S")
+        {
+            return FREQ2;
+        }
+    if (signal == "L5" or signal == "5X")
+        {
+            return FREQ5;
+        }
+    if (signal == "B1")
+        {
+            return FREQ1_BDS;
+        }
+    if (signal == "B3")
+        {
+            return FREQ3_BDS;
+        }
+    return 0.0;  // GLONASS FDMA signals are not predicted
+}
+
+
+namespace
+{
+// One record of the PVT dump file
+#pragma pack(push, 1)
+struct Pvt_Dump_Record
+{
+    uint32_t TOW_at_current_symbol_ms;
+    uint32_t week;
+    double RX_time;
+    double user_clk_offset;
+    double pos_x;
+    double pos_y;
+    double pos_z;
+    double vel_x;
+    double vel_y;
+    double vel_z;
+    double cov_xx;
+    double cov_yy;
+    double cov_zz;
+    double cov_xy;
+    double cov_yz;
+    double cov_zx;
+    double latitude;
+    double longitude;
+    double height;
+    uint8_t valid_sats;
+    uint8_t solution_status;
+    uint8_t solution_type;
+    float AR_ratio_factor;
+    float AR_ratio_threshold;
+    double gdop;
+    double pdop;
+    double hdop;
+    double vdop;
+};
+#pragma pack(pop)
+}  // namespace
 
 
 Rtklib_Solver::Rtklib_Solver(int nchannels, std::string dump_filename, bool flag_dump_to_file, bool flag_dump_to_mat, const rtk_t &rtk)
@@ -75,6 +145,7 @@ Rtklib_Solver::Rtklib_Solver(int nchannels, std::string dump_filename, bool flag
     d_flag_dump_mat_enabled = flag_dump_to_mat;
     count_valid_position = 0;
     this->set_averaging_flag(false);
+    d_last_prediction_rx_time = {0, 0};
     rtk_ = rtk;
     for (double &i : dop_)
         {
@@ -91,15 +162,13 @@ Rtklib_Solver::Rtklib_Solver(int nchannels, std::string dump_filename, bool flag
         {
             if (d_dump_file.is_open() == false)
                 {
-                    try
+                    if (d_dump_file.open(d_dump_filename))
                         {
-                            d_dump_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
                             LOG(INFO) << "PVT lib dump enabled Log file: " << d_dump_filename.c_str();
                         }
-                    catch (const std::ofstream::failure &e)
+                    else
                         {
-                            LOG(WARNING) << "Exception opening RTKLIB dump file " << e.what();
+                            LOG(WARNING) << "Problem opening RTKLIB dump file " << d_dump_filename;
                         }
                 }
         }
@@ -138,141 +207,14 @@ bool Rtklib_Solver::save_matfile()
 {
     // READ DUMP FILE
     std::string dump_filename = d_dump_filename;
-    std::ifstream::pos_type size;
-    int32_t number_of_double_vars = 21;
-    int32_t number_of_uint32_vars = 2;
-    int32_t number_of_uint8_vars = 3;
-    int32_t number_of_float_vars = 2;
-    int32_t epoch_size_bytes = sizeof(double) * number_of_double_vars +
-                               sizeof(uint32_t) * number_of_uint32_vars +
-                               sizeof(uint8_t) * number_of_uint8_vars +
-                               sizeof(float) * number_of_float_vars;
-    std::ifstream dump_file;
     std::cout << "Generating .mat file for " << dump_filename << std::endl;
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
-        {
-            dump_file.open(dump_filename.c_str(), std::ios::binary | std::ios::ate);
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem opening dump file:" << e.what() << std::endl;
-            return false;
-        }
-    // count number of epochs and rewind
-    int64_t num_epoch = 0LL;
-    if (dump_file.is_open())
-        {
-            size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
-        }
-    else
+    Gnss_Dump_Reader dump_file;
+    if (!dump_file.open(dump_filename, sizeof(Pvt_Dump_Record)))
         {
+            std::cerr << "Problem opening dump file: " << dump_filename << std::endl;
             return false;
         }
-
-    auto *TOW_at_current_symbol_ms = new uint32_t[num_epoch];
-    auto *week = new uint32_t[num_epoch];
-    auto *RX_time = new double[num_epoch];
-    auto *user_clk_offset = new double[num_epoch];
-    auto *pos_x = new double[num_epoch];
-    auto *pos_y = new double[num_epoch];
-    auto *pos_z = new double[num_epoch];
-    auto *vel_x = new double[num_epoch];
-    auto *vel_y = new double[num_epoch];
-    auto *vel_z = new double[num_epoch];
-    auto *cov_xx = new double[num_epoch];
-    auto *cov_yy = new double[num_epoch];
-    auto *cov_zz = new double[num_epoch];
-    auto *cov_xy = new double[num_epoch];
-    auto *cov_yz = new double[num_epoch];
-    auto *cov_zx = new double[num_epoch];
-    auto *latitude = new double[num_epoch];
-    auto *longitude = new double[num_epoch];
-    auto *height = new double[num_epoch];
-    auto *valid_sats = new uint8_t[num_epoch];
-    auto *solution_status = new uint8_t[num_epoch];
-    auto *solution_type = new uint8_t[num_epoch];
-    auto *AR_ratio_factor = new float[num_epoch];
-    auto *AR_ratio_threshold = new float[num_epoch];
-    auto *gdop = new double[num_epoch];
-    auto *pdop = new double[num_epoch];
-    auto *hdop = new double[num_epoch];
-    auto *vdop = new double[num_epoch];
-
-    try
-        {
-            if (dump_file.is_open())
-                {
-                    for (int64_t i = 0; i < num_epoch; i++)
-                        {
-                            dump_file.read(reinterpret_cast<char *>(&TOW_at_current_symbol_ms[i]), sizeof(uint32_t));
-                            dump_file.read(reinterpret_cast<char *>(&week[i]), sizeof(uint32_t));
-                            dump_file.read(reinterpret_cast<char *>(&RX_time[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&user_clk_offset[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&pos_x[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&pos_y[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&pos_z[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&vel_x[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&vel_y[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&vel_z[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_xx[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_yy[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_zz[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_xy[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_yz[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&cov_zx[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&latitude[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&longitude[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&height[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&valid_sats[i]), sizeof(uint8_t));
-                            dump_file.read(reinterpret_cast<char *>(&solution_status[i]), sizeof(uint8_t));
-                            dump_file.read(reinterpret_cast<char *>(&solution_type[i]), sizeof(uint8_t));
-                            dump_file.read(reinterpret_cast<char *>(&AR_ratio_factor[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&AR_ratio_threshold[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&gdop[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&pdop[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&hdop[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&vdop[i]), sizeof(double));
-                        }
-                }
-            dump_file.close();
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem reading dump file:" << e.what() << std::endl;
-            delete[] TOW_at_current_symbol_ms;
-            delete[] week;
-            delete[] RX_time;
-            delete[] user_clk_offset;
-            delete[] pos_x;
-            delete[] pos_y;
-            delete[] pos_z;
-            delete[] vel_x;
-            delete[] vel_y;
-            delete[] vel_z;
-            delete[] cov_xx;
-            delete[] cov_yy;
-            delete[] cov_zz;
-            delete[] cov_xy;
-            delete[] cov_yz;
-            delete[] cov_zx;
-            delete[] latitude;
-            delete[] longitude;
-            delete[] height;
-            delete[] valid_sats;
-            delete[] solution_status;
-            delete[] solution_type;
-            delete[] AR_ratio_factor;
-            delete[] AR_ratio_threshold;
-            delete[] gdop;
-            delete[] pdop;
-            delete[] hdop;
-            delete[] vdop;
-
-            return false;
-        }
+    auto num_epoch = static_cast<size_t>(dump_file.records());
 
     // WRITE MAT FILE
     mat_t *matfp;
@@ -283,150 +225,83 @@ bool Rtklib_Solver::save_matfile()
     matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
     if (reinterpret_cast<int64_t *>(matfp) != nullptr)
         {
-            size_t dims[2] = {1, static_cast<size_t>(num_epoch)};
-            matvar = Mat_VarCreate("TOW_at_current_symbol_ms", MAT_C_UINT32, MAT_T_UINT32, 2, dims, TOW_at_current_symbol_ms, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("week", MAT_C_UINT32, MAT_T_UINT32, 2, dims, week, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("RX_time", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, RX_time, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("user_clk_offset", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, user_clk_offset, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("pos_x", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, pos_x, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("pos_y", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, pos_y, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("pos_z", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, pos_z, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("vel_x", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, vel_x, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("vel_y", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, vel_y, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("vel_z", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, vel_z, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("cov_xx", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, cov_xx, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("cov_yy", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, cov_yy, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("cov_zz", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, cov_zz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("cov_xy", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, cov_xy, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("cov_yz", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, cov_yz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("cov_zx", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, cov_zx, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("latitude", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, latitude, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("longitude", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, longitude, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("height", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, height, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("valid_sats", MAT_C_UINT8, MAT_T_UINT8, 2, dims, valid_sats, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("solution_status", MAT_C_UINT8, MAT_T_UINT8, 2, dims, solution_status, 0);
+            size_t dims[2] = {1, num_epoch};
+            std::vector<uint32_t> TOW_at_current_symbol_ms = dump_file.column<uint32_t>(offsetof(Pvt_Dump_Record, TOW_at_current_symbol_ms));
+            matvar = Mat_VarCreate("TOW_at_current_symbol_ms", MAT_C_UINT32, MAT_T_UINT32, 2, dims, TOW_at_current_symbol_ms.data(), 0);
             Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
             Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("solution_type", MAT_C_UINT8, MAT_T_UINT8, 2, dims, solution_type, 0);
+            std::vector<uint32_t> week = dump_file.column<uint32_t>(offsetof(Pvt_Dump_Record, week));
+            matvar = Mat_VarCreate("week", MAT_C_UINT32, MAT_T_UINT32, 2, dims, week.data(), 0);
             Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
             Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("AR_ratio_factor", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, AR_ratio_factor, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("AR_ratio_threshold", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, AR_ratio_threshold, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+            // One column at a time, read in bulk from the records
+            std::vector<double> double_column;
+            const std::vector<std::pair<std::string, size_t>> double_vars = {
+                {"RX_time", offsetof(Pvt_Dump_Record, RX_time)},
+                {"user_clk_offset", offsetof(Pvt_Dump_Record, user_clk_offset)},
+                {"pos_x", offsetof(Pvt_Dump_Record, pos_x)},
+                {"pos_y", offsetof(Pvt_Dump_Record, pos_y)},
+                {"pos_z", offsetof(Pvt_Dump_Record, pos_z)},
+                {"vel_x", offsetof(Pvt_Dump_Record, vel_x)},
+                {"vel_y", offsetof(Pvt_Dump_Record, vel_y)},
+                {"vel_z", offsetof(Pvt_Dump_Record, vel_z)},
+                {"cov_xx", offsetof(Pvt_Dump_Record, cov_xx)},
+                {"cov_yy", offsetof(Pvt_Dump_Record, cov_yy)},
+                {"cov_zz", offsetof(Pvt_Dump_Record, cov_zz)},
+                {"cov_xy", offsetof(Pvt_Dump_Record, cov_xy)},
+                {"cov_yz", offsetof(Pvt_Dump_Record, cov_yz)},
+                {"cov_zx", offsetof(Pvt_Dump_Record, cov_zx)},
+                {"latitude", offsetof(Pvt_Dump_Record, latitude)},
+                {"longitude", offsetof(Pvt_Dump_Record, longitude)},
+                {"height", offsetof(Pvt_Dump_Record, height)}};
+            for (const auto &var : double_vars)
+                {
+                    dump_file.column(var.second, double_column);
+                    matvar = Mat_VarCreate(var.first.c_str(), MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, double_column.data(), 0);
+                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+                    Mat_VarFree(matvar);
+                }
 
-            matvar = Mat_VarCreate("gdop", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, gdop, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+            std::vector<uint8_t> uint8_column;
+            const std::vector<std::pair<std::string, size_t>> uint8_vars = {
+                {"valid_sats", offsetof(Pvt_Dump_Record, valid_sats)},
+                {"solution_status", offsetof(Pvt_Dump_Record, solution_status)},
+                {"solution_type", offsetof(Pvt_Dump_Record, solution_type)}};
+            for (const auto &var : uint8_vars)
+                {
+                    dump_file.column(var.second, uint8_column);
+                    matvar = Mat_VarCreate(var.first.c_str(), MAT_C_UINT8, MAT_T_UINT8, 2, dims, uint8_column.data(), 0);
+                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+                    Mat_VarFree(matvar);
+                }
 
-            matvar = Mat_VarCreate("pdop", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, pdop, 0);
+            std::vector<float> AR_ratio_factor = dump_file.column<float>(offsetof(Pvt_Dump_Record, AR_ratio_factor));
+            matvar = Mat_VarCreate("AR_ratio_factor", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, AR_ratio_factor.data(), 0);
             Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
             Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("hdop", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, hdop, 0);
+            std::vector<float> AR_ratio_threshold = dump_file.column<float>(offsetof(Pvt_Dump_Record, AR_ratio_threshold));
+            matvar = Mat_VarCreate("AR_ratio_threshold", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, AR_ratio_threshold.data(), 0);
             Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
             Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("vdop", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, vdop, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+            const std::vector<std::pair<std::string, size_t>> dop_vars = {
+                {"gdop", offsetof(Pvt_Dump_Record, gdop)},
+                {"pdop", offsetof(Pvt_Dump_Record, pdop)},
+                {"hdop", offsetof(Pvt_Dump_Record, hdop)},
+                {"vdop", offsetof(Pvt_Dump_Record, vdop)}};
+            for (const auto &var : dop_vars)
+                {
+                    dump_file.column(var.second, double_column);
+                    matvar = Mat_VarCreate(var.first.c_str(), MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, double_column.data(), 0);
+                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+                    Mat_VarFree(matvar);
+                }
         }
 
     Mat_Close(matfp);
-    delete[] TOW_at_current_symbol_ms;
-    delete[] week;
-    delete[] RX_time;
-    delete[] user_clk_offset;
-    delete[] pos_x;
-    delete[] pos_y;
-    delete[] pos_z;
-    delete[] vel_x;
-    delete[] vel_y;
-    delete[] vel_z;
-    delete[] cov_xx;
-    delete[] cov_yy;
-    delete[] cov_zz;
-    delete[] cov_xy;
-    delete[] cov_yz;
-    delete[] cov_zx;
-    delete[] latitude;
-    delete[] longitude;
-    delete[] height;
-    delete[] valid_sats;
-    delete[] solution_status;
-    delete[] solution_type;
-    delete[] AR_ratio_factor;
-    delete[] AR_ratio_threshold;
-    delete[] gdop;
-    delete[] pdop;
-    delete[] hdop;
-    delete[] vdop;
-
     return true;
 }
 
@@ -435,14 +310,7 @@ Rtklib_Solver::~Rtklib_Solver()
 {
     if (d_dump_file.is_open() == true)
         {
-            try
-                {
-                    d_dump_file.close();
-                }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor closing the RTKLIB dump file " << ex.what();
-                }
+            d_dump_file.close();
         }
     if (d_flag_dump_mat_enabled)
         {
@@ -458,6 +326,12 @@ Rtklib_Solver::~Rtklib_Solver()
 }
 
 
+void Rtklib_Solver::flush_dump()
+{
+    d_dump_file.flush();
+}
+
+
 double Rtklib_Solver::get_gdop() const
 {
     return dop_[0];
@@ -1007,6 +881,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     p_time = boost::posix_time::from_time_t(rtklib_utc_time.time);
                     p_time += boost::posix_time::microseconds(static_cast<long>(round(rtklib_utc_time.sec * 1e6)));  // NOLINT(google-runtime-int)
                     this->set_position_UTC_time(p_time);
+                    update_doppler_predictions(gnss_observables_map, rtklib_time);
                     cart2geo(static_cast<double>(rx_position_and_time(0)), static_cast<double>(rx_position_and_time(1)), static_cast<double>(rx_position_and_time(2)), 4);
 
                     DLOG(INFO) << "RTKLIB Position at " << boost::posix_time::to_simple_string(p_time)
@@ -1070,84 +945,165 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     if (d_flag_dump_enabled == true)
                         {
                             // MULTIPLEXED FILE RECORDING - Record results to file
-                            try
-                                {
-                                    double tmp_double;
-                                    uint32_t tmp_uint32;
-                                    // TOW
-                                    tmp_uint32 = gnss_observables_map.begin()->second.TOW_at_current_symbol_ms;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
-                                    // WEEK
-                                    tmp_uint32 = adjgpsweek(nav_data.eph[0].week);
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
-                                    // PVT GPS time
-                                    tmp_double = gnss_observables_map.begin()->second.RX_time;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    // User clock offset [s]
-                                    tmp_double = rx_position_and_time(3);
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-
-                                    // ECEF POS X,Y,X [m] + ECEF VEL X,Y,X [m/s] (6 x double)
-                                    tmp_double = pvt_sol.rr[0];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[1];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[2];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[3];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[4];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[5];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-
-                                    // position variance/covariance (m^2) {c_xx,c_yy,c_zz,c_xy,c_yz,c_zx} (6 x double)
-                                    tmp_double = pvt_sol.qr[0];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[1];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[2];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[3];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[4];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[5];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-
-                                    // GEO user position Latitude [deg]
-                                    tmp_double = get_latitude();
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    // GEO user position Longitude [deg]
-                                    tmp_double = get_longitude();
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    // GEO user position Height [m]
-                                    tmp_double = get_height();
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-
-                                    // NUMBER OF VALID SATS
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.ns), sizeof(uint8_t));
-                                    // RTKLIB solution status
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.stat), sizeof(uint8_t));
-                                    // RTKLIB solution type (0:xyz-ecef,1:enu-baseline)
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.type), sizeof(uint8_t));
-                                    // AR ratio factor for validation
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.ratio), sizeof(float));
-                                    // AR ratio threshold for validation
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.thres), sizeof(float));
-
-                                    // GDOP / PDOP/ HDOP/ VDOP
-                                    d_dump_file.write(reinterpret_cast<char *>(&dop_[0]), sizeof(double));
-                                    d_dump_file.write(reinterpret_cast<char *>(&dop_[1]), sizeof(double));
-                                    d_dump_file.write(reinterpret_cast<char *>(&dop_[2]), sizeof(double));
-                                    d_dump_file.write(reinterpret_cast<char *>(&dop_[3]), sizeof(double));
-                                }
-                            catch (const std::ifstream::failure &e)
-                                {
-                                    LOG(WARNING) << "Exception writing RTKLIB dump file " << e.what();
-                                }
+                            Pvt_Dump_Record record{};
+                            // TOW
+                            record.TOW_at_current_symbol_ms = gnss_observables_map.begin()->second.TOW_at_current_symbol_ms;
+                            // WEEK
+                            record.week = adjgpsweek(nav_data.eph[0].week);
+                            // PVT GPS time
+                            record.RX_time = gnss_observables_map.begin()->second.RX_time;
+                            // User clock offset [s]
+                            record.user_clk_offset = rx_position_and_time(3);
+
+                            // ECEF POS X,Y,X [m] + ECEF VEL X,Y,X [m/s] (6 x double)
+                            record.pos_x = pvt_sol.rr[0];
+                            record.pos_y = pvt_sol.rr[1];
+                            record.pos_z = pvt_sol.rr[2];
+                            record.vel_x = pvt_sol.rr[3];
+                            record.vel_y = pvt_sol.rr[4];
+                            record.vel_z = pvt_sol.rr[5];
+
+                            // position variance/covariance (m^2) {c_xx,c_yy,c_zz,c_xy,c_yz,c_zx} (6 x double)
+                            record.cov_xx = pvt_sol.qr[0];
+                            record.cov_yy = pvt_sol.qr[1];
+                            record.cov_zz = pvt_sol.qr[2];
+                            record.cov_xy = pvt_sol.qr[3];
+                            record.cov_yz = pvt_sol.qr[4];
+                            record.cov_zx = pvt_sol.qr[5];
+
+                            // GEO user position Latitude [deg], Longitude [deg] and Height [m]
+                            record.latitude = get_latitude();
+                            record.longitude = get_longitude();
+                            record.height = get_height();
+
+                            // NUMBER OF VALID SATS
+                            record.valid_sats = pvt_sol.ns;
+                            // RTKLIB solution status
+                            record.solution_status = pvt_sol.stat;
+                            // RTKLIB solution type (0:xyz-ecef,1:enu-baseline)
+                            record.solution_type = pvt_sol.type;
+                            // AR ratio factor and threshold for validation
+                            record.AR_ratio_factor = pvt_sol.ratio;
+                            record.AR_ratio_threshold = pvt_sol.thres;
+
+                            // GDOP / PDOP/ HDOP/ VDOP
+                            record.gdop = dop_[0];
+                            record.pdop = dop_[1];
+                            record.hdop = dop_[2];
+                            record.vdop = dop_[3];
+                            d_dump_file.write(record);
                         }
                 }
         }
     return is_valid_position();
 }
+
+
+void Rtklib_Solver::update_doppler_predictions(const std::map<int, Gnss_Synchro> &gnss_observables_map, gtime_t rx_time)
+{
+    // No need to refresh the prediction at the PVT rate
+    if (d_last_prediction_rx_time.time != 0 and std::fabs(timediff(rx_time, d_last_prediction_rx_time)) < 1.0)
+        {
+            return;
+        }
+    d_last_prediction_rx_time = rx_time;
+
+    std::vector<eph_t> ephs;
+    ephs.reserve(gps_ephemeris_map.size() + galileo_ephemeris_map.size() + beidou_dnav_ephemeris_map.size());
+    for (const auto &eph : gps_ephemeris_map)
+        {
+            ephs.push_back(eph_to_rtklib(eph.second));
+        }
+    for (const auto &eph : galileo_ephemeris_map)
+        {
+            ephs.push_back(eph_to_rtklib(eph.second));
+        }
+    for (const auto &eph : beidou_dnav_ephemeris_map)
+        {
+            ephs.push_back(eph_to_rtklib(eph.second));
+        }
+
+    // Geometric range rate, corrected by the satellite clock drift
+    std::map<int, double> range_rate;
+    const double dt = 1e-3;
+    gtime_t rx_time_dt = timeadd(rx_time, dt);
+    for (const auto &eph : ephs)
+        {
+            double rs0[3];
+            double rs1[3];
+            double dts0;
+            double dts1;
+            double var;
+            eph2pos(rx_time, &eph, rs0, &dts0, &var);
+            eph2pos(rx_time_dt, &eph, rs1, &dts1, &var);
+            double los[3];
+            double range = 0.0;
+            double rate = 0.0;
+            for (int k = 0; k < 3; k++)
+                {
+                    los[k] = rs0[k] - pvt_sol.rr[k];
+                    range += los[k] * los[k];
+                }
+            range = std::sqrt(range);
+            if (range < 1.0)
+                {
+                    continue;
+                }
+            for (int k = 0; k < 3; k++)
+                {
+                    rate += los[k] / range * ((rs1[k] - rs0[k]) / dt - pvt_sol.rr[k + 3]);
+                }
+            range_rate[eph.sat] = rate - SPEED_OF_LIGHT * (dts1 - dts0) / dt;
+        }
+
+    // Receiver clock drift, from the Doppler measured on the satellites in track
+    double drift = 0.0;
+    int n_drift = 0;
+    for (const auto &obs : gnss_observables_map)
+        {
+            int sys = obs.second.System == 'G' ? SYS_GPS : (obs.second.System == 'E' ? SYS_GAL : (obs.second.System == 'C' ? SYS_BDS : SYS_NONE));
+            double freq = rtklib_carrier_frequency(std::string(obs.second.Signal, 2));
+            if (sys == SYS_NONE or freq == 0.0)
+                {
+                    continue;
+                }
+            auto it = range_rate.find(satno(sys, static_cast<int>(obs.second.PRN)));
+            if (it != range_rate.cend())
+                {
+                    drift += -obs.second.Carrier_Doppler_hz * SPEED_OF_LIGHT / freq - it->second;
+                    n_drift++;
+                }
+        }
+    if (n_drift > 0)
+        {
+            drift /= static_cast<double>(n_drift);
+        }
+    for (auto &rate : range_rate)
+        {
+            rate.second += drift;
+        }
+
+    std::lock_guard<std::mutex> lock(d_predicted_range_rate_mutex);
+    d_predicted_range_rate = std::move(range_rate);
+    d_predicted_range_rate_time = std::chrono::steady_clock::now();
+}
+
+
+bool Rtklib_Solver::get_predicted_doppler(char system, uint32_t PRN, const std::string &signal, double *doppler_hz, double *age_s) const
+{
+    int sys = system == 'G' ? SYS_GPS : (system == 'E' ? SYS_GAL : (system == 'C' ? SYS_BDS : SYS_NONE));
+    double freq = rtklib_carrier_frequency(signal);
+    if (sys == SYS_NONE or freq == 0.0)
+        {
+            return false;
+        }
+    std::lock_guard<std::mutex> lock(d_predicted_range_rate_mutex);
+    auto it = d_predicted_range_rate.find(satno(sys, static_cast<int>(PRN)));
+    if (it == d_predicted_range_rate.cend())
+        {
+            return false;
+        }
+    *doppler_hz = -it->second * freq / SPEED_OF_LIGHT;
+    *age_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - d_predicted_range_rate_time).count();
+    return true;
+}
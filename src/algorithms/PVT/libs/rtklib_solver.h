@@ -66,6 +66,7 @@
 #include "glonass_gnav_almanac.h"
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
+#include "gnss_sdr_dump.h"
 #include "gnss_synchro.h"
 #include "gps_almanac.h"
 #include "gps_cnav_ephemeris.h"
@@ -78,8 +79,10 @@
 #include "pvt_solution.h"
 #include "rtklib.h"
 #include <array>
-#include <fstream>
+#include <chrono>
+#include <cstdint>
 #include <map>
+#include <mutex>
 #include <string>
 
 
@@ -91,7 +94,7 @@ class Rtklib_Solver : public Pvt_Solution
 private:
     rtk_t rtk_;
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
     bool save_matfile();
 
     bool d_flag_dump_enabled;
@@ -100,12 +103,24 @@ private:
     std::array<double, 4> dop_;
     Monitor_Pvt monitor_pvt;
 
+    // Doppler prediction for the acquisition: geometric range rate plus receiver clock drift [m/s], by RTKLIB satellite number
+    void update_doppler_predictions(const std::map<int, Gnss_Synchro>& gnss_observables_map, gtime_t rx_time);
+    std::map<int, double> d_predicted_range_rate;
+    std::chrono::steady_clock::time_point d_predicted_range_rate_time;
+    gtime_t d_last_prediction_rx_time;
+    mutable std::mutex d_predicted_range_rate_mutex;
+
 public:
     Rtklib_Solver(int nchannels, std::string dump_filename, bool flag_dump_to_file, bool flag_dump_to_mat, const rtk_t& rtk);
     ~Rtklib_Solver();
 
     bool get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, bool flag_averaging);
 
+    /*!
+     * \brief Waits until all the records of the binary dump file are on disk
+     */
+    void flush_dump();
+
     sol_t pvt_sol;
     ssat_t pvt_ssat[MAXSAT];
     double get_hdop() const;
@@ -114,6 +129,13 @@ public:
     double get_gdop() const;
     Monitor_Pvt get_monitor_pvt() const;
 
+    /*!
+     * \brief Doppler [Hz] of a satellite signal predicted from the latest fix, the
+     * broadcast ephemeris and the estimated receiver clock drift. age_s returns
+     * the time elapsed since the prediction was made.
+     */
+    bool get_predicted_doppler(char system, uint32_t PRN, const std::string& signal, double* doppler_hz, double* age_s) const;
+
     std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;            //!< Map storing new Galileo_Ephemeris
     std::map<int, Gps_Ephemeris> gps_ephemeris_map;                    //!< Map storing new GPS_Ephemeris
     std::map<int, Gps_CNAV_Ephemeris> gps_cnav_ephemeris_map;          //!< Map storing new GPS_CNAV_Ephemeris
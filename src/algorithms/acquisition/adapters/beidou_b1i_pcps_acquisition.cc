@@ -80,6 +80,8 @@ BeidouB1iPcpsAcquisition::BeidouB1iPcpsAcquisition(
     acq_parameters.max_dwells = max_dwells_;
     dump_filename_ = configuration_->property(role + ".dump_filename", default_dump_filename);
     acq_parameters.dump_filename = dump_filename_;
+    acq_parameters.dump_format = configuration_->property(role + ".dump_format", std::string("mat"));
+    acq_parameters.dump_queue_size = configuration_->property(role + ".dump_queue_size", 16);
     //--- Find number of samples per spreading code -------------------------
     code_length_ = static_cast<uint32_t>(std::round(static_cast<double>(fs_in_) / (BEIDOU_B1I_CODE_RATE_HZ / BEIDOU_B1I_CODE_LENGTH_CHIPS)));
 
@@ -107,6 +109,15 @@ BeidouB1iPcpsAcquisition::BeidouB1iPcpsAcquisition(
     acq_parameters.num_doppler_bins_step2 = configuration_->property(role + ".second_nbins", 4);
     acq_parameters.doppler_step2 = configuration_->property(role + ".second_doppler_step", 125.0);
     acq_parameters.make_2_steps = configuration_->property(role + ".make_two_steps", false);
+    acq_parameters.interpolate_peak = configuration_->property(role + ".interpolate_peak", false);
+    acq_parameters.prompt_fft_blocks = configuration_->property(role + ".prompt_fft_blocks", 0);
+    acq_parameters.sequential_detection = configuration_->property(role + ".sequential_detection", false);
+    acq_parameters.pfa = configuration_->property(role + ".pfa", 0.0);
+    acq_parameters.sequential_pmiss = configuration_->property(role + ".sequential_pmiss", 0.05);
+    acq_parameters.sequential_cn0_dbhz = configuration_->property(role + ".sequential_cn0_dbhz", 40.0);
+    acq_parameters.compact_grid = configuration_->property(role + ".compact_grid", false);
+    acq_parameters.use_smooth_fft_size = configuration_->property(role + ".smooth_fft_size", true);
+    acq_parameters.coarse_decimation_factor = configuration_->property(role + ".coarse_decimation_factor", 1);
     acquisition_ = pcps_make_acquisition(acq_parameters);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
 
@@ -181,6 +192,12 @@ void BeidouB1iPcpsAcquisition::set_doppler_step(uint32_t doppler_step)
 }
 
 
+void BeidouB1iPcpsAcquisition::set_doppler_window(int32_t doppler_center, uint32_t doppler_window)
+{
+    acquisition_->set_doppler_window(doppler_center, doppler_window);
+}
+
+
 void BeidouB1iPcpsAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
 {
     gnss_synchro_ = gnss_synchro;
@@ -124,6 +124,11 @@ public:
      */
     void set_doppler_step(uint32_t doppler_step) override;
 
+    /*!
+     * \brief Restricts the Doppler search around a predicted Doppler
+     */
+    void set_doppler_window(int32_t doppler_center, uint32_t doppler_window) override;
+
     /*!
      * \brief Initializes acquisition algorithm.
      */
@@ -49,6 +49,10 @@ class ConfigurationInterface;
 /*!
  * \brief This class adapts a PCPS acquisition block to an AcquisitionInterface
  *  for BeiDou B3I signals
+ *
+ *  With pmf_fft=true, the Doppler search is an FFT across partial matched
+ *  filters. doppler_step is not used then: the resolution is fixed to
+ *  fs / (block size * Doppler FFT size), and it is reported in the log.
  */
 class BeidouB3iPcpsAcquisition : public AcquisitionInterface
 {
@@ -123,6 +127,11 @@ public:
      */
     void set_doppler_step(unsigned int doppler_step) override;
 
+    /*!
+     * \brief Restricts the Doppler search around a predicted Doppler
+     */
+    void set_doppler_window(int doppler_center, unsigned int doppler_window) override;
+
     /*!
      * \brief Initializes acquisition algorithm.
      */
@@ -120,6 +120,11 @@ public:
      */
     void set_doppler_step(unsigned int doppler_step) override;
 
+    /*!
+     * \brief Restricts the Doppler search around a predicted Doppler
+     */
+    void set_doppler_window(int doppler_center, unsigned int doppler_window) override;
+
     /*!
      * \brief Initializes acquisition algorithm.
      */
@@ -159,6 +159,7 @@ private:
     unsigned int vector_length_;
     unsigned int code_length_;
     bool bit_transition_flag_;
+    bool blocking_;
     unsigned int channel_;
     std::shared_ptr<ChannelFsm> channel_fsm_;
     float threshold_;
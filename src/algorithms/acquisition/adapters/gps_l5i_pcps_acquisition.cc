@@ -79,6 +79,8 @@ GpsL5iPcpsAcquisition::GpsL5iPcpsAcquisition(
     acq_parameters_.max_dwells = max_dwells_;
     dump_filename_ = configuration_->property(role + ".dump_filename", default_dump_filename);
     acq_parameters_.dump_filename = dump_filename_;
+    acq_parameters_.dump_format = configuration_->property(role + ".dump_format", std::string("mat"));
+    acq_parameters_.dump_queue_size = configuration_->property(role + ".dump_queue_size", 16);
     acq_parameters_.sampled_ms = configuration_->property(role + ".coherent_integration_time_ms", 1);
 
     if (item_type_ == "cshort")
@@ -96,6 +98,16 @@ GpsL5iPcpsAcquisition::GpsL5iPcpsAcquisition(
     acq_parameters_.num_doppler_bins_step2 = configuration_->property(role + ".second_nbins", 4);
     acq_parameters_.doppler_step2 = configuration_->property(role + ".second_doppler_step", 125.0);
     acq_parameters_.make_2_steps = configuration_->property(role + ".make_two_steps", false);
+    acq_parameters_.interpolate_peak = configuration_->property(role + ".interpolate_peak", false);
+    acq_parameters_.prompt_fft_blocks = configuration_->property(role + ".prompt_fft_blocks", 0);
+    acq_parameters_.sequential_detection = configuration_->property(role + ".sequential_detection", false);
+    acq_parameters_.pfa = configuration_->property(role + ".pfa", 0.0);
+    acq_parameters_.sequential_pmiss = configuration_->property(role + ".sequential_pmiss", 0.05);
+    acq_parameters_.sequential_cn0_dbhz = configuration_->property(role + ".sequential_cn0_dbhz", 40.0);
+    acq_parameters_.compact_grid = configuration_->property(role + ".compact_grid", false);
+    acq_parameters_.use_smooth_fft_size = configuration_->property(role + ".smooth_fft_size", true);
+    acq_parameters_.coarse_decimation_factor = configuration_->property(role + ".coarse_decimation_factor", 1);
+    acq_parameters_.pmf_fft = configuration_->property(role + ".pmf_fft", false);
     acq_parameters_.blocking_on_standby = configuration_->property(role + ".blocking_on_standby", false);
     acq_parameters_.use_automatic_resampler = configuration_->property("GNSS-SDR.use_acquisition_resampler", false);
     if (acq_parameters_.use_automatic_resampler == true and item_type_ != "gr_complex")
@@ -211,6 +223,12 @@ void GpsL5iPcpsAcquisition::set_doppler_step(unsigned int doppler_step)
 }
 
 
+void GpsL5iPcpsAcquisition::set_doppler_window(int doppler_center, unsigned int doppler_window)
+{
+    acquisition_->set_doppler_window(doppler_center, doppler_window);
+}
+
+
 void GpsL5iPcpsAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
 {
     gnss_synchro_ = gnss_synchro;
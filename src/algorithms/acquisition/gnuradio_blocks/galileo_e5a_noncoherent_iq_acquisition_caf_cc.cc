@@ -40,6 +40,8 @@
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for max, min
+#include <cstring>    // for memcpy
 #include <exception>
 #include <sstream>
 #include <utility>
@@ -101,6 +103,8 @@ galileo_e5a_noncoherentIQ_acquisition_caf_cc::galileo_e5a_noncoherentIQ_acquisit
     d_mag = 0;
     d_input_power = 0.0;
     d_num_doppler_bins = 0;
+    d_num_doppler_spectra = 0;
+    d_doppler_spectra = nullptr;
     d_bit_transition_flag = bit_transition_flag;
     d_buffer_count = 0;
     d_both_signal_components = both_signal_components_;
@@ -145,10 +149,10 @@ galileo_e5a_noncoherentIQ_acquisition_caf_cc::galileo_e5a_noncoherentIQ_acquisit
         }
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft_Complex(d_fft_size, true);
 
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft_Complex(d_fft_size, false);
 
     // For dumping samples into a file
     d_dump = dump;
@@ -172,13 +176,15 @@ galileo_e5a_noncoherentIQ_acquisition_caf_cc::galileo_e5a_noncoherentIQ_acquisit
 
 galileo_e5a_noncoherentIQ_acquisition_caf_cc::~galileo_e5a_noncoherentIQ_acquisition_caf_cc()
 {
-    if (d_num_doppler_bins > 0)
+    if (d_num_doppler_spectra > 0)
         {
-            for (unsigned int i = 0; i < d_num_doppler_bins; i++)
+            for (unsigned int i = 0; i < d_num_doppler_spectra; i++)
                 {
                     volk_gnsssdr_free(d_grid_doppler_wipeoffs[i]);
+                    volk_gnsssdr_free(d_doppler_spectra[i]);
                 }
             delete[] d_grid_doppler_wipeoffs;
+            delete[] d_doppler_spectra;
         }
 
     volk_gnsssdr_free(d_inbuffer);
@@ -233,51 +239,49 @@ galileo_e5a_noncoherentIQ_acquisition_caf_cc::~galileo_e5a_noncoherentIQ_acquisi
 
 void galileo_e5a_noncoherentIQ_acquisition_caf_cc::set_local_code(std::complex<float> *codeI, std::complex<float> *codeQ)
 {
-    // DATA SIGNAL
-    // Three replicas of data primary code. CODE A: (1,1,1)
-    memcpy(d_fft_if->get_inbuf(), codeI, sizeof(gr_complex) * d_fft_size);
-
-    d_fft_if->execute();  // We need the FFT of local code
-
-    //Conjugate the local code
-    volk_32fc_conjugate_32fc(d_fft_code_I_A, d_fft_if->get_outbuf(), d_fft_size);
-
-    // SAME FOR PILOT SIGNAL
+    // The data code is real and the pilot code is imaginary, so the FFT of
+    // their sum (codeI + j codeQ) holds both spectra. They are recovered from
+    // its even and odd parts: FI[k] = (P[k] + P*[N-k]) / 2, FQ[k] = (P[k] - P*[N-k]) / 2.
+    // CODE A: (1,1,1)
+    gr_complex *packed = d_fft_if->get_inbuf();
+    memcpy(packed, codeI, sizeof(gr_complex) * d_fft_size);
     if (d_both_signal_components == true)
         {
-            // Three replicas of pilot primary code. CODE A: (1,1,1)
-            memcpy(d_fft_if->get_inbuf(), codeQ, sizeof(gr_complex) * d_fft_size);
-
-            d_fft_if->execute();  // We need the FFT of local code
-
-            //Conjugate the local code
-            volk_32fc_conjugate_32fc(d_fft_code_Q_A, d_fft_if->get_outbuf(), d_fft_size);
+            for (unsigned int i = 0; i < d_fft_size; i++)
+                {
+                    packed[i] += codeQ[i];
+                }
         }
+    d_fft_if->execute();  // We need the FFT of local code
+    split_code_spectra(d_fft_code_I_A, d_fft_code_Q_A);
+
     // IF INTEGRATION TIME > 1 code, we need to evaluate the other possible combination
     // Note: max integration time allowed = 3ms (dealt in adapter)
     if (d_sampled_ms > 1)
         {
-            // DATA CODE B: First replica is inverted (0,1,1)
-            volk_32fc_s32fc_multiply_32fc(&(d_fft_if->get_inbuf())[0],
-                &codeI[0], gr_complex(-1, 0),
-                d_samples_per_code);
-
+            // CODE B: First replica is inverted (0,1,1)
+            volk_32fc_s32fc_multiply_32fc(packed, packed, gr_complex(-1, 0), d_samples_per_code);
             d_fft_if->execute();  // We need the FFT of local code
+            split_code_spectra(d_fft_code_I_B, d_fft_code_Q_B);
+        }
+}
 
-            //Conjugate the local code
-            volk_32fc_conjugate_32fc(d_fft_code_I_B, d_fft_if->get_outbuf(), d_fft_size);
 
-            if (d_both_signal_components == true)
-                {
-                    // PILOT CODE B: First replica is inverted (0,1,1)
-                    volk_32fc_s32fc_multiply_32fc(&(d_fft_if->get_inbuf())[0],
-                        &codeQ[0], gr_complex(-1, 0),
-                        d_samples_per_code);
-                    d_fft_if->execute();  // We need the FFT of local code
-
-                    //Conjugate the local code
-                    volk_32fc_conjugate_32fc(d_fft_code_Q_B, d_fft_if->get_outbuf(), d_fft_size);
-                }
+void galileo_e5a_noncoherentIQ_acquisition_caf_cc::split_code_spectra(gr_complex *fft_code_I, gr_complex *fft_code_Q)
+{
+    const gr_complex *packed = d_fft_if->get_outbuf();
+    if (d_both_signal_components == false)
+        {
+            //Conjugate the local code
+            volk_32fc_conjugate_32fc(fft_code_I, packed, d_fft_size);
+            return;
+        }
+    for (unsigned int k = 0; k < d_fft_size; k++)
+        {
+            gr_complex mirror = std::conj(packed[(d_fft_size - k) % d_fft_size]);
+            // Conjugated, ready for the correlation
+            fft_code_I[k] = std::conj(packed[k] + mirror) * 0.5F;
+            fft_code_Q[k] = std::conj(packed[k] - mirror) * 0.5F;
         }
 }
 
@@ -306,16 +310,39 @@ void galileo_e5a_noncoherentIQ_acquisition_caf_cc::init()
             d_num_doppler_bins++;
         }
 
-    // Create the carrier Doppler wipeoff signals
-    d_grid_doppler_wipeoffs = new gr_complex *[d_num_doppler_bins];
+    // Doppler bins a whole number of FFT bins apart share their spectrum,
+    // circularly shifted. Only the first bin of each class is transformed.
+    std::vector<int> spectrum_doppler;
+    d_doppler_spectrum_index = std::vector<uint32_t>(d_num_doppler_bins);
+    d_doppler_spectrum_shift = std::vector<uint32_t>(d_num_doppler_bins);
     for (unsigned int doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
-            d_grid_doppler_wipeoffs[doppler_index] = static_cast<gr_complex *>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
             int doppler = -static_cast<int>(d_doppler_max) + d_doppler_step * doppler_index;
-            float phase_step_rad = GALILEO_TWO_PI * doppler / static_cast<float>(d_fs_in);
+            unsigned int spectrum = 0;
+            while (spectrum < spectrum_doppler.size() and (static_cast<int64_t>(doppler - spectrum_doppler[spectrum]) * d_fft_size) % d_fs_in != 0)
+                {
+                    spectrum++;
+                }
+            if (spectrum == spectrum_doppler.size())
+                {
+                    spectrum_doppler.push_back(doppler);
+                }
+            d_doppler_spectrum_index[doppler_index] = spectrum;
+            d_doppler_spectrum_shift[doppler_index] = static_cast<uint32_t>(((static_cast<int64_t>(doppler - spectrum_doppler[spectrum]) * d_fft_size) / d_fs_in) % d_fft_size);
+        }
+
+    // Create the carrier Doppler wipeoff signals
+    d_num_doppler_spectra = spectrum_doppler.size();
+    d_grid_doppler_wipeoffs = new gr_complex *[d_num_doppler_spectra];
+    d_doppler_spectra = new gr_complex *[d_num_doppler_spectra];
+    for (unsigned int spectrum = 0; spectrum < d_num_doppler_spectra; spectrum++)
+        {
+            d_grid_doppler_wipeoffs[spectrum] = static_cast<gr_complex *>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            d_doppler_spectra[spectrum] = static_cast<gr_complex *>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            float phase_step_rad = GALILEO_TWO_PI * spectrum_doppler[spectrum] / static_cast<float>(d_fs_in);
             float _phase[1];
             _phase[0] = 0;
-            volk_gnsssdr_s32f_sincos_32fc(d_grid_doppler_wipeoffs[doppler_index], -phase_step_rad, _phase, d_fft_size);
+            volk_gnsssdr_s32f_sincos_32fc(d_grid_doppler_wipeoffs[spectrum], -phase_step_rad, _phase, d_fft_size);
         }
 
     /* CAF Filtering to resolve doppler ambiguity. Phase and quadrature must be processed
@@ -357,6 +384,51 @@ void galileo_e5a_noncoherentIQ_acquisition_caf_cc::set_state(int state)
 }
 
 
+void galileo_e5a_noncoherentIQ_acquisition_caf_cc::correlate(float *magnitude, const gr_complex *spectrum, uint32_t shift,
+    const gr_complex *fft_code, uint32_t &max_index, float &max_value)
+{
+    // Multiply the Doppler shifted spectrum of the input with the local FFT'd code reference
+    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), spectrum + shift, fft_code, d_fft_size - shift);
+    if (shift > 0)
+        {
+            volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf() + d_fft_size - shift, spectrum, fft_code + d_fft_size - shift, shift);
+        }
+
+    // compute the inverse FFT
+    d_ifft->execute();
+
+    // Squared magnitude and its maximum in a single pass
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f(magnitude, &max_index, &max_value, d_ifft->get_outbuf(), 0, d_fft_size);
+}
+
+
+void galileo_e5a_noncoherentIQ_acquisition_caf_cc::caf_window_filter(float *out, const float *in, int bins_half) const
+{
+    // Triangular window of weights 1 - |i - j| / (2 * bins_half), normalized by
+    // the sum of the weights that fall inside the grid. The weighted sums come
+    // from running sums of in[j] and j * in[j], in a single pass over the bins.
+    int num_bins = d_num_doppler_bins;
+    float weighting_factor = (bins_half > 0 ? 0.5F / static_cast<float>(bins_half) : 0.0F);
+    std::vector<double> sum(num_bins + 1, 0.0);
+    std::vector<double> moment(num_bins + 1, 0.0);
+    for (int j = 0; j < num_bins; j++)
+        {
+            sum[j + 1] = sum[j] + in[j];
+            moment[j + 1] = moment[j] + static_cast<double>(j) * in[j];
+        }
+    for (int i = 0; i < num_bins; i++)
+        {
+            int first = std::max(0, i - bins_half);
+            int last = std::min(num_bins - 1, i + bins_half);
+            double left_sum = sum[i + 1] - sum[first];
+            double right_sum = sum[last + 1] - sum[i + 1];
+            double distance = static_cast<double>(i) * (left_sum - right_sum) - (moment[i + 1] - moment[first]) + (moment[last + 1] - moment[i + 1]);
+            double weights = static_cast<double>(last - first + 1) - weighting_factor * static_cast<double>((i - first) * (i - first + 1) / 2 + (last - i) * (last - i + 1) / 2);
+            out[i] = static_cast<float>((left_sum + right_sum - weighting_factor * distance) / weights);
+        }
+}
+
+
 int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items __attribute__((unused)),
     gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items __attribute__((unused)))
@@ -464,63 +536,45 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                 d_input_power /= static_cast<float>(d_fft_size);
 
                 // 2- Doppler frequency search loop
+                // Fourier transform of the carrier wiped--off incoming signal,
+                // once for each class of Doppler bins sharing a spectrum
+                for (unsigned int spectrum = 0; spectrum < d_num_doppler_spectra; spectrum++)
+                    {
+                        volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), d_inbuffer,
+                            d_grid_doppler_wipeoffs[spectrum], d_fft_size);
+                        d_fft_if->execute();
+                        memcpy(d_doppler_spectra[spectrum], d_fft_if->get_outbuf(), sizeof(gr_complex) * d_fft_size);
+                    }
                 for (unsigned int doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
                     {
                         // doppler search steps
-
                         doppler = -static_cast<int>(d_doppler_max) + d_doppler_step * doppler_index;
-
-                        volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), d_inbuffer,
-                            d_grid_doppler_wipeoffs[doppler_index], d_fft_size);
+                        const gr_complex *spectrum = d_doppler_spectra[d_doppler_spectrum_index[doppler_index]];
+                        uint32_t shift = d_doppler_spectrum_shift[doppler_index];
 
                         // 3- Perform the FFT-based convolution  (parallel time search)
-                        // Compute the FFT of the carrier wiped--off incoming signal
-                        d_fft_if->execute();
-
                         // CODE IA
-                        // Multiply carrier wiped--off, Fourier transformed incoming signal
-                        // with the local FFT'd code reference using SIMD operations with VOLK library
-                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                            d_fft_if->get_outbuf(), d_fft_code_I_A, d_fft_size);
-
-                        // compute the inverse FFT
-                        d_ifft->execute();
-
-                        // Search maximum
-                        volk_32fc_magnitude_squared_32f(d_magnitudeIA, d_ifft->get_outbuf(), d_fft_size);
-                        volk_gnsssdr_32f_index_max_32u(&indext_IA, d_magnitudeIA, d_fft_size);
+                        correlate(d_magnitudeIA, spectrum, shift, d_fft_code_I_A, indext_IA, magt_IA);
                         // Normalize the maximum value to correct the scale factor introduced by FFTW
-                        magt_IA = d_magnitudeIA[indext_IA] / (fft_normalization_factor * fft_normalization_factor);
+                        magt_IA /= (fft_normalization_factor * fft_normalization_factor);
 
                         if (d_both_signal_components == true)
                             {
                                 // REPEAT FOR ALL CODES. CODE_QA
-                                volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                                    d_fft_if->get_outbuf(), d_fft_code_Q_A, d_fft_size);
-                                d_ifft->execute();
-                                volk_32fc_magnitude_squared_32f(d_magnitudeQA, d_ifft->get_outbuf(), d_fft_size);
-                                volk_gnsssdr_32f_index_max_32u(&indext_QA, d_magnitudeQA, d_fft_size);
-                                magt_QA = d_magnitudeQA[indext_QA] / (fft_normalization_factor * fft_normalization_factor);
+                                correlate(d_magnitudeQA, spectrum, shift, d_fft_code_Q_A, indext_QA, magt_QA);
+                                magt_QA /= (fft_normalization_factor * fft_normalization_factor);
                             }
                         if (d_sampled_ms > 1)  // If Integration time > 1 code
                             {
                                 // REPEAT FOR ALL CODES. CODE_IB
-                                volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                                    d_fft_if->get_outbuf(), d_fft_code_I_B, d_fft_size);
-                                d_ifft->execute();
-                                volk_32fc_magnitude_squared_32f(d_magnitudeIB, d_ifft->get_outbuf(), d_fft_size);
-                                volk_gnsssdr_32f_index_max_32u(&indext_IB, d_magnitudeIB, d_fft_size);
-                                magt_IB = d_magnitudeIB[indext_IB] / (fft_normalization_factor * fft_normalization_factor);
+                                correlate(d_magnitudeIB, spectrum, shift, d_fft_code_I_B, indext_IB, magt_IB);
+                                magt_IB /= (fft_normalization_factor * fft_normalization_factor);
 
                                 if (d_both_signal_components == true)
                                     {
                                         // REPEAT FOR ALL CODES. CODE_QB
-                                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                                            d_fft_if->get_outbuf(), d_fft_code_Q_B, d_fft_size);
-                                        d_ifft->execute();
-                                        volk_32fc_magnitude_squared_32f(d_magnitudeQB, d_ifft->get_outbuf(), d_fft_size);
-                                        volk_gnsssdr_32f_index_max_32u(&indext_QB, d_magnitudeQB, d_fft_size);
-                                        magt_QB = d_magnitudeIB[indext_QB] / (fft_normalization_factor * fft_normalization_factor);
+                                        correlate(d_magnitudeQB, spectrum, shift, d_fft_code_Q_B, indext_QB, magt_QB);
+                                        magt_QB /= (fft_normalization_factor * fft_normalization_factor);
                                     }
                             }
 
@@ -547,10 +601,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                                             {
                                                                 d_CAF_vector_Q[doppler_index] = d_magnitudeQA[indext_QA];
                                                             }
-                                                        for (unsigned int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIA[i] += d_magnitudeQA[i];
-                                                            }
+                                                        volk_32f_x2_add_32f(d_magnitudeIA, d_magnitudeIA, d_magnitudeQA, d_fft_size);
                                                     }
                                                 else
                                                     {
@@ -559,10 +610,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                                             {
                                                                 d_CAF_vector_Q[doppler_index] = d_magnitudeQB[indext_QB];
                                                             }
-                                                        for (unsigned int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIA[i] += d_magnitudeQB[i];
-                                                            }
+                                                        volk_32f_x2_add_32f(d_magnitudeIA, d_magnitudeIA, d_magnitudeQB, d_fft_size);
                                                     }
                                             }
                                         volk_gnsssdr_32f_index_max_32u(&indext, d_magnitudeIA, d_fft_size);
@@ -585,10 +633,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                                             {
                                                                 d_CAF_vector_Q[doppler_index] = d_magnitudeQA[indext_QA];
                                                             }
-                                                        for (unsigned int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIB[i] += d_magnitudeQA[i];
-                                                            }
+                                                        volk_32f_x2_add_32f(d_magnitudeIB, d_magnitudeIB, d_magnitudeQA, d_fft_size);
                                                     }
                                                 else
                                                     {
@@ -597,10 +642,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                                             {
                                                                 d_CAF_vector_Q[doppler_index] = d_magnitudeQB[indext_QB];
                                                             }
-                                                        for (unsigned int i = 0; i < d_fft_size; i++)
-                                                            {
-                                                                d_magnitudeIB[i] += d_magnitudeQB[i];
-                                                            }
+                                                        volk_32f_x2_add_32f(d_magnitudeIB, d_magnitudeIB, d_magnitudeQB, d_fft_size);
                                                     }
                                             }
                                         volk_gnsssdr_32f_index_max_32u(&indext, d_magnitudeIB, d_fft_size);
@@ -622,10 +664,7 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                                 d_CAF_vector_Q[doppler_index] = d_magnitudeQA[indext_QA];
                                             }
                                         // NON-Coherent integration of only 1 code
-                                        for (unsigned int i = 0; i < d_fft_size; i++)
-                                            {
-                                                d_magnitudeIA[i] += d_magnitudeQA[i];
-                                            }
+                                        volk_32f_x2_add_32f(d_magnitudeIA, d_magnitudeIA, d_magnitudeQA, d_fft_size);
                                     }
                                 volk_gnsssdr_32f_index_max_32u(&indext, d_magnitudeIA, d_fft_size);
                                 magt = d_magnitudeIA[indext] / (fft_normalization_factor * fft_normalization_factor);
@@ -684,85 +723,12 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                 // 6 OPTIONAL: CAF filter to avoid Doppler ambiguity in bit transition.
                 if (d_CAF_window_hz > 0)
                     {
-                        int CAF_bins_half;
-                        auto *accum = static_cast<float *>(volk_gnsssdr_malloc(sizeof(float), volk_gnsssdr_get_alignment()));
-                        CAF_bins_half = d_CAF_window_hz / (2 * d_doppler_step);
-                        float weighting_factor;
-                        weighting_factor = 0.5 / static_cast<float>(CAF_bins_half);
-                        // weighting_factor = 0;
-                        // std::cout << "weighting_factor " << weighting_factor << std::endl;
-                        // Initialize first iterations
-                        for (int doppler_index = 0; doppler_index < CAF_bins_half; doppler_index++)
+                        // The I and Q windows share their weights, so they are filtered at once
+                        if (d_both_signal_components)
                             {
-                                d_CAF_vector[doppler_index] = 0;
-                                // volk_32f_accumulator_s32f_a(&d_CAF_vector[doppler_index], d_CAF_vector_I, CAF_bins_half+doppler_index+1);
-                                for (int i = 0; i < CAF_bins_half + doppler_index + 1; i++)
-                                    {
-                                        d_CAF_vector[doppler_index] += d_CAF_vector_I[i] * (1 - weighting_factor * static_cast<unsigned int>((doppler_index - i)));
-                                    }
-                                // d_CAF_vector[doppler_index] /= CAF_bins_half+doppler_index+1;
-                                d_CAF_vector[doppler_index] /= 1 + CAF_bins_half + doppler_index - weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2 - weighting_factor * doppler_index * (doppler_index + 1) / 2;  // triangles = [n*(n+1)/2]
-                                if (d_both_signal_components)
-                                    {
-                                        accum[0] = 0;
-                                        // volk_32f_accumulator_s32f_a(&accum[0], d_CAF_vector_Q, CAF_bins_half+doppler_index+1);
-                                        for (int i = 0; i < CAF_bins_half + doppler_index + 1; i++)
-                                            {
-                                                accum[0] += d_CAF_vector_Q[i] * (1 - weighting_factor * static_cast<unsigned int>(abs(doppler_index - i)));
-                                            }
-                                        // accum[0] /= CAF_bins_half+doppler_index+1;
-                                        accum[0] /= 1 + CAF_bins_half + doppler_index - weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2 - weighting_factor * doppler_index * (doppler_index + 1) / 2;  // triangles = [n*(n+1)/2]
-                                        d_CAF_vector[doppler_index] += accum[0];
-                                    }
-                            }
-                        // Body loop
-                        for (unsigned int doppler_index = CAF_bins_half; doppler_index < d_num_doppler_bins - CAF_bins_half; doppler_index++)
-                            {
-                                d_CAF_vector[doppler_index] = 0;
-                                // volk_32f_accumulator_s32f_a(&d_CAF_vector[doppler_index], &d_CAF_vector_I[doppler_index-CAF_bins_half], 2*CAF_bins_half+1);
-                                for (int i = doppler_index - CAF_bins_half; i < static_cast<int>(doppler_index + CAF_bins_half + 1); i++)
-                                    {
-                                        d_CAF_vector[doppler_index] += d_CAF_vector_I[i] * (1 - weighting_factor * static_cast<unsigned int>((doppler_index - i)));
-                                    }
-                                // d_CAF_vector[doppler_index] /= 2*CAF_bins_half+1;
-                                d_CAF_vector[doppler_index] /= 1 + 2 * CAF_bins_half - 2 * weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2;
-                                if (d_both_signal_components)
-                                    {
-                                        accum[0] = 0;
-                                        // volk_32f_accumulator_s32f_a(&accum[0], &d_CAF_vector_Q[doppler_index-CAF_bins_half], 2*CAF_bins_half);
-                                        for (int i = doppler_index - CAF_bins_half; i < static_cast<int>(doppler_index + CAF_bins_half + 1); i++)
-                                            {
-                                                accum[0] += d_CAF_vector_Q[i] * (1 - weighting_factor * static_cast<unsigned int>((doppler_index - i)));
-                                            }
-                                        // accum[0] /= 2*CAF_bins_half+1;
-                                        accum[0] /= 1 + 2 * CAF_bins_half - 2 * weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2;
-                                        d_CAF_vector[doppler_index] += accum[0];
-                                    }
-                            }
-                        // Final iterations
-                        for (int doppler_index = d_num_doppler_bins - CAF_bins_half; doppler_index < static_cast<int>(d_num_doppler_bins); doppler_index++)
-                            {
-                                d_CAF_vector[doppler_index] = 0;
-                                // volk_32f_accumulator_s32f_a(&d_CAF_vector[doppler_index], &d_CAF_vector_I[doppler_index-CAF_bins_half], CAF_bins_half + (d_num_doppler_bins-doppler_index));
-                                for (int i = doppler_index - CAF_bins_half; i < static_cast<int>(d_num_doppler_bins); i++)
-                                    {
-                                        d_CAF_vector[doppler_index] += d_CAF_vector_I[i] * (1 - weighting_factor * (abs(doppler_index - i)));
-                                    }
-                                // d_CAF_vector[doppler_index] /= CAF_bins_half+(d_num_doppler_bins-doppler_index);
-                                d_CAF_vector[doppler_index] /= 1 + CAF_bins_half + (d_num_doppler_bins - doppler_index - 1) - weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2 - weighting_factor * (d_num_doppler_bins - doppler_index - 1) * (d_num_doppler_bins - doppler_index) / 2;
-                                if (d_both_signal_components)
-                                    {
-                                        accum[0] = 0;
-                                        // volk_32f_accumulator_s32f_a(&accum[0], &d_CAF_vector_Q[doppler_index-CAF_bins_half], CAF_bins_half + (d_num_doppler_bins-doppler_index));
-                                        for (int i = doppler_index - CAF_bins_half; i < static_cast<int>(d_num_doppler_bins); i++)
-                                            {
-                                                accum[0] += d_CAF_vector_Q[i] * (1 - weighting_factor * (abs(doppler_index - i)));
-                                            }
-                                        // accum[0] /= CAF_bins_half+(d_num_doppler_bins-doppler_index);
-                                        accum[0] /= 1 + CAF_bins_half + (d_num_doppler_bins - doppler_index - 1) - weighting_factor * CAF_bins_half * (CAF_bins_half + 1) / 2 - weighting_factor * (d_num_doppler_bins - doppler_index - 1) * (d_num_doppler_bins - doppler_index) / 2;
-                                        d_CAF_vector[doppler_index] += accum[0];
-                                    }
+                                volk_32f_x2_add_32f(d_CAF_vector_I, d_CAF_vector_I, d_CAF_vector_Q, d_num_doppler_bins);
                             }
+                        caf_window_filter(d_CAF_vector, d_CAF_vector_I, d_CAF_window_hz / (2 * d_doppler_step));
 
                         // Recompute the maximum doppler peak
                         volk_gnsssdr_32f_index_max_32u(&indext, d_CAF_vector, d_num_doppler_bins);
@@ -779,7 +745,6 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                                 d_dump_file.write(reinterpret_cast<char *>(d_CAF_vector), n);
                                 d_dump_file.close();
                             }
-                        volk_gnsssdr_free(accum);
                     }
 
                 if (d_well_count == d_max_dwells)
@@ -39,12 +39,13 @@
 #define GALILEO_E5A_NONCOHERENT_IQ_ACQUISITION_CAF_CC_H_
 
 #include "channel_fsm.h"
+#include "gnss_sdr_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>
 #include <fstream>
 #include <string>
+#include <vector>
 
 class galileo_e5a_noncoherentIQ_acquisition_caf_cc;
 
@@ -99,6 +100,10 @@ private:
     void calculate_magnitudes(gr_complex* fft_begin, int doppler_shift,
         int doppler_offset);
     float estimate_input_power(gr_complex* in);
+    void split_code_spectra(gr_complex* fft_code_I, gr_complex* fft_code_Q);
+    void correlate(float* magnitude, const gr_complex* spectrum, uint32_t shift,
+        const gr_complex* fft_code, uint32_t& max_index, float& max_value);
+    void caf_window_filter(float* out, const float* in, int bins_half) const;
 
     std::shared_ptr<ChannelFsm> d_channel_fsm;
     int64_t d_fs_in;
@@ -116,13 +121,17 @@ private:
     uint64_t d_sample_counter;
     gr_complex** d_grid_doppler_wipeoffs;
     unsigned int d_num_doppler_bins;
+    unsigned int d_num_doppler_spectra;
+    gr_complex** d_doppler_spectra;
+    std::vector<uint32_t> d_doppler_spectrum_index;
+    std::vector<uint32_t> d_doppler_spectrum_shift;
     gr_complex* d_fft_code_I_A;
     gr_complex* d_fft_code_I_B;
     gr_complex* d_fft_code_Q_A;
     gr_complex* d_fft_code_Q_B;
     gr_complex* d_inbuffer;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft_Complex* d_fft_if;
+    Gnss_Fft_Complex* d_ifft;
     Gnss_Synchro* d_gnss_synchro;
     unsigned int d_code_phase;
     float d_doppler_freq;
@@ -40,18 +40,22 @@
 #include "gnss_sdr_create_directory.h"
 #include "gnss_synchro.h"
 #include <boost/filesystem/path.hpp>
+#include <boost/math/distributions/gamma.hpp>
+#include <boost/math/distributions/non_central_chi_squared.hpp>
 #include <glog/logging.h>
+#include <gnuradio/block_detail.h>
+#include <gnuradio/buffer.h>
 #include <gnuradio/io_signature.h>
-#include <matio.h>
 #include <pmt/pmt.h>        // for from_long
 #include <pmt/pmt_sugar.h>  // for mp
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
-#include <algorithm>  // for fill_n, min
-#include <cmath>      // for floor, fmod, rint, ceil
+#include <algorithm>  // for fill, fill_n, min, max
+#include <cmath>      // for floor, fmod, rint, ceil, round, sqrt
 #include <cstring>    // for memcpy
 #include <iostream>
 #include <map>
+#include <utility>  // for move
 
 
 pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_)
@@ -82,10 +86,13 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
         {
             d_fft_size = d_consumed_samples * 2;
         }
-    // d_fft_size = next power of two?  ////
     d_mag = 0;
     d_input_power = 0.0;
     d_num_doppler_bins = 0U;
+    d_num_doppler_bins_max = 0U;
+    d_doppler_center = 0;
+    d_doppler_window = 0U;
+    d_doppler_grid_min = 0;
     d_threshold = 0.0;
     d_doppler_step = 0U;
     d_doppler_center_step_two = 0.0;
@@ -115,22 +122,178 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
             d_fft_size = d_consumed_samples * 2;
             acq_parameters.max_dwells = 1;  // Activation of acq_parameters.bit_transition_flag invalidates the value of acq_parameters.max_dwells
         }
+    d_nominal_fft_size = d_fft_size;
+    d_effective_fft_size = (acq_parameters.bit_transition_flag ? d_nominal_fft_size / 2 : d_nominal_fft_size);
+
+    // Linear (zero-padded) correlations are not altered by extra zero padding, so
+    // in that case the FFT length can be rounded up to a size with small prime factors.
+    // The circular correlation over one code period requires the exact code length.
+    if (acq_parameters.use_smooth_fft_size and (d_fft_size > d_consumed_samples))
+        {
+            d_fft_size = gnss_sdr_fft_smooth_size(d_fft_size);
+        }
 
     d_tmp_buffer = static_cast<float*>(volk_gnsssdr_malloc(d_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
     d_fft_codes = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
     d_magnitude = static_cast<float*>(volk_gnsssdr_malloc(d_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
     d_input_signal = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
 
-    // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    // Direct FFT (the plan is shared among all the channels with the same FFT size)
+    d_fft_if = new Gnss_Fft_Complex(d_fft_size, true);
 
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft_Complex(d_fft_size, false);
+
+    // Coarse-to-fine search. The first step runs on the input decimated by an
+    // integer factor (keeping at least two samples per chip), and the second
+    // step refines code phase and Doppler at the full rate, only in a narrow
+    // window around the coarse peak. Only for circular correlations.
+    d_decimation_factor = 1U;
+    if (acq_parameters.coarse_decimation_factor > 1)
+        {
+            if (d_fft_size != d_consumed_samples)
+                {
+                    LOG(WARNING) << "Coarse-to-fine acquisition is not available with bit_transition_flag or sampled_ms != ms_per_code. Disabled.";
+                }
+            else
+                {
+                    uint32_t factor = std::min(acq_parameters.coarse_decimation_factor, std::max(acq_parameters.samples_per_chip / 2, 1U));
+                    // The code period must be an integer number of decimated samples
+                    while (d_consumed_samples % factor != 0)
+                        {
+                            factor--;
+                        }
+                    d_decimation_factor = factor;
+                }
+            LOG(INFO) << "Acquisition coarse step decimation factor: " << d_decimation_factor;
+        }
+    d_coarse_fft_size = d_consumed_samples / d_decimation_factor;
+    d_coarse_code_phase = 0U;
+    d_fine_window_center = 0U;
+    d_coarse_sample_stamp = 0ULL;
+    d_coarse_test_statistics = 0.0;
+    d_coarse_grid_doppler_wipeoffs = nullptr;
+    d_coarse_fft_codes = nullptr;
+    d_coarse_input_signal = nullptr;
+    d_if_wipeoff = nullptr;
+    d_local_code = nullptr;
+    d_coarse_fft_if = nullptr;
+    d_coarse_ifft = nullptr;
+    if (d_decimation_factor > 1)
+        {
+            acq_parameters.make_2_steps = true;  // the second step is the full-rate refinement
+            d_coarse_fft_codes = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_coarse_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            d_coarse_input_signal = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_coarse_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            d_if_wipeoff = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            d_coarse_fft_if = new Gnss_Fft_Complex(d_coarse_fft_size, true);
+            d_coarse_ifft = new Gnss_Fft_Complex(d_coarse_fft_size, false);
+        }
+
+    // Partial matched filter + FFT search. The dwell is split in short blocks,
+    // each one correlated with the code at all the code phases, and an FFT
+    // across the blocks resolves the Doppler. It replaces the FFT correlation
+    // per Doppler bin, so the cost grows with log(bins) instead of linearly.
+    // The code is periodic in the dwell, so the correlations are circular over
+    // one code period whatever sampled_ms is.
+    d_pmf_blocks = 0U;
+    d_pmf_block_size = 0U;
+    d_pmf_code_samples = 0U;
+    d_pmf_fft_size = 0U;
+    d_pmf_bin_hz = 0.0;
+    d_pmf_center = 0;
+    d_pmf_shift = false;
+    d_pmf_carrier = nullptr;
+    d_pmf_fft_codes = nullptr;
+    d_pmf_partial = nullptr;
+    d_pmf_fft_if = nullptr;
+    d_pmf_ifft = nullptr;
+    d_pmf_doppler_fft = nullptr;
+    d_pmf_magnitude = nullptr;
+    d_num_grid_rows = 0U;
+    if (acq_parameters.pmf_fft)
+        {
+            auto code_samples = static_cast<uint32_t>(std::round(acq_parameters.samples_per_code));
+            if (d_decimation_factor > 1 or acq_parameters.make_2_steps or code_samples == 0 or d_consumed_samples % code_samples != 0)
+                {
+                    LOG(WARNING) << "PMF-FFT acquisition needs an integer number of code periods per dwell, and it is not available with coarse_decimation_factor > 1 nor make_two_steps. Disabled.";
+                }
+            else
+                {
+                    double fs = acq_parameters.use_automatic_resampler ? static_cast<double>(acq_parameters.resampled_fs) : static_cast<double>(acq_parameters.fs_in);
+                    // The Doppler FFT spans fs / block_size, which must cover +/- doppler_max.
+                    // Blocks divide the code period, so that none of them wraps around it.
+                    uint32_t block_size = std::min(code_samples, static_cast<uint32_t>(std::floor(fs / (2.0 * static_cast<double>(std::max(acq_parameters.doppler_max, 1U))))));
+                    while (block_size > 1 and code_samples % block_size != 0)
+                        {
+                            block_size--;
+                        }
+                    d_pmf_code_samples = code_samples;
+                    d_pmf_block_size = block_size;
+                    d_pmf_blocks = d_consumed_samples / block_size;
+                    // Zero padding to twice the number of blocks halves the scalloping loss between bins
+                    d_pmf_fft_size = gnss_sdr_fft_smooth_size(2 * d_pmf_blocks);
+                    d_pmf_bin_hz = static_cast<float>(fs / (static_cast<double>(block_size) * static_cast<double>(d_pmf_fft_size)));
+                    d_pmf_carrier = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_consumed_samples * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+                    d_pmf_fft_codes = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_pmf_code_samples * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+                    d_pmf_partial = new gr_complex*[d_pmf_blocks];
+                    for (uint32_t p = 0; p < d_pmf_blocks; p++)
+                        {
+                            d_pmf_partial[p] = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_pmf_code_samples * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+                        }
+                    d_pmf_fft_if = new Gnss_Fft_Complex(d_pmf_code_samples, true);
+                    d_pmf_ifft = new Gnss_Fft_Complex(d_pmf_code_samples, false);
+                    d_pmf_doppler_fft = new Gnss_Fft_Complex(d_pmf_fft_size, true);
+                    d_pmf_magnitude = static_cast<float*>(volk_gnsssdr_malloc(d_pmf_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
+                    LOG(INFO) << "PMF-FFT acquisition: " << d_pmf_blocks << " blocks of " << d_pmf_block_size
+                              << " samples, Doppler FFT of " << d_pmf_fft_size << " bins of " << d_pmf_bin_hz << " Hz";
+                }
+        }
+
+    // Doppler refinement with an FFT of the prompt correlation of the dwell blocks.
+    // Zero padding to eight times the number of blocks leaves little scalloping
+    // for the parabolic interpolation of the peak.
+    d_prompt_fft_blocks = 0U;
+    d_prompt_code = nullptr;
+    d_prompt_signal = nullptr;
+    d_prompt_magnitude = nullptr;
+    d_prompt_fft = nullptr;
+    if (acq_parameters.prompt_fft_blocks > 1)
+        {
+            if (acq_parameters.bit_transition_flag or d_consumed_samples / acq_parameters.prompt_fft_blocks < 2)
+                {
+                    LOG(WARNING) << "The prompt FFT Doppler refinement is not available with bit_transition_flag nor with blocks of less than two samples. Disabled.";
+                }
+            else
+                {
+                    d_prompt_fft_blocks = acq_parameters.prompt_fft_blocks;
+                    d_prompt_code = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+                    d_prompt_signal = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+                    d_prompt_magnitude = static_cast<float*>(volk_gnsssdr_malloc(8 * d_prompt_fft_blocks * sizeof(float), volk_gnsssdr_get_alignment()));
+                    d_prompt_fft = new Gnss_Fft_Complex(8 * d_prompt_fft_blocks, true);
+                }
+        }
+    if (d_decimation_factor > 1 or d_prompt_fft_blocks > 1)
+        {
+            d_local_code = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+        }
 
     d_gnss_synchro = nullptr;
     d_grid_doppler_wipeoffs = nullptr;
     d_grid_doppler_wipeoffs_step_two = nullptr;
     d_magnitude_grid = nullptr;
+    d_magnitude_grid_16i = nullptr;
+    d_compact_grid = false;
+    if (acq_parameters.compact_grid)
+        {
+            if (d_decimation_factor > 1 or d_pmf_blocks > 0)
+                {
+                    LOG(WARNING) << "The compact acquisition grid is not available with coarse_decimation_factor nor pmf_fft. Disabled.";
+                }
+            else
+                {
+                    d_compact_grid = true;
+                }
+        }
     d_worker_active = false;
     d_data_buffer = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_consumed_samples * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
     if (d_cshort)
@@ -157,6 +320,22 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
         {
             d_use_CFAR_algorithm_flag = false;
         }
+    // The sequential test compares the accumulated grid with thresholds that
+    // depend on the number of dwells, so it makes the CFAR statistic valid
+    // for non-coherent integration
+    d_sequential = false;
+    if (acq_parameters.sequential_detection)
+        {
+            if (acq_parameters.pfa <= 0.0 or acq_parameters.bit_transition_flag or d_decimation_factor > 1 or d_pmf_blocks > 0)
+                {
+                    LOG(WARNING) << "Sequential detection needs a pfa, and is not available with bit_transition_flag, coarse_decimation_factor nor pmf_fft. Disabled.";
+                }
+            else
+                {
+                    d_sequential = true;
+                    d_use_CFAR_algorithm_flag = true;
+                }
+        }
     d_dump_number = 0LL;
     d_dump_channel = acq_parameters.dump_channel;
     d_dump = acq_parameters.dump;
@@ -197,15 +376,40 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_) : gr::block("pcps_acqu
 
 pcps_acquisition::~pcps_acquisition()
 {
-    if (d_num_doppler_bins > 0)
+    if (d_num_doppler_bins_max > 0)
         {
-            for (uint32_t i = 0; i < d_num_doppler_bins; i++)
+            for (uint32_t i = 0; i < d_num_doppler_bins_max; i++)
                 {
                     volk_gnsssdr_free(d_grid_doppler_wipeoffs[i]);
-                    volk_gnsssdr_free(d_magnitude_grid[i]);
+                }
+            for (uint32_t i = 0; i < d_num_grid_rows; i++)
+                {
+                    if (d_compact_grid)
+                        {
+                            volk_gnsssdr_free(d_magnitude_grid_16i[i]);
+                        }
+                    else
+                        {
+                            volk_gnsssdr_free(d_magnitude_grid[i]);
+                        }
                 }
             delete[] d_grid_doppler_wipeoffs;
             delete[] d_magnitude_grid;
+            delete[] d_magnitude_grid_16i;
+        }
+    if (d_pmf_blocks > 0)
+        {
+            for (uint32_t p = 0; p < d_pmf_blocks; p++)
+                {
+                    volk_gnsssdr_free(d_pmf_partial[p]);
+                }
+            delete[] d_pmf_partial;
+            volk_gnsssdr_free(d_pmf_carrier);
+            volk_gnsssdr_free(d_pmf_fft_codes);
+            volk_gnsssdr_free(d_pmf_magnitude);
+            delete d_pmf_fft_if;
+            delete d_pmf_ifft;
+            delete d_pmf_doppler_fft;
         }
     if (acq_parameters.make_2_steps)
         {
@@ -215,6 +419,33 @@ pcps_acquisition::~pcps_acquisition()
                 }
             delete[] d_grid_doppler_wipeoffs_step_two;
         }
+    if (d_decimation_factor > 1)
+        {
+            if (d_coarse_grid_doppler_wipeoffs != nullptr)
+                {
+                    for (uint32_t i = 0; i < d_num_doppler_bins_max; i++)
+                        {
+                            volk_gnsssdr_free(d_coarse_grid_doppler_wipeoffs[i]);
+                        }
+                    delete[] d_coarse_grid_doppler_wipeoffs;
+                }
+            volk_gnsssdr_free(d_coarse_fft_codes);
+            volk_gnsssdr_free(d_coarse_input_signal);
+            volk_gnsssdr_free(d_if_wipeoff);
+            delete d_coarse_ifft;
+            delete d_coarse_fft_if;
+        }
+    if (d_prompt_fft_blocks > 1)
+        {
+            volk_gnsssdr_free(d_prompt_code);
+            volk_gnsssdr_free(d_prompt_signal);
+            volk_gnsssdr_free(d_prompt_magnitude);
+            delete d_prompt_fft;
+        }
+    if (d_local_code != nullptr)
+        {
+            volk_gnsssdr_free(d_local_code);
+        }
     volk_gnsssdr_free(d_fft_codes);
     volk_gnsssdr_free(d_magnitude);
     volk_gnsssdr_free(d_tmp_buffer);
@@ -252,9 +483,10 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
     if (acq_parameters.bit_transition_flag)
         {
-            int32_t offset = d_fft_size / 2;
+            int32_t code_samples = d_nominal_fft_size / 2;
+            int32_t offset = d_fft_size - code_samples;
             std::fill_n(d_fft_if->get_inbuf(), offset, gr_complex(0.0, 0.0));
-            memcpy(d_fft_if->get_inbuf() + offset, code, sizeof(gr_complex) * offset);
+            memcpy(d_fft_if->get_inbuf() + offset, code, sizeof(gr_complex) * code_samples);
         }
     else
         {
@@ -265,12 +497,54 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
             else
                 {
                     std::fill_n(d_fft_if->get_inbuf(), d_fft_size - d_consumed_samples, gr_complex(0.0, 0.0));
-                    memcpy(d_fft_if->get_inbuf() + d_consumed_samples, code, sizeof(gr_complex) * d_consumed_samples);
+                    memcpy(d_fft_if->get_inbuf() + d_fft_size - d_consumed_samples, code, sizeof(gr_complex) * d_consumed_samples);
                 }
         }
 
     d_fft_if->execute();  // We need the FFT of local code
     volk_32fc_conjugate_32fc(d_fft_codes, d_fft_if->get_outbuf(), d_fft_size);
+
+    if (d_pmf_blocks > 0)
+        {
+            // One code period is enough for the partial correlations
+            memcpy(d_pmf_fft_if->get_inbuf(), code, sizeof(gr_complex) * d_pmf_code_samples);
+            d_pmf_fft_if->execute();
+            volk_32fc_conjugate_32fc(d_pmf_fft_codes, d_pmf_fft_if->get_outbuf(), d_pmf_code_samples);
+        }
+
+    if (d_local_code != nullptr)
+        {
+            // The replica holds d_consumed_samples, d_fft_size may be larger
+            memcpy(d_local_code, code, sizeof(gr_complex) * d_consumed_samples);
+            std::fill_n(d_local_code + d_consumed_samples, d_fft_size - d_consumed_samples, gr_complex(0.0, 0.0));
+        }
+
+    if (d_decimation_factor > 1)
+        {
+            // Full-rate replica for the fine step, and FFT of the decimated replica for the coarse step
+            boxcar_decimate(d_coarse_fft_if->get_inbuf(), code);
+            d_coarse_fft_if->execute();
+            volk_32fc_conjugate_32fc(d_coarse_fft_codes, d_coarse_fft_if->get_outbuf(), d_coarse_fft_size);
+            // FDMA channels are shifted to baseband before decimating
+            update_local_carrier(d_if_wipeoff, d_fft_size, d_old_freq);
+        }
+}
+
+
+void pcps_acquisition::boxcar_decimate(gr_complex* out, const gr_complex* in) const
+{
+    // Moving average (a sinc-shaped low-pass filter) followed by decimation.
+    // Averaging keeps the amplitude of the local code replica close to one.
+    const float gain = 1.0 / static_cast<float>(d_decimation_factor);
+    for (uint32_t k = 0; k < d_coarse_fft_size; k++)
+        {
+            gr_complex acc(0.0, 0.0);
+            for (uint32_t j = 0; j < d_decimation_factor; j++)
+                {
+                    acc += in[k * d_decimation_factor + j];
+                }
+            out[k] = acc * gain;
+        }
 }
 
 
@@ -293,23 +567,48 @@ bool pcps_acquisition::is_fdma()
 }
 
 
-void pcps_acquisition::update_local_carrier(gr_complex* carrier_vector, int32_t correlator_length_samples, float freq)
+float pcps_acquisition::carrier_phase_step_rad(float freq) const
 {
-    float phase_step_rad;
     if (acq_parameters.use_automatic_resampler)
         {
-            phase_step_rad = GPS_TWO_PI * freq / static_cast<float>(acq_parameters.resampled_fs);
-        }
-    else
-        {
-            phase_step_rad = GPS_TWO_PI * freq / static_cast<float>(acq_parameters.fs_in);
+            return GPS_TWO_PI * freq / static_cast<float>(acq_parameters.resampled_fs);
         }
+    return GPS_TWO_PI * freq / static_cast<float>(acq_parameters.fs_in);
+}
+
+
+void pcps_acquisition::update_local_carrier(gr_complex* carrier_vector, int32_t correlator_length_samples, float freq)
+{
+    float phase_step_rad = carrier_phase_step_rad(freq);
     float _phase[1];
     _phase[0] = 0.0;
     volk_gnsssdr_s32f_sincos_32fc(carrier_vector, -phase_step_rad, _phase, correlator_length_samples);
 }
 
 
+void pcps_acquisition::wipe_off_doppler(gr_complex* out, const gr_complex* in, const gr_complex* carrier_vector, float freq)
+{
+    if (d_cshort)
+        {
+            // Rotate the 16-bit samples straight into the FFT input buffer,
+            // with no conversion pass nor carrier table to read
+            float phase_step_rad = carrier_phase_step_rad(freq);
+            lv_32fc_t phase_inc = lv_cmake(std::cos(phase_step_rad), -std::sin(phase_step_rad));
+            lv_32fc_t phase[1];
+            phase[0] = lv_cmake(1.0, 0.0);
+            volk_gnsssdr_16ic_s32fc_x2_rotator_32fc(out, d_data_buffer_sc, phase_inc, phase, d_consumed_samples);
+            if (d_fft_size > d_consumed_samples)
+                {
+                    std::fill(out + d_consumed_samples, out + d_fft_size, gr_complex(0.0, 0.0));
+                }
+        }
+    else
+        {
+            volk_32fc_x2_multiply_32fc(out, in, carrier_vector, d_fft_size);
+        }
+}
+
+
 void pcps_acquisition::init()
 {
     d_gnss_synchro->Flag_valid_acquisition = false;
@@ -323,12 +622,16 @@ void pcps_acquisition::init()
     d_mag = 0.0;
     d_input_power = 0.0;
 
-    d_num_doppler_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(acq_parameters.doppler_max) - static_cast<int32_t>(-acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
+    d_num_doppler_bins_max = static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(acq_parameters.doppler_max) - static_cast<int32_t>(-acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
+    if (d_pmf_blocks > 0)
+        {
+            LOG(INFO) << "doppler_step = " << d_doppler_step << " Hz has no effect with pmf_fft. The Doppler resolution is fs / (block size * Doppler FFT size) = " << d_pmf_bin_hz << " Hz";
+        }
 
     // Create the carrier Doppler wipeoff signals
     if (d_grid_doppler_wipeoffs == nullptr)
         {
-            d_grid_doppler_wipeoffs = new gr_complex*[d_num_doppler_bins];
+            d_grid_doppler_wipeoffs = new gr_complex*[d_num_doppler_bins_max];
         }
     if (acq_parameters.make_2_steps && (d_grid_doppler_wipeoffs_step_two == nullptr))
         {
@@ -339,53 +642,188 @@ void pcps_acquisition::init()
                 }
         }
 
-    if (d_magnitude_grid == nullptr)
+    if (d_magnitude_grid == nullptr and d_magnitude_grid_16i == nullptr)
         {
-            d_magnitude_grid = new float*[d_num_doppler_bins];
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+            // The PMF-FFT search stores its Doppler FFT bins in the same grid
+            d_num_grid_rows = std::max(d_num_doppler_bins_max, d_pmf_fft_size);
+            d_grid_row_max.resize(d_num_grid_rows);
+            d_grid_row_max_index.resize(d_num_grid_rows);
+            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_max; doppler_index++)
                 {
                     d_grid_doppler_wipeoffs[doppler_index] = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
-                    d_magnitude_grid[doppler_index] = static_cast<float*>(volk_gnsssdr_malloc(d_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
+                }
+            if (d_compact_grid)
+                {
+                    d_magnitude_grid_16i = new int16_t*[d_num_grid_rows];
+                    d_grid_row_scale.assign(d_num_grid_rows, 1.0);
+                    for (uint32_t doppler_index = 0; doppler_index < d_num_grid_rows; doppler_index++)
+                        {
+                            d_magnitude_grid_16i[doppler_index] = static_cast<int16_t*>(volk_gnsssdr_malloc(d_fft_size * sizeof(int16_t), volk_gnsssdr_get_alignment()));
+                        }
+                }
+            else
+                {
+                    d_magnitude_grid = new float*[d_num_grid_rows];
+                    for (uint32_t doppler_index = 0; doppler_index < d_num_grid_rows; doppler_index++)
+                        {
+                            d_magnitude_grid[doppler_index] = static_cast<float*>(volk_gnsssdr_malloc(d_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
+                        }
                 }
         }
 
-    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+    reset_grid(d_num_grid_rows);
+
+    if (d_decimation_factor > 1 and d_coarse_grid_doppler_wipeoffs == nullptr)
         {
-            for (uint32_t k = 0; k < d_fft_size; k++)
+            d_coarse_grid_doppler_wipeoffs = new gr_complex*[d_num_doppler_bins_max];
+            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_max; doppler_index++)
                 {
-                    d_magnitude_grid[doppler_index][k] = 0.0;
+                    d_coarse_grid_doppler_wipeoffs[doppler_index] = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_coarse_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
                 }
-            int32_t doppler = -static_cast<int32_t>(acq_parameters.doppler_max) + d_doppler_step * doppler_index;
-            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], d_fft_size, d_old_freq + doppler);
         }
 
+    update_doppler_grid();
+    update_grid_doppler_wipeoffs();
+
     d_worker_active = false;
 
     if (d_dump)
         {
-            uint32_t effective_fft_size = (acq_parameters.bit_transition_flag ? (d_fft_size / 2) : d_fft_size);
-            grid_ = arma::fmat(effective_fft_size, d_num_doppler_bins, arma::fill::zeros);
-            narrow_grid_ = arma::fmat(effective_fft_size, d_num_doppler_bins_step2, arma::fill::zeros);
+            narrow_grid_ = arma::fmat(d_effective_fft_size, d_num_doppler_bins_step2, arma::fill::zeros);
+            if (!d_dump_writer)
+                {
+                    // Dumps are written by a background thread, so they do not stall acquisition_core
+                    size_t grid_size = static_cast<size_t>(d_num_grid_rows) * std::max(d_decimation_factor > 1 ? d_coarse_fft_size : d_effective_fft_size, d_pmf_code_samples);
+                    if (acq_parameters.make_2_steps)
+                        {
+                            grid_size += narrow_grid_.n_elem;
+                        }
+                    d_dump_writer = std::unique_ptr<Acquisition_Dump_Writer>(new Acquisition_Dump_Writer(acq_parameters.dump_format, acq_parameters.dump_queue_size, grid_size));
+                }
+        }
+}
+
+
+void pcps_acquisition::update_doppler_grid()
+{
+    if (d_doppler_window == 0 or d_doppler_window >= acq_parameters.doppler_max or d_doppler_step == 0)
+        {
+            // Whole search range
+            d_num_doppler_bins = d_num_doppler_bins_max;
+            d_doppler_grid_min = -static_cast<int32_t>(acq_parameters.doppler_max);
+        }
+    else
+        {
+            // A few bins around the predicted Doppler, which is always one of them
+            auto half_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(d_doppler_window) / static_cast<double>(d_doppler_step)));
+            d_num_doppler_bins = std::min(2 * half_bins + 1, d_num_doppler_bins_max);
+            d_doppler_grid_min = d_doppler_center - static_cast<int32_t>(half_bins * d_doppler_step);
+        }
+    if (d_sequential)
+        {
+            update_sequential_thresholds();
+        }
+    if (d_pmf_blocks > 0)
+        {
+            // The Doppler FFT always spans fs / block_size. The window only moves its center.
+            d_num_doppler_bins = d_pmf_fft_size;
+            d_pmf_center = (d_doppler_window == 0 or d_doppler_window >= acq_parameters.doppler_max) ? 0 : d_doppler_center;
+            if (d_dump)
+                {
+                    grid_ = arma::fmat(d_pmf_code_samples, d_pmf_fft_size, arma::fill::zeros);
+                }
+            return;
+        }
+    if (d_dump)
+        {
+            grid_ = arma::fmat(d_decimation_factor > 1 ? d_coarse_fft_size : d_effective_fft_size, d_num_doppler_bins, arma::fill::zeros);
+        }
+}
+
+
+void pcps_acquisition::update_sequential_thresholds()
+{
+    // The grid, normalized by the noise power of a cell, accumulates k dwells.
+    // Without signal each cell is Gamma(k, 1). A signal of C/N0 adds
+    // lambda = C/N0 * T per dwell, and its cell is a noncentral chi-square of
+    // 2k degrees of freedom and noncentrality 2 k lambda, halved.
+    // Above the upper threshold the satellite is present, with the pfa split
+    // among the cells and the dwells. Below the lower threshold a signal at
+    // the design C/N0 would have been missed with probability sequential_pmiss,
+    // so the search is dismissed. The last dwell always decides.
+    uint32_t max_dwells = acq_parameters.max_dwells;
+    double ncells = static_cast<double>(d_effective_fft_size) * static_cast<double>(d_num_doppler_bins);
+    double cell_pfa = -std::expm1(std::log1p(-static_cast<double>(acq_parameters.pfa) / static_cast<double>(max_dwells)) / ncells);
+    double lambda = std::pow(10.0, static_cast<double>(acq_parameters.sequential_cn0_dbhz) / 10.0) * static_cast<double>(acq_parameters.sampled_ms) / 1000.0;
+    d_sequential_upper.resize(max_dwells);
+    d_sequential_lower.resize(max_dwells);
+    for (uint32_t k = 1; k <= max_dwells; k++)
+        {
+            boost::math::gamma_distribution<double> noise(static_cast<double>(k), 1.0);
+            boost::math::non_central_chi_squared_distribution<double> signal(2.0 * k, 2.0 * k * lambda);
+            d_sequential_upper[k - 1] = static_cast<float>(boost::math::quantile(boost::math::complement(noise, cell_pfa)));
+            d_sequential_lower[k - 1] = std::min(d_sequential_upper[k - 1], static_cast<float>(boost::math::quantile(signal, static_cast<double>(acq_parameters.sequential_pmiss)) / 2.0));
         }
+    d_sequential_lower[max_dwells - 1] = d_sequential_upper[max_dwells - 1];
 }
 
 
 void pcps_acquisition::update_grid_doppler_wipeoffs()
 {
+    if (d_pmf_blocks > 0)
+        {
+            // A single wipeoff moves the center of the Doppler FFT, if needed
+            d_pmf_shift = (d_old_freq + d_pmf_center) != 0;
+            if (d_pmf_shift)
+                {
+                    update_local_carrier(d_pmf_carrier, d_consumed_samples, static_cast<float>(d_old_freq + d_pmf_center));
+                }
+            return;
+        }
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
-            int32_t doppler = -static_cast<int32_t>(acq_parameters.doppler_max) + d_doppler_step * doppler_index;
-            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], d_fft_size, d_old_freq + doppler);
+            int32_t doppler = d_doppler_grid_min + static_cast<int32_t>(d_doppler_step * doppler_index);
+            if (!d_cshort)
+                {
+                    // The 16-bit path rotates the samples on the fly
+                    update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], d_fft_size, d_old_freq + doppler);
+                }
+            if (d_decimation_factor > 1)
+                {
+                    // Scaling the frequency by the decimation factor yields the carrier at the decimated rate
+                    update_local_carrier(d_coarse_grid_doppler_wipeoffs[doppler_index], d_coarse_fft_size, static_cast<float>(doppler * static_cast<int32_t>(d_decimation_factor)));
+                }
         }
 }
 
 
+void pcps_acquisition::set_doppler_window(int32_t doppler_center, uint32_t doppler_window)
+{
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    d_doppler_center = doppler_center;
+    d_doppler_window = doppler_window;
+    if (d_num_doppler_bins_max > 0)
+        {
+            update_doppler_grid();
+            update_grid_doppler_wipeoffs();
+        }
+}
+
+
+float pcps_acquisition::step_two_doppler(uint32_t doppler_index) const
+{
+    return (static_cast<float>(doppler_index) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * acq_parameters.doppler_step2;
+}
+
+
 void pcps_acquisition::update_grid_doppler_wipeoffs_step2()
 {
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
         {
-            float doppler = (static_cast<float>(doppler_index) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * acq_parameters.doppler_step2;
-            update_local_carrier(d_grid_doppler_wipeoffs_step_two[doppler_index], d_fft_size, d_doppler_center_step_two + doppler);
+            if (!d_cshort)
+                {
+                    update_local_carrier(d_grid_doppler_wipeoffs_step_two[doppler_index], d_fft_size, d_doppler_center_step_two + step_two_doppler(doppler_index));
+                }
         }
 }
 
@@ -459,132 +897,74 @@ void pcps_acquisition::send_negative_acquisition()
 }
 
 
-void pcps_acquisition::dump_results(int32_t effective_fft_size)
+void pcps_acquisition::dump_results()
 {
     d_dump_number++;
-    std::string filename = d_dump_filename;
-    filename.append("_");
-    filename.append(1, d_gnss_synchro->System);
-    filename.append("_");
-    filename.append(1, d_gnss_synchro->Signal[0]);
-    filename.append(1, d_gnss_synchro->Signal[1]);
-    filename.append("_ch_");
-    filename.append(std::to_string(d_channel));
-    filename.append("_");
-    filename.append(std::to_string(d_dump_number));
-    filename.append("_sat_");
-    filename.append(std::to_string(d_gnss_synchro->PRN));
-    filename.append(".mat");
-
-    mat_t* matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
-    if (matfp == nullptr)
-        {
-            std::cout << "Unable to create or open Acquisition dump file" << std::endl;
-            //acq_parameters.dump = false;
-        }
-    else
+    Acquisition_Dump_Record record;
+    record.basename = d_dump_filename;
+    record.basename.append("_");
+    record.basename.append(1, d_gnss_synchro->System);
+    record.basename.append("_");
+    record.basename.append(1, d_gnss_synchro->Signal[0]);
+    record.basename.append(1, d_gnss_synchro->Signal[1]);
+    record.basename.append("_ch_");
+    record.basename.append(std::to_string(d_channel));
+    record.basename.append("_");
+    record.basename.append(std::to_string(d_dump_number));
+    record.basename.append("_sat_");
+    record.basename.append(std::to_string(d_gnss_synchro->PRN));
+
+    // The grids are lent to the record, so that they are only copied into the writer
+    record.grid = std::move(grid_);
+    record.doppler_max = acq_parameters.doppler_max;
+    record.doppler_step = (d_pmf_blocks > 0 ? static_cast<uint32_t>(std::round(d_pmf_bin_hz)) : d_doppler_step);
+    record.positive_acq = d_positive_acq;
+    record.acq_doppler_hz = static_cast<float>(d_gnss_synchro->Acq_doppler_hz);
+    record.acq_delay_samples = static_cast<float>(d_gnss_synchro->Acq_delay_samples);
+    record.test_statistic = d_test_statistics;
+    record.threshold = d_threshold;
+    record.input_power = d_input_power;
+    record.sample_counter = d_sample_counter;
+    record.PRN = d_gnss_synchro->PRN;
+    record.num_dwells = d_num_noncoherent_integrations_counter;
+    record.two_steps = acq_parameters.make_2_steps;
+    if (acq_parameters.make_2_steps)
         {
-            size_t dims[2] = {static_cast<size_t>(effective_fft_size), static_cast<size_t>(d_num_doppler_bins)};
-            matvar_t* matvar = Mat_VarCreate("acq_grid", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, grid_.memptr(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            dims[0] = static_cast<size_t>(1);
-            dims[1] = static_cast<size_t>(1);
-            matvar = Mat_VarCreate("doppler_max", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &acq_parameters.doppler_max, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("doppler_step", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &d_doppler_step, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("d_positive_acq", MAT_C_INT32, MAT_T_INT32, 1, dims, &d_positive_acq, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            auto aux = static_cast<float>(d_gnss_synchro->Acq_doppler_hz);
-            matvar = Mat_VarCreate("acq_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &aux, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            aux = static_cast<float>(d_gnss_synchro->Acq_delay_samples);
-            matvar = Mat_VarCreate("acq_delay_samples", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &aux, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("test_statistic", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &d_test_statistics, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("threshold", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &d_threshold, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("input_power", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &d_input_power, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("sample_counter", MAT_C_UINT64, MAT_T_UINT64, 1, dims, &d_sample_counter, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &d_gnss_synchro->PRN, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("num_dwells", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &d_num_noncoherent_integrations_counter, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            if (acq_parameters.make_2_steps)
-                {
-                    dims[0] = static_cast<size_t>(effective_fft_size);
-                    dims[1] = static_cast<size_t>(d_num_doppler_bins_step2);
-                    matvar = Mat_VarCreate("acq_grid_narrow", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, narrow_grid_.memptr(), 0);
-                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-                    Mat_VarFree(matvar);
-
-                    dims[0] = static_cast<size_t>(1);
-                    dims[1] = static_cast<size_t>(1);
-                    matvar = Mat_VarCreate("doppler_step_narrow", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &acq_parameters.doppler_step2, 0);
-                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-                    Mat_VarFree(matvar);
-
-                    aux = d_doppler_center_step_two - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0)) * acq_parameters.doppler_step2;
-                    matvar = Mat_VarCreate("doppler_grid_narrow_min", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &aux, 0);
-                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-                    Mat_VarFree(matvar);
-                }
+            record.narrow_grid = std::move(narrow_grid_);
+            record.doppler_step_narrow = acq_parameters.doppler_step2;
+            record.doppler_grid_narrow_min = d_doppler_center_step_two - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0)) * acq_parameters.doppler_step2;
+        }
 
-            Mat_Close(matfp);
+    // Never blocks: if the writer is behind, this dump is dropped
+    d_dump_writer->push(record);
+    grid_ = std::move(record.grid);
+    if (acq_parameters.make_2_steps)
+        {
+            narrow_grid_ = std::move(record.narrow_grid);
         }
 }
 
 
-float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, float input_power, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step)
+float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, float input_power, uint32_t num_doppler_bins, int32_t doppler_min, int32_t doppler_step, float fft_normalization_factor)
 {
     float grid_maximum = 0.0;
     uint32_t index_doppler = 0U;
-    uint32_t tmp_intex_t = 0U;
     uint32_t index_time = 0U;
-    float fft_normalization_factor = static_cast<float>(d_fft_size) * static_cast<float>(d_fft_size);
 
     // Find the correlation peak and the carrier frequency
     for (uint32_t i = 0; i < num_doppler_bins; i++)
         {
-            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i], d_fft_size);
-            if (d_magnitude_grid[i][tmp_intex_t] > grid_maximum)
+            if (d_grid_row_max[i] > grid_maximum)
                 {
-                    grid_maximum = d_magnitude_grid[i][tmp_intex_t];
+                    grid_maximum = d_grid_row_max[i];
                     index_doppler = i;
-                    index_time = tmp_intex_t;
+                    index_time = d_grid_row_max_index[i];
                 }
         }
     indext = index_time;
     if (!d_step_two)
         {
-            doppler = -static_cast<int32_t>(doppler_max) + doppler_step * static_cast<int32_t>(index_doppler);
+            doppler = doppler_min + doppler_step * static_cast<int32_t>(index_doppler);
         }
     else
         {
@@ -596,7 +976,74 @@ float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t&
 }
 
 
-float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step)
+void pcps_acquisition::accumulate_grid_row(uint32_t row, const gr_complex* correlation, uint32_t num_points)
+{
+    // Squared magnitude, non-coherent accumulation and row maximum in a single pass
+    int accumulate = (d_num_noncoherent_integrations_counter > 1 ? 1 : 0);
+    if (d_compact_grid)
+        {
+            // Accumulate in floating point, then store the row scaled to the
+            // 16-bit range of its maximum. The row maximum is kept exact.
+            if (accumulate)
+                {
+                    volk_16i_s32f_convert_32f(d_tmp_buffer, d_magnitude_grid_16i[row], d_grid_row_scale[row], num_points);
+                }
+            volk_gnsssdr_32fc_mag_squared_accumulate_max_32f(d_tmp_buffer, &d_grid_row_max_index[row], &d_grid_row_max[row], correlation, accumulate, num_points);
+            d_grid_row_scale[row] = (d_grid_row_max[row] > 0.0 ? 32767.0F / d_grid_row_max[row] : 1.0F);
+            volk_32f_s32f_convert_16i(d_magnitude_grid_16i[row], d_tmp_buffer, d_grid_row_scale[row], num_points);
+            return;
+        }
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f(d_magnitude_grid[row], &d_grid_row_max_index[row], &d_grid_row_max[row], correlation, accumulate, num_points);
+}
+
+
+void pcps_acquisition::load_grid_row(uint32_t row, float* out, uint32_t num_points) const
+{
+    if (d_compact_grid)
+        {
+            volk_16i_s32f_convert_32f(out, d_magnitude_grid_16i[row], d_grid_row_scale[row], num_points);
+        }
+    else
+        {
+            memcpy(out, d_magnitude_grid[row], sizeof(float) * num_points);
+        }
+}
+
+
+float pcps_acquisition::grid_cell(uint32_t row, uint32_t index) const
+{
+    if (d_compact_grid)
+        {
+            return static_cast<float>(d_magnitude_grid_16i[row][index]) / d_grid_row_scale[row];
+        }
+    return d_magnitude_grid[row][index];
+}
+
+
+void pcps_acquisition::reset_grid(uint32_t num_rows)
+{
+    for (uint32_t i = 0; i < num_rows; i++)
+        {
+            if (d_compact_grid)
+                {
+                    std::fill_n(d_magnitude_grid_16i[i], d_fft_size, 0);
+                }
+            else
+                {
+                    std::fill_n(d_magnitude_grid[i], d_fft_size, 0.0);
+                }
+        }
+}
+
+
+void pcps_acquisition::find_grid_row_maximum(uint32_t row, uint32_t num_points)
+{
+    volk_gnsssdr_32f_index_max_32u(&d_grid_row_max_index[row], d_magnitude_grid[row], num_points);
+    d_grid_row_max[row] = d_magnitude_grid[row][d_grid_row_max_index[row]];
+}
+
+
+float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_min, int32_t doppler_step, uint32_t fft_size, uint32_t samples_per_chip)
 {
     // Look for correlation peaks in the results
     // Find the highest peak and compare it to the second highest peak
@@ -610,19 +1057,18 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
     // Find the correlation peak and the carrier frequency
     for (uint32_t i = 0; i < num_doppler_bins; i++)
         {
-            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i], d_fft_size);
-            if (d_magnitude_grid[i][tmp_intex_t] > firstPeak)
+            if (d_grid_row_max[i] > firstPeak)
                 {
-                    firstPeak = d_magnitude_grid[i][tmp_intex_t];
+                    firstPeak = d_grid_row_max[i];
                     index_doppler = i;
-                    index_time = tmp_intex_t;
+                    index_time = d_grid_row_max_index[i];
                 }
         }
     indext = index_time;
 
     if (!d_step_two)
         {
-            doppler = -static_cast<int32_t>(doppler_max) + doppler_step * static_cast<int32_t>(index_doppler);
+            doppler = doppler_min + doppler_step * static_cast<int32_t>(index_doppler);
         }
     else
         {
@@ -630,26 +1076,26 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
         }
 
     // Find 1 chip wide code phase exclude range around the peak
-    int32_t excludeRangeIndex1 = index_time - d_samplesPerChip;
-    int32_t excludeRangeIndex2 = index_time + d_samplesPerChip;
+    int32_t excludeRangeIndex1 = index_time - samples_per_chip;
+    int32_t excludeRangeIndex2 = index_time + samples_per_chip;
 
     // Correct code phase exclude range if the range includes array boundaries
     if (excludeRangeIndex1 < 0)
         {
-            excludeRangeIndex1 = d_fft_size + excludeRangeIndex1;
+            excludeRangeIndex1 = fft_size + excludeRangeIndex1;
         }
-    else if (excludeRangeIndex2 >= static_cast<int32_t>(d_fft_size))
+    else if (excludeRangeIndex2 >= static_cast<int32_t>(fft_size))
         {
-            excludeRangeIndex2 = excludeRangeIndex2 - d_fft_size;
+            excludeRangeIndex2 = excludeRangeIndex2 - fft_size;
         }
 
     int32_t idx = excludeRangeIndex1;
-    memcpy(d_tmp_buffer, d_magnitude_grid[index_doppler], d_fft_size);
+    load_grid_row(index_doppler, d_tmp_buffer, fft_size);
     do
         {
             d_tmp_buffer[idx] = 0.0;
             idx++;
-            if (idx == static_cast<int32_t>(d_fft_size))
+            if (idx == static_cast<int32_t>(fft_size))
                 {
                     idx = 0;
                 }
@@ -657,7 +1103,7 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
     while (idx != excludeRangeIndex2);
 
     // Find the second highest correlation peak in the same freq. bin ---
-    volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_tmp_buffer, d_fft_size);
+    volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_tmp_buffer, fft_size);
     float secondPeak = d_tmp_buffer[tmp_intex_t];
 
     // Compute the test statistics and compare to the threshold
@@ -665,6 +1111,252 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
 }
 
 
+void pcps_acquisition::coarse_search(uint32_t& indext, int32_t& doppler, uint64_t samp_count)
+{
+    if (d_old_freq != 0)
+        {
+            volk_32fc_x2_multiply_32fc(d_input_signal, d_input_signal, d_if_wipeoff, d_fft_size);
+        }
+    boxcar_decimate(d_coarse_input_signal, d_input_signal);
+
+    if (d_use_CFAR_algorithm_flag)
+        {
+            gr_complex power;
+            volk_32fc_x2_conjugate_dot_prod_32fc(&power, d_coarse_input_signal, d_coarse_input_signal, d_coarse_fft_size);
+            d_input_power = power.real() / static_cast<float>(d_coarse_fft_size);
+        }
+
+    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+        {
+            volk_32fc_x2_multiply_32fc(d_coarse_fft_if->get_inbuf(), d_coarse_input_signal, d_coarse_grid_doppler_wipeoffs[doppler_index], d_coarse_fft_size);
+            d_coarse_fft_if->execute();
+            volk_32fc_x2_multiply_32fc(d_coarse_ifft->get_inbuf(), d_coarse_fft_if->get_outbuf(), d_coarse_fft_codes, d_coarse_fft_size);
+            d_coarse_ifft->execute();
+            accumulate_grid_row(doppler_index, d_coarse_ifft->get_outbuf(), d_coarse_fft_size);
+            if (d_dump and d_channel == d_dump_channel)
+                {
+                    memcpy(grid_.colptr(doppler_index), d_magnitude_grid[doppler_index], sizeof(float) * d_coarse_fft_size);
+                }
+        }
+
+    if (d_use_CFAR_algorithm_flag)
+        {
+            // For white input noise, decimating by D scales this statistic by D both
+            // with and without signal, so it is scaled back to use the same threshold
+            d_test_statistics = max_to_input_power_statistic(indext, doppler, d_input_power, d_num_doppler_bins, d_doppler_grid_min, d_doppler_step, static_cast<float>(d_coarse_fft_size) * static_cast<float>(d_coarse_fft_size));
+            d_test_statistics /= static_cast<float>(d_decimation_factor);
+        }
+    else
+        {
+            uint32_t samples_per_chip = std::max(d_samplesPerChip / d_decimation_factor, 1U);
+            d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins, d_doppler_grid_min, d_doppler_step, d_coarse_fft_size, samples_per_chip);
+        }
+    d_coarse_test_statistics = d_test_statistics;
+    d_coarse_code_phase = indext * d_decimation_factor;
+    d_coarse_sample_stamp = samp_count;
+    indext = d_coarse_code_phase;
+
+    d_gnss_synchro->Acq_delay_samples = static_cast<double>(d_coarse_code_phase);
+    d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
+    d_gnss_synchro->Acq_samplestamp_samples = samp_count;
+}
+
+
+void pcps_acquisition::pmf_fft_search(uint32_t& indext, uint64_t samp_count)
+{
+    if (d_pmf_shift)
+        {
+            volk_32fc_x2_multiply_32fc(d_input_signal, d_input_signal, d_pmf_carrier, d_consumed_samples);
+        }
+
+    // Partial correlations: block p only overlaps the code samples
+    // [(p * M) mod N, (p * M) mod N + M), so its circular correlation with the
+    // code at all the N code phases is an FFT of N points with M nonzero inputs.
+    gr_complex* block_in = d_pmf_fft_if->get_inbuf();
+    std::fill_n(block_in, d_pmf_code_samples, gr_complex(0.0, 0.0));
+    for (uint32_t p = 0; p < d_pmf_blocks; p++)
+        {
+            uint32_t offset = (p * d_pmf_block_size) % d_pmf_code_samples;
+            memcpy(block_in + offset, d_input_signal + p * d_pmf_block_size, sizeof(gr_complex) * d_pmf_block_size);
+            d_pmf_fft_if->execute();
+            volk_32fc_x2_multiply_32fc(d_pmf_ifft->get_inbuf(), d_pmf_fft_if->get_outbuf(), d_pmf_fft_codes, d_pmf_code_samples);
+            d_pmf_ifft->execute();
+            memcpy(d_pmf_partial[p], d_pmf_ifft->get_outbuf(), sizeof(gr_complex) * d_pmf_code_samples);
+            std::fill_n(block_in + offset, d_pmf_block_size, gr_complex(0.0, 0.0));
+        }
+
+    // Doppler FFT across the partial correlations at each code phase. The bins
+    // are stored from the most negative frequency up, as the PCPS grid.
+    gr_complex* doppler_in = d_pmf_doppler_fft->get_inbuf();
+    std::fill_n(doppler_in, d_pmf_fft_size, gr_complex(0.0, 0.0));
+    const uint32_t half_size = d_pmf_fft_size / 2;
+    for (uint32_t tau = 0; tau < d_pmf_code_samples; tau++)
+        {
+            for (uint32_t p = 0; p < d_pmf_blocks; p++)
+                {
+                    doppler_in[p] = d_pmf_partial[p][tau];
+                }
+            d_pmf_doppler_fft->execute();
+            volk_32fc_magnitude_squared_32f(d_pmf_magnitude, d_pmf_doppler_fft->get_outbuf(), d_pmf_fft_size);
+            for (uint32_t k = 0; k < d_pmf_fft_size; k++)
+                {
+                    uint32_t row = (k + half_size) % d_pmf_fft_size;
+                    if (d_num_noncoherent_integrations_counter == 1)
+                        {
+                            d_magnitude_grid[row][tau] = d_pmf_magnitude[k];
+                        }
+                    else
+                        {
+                            d_magnitude_grid[row][tau] += d_pmf_magnitude[k];
+                        }
+                }
+        }
+    for (uint32_t row = 0; row < d_pmf_fft_size; row++)
+        {
+            find_grid_row_maximum(row, d_pmf_code_samples);
+        }
+    if (d_dump and d_channel == d_dump_channel)
+        {
+            for (uint32_t row = 0; row < d_pmf_fft_size; row++)
+                {
+                    memcpy(grid_.colptr(row), d_magnitude_grid[row], sizeof(float) * d_pmf_code_samples);
+                }
+        }
+
+    // The statistics are computed on bin indexes, converted to Hz afterwards.
+    // The grid holds N^2 |r|^2 (N = code samples), hence the normalization.
+    int32_t bin = 0;
+    if (d_use_CFAR_algorithm_flag)
+        {
+            d_test_statistics = max_to_input_power_statistic(indext, bin, d_input_power, d_pmf_fft_size, 0, 1, static_cast<float>(d_pmf_code_samples) * static_cast<float>(d_nominal_fft_size));
+        }
+    else
+        {
+            d_test_statistics = first_vs_second_peak_statistic(indext, bin, d_pmf_fft_size, 0, 1, d_pmf_code_samples, d_samplesPerChip);
+        }
+    double doppler = static_cast<double>(d_pmf_center) + static_cast<double>(bin - static_cast<int32_t>(half_size)) * static_cast<double>(d_pmf_bin_hz);
+
+    if (acq_parameters.use_automatic_resampler)
+        {
+            //take into account the acquisition resampler ratio
+            d_gnss_synchro->Acq_delay_samples = static_cast<double>(indext) * acq_parameters.resampler_ratio;
+            d_gnss_synchro->Acq_delay_samples -= static_cast<double>(acq_parameters.resampler_latency_samples);  //account the resampler filter latency
+            d_gnss_synchro->Acq_doppler_hz = doppler;
+            d_gnss_synchro->Acq_samplestamp_samples = rint(static_cast<double>(samp_count) * acq_parameters.resampler_ratio);
+        }
+    else
+        {
+            d_gnss_synchro->Acq_delay_samples = static_cast<double>(indext);
+            d_gnss_synchro->Acq_doppler_hz = doppler;
+            d_gnss_synchro->Acq_samplestamp_samples = samp_count;
+        }
+}
+
+
+void pcps_acquisition::fine_code_phase_search(const gr_complex* wiped_signal, float* magnitude)
+{
+    // Direct evaluation of the circular correlation
+    // r[tau] = sum_n x[(n + tau) mod N] * conj(c[n]) at the code phases around the
+    // coarse estimate, scaled as the FFT path (N^2 |r|^2) so that the statistics
+    // are not affected. The window spans the coarse resolution with some margin.
+    if (d_num_noncoherent_integrations_counter == 1)
+        {
+            std::fill_n(magnitude, d_fft_size, 0.0);
+        }
+    const auto n = static_cast<int32_t>(d_fft_size);
+    const int32_t window = std::min(static_cast<int32_t>(2 * d_decimation_factor), (n - 1) / 2);
+    const float scale = static_cast<float>(d_fft_size) * static_cast<float>(d_fft_size);
+    for (int32_t k = -window; k <= window; k++)
+        {
+            int32_t tau = (static_cast<int32_t>(d_fine_window_center) + k + n) % n;
+            gr_complex corr(0.0, 0.0);
+            volk_32fc_x2_conjugate_dot_prod_32fc(&corr, wiped_signal + tau, d_local_code, n - tau);
+            if (tau > 0)
+                {
+                    gr_complex corr_wrap(0.0, 0.0);
+                    volk_32fc_x2_conjugate_dot_prod_32fc(&corr_wrap, wiped_signal, d_local_code + n - tau, tau);
+                    corr += corr_wrap;
+                }
+            magnitude[tau] += scale * std::norm(corr);
+        }
+}
+
+
+void pcps_acquisition::interpolate_grid_peak(uint32_t indext, int32_t doppler, double& code_phase, double& doppler_hz) const
+{
+    // Parabolic fit of the correlation amplitude across the neighbouring
+    // Doppler bins, and triangle fit of the correlation peak across the
+    // neighbouring code phases. The edges of the Doppler grid are not refined.
+    auto row = static_cast<uint32_t>((doppler - d_doppler_grid_min) / static_cast<int32_t>(d_doppler_step));
+    uint32_t size = d_effective_fft_size;
+    float a0 = std::sqrt(grid_cell(row, indext));
+    float a_minus = std::sqrt(grid_cell(row, (indext + size - 1) % size));
+    float a_plus = std::sqrt(grid_cell(row, (indext + 1) % size));
+    float a_floor = std::min(a_minus, a_plus);
+    if (a0 > a_floor)
+        {
+            code_phase += static_cast<double>((a_plus - a_minus) / (2.0F * (a0 - a_floor)));
+        }
+    if (row > 0 and row + 1 < d_num_doppler_bins)
+        {
+            a_minus = std::sqrt(grid_cell(row - 1, indext));
+            a_plus = std::sqrt(grid_cell(row + 1, indext));
+            float curvature = a_minus - 2.0F * a0 + a_plus;
+            if (curvature < 0.0F)
+                {
+                    float delta = std::max(-0.5F, std::min(0.5F, 0.5F * (a_minus - a_plus) / curvature));
+                    doppler_hz += static_cast<double>(delta * static_cast<float>(d_doppler_step));
+                }
+        }
+}
+
+
+void pcps_acquisition::prompt_fft_refinement(const gr_complex* in, double code_phase, double& doppler_hz)
+{
+    // Prompt correlation of each block of the dwell with the replica aligned
+    // to the acquired code phase. The phase rotation between blocks is the
+    // residual Doppler, found as the peak of their zero-padded FFT.
+    auto samples_per_code = static_cast<uint32_t>(std::round(acq_parameters.samples_per_code));
+    uint32_t delay = static_cast<uint32_t>(std::round(code_phase)) % samples_per_code;
+    for (uint32_t n = 0; n < d_consumed_samples; n++)
+        {
+            d_prompt_code[n] = d_local_code[(n + samples_per_code - delay) % samples_per_code];
+        }
+    update_local_carrier(d_prompt_signal, d_consumed_samples, static_cast<float>(d_old_freq + doppler_hz));
+    volk_32fc_x2_multiply_32fc(d_prompt_signal, in, d_prompt_signal, d_consumed_samples);
+
+    uint32_t block_samples = d_consumed_samples / d_prompt_fft_blocks;
+    uint32_t prompt_fft_size = 8 * d_prompt_fft_blocks;
+    gr_complex* prompt = d_prompt_fft->get_inbuf();
+    std::fill_n(prompt, prompt_fft_size, gr_complex(0.0, 0.0));
+    for (uint32_t k = 0; k < d_prompt_fft_blocks; k++)
+        {
+            volk_32fc_x2_conjugate_dot_prod_32fc(&prompt[k], d_prompt_signal + k * block_samples, d_prompt_code + k * block_samples, block_samples);
+        }
+    d_prompt_fft->execute();
+    volk_32fc_magnitude_squared_32f(d_prompt_magnitude, d_prompt_fft->get_outbuf(), prompt_fft_size);
+    uint32_t peak;
+    volk_gnsssdr_32f_index_max_32u(&peak, d_prompt_magnitude, prompt_fft_size);
+
+    float a0 = std::sqrt(d_prompt_magnitude[peak]);
+    float a_minus = std::sqrt(d_prompt_magnitude[(peak + prompt_fft_size - 1) % prompt_fft_size]);
+    float a_plus = std::sqrt(d_prompt_magnitude[(peak + 1) % prompt_fft_size]);
+    float curvature = a_minus - 2.0F * a0 + a_plus;
+    double bin = (peak < prompt_fft_size / 2 ? static_cast<double>(peak) : static_cast<double>(peak) - static_cast<double>(prompt_fft_size));
+    if (curvature < 0.0F)
+        {
+            bin += static_cast<double>(0.5F * (a_minus - a_plus) / curvature);
+        }
+    double fs = (acq_parameters.use_automatic_resampler ? static_cast<double>(acq_parameters.resampled_fs) : static_cast<double>(acq_parameters.fs_in));
+    double residual_hz = bin * fs / (static_cast<double>(block_samples) * static_cast<double>(prompt_fft_size));
+    // A residual beyond the grid step means the prompt was dominated by noise
+    if (std::abs(residual_hz) <= static_cast<double>(d_doppler_step))
+        {
+            doppler_hz += residual_hz;
+        }
+}
+
+
 void pcps_acquisition::acquisition_core(uint64_t samp_count)
 {
     gr::thread::scoped_lock lk(d_setlock);
@@ -672,17 +1364,26 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     // Initialize acquisition algorithm
     int32_t doppler = 0;
     uint32_t indext = 0U;
-    int32_t effective_fft_size = (acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
-    if (d_cshort)
-        {
-            volk_gnsssdr_16ic_convert_32fc(d_data_buffer, d_data_buffer_sc, d_consumed_samples);
-        }
-    memcpy(d_input_signal, d_data_buffer, d_consumed_samples * sizeof(gr_complex));
-    if (d_fft_size > d_consumed_samples)
+    int32_t effective_fft_size = d_effective_fft_size;
+    bool estimate_power = (d_use_CFAR_algorithm_flag or acq_parameters.bit_transition_flag) and (d_step_two or d_decimation_factor == 1);
+    bool coarse_step = !d_step_two and d_decimation_factor > 1;
+    bool pmf_step = !d_step_two and d_pmf_blocks > 0;
+    bool prompt_step = !d_step_two and d_prompt_fft_blocks > 1;
+    // 16-bit samples are converted only for the power estimation, the
+    // coarse step and the prompt refinement. The Doppler wipeoff reads them directly.
+    if (!d_cshort or estimate_power or coarse_step or pmf_step or prompt_step)
         {
-            for (uint32_t i = d_consumed_samples; i < d_fft_size; i++)
+            if (d_cshort)
+                {
+                    volk_gnsssdr_16ic_convert_32fc(d_data_buffer, d_data_buffer_sc, d_consumed_samples);
+                }
+            memcpy(d_input_signal, d_data_buffer, d_consumed_samples * sizeof(gr_complex));
+            if (d_fft_size > d_consumed_samples)
                 {
-                    d_input_signal[i] = gr_complex(0.0, 0.0);
+                    for (uint32_t i = d_consumed_samples; i < d_fft_size; i++)
+                        {
+                            d_input_signal[i] = gr_complex(0.0, 0.0);
+                        }
                 }
         }
     const gr_complex* in = d_input_signal;  // Get the input samples pointer
@@ -700,21 +1401,29 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
 
     lk.unlock();
 
-    if (d_use_CFAR_algorithm_flag or acq_parameters.bit_transition_flag)
+    if (estimate_power)
         {
             // Compute the input signal power estimation
-            volk_32fc_magnitude_squared_32f(d_tmp_buffer, in, d_fft_size);
-            volk_32f_accumulator_s32f(&d_input_power, d_tmp_buffer, d_fft_size);
-            d_input_power /= static_cast<float>(d_fft_size);
+            gr_complex power;
+            volk_32fc_x2_conjugate_dot_prod_32fc(&power, in, in, d_fft_size);
+            d_input_power = power.real() / static_cast<float>(d_nominal_fft_size);
         }
 
     // Doppler frequency grid loop
-    if (!d_step_two)
+    if (coarse_step)
+        {
+            coarse_search(indext, doppler, samp_count);
+        }
+    else if (pmf_step)
+        {
+            pmf_fft_search(indext, samp_count);
+        }
+    else if (!d_step_two)
         {
             for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
                 {
                     // Remove Doppler
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index], d_fft_size);
+                    wipe_off_doppler(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_old_freq + d_doppler_grid_min + static_cast<int32_t>(d_doppler_step * doppler_index)));
 
                     // Perform the FFT-based convolution  (parallel time search)
                     // Compute the FFT of the carrier wiped--off incoming signal
@@ -728,87 +1437,108 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
 
                     // Compute squared magnitude (and accumulate in case of non-coherent integration)
                     size_t offset = (acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index], d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer, d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index], d_magnitude_grid[doppler_index], d_tmp_buffer, effective_fft_size);
-                        }
+                    accumulate_grid_row(doppler_index, d_ifft->get_outbuf() + offset, effective_fft_size);
                     // Record results to file if required
                     if (d_dump and d_channel == d_dump_channel)
                         {
-                            memcpy(grid_.colptr(doppler_index), d_magnitude_grid[doppler_index], sizeof(float) * effective_fft_size);
+                            load_grid_row(doppler_index, grid_.colptr(doppler_index), effective_fft_size);
                         }
                 }
 
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
                 {
-                    d_test_statistics = max_to_input_power_statistic(indext, doppler, d_input_power, d_num_doppler_bins, acq_parameters.doppler_max, d_doppler_step);
+                    d_test_statistics = max_to_input_power_statistic(indext, doppler, d_input_power, d_num_doppler_bins, d_doppler_grid_min, d_doppler_step, static_cast<float>(d_fft_size) * static_cast<float>(d_nominal_fft_size));
                 }
             else
                 {
-                    d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins, acq_parameters.doppler_max, d_doppler_step);
+                    d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins, d_doppler_grid_min, d_doppler_step, effective_fft_size, d_samplesPerChip);
+                }
+            // Refine the peak without recomputing the grid
+            auto code_phase = static_cast<double>(indext);
+            auto doppler_hz = static_cast<double>(doppler);
+            if (acq_parameters.interpolate_peak)
+                {
+                    interpolate_grid_peak(indext, doppler, code_phase, doppler_hz);
+                }
+            if (prompt_step)
+                {
+                    prompt_fft_refinement(in, code_phase, doppler_hz);
+                }
+            code_phase = std::fmod(code_phase, static_cast<double>(acq_parameters.samples_per_code));
+            if (code_phase < 0.0)
+                {
+                    code_phase += static_cast<double>(acq_parameters.samples_per_code);
                 }
             if (acq_parameters.use_automatic_resampler)
                 {
                     //take into account the acquisition resampler ratio
-                    d_gnss_synchro->Acq_delay_samples = static_cast<double>(std::fmod(static_cast<float>(indext), acq_parameters.samples_per_code)) * acq_parameters.resampler_ratio;
+                    d_gnss_synchro->Acq_delay_samples = code_phase * acq_parameters.resampler_ratio;
                     d_gnss_synchro->Acq_delay_samples -= static_cast<double>(acq_parameters.resampler_latency_samples);  //account the resampler filter latency
-                    d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
+                    d_gnss_synchro->Acq_doppler_hz = doppler_hz;
                     d_gnss_synchro->Acq_samplestamp_samples = rint(static_cast<double>(samp_count) * acq_parameters.resampler_ratio);
                 }
             else
                 {
-                    d_gnss_synchro->Acq_delay_samples = static_cast<double>(std::fmod(static_cast<float>(indext), acq_parameters.samples_per_code));
-                    d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
+                    d_gnss_synchro->Acq_delay_samples = code_phase;
+                    d_gnss_synchro->Acq_doppler_hz = doppler_hz;
                     d_gnss_synchro->Acq_samplestamp_samples = samp_count;
                 }
         }
     else
         {
+            if (d_decimation_factor > 1)
+                {
+                    // Carry the coarse code phase over to the samples of this step
+                    int64_t shift = static_cast<int64_t>(d_coarse_sample_stamp) - static_cast<int64_t>(samp_count);
+                    int64_t center = (static_cast<int64_t>(d_coarse_code_phase) + shift) % static_cast<int64_t>(d_fft_size);
+                    d_fine_window_center = static_cast<uint32_t>(center < 0 ? center + d_fft_size : center);
+                }
             for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
                 {
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs_step_two[doppler_index], d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal
-                    // with the local FFT'd code reference using SIMD operations with VOLK library
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes, d_fft_size);
+                    wipe_off_doppler(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs_step_two[doppler_index], d_doppler_center_step_two + step_two_doppler(doppler_index));
 
-                    // compute the inverse FFT
-                    d_ifft->execute();
-
-                    size_t offset = (acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
+                    if (d_decimation_factor > 1)
                         {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index], d_ifft->get_outbuf() + offset, effective_fft_size);
+                            fine_code_phase_search(d_fft_if->get_inbuf(), d_magnitude_grid[doppler_index]);
+                            find_grid_row_maximum(doppler_index, d_fft_size);
                         }
                     else
                         {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer, d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index], d_magnitude_grid[doppler_index], d_tmp_buffer, effective_fft_size);
+                            // Perform the FFT-based convolution  (parallel time search)
+                            // Compute the FFT of the carrier wiped--off incoming signal
+                            d_fft_if->execute();
+
+                            // Multiply carrier wiped--off, Fourier transformed incoming signal
+                            // with the local FFT'd code reference using SIMD operations with VOLK library
+                            volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes, d_fft_size);
+
+                            // compute the inverse FFT
+                            d_ifft->execute();
+
+                            size_t offset = (acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+                            accumulate_grid_row(doppler_index, d_ifft->get_outbuf() + offset, effective_fft_size);
                         }
                     // Record results to file if required
                     if (d_dump and d_channel == d_dump_channel)
                         {
-                            memcpy(narrow_grid_.colptr(doppler_index), d_magnitude_grid[doppler_index], sizeof(float) * effective_fft_size);
+                            load_grid_row(doppler_index, narrow_grid_.colptr(doppler_index), effective_fft_size);
                         }
                 }
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
                 {
-                    d_test_statistics = max_to_input_power_statistic(indext, doppler, d_input_power, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * acq_parameters.doppler_step2), acq_parameters.doppler_step2);
+                    d_test_statistics = max_to_input_power_statistic(indext, doppler, d_input_power, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * acq_parameters.doppler_step2), acq_parameters.doppler_step2, static_cast<float>(d_fft_size) * static_cast<float>(d_nominal_fft_size));
+                }
+            else if (d_decimation_factor > 1)
+                {
+                    // The fine window holds no second peak, so the detection of the coarse step stands
+                    max_to_input_power_statistic(indext, doppler, 1.0, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * acq_parameters.doppler_step2), acq_parameters.doppler_step2, static_cast<float>(d_fft_size) * static_cast<float>(d_nominal_fft_size));
+                    d_test_statistics = d_coarse_test_statistics;
                 }
             else
                 {
-                    d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * acq_parameters.doppler_step2), acq_parameters.doppler_step2);
+                    d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * acq_parameters.doppler_step2), acq_parameters.doppler_step2, effective_fft_size, d_samplesPerChip);
                 }
 
             if (acq_parameters.use_automatic_resampler)
@@ -830,9 +1560,23 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
 
     lk.lock();
+    bool positive = d_test_statistics > d_threshold;
+    bool dismissed = false;
+    if (d_sequential)
+        {
+            // Noise-normalized accumulated grid, see update_sequential_thresholds()
+            float statistic = d_test_statistics * static_cast<float>(d_nominal_fft_size);
+            positive = statistic > d_sequential_upper[d_num_noncoherent_integrations_counter - 1];
+            if (!positive and statistic < d_sequential_lower[d_num_noncoherent_integrations_counter - 1])
+                {
+                    DLOG(INFO) << "Sequential test dismissed " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
+                               << " after " << d_num_noncoherent_integrations_counter << " dwells";
+                    dismissed = true;
+                }
+        }
     if (!acq_parameters.bit_transition_flag)
         {
-            if (d_test_statistics > d_threshold)
+            if (positive)
                 {
                     d_active = false;
                     if (acq_parameters.make_2_steps)
@@ -863,7 +1607,7 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                     d_state = 1;
                 }
 
-            if (d_num_noncoherent_integrations_counter == acq_parameters.max_dwells)
+            if (d_num_noncoherent_integrations_counter == acq_parameters.max_dwells or dismissed)
                 {
                     if (d_state != 0)
                         {
@@ -909,23 +1653,17 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
     d_worker_active = false;
 
-    if ((d_num_noncoherent_integrations_counter == acq_parameters.max_dwells) or (d_positive_acq == 1))
+    if ((d_num_noncoherent_integrations_counter == acq_parameters.max_dwells) or dismissed or (d_positive_acq == 1))
         {
             // Record results to file if required
             if (d_dump and d_channel == d_dump_channel)
                 {
-                    pcps_acquisition::dump_results(effective_fft_size);
+                    pcps_acquisition::dump_results();
                 }
             d_num_noncoherent_integrations_counter = 0U;
             d_positive_acq = 0;
             // Reset grid
-            for (uint32_t i = 0; i < d_num_doppler_bins; i++)
-                {
-                    for (uint32_t k = 0; k < d_fft_size; k++)
-                        {
-                            d_magnitude_grid[i][k] = 0.0;
-                        }
-                }
+            reset_grid(d_num_doppler_bins);
         }
 }
 
@@ -938,6 +1676,17 @@ bool pcps_acquisition::start()
 }
 
 
+bool pcps_acquisition::stop()
+{
+    // Make sure all pending dumps are on disk when the flowgraph stops
+    if (d_dump_writer)
+        {
+            d_dump_writer->flush();
+        }
+    return true;
+}
+
+
 int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
     gr_vector_int& ninput_items,
     gr_vector_const_void_star& input_items,
@@ -960,6 +1709,14 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                 {
                     d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
                     consume_each(ninput_items[0]);
+                    if (!d_active and detail())
+                        {
+                            // Standby: the scheduler only calls a sink when a whole output
+                            // multiple worth of input is available, so idle channels drop
+                            // half an input buffer per call instead of running on every
+                            // write of the source. The sample counter stays exact.
+                            set_output_multiple(std::max(1, detail()->input(0)->max_possible_items_available() / 2));
+                        }
                 }
             if (d_step_two)
                 {
@@ -967,6 +1724,7 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                     update_grid_doppler_wipeoffs_step2();
                     d_state = 0;
                     d_active = true;
+                    set_output_multiple(1);
                 }
             return 0;
         }
@@ -53,16 +53,19 @@
 #define GNSS_SDR_PCPS_ACQUISITION_H_
 
 #include "acq_conf.h"
+#include "acquisition_dump_writer.h"
 #include "channel_fsm.h"
+#include "gnss_sdr_fft.h"
 #include <armadillo>
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>     // for gr_complex
 #include <gnuradio/thread/thread.h>  // for scoped_lock
 #include <gnuradio/types.h>          // for gr_vector_const_void_star
 #include <volk/volk_complex.h>       // for lv_16sc_t
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 class Gnss_Synchro;
 class pcps_acquisition;
@@ -86,7 +89,12 @@ private:
 
     pcps_acquisition(const Acq_Conf& conf_);
 
+    float carrier_phase_step_rad(float freq) const;
     void update_local_carrier(gr_complex* carrier_vector, int32_t correlator_length_samples, float freq);
+    void wipe_off_doppler(gr_complex* out, const gr_complex* in, const gr_complex* carrier_vector, float freq);
+    float step_two_doppler(uint32_t doppler_index) const;
+    void update_doppler_grid();
+    void update_sequential_thresholds();
     void update_grid_doppler_wipeoffs();
     void update_grid_doppler_wipeoffs_step2();
     bool is_fdma();
@@ -97,12 +105,25 @@ private:
 
     void send_positive_acquisition();
 
-    void dump_results(int32_t effective_fft_size);
+    void dump_results();
 
-    float first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
-    float max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, float input_power, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
+    float first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_min, int32_t doppler_step, uint32_t fft_size, uint32_t samples_per_chip);
+    float max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, float input_power, uint32_t num_doppler_bins, int32_t doppler_min, int32_t doppler_step, float fft_normalization_factor);
+    void accumulate_grid_row(uint32_t row, const gr_complex* correlation, uint32_t num_points);
+    void find_grid_row_maximum(uint32_t row, uint32_t num_points);
+    void load_grid_row(uint32_t row, float* out, uint32_t num_points) const;
+    float grid_cell(uint32_t row, uint32_t index) const;
+    void reset_grid(uint32_t num_rows);
+
+    void boxcar_decimate(gr_complex* out, const gr_complex* in) const;
+    void coarse_search(uint32_t& indext, int32_t& doppler, uint64_t samp_count);
+    void fine_code_phase_search(const gr_complex* wiped_signal, float* magnitude);
+    void pmf_fft_search(uint32_t& indext, uint64_t samp_count);
+    void interpolate_grid_peak(uint32_t indext, int32_t doppler, double& code_phase, double& doppler_hz) const;
+    void prompt_fft_refinement(const gr_complex* in, double code_phase, double& doppler_hz);
 
     bool start();
+    bool stop();
 
 
     Acq_Conf acq_parameters;
@@ -118,6 +139,11 @@ private:
     float d_test_statistics;
     float* d_magnitude;
     float** d_magnitude_grid;
+    bool d_compact_grid;
+    int16_t** d_magnitude_grid_16i;      // d_magnitude_grid in compact_grid mode
+    std::vector<float> d_grid_row_scale;  // scale of each row of d_magnitude_grid_16i
+    std::vector<float> d_grid_row_max;           // maximum of each row of d_magnitude_grid
+    std::vector<uint32_t> d_grid_row_max_index;  // and its code phase
     float* d_tmp_buffer;
     gr_complex* d_input_signal;
     uint32_t d_samplesPerChip;
@@ -129,16 +155,23 @@ private:
     float d_doppler_center_step_two;
     uint32_t d_num_noncoherent_integrations_counter;
     uint32_t d_fft_size;
+    uint32_t d_nominal_fft_size;
+    uint32_t d_effective_fft_size;
     uint32_t d_consumed_samples;
     uint32_t d_num_doppler_bins;
+    uint32_t d_num_doppler_bins_max;  // bins of the whole +/- doppler_max range
+    uint32_t d_num_grid_rows;         // rows of d_magnitude_grid
+    int32_t d_doppler_center;
+    uint32_t d_doppler_window;
+    int32_t d_doppler_grid_min;
     uint64_t d_sample_counter;
     gr_complex** d_grid_doppler_wipeoffs;
     gr_complex** d_grid_doppler_wipeoffs_step_two;
     gr_complex* d_fft_codes;
     gr_complex* d_data_buffer;
     lv_16sc_t* d_data_buffer_sc;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft_Complex* d_fft_if;
+    Gnss_Fft_Complex* d_ifft;
     Gnss_Synchro* d_gnss_synchro;
     arma::fmat grid_;
     arma::fmat narrow_grid_;
@@ -148,6 +181,47 @@ private:
     uint32_t d_buffer_count;
     bool d_dump;
     std::string d_dump_filename;
+    std::unique_ptr<Acquisition_Dump_Writer> d_dump_writer;
+
+    // Coarse-to-fine search: the first step runs on a decimated copy of the input
+    uint32_t d_decimation_factor;
+    uint32_t d_coarse_fft_size;
+    uint32_t d_coarse_code_phase;  // code phase found by the coarse step, in input samples
+    uint32_t d_fine_window_center;
+    uint64_t d_coarse_sample_stamp;
+    float d_coarse_test_statistics;
+    gr_complex** d_coarse_grid_doppler_wipeoffs;
+    gr_complex* d_coarse_fft_codes;
+    gr_complex* d_coarse_input_signal;
+    gr_complex* d_if_wipeoff;
+    gr_complex* d_local_code;
+    Gnss_Fft_Complex* d_coarse_fft_if;
+    Gnss_Fft_Complex* d_coarse_ifft;
+
+    // Partial matched filter + FFT search: the Doppler is resolved by an FFT
+    // across the correlations of short blocks of the dwell
+    uint32_t d_pmf_blocks;        // number of blocks, 0 if the search is disabled
+    uint32_t d_pmf_block_size;    // samples per block
+    uint32_t d_pmf_code_samples;  // samples per code period
+    uint32_t d_pmf_fft_size;      // Doppler bins
+    float d_pmf_bin_hz;
+    int32_t d_pmf_center;  // center of the Doppler FFT, relative to d_old_freq
+    bool d_pmf_shift;
+    gr_complex* d_pmf_carrier;
+    gr_complex* d_pmf_fft_codes;
+    gr_complex** d_pmf_partial;
+    float* d_pmf_magnitude;
+    Gnss_Fft_Complex* d_pmf_fft_if;
+    Gnss_Fft_Complex* d_pmf_ifft;
+    Gnss_Fft_Complex* d_pmf_doppler_fft;
+    uint32_t d_prompt_fft_blocks;
+    gr_complex* d_prompt_code;
+    gr_complex* d_prompt_signal;
+    float* d_prompt_magnitude;
+    Gnss_Fft_Complex* d_prompt_fft;
+    bool d_sequential;
+    std::vector<float> d_sequential_upper;
+    std::vector<float> d_sequential_lower;
 
 public:
     ~pcps_acquisition();
@@ -191,6 +265,10 @@ public:
     {
         gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
         d_active = active;
+        if (active)
+            {
+                set_output_multiple(1);  // leave the standby batching
+            }
     }
 
     /*!
@@ -250,6 +328,13 @@ public:
     }
 
 
+    /*!
+      * \brief Restricts the Doppler search to doppler_center +/- doppler_window [Hz],
+      * e.g. around a prediction from the PVT. A zero window restores the
+      * whole +/- doppler_max search.
+      */
+    void set_doppler_window(int32_t doppler_center, uint32_t doppler_window);
+
     void set_resampler_latency(uint32_t latency_samples);
 
     /*!
@@ -131,10 +131,10 @@ pcps_opencl_acquisition_cc::pcps_opencl_acquisition_cc(
     if (d_opencl != 0)
         {
             // Direct FFT
-            d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+            d_fft_if = new Gnss_Fft_Complex(d_fft_size, true);
 
             // Inverse FFT
-            d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+            d_ifft = new Gnss_Fft_Complex(d_fft_size, false);
         }
 
     // For dumping samples into a file
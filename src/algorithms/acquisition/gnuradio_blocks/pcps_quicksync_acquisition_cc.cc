@@ -34,9 +34,12 @@
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <exception>
 #include <sstream>
+#include <thread>
 #include <utility>
 
 
@@ -49,6 +52,7 @@ pcps_quicksync_acquisition_cc_sptr pcps_quicksync_make_acquisition_cc(
     int32_t samples_per_ms,
     int32_t samples_per_code,
     bool bit_transition_flag,
+    bool blocking,
     bool dump,
     std::string dump_filename)
 {
@@ -59,6 +63,7 @@ pcps_quicksync_acquisition_cc_sptr pcps_quicksync_make_acquisition_cc(
             fs_in, samples_per_ms,
             samples_per_code,
             bit_transition_flag,
+            blocking,
             dump, std::move(dump_filename)));
 }
 
@@ -69,6 +74,7 @@ pcps_quicksync_acquisition_cc::pcps_quicksync_acquisition_cc(
     uint32_t doppler_max, int64_t fs_in,
     int32_t samples_per_ms, int32_t samples_per_code,
     bool bit_transition_flag,
+    bool blocking,
     bool dump,
     std::string dump_filename) : gr::block("pcps_quicksync_acquisition_cc",
                                      gr::io_signature::make(1, 1, (sizeof(gr_complex) * sampled_ms * samples_per_ms)),
@@ -90,6 +96,8 @@ pcps_quicksync_acquisition_cc::pcps_quicksync_acquisition_cc(
     d_num_doppler_bins = 0;
     d_bit_transition_flag = bit_transition_flag;
     d_folding_factor = folding_factor;
+    d_blocking = blocking;
+    d_worker_active = false;
 
     //fft size is reduced.
     d_fft_size = (d_samples_per_code) / d_folding_factor;
@@ -99,24 +107,26 @@ pcps_quicksync_acquisition_cc::pcps_quicksync_acquisition_cc(
     d_magnitude_folded = static_cast<float*>(volk_gnsssdr_malloc(d_fft_size * sizeof(float), volk_gnsssdr_get_alignment()));
 
     d_possible_delay = new uint32_t[d_folding_factor];
-    d_corr_output_f = new float[d_folding_factor];
+    d_corr_output_f = new float[d_folding_factor]();
+    d_corr_acumulator = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_folding_factor * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+
+    // Working buffers of a whole dwell, reused by every dwell and Doppler bin
+    d_data_buffer = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_samples_per_code * d_folding_factor * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    d_in_temp = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_samples_per_code * d_folding_factor * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
 
     /*Create the d_code signal , which would store the values of the code in its
     original form to perform later correlation in time domain*/
     d_code = new gr_complex[d_samples_per_code]();
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft_Complex(d_fft_size, true);
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft_Complex(d_fft_size, false);
 
     // For dumping samples into a file
     d_dump = dump;
     d_dump_filename = std::move(dump_filename);
 
-    d_corr_acumulator = nullptr;
-    d_signal_folded = nullptr;
-    d_code_folded = new gr_complex[d_fft_size]();
     d_noise_floor_power = 0;
     d_doppler_resolution = 0;
     d_threshold = 0;
@@ -128,7 +138,6 @@ pcps_quicksync_acquisition_cc::pcps_quicksync_acquisition_cc(
     d_doppler_freq = 0;
     d_test_statistics = 0;
     d_channel = 0;
-    //d_code_folded = 0;
 
     // DLOG(INFO) << "END CONSTRUCTOR";
 }
@@ -149,13 +158,15 @@ pcps_quicksync_acquisition_cc::~pcps_quicksync_acquisition_cc()
     volk_gnsssdr_free(d_fft_codes);
     volk_gnsssdr_free(d_magnitude);
     volk_gnsssdr_free(d_magnitude_folded);
+    volk_gnsssdr_free(d_corr_acumulator);
+    volk_gnsssdr_free(d_data_buffer);
+    volk_gnsssdr_free(d_in_temp);
 
     delete d_ifft;
     delete d_fft_if;
-    delete d_code;
-    delete d_possible_delay;
-    delete d_corr_output_f;
-    delete[] d_code_folded;
+    delete[] d_code;
+    delete[] d_possible_delay;
+    delete[] d_corr_output_f;
 
     try
         {
@@ -175,24 +186,34 @@ pcps_quicksync_acquisition_cc::~pcps_quicksync_acquisition_cc()
 }
 
 
+void pcps_quicksync_acquisition_cc::fold(gr_complex* folded, const gr_complex* in, uint32_t num_segments)
+{
+    /* Accumulate num_segments consecutive blocks of d_fft_size samples. The
+    complex sum is done as a float sum over the interleaved I/Q components, so
+    that VOLK picks the SIMD kernel of the machine*/
+    memcpy(folded, in, sizeof(gr_complex) * d_fft_size);
+    for (uint32_t i = 1; i < num_segments; i++)
+        {
+            volk_32f_x2_add_32f(reinterpret_cast<float*>(folded),
+                reinterpret_cast<const float*>(folded),
+                reinterpret_cast<const float*>(in + i * d_fft_size),
+                2 * d_fft_size);
+        }
+}
+
+
 void pcps_quicksync_acquisition_cc::set_local_code(std::complex<float>* code)
 {
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+
     /*save a local copy of the code without the folding process to perform corre-
     lation in time in the final steps of the acquisition stage*/
     memcpy(d_code, code, sizeof(gr_complex) * d_samples_per_code);
 
-    //d_code_folded = new gr_complex[d_fft_size]();
-    memcpy(d_fft_if->get_inbuf(), d_code_folded, sizeof(gr_complex) * (d_fft_size));
-
     /*perform folding of the code by the factorial factor parameter. Notice that
     folding of the code in the time stage would result in a downsampled spectrum
     in the frequency domain after applying the fftw operation*/
-    for (uint32_t i = 0; i < d_folding_factor; i++)
-        {
-            std::transform((code + i * d_fft_size), (code + ((i + 1) * d_fft_size)),
-                d_fft_if->get_inbuf(), d_fft_if->get_inbuf(),
-                std::plus<gr_complex>());
-        }
+    fold(d_fft_if->get_inbuf(), code, d_folding_factor);
 
     d_fft_if->execute();  // We need the FFT of local code
 
@@ -203,6 +224,7 @@ void pcps_quicksync_acquisition_cc::set_local_code(std::complex<float>* code)
 
 void pcps_quicksync_acquisition_cc::init()
 {
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
     d_gnss_synchro->Flag_valid_acquisition = false;
     d_gnss_synchro->Flag_valid_symbol_output = false;
     d_gnss_synchro->Flag_valid_pseudorange = false;
@@ -221,6 +243,16 @@ void pcps_quicksync_acquisition_cc::init()
             d_doppler_step = 250;
         }
 
+    // Release the wipeoffs of a previous initialization
+    if (d_num_doppler_bins > 0)
+        {
+            for (uint32_t i = 0; i < d_num_doppler_bins; i++)
+                {
+                    volk_gnsssdr_free(d_grid_doppler_wipeoffs[i]);
+                }
+            delete[] d_grid_doppler_wipeoffs;
+        }
+
     // Count the number of bins
     d_num_doppler_bins = 0;
     for (auto doppler = static_cast<int32_t>(-d_doppler_max);
@@ -247,6 +279,7 @@ void pcps_quicksync_acquisition_cc::init()
 
 void pcps_quicksync_acquisition_cc::set_state(int32_t state)
 {
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
     d_state = state;
     if (d_state == 1)
         {
@@ -269,6 +302,209 @@ void pcps_quicksync_acquisition_cc::set_state(int32_t state)
         }
 }
 
+void pcps_quicksync_acquisition_cc::acquisition_core(uint64_t samp_count)
+{
+    gr::thread::scoped_lock lk(d_setlock);
+
+    /* initialize acquisition  implementing the QuickSync algorithm*/
+    int32_t doppler;
+    uint32_t indext = 0;
+    float magt = 0.0;
+    const gr_complex* in = d_data_buffer;  // Get the input samples pointer
+
+    float fft_normalization_factor = static_cast<float>(d_fft_size) * static_cast<float>(d_fft_size);
+
+    // The search works on local copies of the results, published at the end,
+    // so that general_work() can run (and drop dwells) while it is in progress
+    float input_power = 0.0;
+    float mag = 0.0;
+    float test_statistics = 0.0;
+    double delay_samples = d_gnss_synchro->Acq_delay_samples;
+    double doppler_hz = d_gnss_synchro->Acq_doppler_hz;
+    uint64_t samplestamp = d_gnss_synchro->Acq_samplestamp_samples;
+    bool found = false;
+    d_noise_floor_power = 0.0;
+
+    DLOG(INFO) << "Channel: " << d_channel
+               << " , doing acquisition of satellite: "
+               << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
+               << " ,algorithm: pcps_quicksync_acquisition"
+               << " ,folding factor: " << d_folding_factor
+               << " ,sample stamp: " << samp_count << ", threshold: "
+               << d_threshold << ", doppler_max: " << d_doppler_max
+               << ", doppler_step: " << d_doppler_step << ", Signal Size: "
+               << d_samples_per_code * d_folding_factor;
+
+    lk.unlock();
+
+    /* 1- Compute the input signal power estimation. This operation is
+    being performed in a signal of size nxp */
+    volk_32fc_magnitude_squared_32f(d_magnitude, in, d_samples_per_code * d_folding_factor);
+    volk_32f_accumulator_s32f(&input_power, d_magnitude, d_samples_per_code * d_folding_factor);
+    input_power /= static_cast<float>(d_samples_per_code * d_folding_factor);
+
+    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+        {
+            /*Doppler search steps and then multiplication of the incoming
+            signal with the doppler wipeoffs to eliminate frequency offset
+            */
+            doppler = -static_cast<int32_t>(d_doppler_max) + d_doppler_step * doppler_index;
+
+            /*Perform multiplication of the incoming signal with the
+            complex exponential vector. This removes the frequency doppler
+            shift offset*/
+            volk_32fc_x2_multiply_32fc(d_in_temp, in,
+                d_grid_doppler_wipeoffs[doppler_index],
+                d_samples_per_code * d_folding_factor);
+
+            /*Perform folding of the carrier wiped-off incoming signal. Since
+            superlinear method is being used the folding factor in the
+            incoming raw data signal is of d_folding_factor^2*/
+            fold(d_fft_if->get_inbuf(), d_in_temp, d_folding_factor * d_folding_factor);
+
+            /* 3- Perform the FFT-based convolution  (parallel time search)
+            Compute the FFT of the carrier wiped--off incoming signal*/
+            d_fft_if->execute();
+
+            /*Multiply carrier wiped--off, Fourier transformed incoming
+            signal with the local FFT'd code reference using SIMD
+            operations with VOLK library*/
+            volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
+                d_fft_if->get_outbuf(), d_fft_codes, d_fft_size);
+
+            /* compute the inverse FFT of the aliased signal*/
+            d_ifft->execute();
+
+            /* Compute the magnitude and get the maximum value with its
+            index position*/
+            volk_32fc_magnitude_squared_32f(d_magnitude_folded,
+                d_ifft->get_outbuf(), d_fft_size);
+
+            /* Normalize the maximum value to correct the scale factor
+            introduced by FFTW*/
+            volk_gnsssdr_32f_index_max_32u(&indext, d_magnitude_folded, d_fft_size);
+
+            magt = d_magnitude_folded[indext] / (fft_normalization_factor * fft_normalization_factor);
+
+            // 4- record the maximum peak and the associated synchronization parameters
+            if (mag < magt)
+                {
+                    mag = magt;
+
+                    /* In case that d_bit_transition_flag = true, we compare the potentially
+                    new maximum test statistics (d_mag/d_input_power) with the value in
+                    d_test_statistics. When the second dwell is being processed, the value
+                    of d_mag/d_input_power could be lower than d_test_statistics (i.e,
+                    the maximum test statistics in the previous dwell is greater than
+                    current d_mag/d_input_power). Note that d_test_statistics is not
+                    restarted between consecutive dwells in multidwell operation.*/
+                    if (test_statistics < (mag / input_power) || !d_bit_transition_flag)
+                        {
+                            uint32_t detected_delay_samples_folded = 0;
+                            detected_delay_samples_folded = (indext % d_samples_per_code);
+
+                            for (uint32_t i = 0; i < d_folding_factor; i++)
+                                {
+                                    d_possible_delay[i] = detected_delay_samples_folded + (i)*d_fft_size;
+
+                                    /*Perform multiplication of the unmodified local
+                                    generated code with the incoming signal with doppler
+                                    effect corrected and accumulates its value. This
+                                    is indeed correlation in time for an specific value
+                                    of a shift*/
+                                    volk_32fc_x2_dot_prod_32fc(&d_corr_acumulator[i], &d_in_temp[d_possible_delay[i]], d_code, d_samples_per_code);
+                                }
+                            /*Obtain maximun value of correlation given the possible delay selected */
+                            volk_32fc_magnitude_squared_32f(d_corr_output_f, d_corr_acumulator, d_folding_factor);
+                            volk_gnsssdr_32f_index_max_32u(&indext, d_corr_output_f, d_folding_factor);
+
+                            /*Now save the real code phase in the gnss_syncro block for use in other stages*/
+                            delay_samples = static_cast<double>(d_possible_delay[indext]);
+                            doppler_hz = static_cast<double>(doppler);
+                            samplestamp = samp_count;
+                            found = true;
+
+                            /* 5- Compute the test statistics and compare to the threshold d_test_statistics = 2 * d_fft_size * d_mag / d_input_power;*/
+                            test_statistics = mag / input_power;
+                        }
+                }
+
+            // Record results to file if required
+            if (d_dump)
+                {
+                    /*Since QuickSYnc performs a folded correlation in frequency by means
+                    of the FFT, it is essential to also keep the values obtained from the
+                    possible delay to show how it is maximize*/
+                    std::stringstream filename;
+                    std::streamsize n = sizeof(float) * (d_fft_size);  // complex file write
+                    filename.str("");
+                    filename << "../data/test_statistics_" << d_gnss_synchro->System
+                             << "_" << d_gnss_synchro->Signal << "_sat_"
+                             << d_gnss_synchro->PRN << "_doppler_" << doppler << ".dat";
+                    d_dump_file.open(filename.str().c_str(), std::ios::out | std::ios::binary);
+                    d_dump_file.write(reinterpret_cast<char*>(d_magnitude_folded), n);  //write directly |abs(x)|^2 in this Doppler bin?
+                    d_dump_file.close();
+                }
+        }
+
+    lk.lock();
+    d_input_power = input_power;
+    d_mag = mag;
+    d_test_statistics = test_statistics;
+    if (found)
+        {
+            d_gnss_synchro->Acq_delay_samples = delay_samples;
+            d_gnss_synchro->Acq_doppler_hz = doppler_hz;
+            d_gnss_synchro->Acq_samplestamp_samples = samplestamp;
+            d_gnss_synchro->Acq_doppler_step = d_doppler_step;
+        }
+    if (!d_bit_transition_flag)
+        {
+            if (d_test_statistics > d_threshold)
+                {
+                    d_state = 2;  // Positive acquisition
+                }
+            else if (d_well_count == d_max_dwells)
+                {
+                    d_state = 3;  // Negative acquisition
+                }
+        }
+    else
+        {
+            if (d_well_count == d_max_dwells)  // d_max_dwells = 2
+                {
+                    if (d_test_statistics > d_threshold)
+                        {
+                            d_state = 2;  // Positive acquisition
+                        }
+                    else
+                        {
+                            d_state = 3;  // Negative acquisition
+                        }
+                }
+        }
+    d_worker_active = false;
+}
+
+
+bool pcps_quicksync_acquisition_cc::stop()
+{
+    // The worker uses the block buffers, so it must be done before they are freed
+    while (true)
+        {
+            {
+                gr::thread::scoped_lock lk(d_setlock);
+                if (!d_worker_active)
+                    {
+                        break;
+                    }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    return true;
+}
+
+
 int pcps_quicksync_acquisition_cc::general_work(int noutput_items,
     gr_vector_int& ninput_items, gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items __attribute__((unused)))
@@ -283,14 +519,20 @@ int pcps_quicksync_acquisition_cc::general_work(int noutput_items,
      * 5. Compute the test statistics and compare to the threshold
      * 6. Declare positive or negative acquisition using a message queue
      */
-    //DLOG(INFO) << "START GENERAL WORK";
     int32_t acquisition_message = -1;  //0=STOP_CHANNEL 1=ACQ_SUCCEES 2=ACQ_FAIL
-    //std::cout<<"general_work in quicksync gnuradio block"<<std::endl;
+    gr::thread::scoped_lock lk(d_setlock);
+    if (d_worker_active)
+        {
+            // Dwells arriving while the worker is busy are dropped, as in pcps_acquisition
+            d_sample_counter += static_cast<uint64_t>(d_sampled_ms * d_samples_per_ms * ninput_items[0]);  // sample counter
+            consume_each(ninput_items[0]);
+            return noutput_items;
+        }
+
     switch (d_state)
         {
         case 0:
             {
-                //DLOG(INFO) << "START CASE 0";
                 if (d_active)
                     {
                         //restart acquisition variables
@@ -308,230 +550,27 @@ int pcps_quicksync_acquisition_cc::general_work(int noutput_items,
 
                 d_sample_counter += static_cast<uint64_t>(d_sampled_ms * d_samples_per_ms * ninput_items[0]);  // sample counter
                 consume_each(ninput_items[0]);
-                //DLOG(INFO) << "END CASE 0";
                 break;
             }
 
         case 1:
             {
-                /* initialize acquisition  implementing the QuickSync algorithm*/
-                //DLOG(INFO) << "START CASE 1";
-                int32_t doppler;
-                uint32_t indext = 0;
-                float magt = 0.0;
-                const auto* in = reinterpret_cast<const gr_complex*>(input_items[0]);  //Get the input samples pointer
-
-                auto* in_temp = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_samples_per_code * d_folding_factor * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
-                auto* in_temp_folded = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_fft_size * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
-
-                /*Create a signal to store a signal of size 1ms, to perform correlation
-            in time. No folding on this data is required*/
-                auto* in_1code = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_samples_per_code * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
-
-                /*Stores the values of the correlation output between the local code
-            and the signal with doppler shift corrected */
-                auto* corr_output = static_cast<gr_complex*>(volk_gnsssdr_malloc(d_samples_per_code * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
-
-                /*Stores a copy of the folded version of the signal.This is used for
-            the FFT operations in future steps of execution*/
-                // gr_complex in_folded[d_fft_size];
-                float fft_normalization_factor = static_cast<float>(d_fft_size) * static_cast<float>(d_fft_size);
-
-                d_input_power = 0.0;
-                d_mag = 0.0;
-                d_test_statistics = 0.0;
-                d_noise_floor_power = 0.0;
-
+                // Copy the dwell, so that the scheduler can reuse its buffer while the worker runs
+                memcpy(d_data_buffer, input_items[0], sizeof(gr_complex) * d_samples_per_code * d_folding_factor);
                 d_sample_counter += static_cast<uint64_t>(d_sampled_ms * d_samples_per_ms);  // sample counter
-
                 d_well_count++;
+                consume_each(1);
 
-                DLOG(INFO) << "Channel: " << d_channel
-                           << " , doing acquisition of satellite: "
-                           << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
-                           << " ,algorithm: pcps_quicksync_acquisition"
-                           << " ,folding factor: " << d_folding_factor
-                           << " ,sample stamp: " << d_sample_counter << ", threshold: "
-                           << d_threshold << ", doppler_max: " << d_doppler_max
-                           << ", doppler_step: " << d_doppler_step << ", Signal Size: "
-                           << d_samples_per_code * d_folding_factor;
-
-
-                /* 1- Compute the input signal power estimation. This operation is
-               being performed in a signal of size nxp */
-                volk_32fc_magnitude_squared_32f(d_magnitude, in, d_samples_per_code * d_folding_factor);
-                volk_32f_accumulator_s32f(&d_input_power, d_magnitude, d_samples_per_code * d_folding_factor);
-                d_input_power /= static_cast<float>(d_samples_per_code * d_folding_factor);
-
-                for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
-                    {
-                        /*Ensure that the signal is going to start with all samples
-                    at zero. This is done to avoid over acumulation when performing
-                    the folding process to be stored in d_fft_if->get_inbuf()*/
-                        d_signal_folded = new gr_complex[d_fft_size]();
-                        memcpy(d_fft_if->get_inbuf(), d_signal_folded, sizeof(gr_complex) * (d_fft_size));
-
-                        /*Doppler search steps and then multiplication of the incoming
-                    signal with the doppler wipeoffs to eliminate frequency offset
-                     */
-                        doppler = -static_cast<int32_t>(d_doppler_max) + d_doppler_step * doppler_index;
-
-                        /*Perform multiplication of the incoming signal with the
-                   complex exponential vector. This removes the frequency doppler
-                   shift offset*/
-                        volk_32fc_x2_multiply_32fc(in_temp, in,
-                            d_grid_doppler_wipeoffs[doppler_index],
-                            d_samples_per_code * d_folding_factor);
-
-                        /*Perform folding of the carrier wiped-off incoming signal. Since
-                   superlinear method is being used the folding factor in the
-                   incoming raw data signal is of d_folding_factor^2*/
-                        for (int32_t i = 0; i < static_cast<int32_t>(d_folding_factor * d_folding_factor); i++)
-                            {
-                                std::transform((in_temp + i * d_fft_size),
-                                    (in_temp + ((i + 1) * d_fft_size)),
-                                    d_fft_if->get_inbuf(),
-                                    d_fft_if->get_inbuf(),
-                                    std::plus<gr_complex>());
-                            }
-
-                        /* 3- Perform the FFT-based convolution  (parallel time search)
-                   Compute the FFT of the carrier wiped--off incoming signal*/
-                        d_fft_if->execute();
-
-                        /*Multiply carrier wiped--off, Fourier transformed incoming
-                    signal with the local FFT'd code reference using SIMD
-                    operations with VOLK library*/
-                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                            d_fft_if->get_outbuf(), d_fft_codes, d_fft_size);
-
-                        /* compute the inverse FFT of the aliased signal*/
-                        d_ifft->execute();
-
-                        /* Compute the magnitude and get the maximum value with its
-                   index position*/
-                        volk_32fc_magnitude_squared_32f(d_magnitude_folded,
-                            d_ifft->get_outbuf(), d_fft_size);
-
-                        /* Normalize the maximum value to correct the scale factor
-                   introduced by FFTW*/
-                        //volk_32f_s32f_multiply_32f_a(d_magnitude_folded,d_magnitude_folded,
-                        // (1 / (fft_normalization_factor * fft_normalization_factor)), d_fft_size);
-                        volk_gnsssdr_32f_index_max_32u(&indext, d_magnitude_folded, d_fft_size);
-
-                        magt = d_magnitude_folded[indext] / (fft_normalization_factor * fft_normalization_factor);
-
-                        delete[] d_signal_folded;
-
-                        // 4- record the maximum peak and the associated synchronization parameters
-                        if (d_mag < magt)
-                            {
-                                d_mag = magt;
-
-                                /* In case that d_bit_transition_flag = true, we compare the potentially
-                            new maximum test statistics (d_mag/d_input_power) with the value in
-                            d_test_statistics. When the second dwell is being processed, the value
-                            of d_mag/d_input_power could be lower than d_test_statistics (i.e,
-                            the maximum test statistics in the previous dwell is greater than
-                            current d_mag/d_input_power). Note that d_test_statistics is not
-                            restarted between consecutive dwells in multidwell operation.*/
-                                if (d_test_statistics < (d_mag / d_input_power) || !d_bit_transition_flag)
-                                    {
-                                        uint32_t detected_delay_samples_folded = 0;
-                                        detected_delay_samples_folded = (indext % d_samples_per_code);
-                                        gr_complex complex_acumulator[100];
-                                        //gr_complex complex_acumulator[d_folding_factor];
-
-                                        for (int32_t i = 0; i < static_cast<int32_t>(d_folding_factor); i++)
-                                            {
-                                                d_possible_delay[i] = detected_delay_samples_folded + (i)*d_fft_size;
-                                            }
-
-                                        for (int32_t i = 0; i < static_cast<int32_t>(d_folding_factor); i++)
-                                            {
-                                                /*Copy a signal of 1 code length into suggested buffer.
-                                                                      The copied signal must have doppler effect corrected*/
-                                                memcpy(in_1code, &in_temp[d_possible_delay[i]],
-                                                    sizeof(gr_complex) * (d_samples_per_code));
-
-                                                /*Perform multiplication of the unmodified local
-                                                              generated code with the incoming signal with doppler
-                                                              effect corrected and accumulates its value. This
-                                                              is indeed correlation in time for an specific value
-                                                              of a shift*/
-                                                volk_32fc_x2_multiply_32fc(corr_output, in_1code, d_code, d_samples_per_code);
-
-                                                for (int32_t j = 0; j < d_samples_per_code; j++)
-                                                    {
-                                                        complex_acumulator[i] += (corr_output[j]);
-                                                    }
-                                            }
-                                        /*Obtain maximun value of correlation given the possible delay selected */
-                                        volk_32fc_magnitude_squared_32f(d_corr_output_f, complex_acumulator, d_folding_factor);
-                                        volk_gnsssdr_32f_index_max_32u(&indext, d_corr_output_f, d_folding_factor);
-
-                                        /*Now save the real code phase in the gnss_syncro block for use in other stages*/
-                                        d_gnss_synchro->Acq_delay_samples = static_cast<double>(d_possible_delay[indext]);
-                                        d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
-                                        d_gnss_synchro->Acq_samplestamp_samples = d_sample_counter;
-                                        d_gnss_synchro->Acq_doppler_step = d_doppler_step;
-
-                                        /* 5- Compute the test statistics and compare to the threshold d_test_statistics = 2 * d_fft_size * d_mag / d_input_power;*/
-                                        d_test_statistics = d_mag / d_input_power;
-                                        //delete complex_acumulator;
-                                    }
-                            }
-
-                        // Record results to file if required
-                        if (d_dump)
-                            {
-                                /*Since QuickSYnc performs a folded correlation in frequency by means
-                            of the FFT, it is essential to also keep the values obtained from the
-                            possible delay to show how it is maximize*/
-                                std::stringstream filename;
-                                std::streamsize n = sizeof(float) * (d_fft_size);  // complex file write
-                                filename.str("");
-                                filename << "../data/test_statistics_" << d_gnss_synchro->System
-                                         << "_" << d_gnss_synchro->Signal << "_sat_"
-                                         << d_gnss_synchro->PRN << "_doppler_" << doppler << ".dat";
-                                d_dump_file.open(filename.str().c_str(), std::ios::out | std::ios::binary);
-                                d_dump_file.write(reinterpret_cast<char*>(d_magnitude_folded), n);  //write directly |abs(x)|^2 in this Doppler bin?
-                                d_dump_file.close();
-                            }
-                    }
-
-                if (!d_bit_transition_flag)
+                if (d_blocking)
                     {
-                        if (d_test_statistics > d_threshold)
-                            {
-                                d_state = 2;  // Positive acquisition
-                            }
-                        else if (d_well_count == d_max_dwells)
-                            {
-                                d_state = 3;  // Negative acquisition
-                            }
+                        lk.unlock();
+                        acquisition_core(d_sample_counter);
                     }
                 else
                     {
-                        if (d_well_count == d_max_dwells)  // d_max_dwells = 2
-                            {
-                                if (d_test_statistics > d_threshold)
-                                    {
-                                        d_state = 2;  // Positive acquisition
-                                    }
-                                else
-                                    {
-                                        d_state = 3;  // Negative acquisition
-                                    }
-                            }
+                        gr::thread::thread d_worker(&pcps_quicksync_acquisition_cc::acquisition_core, this, d_sample_counter);
+                        d_worker_active = true;
                     }
-
-                volk_gnsssdr_free(in_temp);
-                volk_gnsssdr_free(in_temp_folded);
-                volk_gnsssdr_free(in_1code);
-                volk_gnsssdr_free(corr_output);
-                consume_each(1);
-
                 break;
             }
 
@@ -52,10 +52,11 @@
 #define GNSS_SDR_PCPS_QUICKSYNC_ACQUISITION_CC_H_
 
 #include "channel_fsm.h"
+#include "gnss_sdr_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <gnuradio/gr_complex.h>
+#include <gnuradio/thread/thread.h>  // for scoped_lock
 #include <algorithm>
 #include <cassert>
 #include <fstream>
@@ -76,6 +77,7 @@ pcps_quicksync_make_acquisition_cc(
     int32_t samples_per_ms,
     int32_t samples_per_code,
     bool bit_transition_flag,
+    bool blocking,
     bool dump,
     std::string dump_filename);
 
@@ -95,6 +97,7 @@ private:
         uint32_t doppler_max, int64_t fs_in,
         int32_t samples_per_ms, int32_t samples_per_code,
         bool bit_transition_flag,
+        bool blocking,
         bool dump,
         std::string dump_filename);
 
@@ -103,20 +106,25 @@ private:
         uint32_t doppler_max, int64_t fs_in,
         int32_t samples_per_ms, int32_t samples_per_code,
         bool bit_transition_flag,
+        bool blocking,
         bool dump,
         std::string dump_filename);
 
     void calculate_magnitudes(gr_complex* fft_begin, int32_t doppler_shift,
         int32_t doppler_offset);
 
+    void acquisition_core(uint64_t samp_count);
+
+    void fold(gr_complex* folded, const gr_complex* in, uint32_t num_segments);
+
     gr_complex* d_code;
     uint32_t d_folding_factor;  // also referred in the paper as 'p'
-    float* d_corr_acumulator;
+    gr_complex* d_corr_acumulator;
     uint32_t* d_possible_delay;
     float* d_corr_output_f;
     float* d_magnitude_folded;
-    gr_complex* d_signal_folded;
-    gr_complex* d_code_folded;
+    gr_complex* d_data_buffer;  // copy of the dwell processed by acquisition_core
+    gr_complex* d_in_temp;      // carrier wiped-off dwell
     float d_noise_floor_power;
 
     int64_t d_fs_in;
@@ -135,9 +143,9 @@ private:
     gr_complex** d_grid_doppler_wipeoffs;
     uint32_t d_num_doppler_bins;
     gr_complex* d_fft_codes;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_fft_if2;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft_Complex* d_fft_if;
+    Gnss_Fft_Complex* d_fft_if2;
+    Gnss_Fft_Complex* d_ifft;
     Gnss_Synchro* d_gnss_synchro;
     uint32_t d_code_phase;
     float d_doppler_freq;
@@ -148,6 +156,8 @@ private:
     bool d_bit_transition_flag;
     std::ofstream d_dump_file;
     bool d_active;
+    bool d_blocking;
+    bool d_worker_active;
     int32_t d_state;
     bool d_dump;
     uint32_t d_channel;
@@ -167,6 +177,7 @@ public:
      */
     inline void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro)
     {
+        gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
         d_gnss_synchro = p_gnss_synchro;
     }
 
@@ -196,6 +207,7 @@ public:
      */
     inline void set_active(bool active)
     {
+        gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
         d_active = active;
     }
 
@@ -206,6 +218,8 @@ public:
      */
     void set_state(int32_t state);
 
+    bool stop();  //!< Waits for a search running in the worker thread
+
     /*!
      * \brief Set acquisition channel unique ID
      * \param channel - receiver channel.
@@ -230,6 +244,7 @@ public:
      */
     inline void set_threshold(float threshold)
     {
+        gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
         d_threshold = threshold;
     }
 
@@ -239,6 +254,7 @@ public:
      */
     inline void set_doppler_max(uint32_t doppler_max)
     {
+        gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
         d_doppler_max = doppler_max;
     }
 
@@ -248,6 +264,7 @@ public:
      */
     inline void set_doppler_step(uint32_t doppler_step)
     {
+        gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
         d_doppler_step = doppler_step;
     }
 
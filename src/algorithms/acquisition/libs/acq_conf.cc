@@ -49,7 +49,19 @@ Acq_Conf::Acq_Conf()
     dump = false;
     blocking = false;
     make_2_steps = false;
+    use_smooth_fft_size = true;
+    coarse_decimation_factor = 1U;
+    pmf_fft = false;
+    interpolate_peak = false;
+    prompt_fft_blocks = 0U;
+    sequential_detection = false;
+    pfa = 0.0;
+    sequential_pmiss = 0.05;
+    sequential_cn0_dbhz = 40.0;
+    compact_grid = false;
     dump_filename = "";
+    dump_format = "mat";
+    dump_queue_size = 16U;
     dump_channel = 0U;
     it_size = sizeof(char);
     blocking_on_standby = false;
@@ -56,11 +56,23 @@ public:
     bool blocking;
     bool blocking_on_standby;  // enable it only for unit testing to avoid sample consume on idle status
     bool make_2_steps;
+    bool use_smooth_fft_size;           // zero-pad linear correlations to a 2^a 3^b 5^c FFT length
+    uint32_t coarse_decimation_factor;  // > 1 enables the coarse-to-fine (decimated) search
+    bool pmf_fft;                       // partial matched filter + FFT Doppler search, doppler_step is not used
+    bool interpolate_peak;              // refine Doppler and code phase by interpolation of the grid
+    uint32_t prompt_fft_blocks;         // > 1 refines the Doppler with an FFT of the prompt over this many blocks of the dwell
+    bool sequential_detection;          // test after each dwell, with early dismissal, up to max_dwells
+    float pfa;                          // probability of false alarm of the sequential test
+    float sequential_pmiss;             // probability of dismissing a signal at sequential_cn0_dbhz
+    float sequential_cn0_dbhz;          // C/N0 the sequential dismissal thresholds are designed for
+    bool compact_grid;                  // store the accumulated grid as 16-bit integers, scaled per Doppler bin
     bool use_automatic_resampler;
     float resampler_ratio;
     int64_t resampled_fs;
     uint32_t resampler_latency_samples;
     std::string dump_filename;
+    std::string dump_format;  // "mat" or "raw"
+    uint32_t dump_queue_size;
     uint32_t dump_channel;
     size_t it_size;
 
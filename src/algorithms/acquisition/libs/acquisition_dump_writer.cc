@@ -0,0 +1,335 @@
+/*!
+ * \file acquisition_dump_writer.cc
+ * \brief Background writer of acquisition grid dumps
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "acquisition_dump_writer.h"
+#include <glog/logging.h>
+#include <matio.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+
+namespace
+{
+// Fixed part of a record in the ring, followed by the file name and the grids
+#pragma pack(push, 1)
+struct Acq_Dump_Header
+{
+    uint32_t basename_size;
+    uint32_t grid_rows;
+    uint32_t grid_cols;
+    uint32_t narrow_grid_rows;
+    uint32_t narrow_grid_cols;
+    uint8_t two_steps;
+    uint32_t doppler_max;
+    uint32_t doppler_step;
+    int32_t positive_acq;
+    float acq_doppler_hz;
+    float acq_delay_samples;
+    float test_statistic;
+    float threshold;
+    float input_power;
+    uint64_t sample_counter;
+    uint32_t PRN;
+    uint32_t num_dwells;
+    float doppler_step_narrow;
+    float doppler_grid_narrow_min;
+};
+#pragma pack(pop)
+
+const size_t MAX_BASENAME_SIZE = 1024;
+}  // namespace
+
+
+Acquisition_Dump_Record::Acquisition_Dump_Record()
+{
+    basename = "";
+    two_steps = false;
+    doppler_max = 0U;
+    doppler_step = 0U;
+    positive_acq = 0;
+    acq_doppler_hz = 0.0;
+    acq_delay_samples = 0.0;
+    test_statistic = 0.0;
+    threshold = 0.0;
+    input_power = 0.0;
+    sample_counter = 0ULL;
+    PRN = 0U;
+    num_dwells = 0U;
+    doppler_step_narrow = 0.0;
+    doppler_grid_narrow_min = 0.0;
+}
+
+
+Acquisition_Dump_Writer::Acquisition_Dump_Writer(const std::string& format, size_t queue_size, size_t grid_size)
+{
+    d_raw = (format == "raw");
+    if (!d_raw and format != "mat")
+        {
+            LOG(WARNING) << "Unknown acquisition dump format " << format << ", using mat";
+        }
+    d_dropped = 0ULL;
+    size_t record_size = sizeof(uint64_t) + sizeof(Acq_Dump_Header) + MAX_BASENAME_SIZE + grid_size * sizeof(float);
+    d_writer.open([this](const char* data, size_t size) { write_record(data, size); }, (queue_size > 0 ? queue_size : 1) * record_size);
+}
+
+
+Acquisition_Dump_Writer::~Acquisition_Dump_Writer()
+{
+    // Before d_record is destroyed
+    d_writer.close();
+    if (d_dropped > 0)
+        {
+            LOG(WARNING) << d_dropped << " acquisition dumps were dropped because the writer queue was full";
+        }
+}
+
+
+bool Acquisition_Dump_Writer::push(const Acquisition_Dump_Record& record)
+{
+    Acq_Dump_Header header{};
+    header.basename_size = static_cast<uint32_t>(std::min(record.basename.size(), MAX_BASENAME_SIZE));
+    header.grid_rows = record.grid.n_rows;
+    header.grid_cols = record.grid.n_cols;
+    header.narrow_grid_rows = record.two_steps ? record.narrow_grid.n_rows : 0U;
+    header.narrow_grid_cols = record.two_steps ? record.narrow_grid.n_cols : 0U;
+    header.two_steps = record.two_steps ? 1U : 0U;
+    header.doppler_max = record.doppler_max;
+    header.doppler_step = record.doppler_step;
+    header.positive_acq = record.positive_acq;
+    header.acq_doppler_hz = record.acq_doppler_hz;
+    header.acq_delay_samples = record.acq_delay_samples;
+    header.test_statistic = record.test_statistic;
+    header.threshold = record.threshold;
+    header.input_power = record.input_power;
+    header.sample_counter = record.sample_counter;
+    header.PRN = record.PRN;
+    header.num_dwells = record.num_dwells;
+    header.doppler_step_narrow = record.doppler_step_narrow;
+    header.doppler_grid_narrow_min = record.doppler_grid_narrow_min;
+
+    if (!d_writer.try_write_record({{&header, sizeof(header)},
+            {record.basename.data(), header.basename_size},
+            {record.grid.memptr(), sizeof(float) * record.grid.n_elem},
+            {record.narrow_grid.memptr(), sizeof(float) * header.narrow_grid_rows * header.narrow_grid_cols}}))
+        {
+            d_dropped++;
+            DLOG(INFO) << "Acquisition dump queue full, dropping " << record.basename;
+            return false;
+        }
+    return true;
+}
+
+
+uint64_t Acquisition_Dump_Writer::dropped() const
+{
+    return d_dropped;
+}
+
+
+void Acquisition_Dump_Writer::flush()
+{
+    d_writer.flush();
+}
+
+
+void Acquisition_Dump_Writer::write_record(const char* data, size_t size)
+{
+    Acq_Dump_Header header{};
+    if (size < sizeof(header))
+        {
+            return;
+        }
+    std::memcpy(&header, data, sizeof(header));
+    const char* src = data + sizeof(header);
+    d_record.basename.assign(src, header.basename_size);
+    src += header.basename_size;
+    d_record.grid.set_size(header.grid_rows, header.grid_cols);
+    std::memcpy(d_record.grid.memptr(), src, sizeof(float) * d_record.grid.n_elem);
+    src += sizeof(float) * d_record.grid.n_elem;
+    d_record.narrow_grid.set_size(header.narrow_grid_rows, header.narrow_grid_cols);
+    if (d_record.narrow_grid.n_elem > 0)
+        {
+            std::memcpy(d_record.narrow_grid.memptr(), src, sizeof(float) * d_record.narrow_grid.n_elem);
+        }
+    d_record.two_steps = (header.two_steps != 0);
+    d_record.doppler_max = header.doppler_max;
+    d_record.doppler_step = header.doppler_step;
+    d_record.positive_acq = header.positive_acq;
+    d_record.acq_doppler_hz = header.acq_doppler_hz;
+    d_record.acq_delay_samples = header.acq_delay_samples;
+    d_record.test_statistic = header.test_statistic;
+    d_record.threshold = header.threshold;
+    d_record.input_power = header.input_power;
+    d_record.sample_counter = header.sample_counter;
+    d_record.PRN = header.PRN;
+    d_record.num_dwells = header.num_dwells;
+    d_record.doppler_step_narrow = header.doppler_step_narrow;
+    d_record.doppler_grid_narrow_min = header.doppler_grid_narrow_min;
+
+    if (d_raw)
+        {
+            write_raw(d_record);
+        }
+    else
+        {
+            write_mat(d_record);
+        }
+}
+
+
+void Acquisition_Dump_Writer::write_mat(const Acquisition_Dump_Record& record) const
+{
+    std::string filename = record.basename + ".mat";
+    mat_t* matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
+    if (matfp == nullptr)
+        {
+            std::cout << "Unable to create or open Acquisition dump file" << std::endl;
+            return;
+        }
+    // matio takes non-const pointers, although it does not modify the data
+    auto& r = const_cast<Acquisition_Dump_Record&>(record);
+    size_t dims[2] = {static_cast<size_t>(r.grid.n_rows), static_cast<size_t>(r.grid.n_cols)};
+    matvar_t* matvar = Mat_VarCreate("acq_grid", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, r.grid.memptr(), 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    dims[0] = static_cast<size_t>(1);
+    dims[1] = static_cast<size_t>(1);
+    matvar = Mat_VarCreate("doppler_max", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &r.doppler_max, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("doppler_step", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &r.doppler_step, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("d_positive_acq", MAT_C_INT32, MAT_T_INT32, 1, dims, &r.positive_acq, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("acq_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &r.acq_doppler_hz, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("acq_delay_samples", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &r.acq_delay_samples, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("test_statistic", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &r.test_statistic, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("threshold", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &r.threshold, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("input_power", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &r.input_power, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("sample_counter", MAT_C_UINT64, MAT_T_UINT64, 1, dims, &r.sample_counter, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("PRN", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &r.PRN, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("num_dwells", MAT_C_UINT32, MAT_T_UINT32, 1, dims, &r.num_dwells, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    if (r.two_steps)
+        {
+            dims[0] = static_cast<size_t>(r.narrow_grid.n_rows);
+            dims[1] = static_cast<size_t>(r.narrow_grid.n_cols);
+            matvar = Mat_VarCreate("acq_grid_narrow", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, r.narrow_grid.memptr(), 0);
+            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+            Mat_VarFree(matvar);
+
+            dims[0] = static_cast<size_t>(1);
+            dims[1] = static_cast<size_t>(1);
+            matvar = Mat_VarCreate("doppler_step_narrow", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &r.doppler_step_narrow, 0);
+            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+            Mat_VarFree(matvar);
+
+            matvar = Mat_VarCreate("doppler_grid_narrow_min", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims, &r.doppler_grid_narrow_min, 0);
+            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+            Mat_VarFree(matvar);
+        }
+
+    Mat_Close(matfp);
+}
+
+
+void Acquisition_Dump_Writer::write_raw(const Acquisition_Dump_Record& record) const
+{
+    std::ofstream grid_file;
+    grid_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    try
+        {
+            grid_file.open(record.basename + ".dat", std::ios::out | std::ios::binary);
+            grid_file.write(reinterpret_cast<const char*>(record.grid.memptr()), sizeof(float) * record.grid.n_elem);
+            if (record.two_steps)
+                {
+                    grid_file.write(reinterpret_cast<const char*>(record.narrow_grid.memptr()), sizeof(float) * record.narrow_grid.n_elem);
+                }
+            grid_file.close();
+
+            // Sidecar header, one "key value" pair per line
+            std::ofstream header_file;
+            header_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            header_file.open(record.basename + ".hdr", std::ios::out);
+            header_file << "format float32_column_major\n"
+                        << "grid_rows " << record.grid.n_rows << "\n"
+                        << "grid_cols " << record.grid.n_cols << "\n"
+                        << "narrow_grid_rows " << (record.two_steps ? record.narrow_grid.n_rows : 0) << "\n"
+                        << "narrow_grid_cols " << (record.two_steps ? record.narrow_grid.n_cols : 0) << "\n"
+                        << "doppler_max " << record.doppler_max << "\n"
+                        << "doppler_step " << record.doppler_step << "\n"
+                        << "d_positive_acq " << record.positive_acq << "\n"
+                        << "acq_doppler_hz " << record.acq_doppler_hz << "\n"
+                        << "acq_delay_samples " << record.acq_delay_samples << "\n"
+                        << "test_statistic " << record.test_statistic << "\n"
+                        << "threshold " << record.threshold << "\n"
+                        << "input_power " << record.input_power << "\n"
+                        << "sample_counter " << record.sample_counter << "\n"
+                        << "PRN " << record.PRN << "\n"
+                        << "num_dwells " << record.num_dwells << "\n"
+                        << "doppler_step_narrow " << record.doppler_step_narrow << "\n"
+                        << "doppler_grid_narrow_min " << record.doppler_grid_narrow_min << "\n";
+            header_file.close();
+        }
+    catch (const std::ofstream::failure& e)
+        {
+            LOG(WARNING) << "Problem writing acquisition dump " << record.basename << ": " << e.what();
+        }
+}
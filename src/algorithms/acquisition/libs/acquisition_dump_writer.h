@@ -0,0 +1,112 @@
+/*!
+ * \file acquisition_dump_writer.h
+ * \brief Background writer of acquisition grid dumps
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQUISITION_DUMP_WRITER_H_
+#define GNSS_SDR_ACQUISITION_DUMP_WRITER_H_
+
+#include "gnss_sdr_dump.h"
+#include <armadillo>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*!
+ * \brief Snapshot of the acquisition results to be written to disk.
+ */
+class Acquisition_Dump_Record
+{
+public:
+    std::string basename;  // output file name, without extension
+    arma::fmat grid;
+    arma::fmat narrow_grid;
+    bool two_steps;
+    uint32_t doppler_max;
+    uint32_t doppler_step;
+    int32_t positive_acq;
+    float acq_doppler_hz;
+    float acq_delay_samples;
+    float test_statistic;
+    float threshold;
+    float input_power;
+    uint64_t sample_counter;
+    uint32_t PRN;
+    uint32_t num_dwells;
+    float doppler_step_narrow;
+    float doppler_grid_narrow_min;
+
+    Acquisition_Dump_Record();
+};
+
+
+/*!
+ * \brief Writes acquisition dumps from the background thread of the dump
+ * files (see Gnss_Dump_Writer).
+ *
+ * The acquisition worker only copies a record into the ring of the writer.
+ * If the ring is full, the record is dropped instead of blocking the caller,
+ * so the acquisition throughput does not depend on the disk. Records are
+ * written either as MAT 7.3 files (same layout as the synchronous dumps) or,
+ * with the "raw" format, as an uncompressed float32 column-major grid (.dat)
+ * plus a small text sidecar header (.hdr).
+ */
+class Acquisition_Dump_Writer
+{
+public:
+    /*!
+     * \brief The ring holds \p queue_size records whose grids (wide plus
+     * narrow) have up to \p grid_size cells.
+     */
+    Acquisition_Dump_Writer(const std::string& format, size_t queue_size, size_t grid_size);
+    ~Acquisition_Dump_Writer();  //!< Writes all pending records
+
+    /*!
+     * \brief Queues a record for writing. Returns false if it was dropped.
+     * It must always be called from the same thread.
+     */
+    bool push(const Acquisition_Dump_Record& record);
+
+    /*!
+     * \brief Blocks until all the queued records have been written.
+     */
+    void flush();
+
+    uint64_t dropped() const;  //!< Number of records dropped so far
+
+private:
+    void write_record(const char* data, size_t size);
+    void write_mat(const Acquisition_Dump_Record& record) const;
+    void write_raw(const Acquisition_Dump_Record& record) const;
+
+    Gnss_Dump_Writer d_writer;
+    Acquisition_Dump_Record d_record;  // record being written, used by the background thread
+    bool d_raw;
+    uint64_t d_dropped;
+};
+
+#endif
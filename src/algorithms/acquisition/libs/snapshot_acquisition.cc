@@ -0,0 +1,320 @@
+/*!
+ * \file snapshot_acquisition.cc
+ * \brief Parallel acquisition of all the satellites of one or more signals
+ * in a snapshot of samples held in memory
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "snapshot_acquisition.h"
+#include "Beidou_B1I.h"
+#include "Beidou_B3I.h"
+#include "GPS_L1_CA.h"
+#include "GPS_L5.h"
+#include "Galileo_E1.h"
+#include "Galileo_E5a.h"
+#include "beidou_b1i_signal_processing.h"
+#include "beidou_b3i_signal_processing.h"
+#include "galileo_e1_signal_processing.h"
+#include "galileo_e5_signal_processing.h"
+#include "gnss_sdr_fft.h"
+#include "gps_l5_signal.h"
+#include "gps_sdr_signal_processing.h"
+#include <glog/logging.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for copy_n, min, max, swap
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <stdexcept>  // for invalid_argument
+#include <thread>
+
+
+Snapshot_Acq_Conf::Snapshot_Acq_Conf()
+{
+    fs_in = 4000000;
+    coherent_ms = 1;
+    max_dwells = 0;
+    doppler_max = 5000;
+    doppler_step = 250;
+    threshold = 2.5;
+    num_threads = 0;
+    signals = std::vector<std::string>(1, "1C");
+}
+
+
+Snapshot_Acq_Result::Snapshot_Acq_Result()
+{
+    System = 'G';
+    Signal = "";
+    PRN = 0;
+    detected = false;
+    doppler_hz = 0.0;
+    code_phase_samples = 0.0;
+    code_phase_chips = 0.0;
+    cn0_db_hz = 0.0;
+    test_statistic = 0.0;
+    dwells = 0;
+}
+
+
+Snapshot_Acquisition::Snapshot_Acquisition(const Snapshot_Acq_Conf& conf) : d_conf(conf)
+{
+    if (d_conf.doppler_step == 0)
+        {
+            d_conf.doppler_step = 250;
+        }
+}
+
+
+Snapshot_Acquisition::Signal_Parameters Snapshot_Acquisition::parameters(const std::string& signal)
+{
+    if (signal == "1C")
+        {
+            return Signal_Parameters{'G', 32, GPS_L1_CA_CODE_RATE_HZ, GPS_L1_CA_CODE_LENGTH_CHIPS};
+        }
+    if (signal == "1B")
+        {
+            return Signal_Parameters{'E', 36, GALILEO_E1_CODE_CHIP_RATE_HZ, GALILEO_E1_B_CODE_LENGTH_CHIPS};
+        }
+    if (signal == "L5")
+        {
+            return Signal_Parameters{'G', 32, GPS_L5I_CODE_RATE_HZ, static_cast<double>(GPS_L5I_CODE_LENGTH_CHIPS)};
+        }
+    if (signal == "5X")
+        {
+            return Signal_Parameters{'E', 36, GALILEO_E5A_CODE_CHIP_RATE_HZ, static_cast<double>(GALILEO_E5A_CODE_LENGTH_CHIPS)};
+        }
+    if (signal == "B1")
+        {
+            return Signal_Parameters{'C', 63, BEIDOU_B1I_CODE_RATE_HZ, BEIDOU_B1I_CODE_LENGTH_CHIPS};
+        }
+    if (signal == "B3")
+        {
+            return Signal_Parameters{'C', 63, BEIDOU_B3I_CODE_RATE_HZ, BEIDOU_B3I_CODE_LENGTH_CHIPS};
+        }
+    throw std::invalid_argument("Snapshot_Acquisition: unsupported signal " + signal);
+}
+
+
+bool Snapshot_Acquisition::is_supported(const std::string& signal)
+{
+    return signal == "1C" or signal == "1B" or signal == "L5" or signal == "5X" or signal == "B1" or signal == "B3";
+}
+
+
+void Snapshot_Acquisition::generate_code(std::complex<float>* dest, const std::string& signal, uint32_t prn) const
+{
+    auto fs = static_cast<int32_t>(d_conf.fs_in);
+    char signal_name[3];
+    std::copy_n(signal.c_str(), 3, signal_name);
+    if (signal == "1C")
+        {
+            gps_l1_ca_code_gen_complex_sampled(dest, prn, fs, 0);
+        }
+    else if (signal == "1B")
+        {
+            galileo_e1_code_gen_complex_sampled(dest, signal_name, false, prn, fs, 0);
+        }
+    else if (signal == "L5")
+        {
+            gps_l5i_code_gen_complex_sampled(dest, prn, fs);
+        }
+    else if (signal == "5X")
+        {
+            galileo_e5_a_code_gen_complex_sampled(dest, signal_name, prn, fs, 0);
+        }
+    else if (signal == "B1")
+        {
+            beidou_b1i_code_gen_complex_sampled(dest, prn, fs, 0);
+        }
+    else if (signal == "B3")
+        {
+            beidou_b3i_code_gen_complex_sampled(dest, prn, fs, 0);
+        }
+}
+
+
+Snapshot_Acq_Result Snapshot_Acquisition::acquire(const std::complex<float>* samples, size_t num_samples, const std::string& signal, uint32_t prn) const
+{
+    Signal_Parameters sig = parameters(signal);
+    Snapshot_Acq_Result result;
+    result.System = sig.system;
+    result.Signal = signal;
+    result.PRN = prn;
+
+    // Same rounding as the code generators
+    const double fs = static_cast<double>(d_conf.fs_in);
+    const auto code_samples = static_cast<uint32_t>(fs / (sig.code_rate_hz / sig.code_length_chips));
+    const double code_period_ms = 1000.0 * sig.code_length_chips / sig.code_rate_hz;
+    const auto codes_per_dwell = std::max(static_cast<uint32_t>(std::ceil(static_cast<double>(d_conf.coherent_ms) / code_period_ms - 1e-6)), 1U);
+    const uint32_t dwell_samples = code_samples * codes_per_dwell;
+    auto num_dwells = static_cast<uint32_t>(num_samples / dwell_samples);
+    if (d_conf.max_dwells > 0)
+        {
+            num_dwells = std::min(num_dwells, d_conf.max_dwells);
+        }
+    if (num_dwells == 0 or code_samples == 0)
+        {
+            LOG(WARNING) << "Snapshot too short to acquire signal " << signal << ": " << num_samples << " samples";
+            return result;
+        }
+    result.dwells = num_dwells;
+
+    Gnss_Fft_Complex fft_if(dwell_samples, true);
+    Gnss_Fft_Complex ifft(dwell_samples, false);
+    std::vector<std::complex<float>> fft_codes(dwell_samples);
+    std::vector<std::complex<float>> carrier(dwell_samples);
+    std::vector<float> magnitude(dwell_samples);
+    std::vector<float> accumulated(dwell_samples);
+    std::vector<float> best_row(dwell_samples);
+
+    // Local code, repeated over the coherent integration
+    generate_code(fft_if.get_inbuf(), signal, prn);
+    for (uint32_t i = 1; i < codes_per_dwell; i++)
+        {
+            std::copy_n(fft_if.get_inbuf(), code_samples, fft_if.get_inbuf() + i * code_samples);
+        }
+    fft_if.execute();
+    volk_32fc_conjugate_32fc(fft_codes.data(), fft_if.get_outbuf(), dwell_samples);
+
+    // The correlation repeats every code period, so only the first one is searched
+    const auto num_doppler_bins = static_cast<uint32_t>(std::floor(2.0 * static_cast<double>(d_conf.doppler_max) / static_cast<double>(d_conf.doppler_step))) + 1;
+    double grid_sum = 0.0;
+    float peak = 0.0;
+    uint32_t peak_index = 0;
+    int32_t peak_doppler = 0;
+    for (uint32_t doppler_index = 0; doppler_index < num_doppler_bins; doppler_index++)
+        {
+            int32_t doppler = -static_cast<int32_t>(d_conf.doppler_max) + static_cast<int32_t>(doppler_index * d_conf.doppler_step);
+            float phase_step_rad = static_cast<float>(2.0 * GPS_PI * doppler / fs);
+            float phase = 0.0;
+            volk_gnsssdr_s32f_sincos_32fc(carrier.data(), -phase_step_rad, &phase, dwell_samples);
+            for (uint32_t dwell = 0; dwell < num_dwells; dwell++)
+                {
+                    volk_32fc_x2_multiply_32fc(fft_if.get_inbuf(), samples + static_cast<size_t>(dwell) * dwell_samples, carrier.data(), dwell_samples);
+                    fft_if.execute();
+                    volk_32fc_x2_multiply_32fc(ifft.get_inbuf(), fft_if.get_outbuf(), fft_codes.data(), dwell_samples);
+                    ifft.execute();
+                    if (dwell == 0)
+                        {
+                            volk_32fc_magnitude_squared_32f(accumulated.data(), ifft.get_outbuf(), code_samples);
+                        }
+                    else
+                        {
+                            volk_32fc_magnitude_squared_32f(magnitude.data(), ifft.get_outbuf(), code_samples);
+                            volk_32f_x2_add_32f(accumulated.data(), accumulated.data(), magnitude.data(), code_samples);
+                        }
+                }
+            uint32_t index = 0;
+            float row_sum = 0.0;
+            volk_gnsssdr_32f_index_max_32u(&index, accumulated.data(), code_samples);
+            volk_32f_accumulator_s32f(&row_sum, accumulated.data(), code_samples);
+            grid_sum += row_sum;
+            if (accumulated[index] > peak)
+                {
+                    peak = accumulated[index];
+                    peak_index = index;
+                    peak_doppler = doppler;
+                    std::swap(accumulated, best_row);
+                }
+        }
+
+    // Second peak, not closer than one chip to the first one
+    auto samples_per_chip = static_cast<int32_t>(std::ceil(fs / sig.code_rate_hz));
+    auto n = static_cast<int32_t>(code_samples);
+    for (int32_t k = -samples_per_chip; k <= samples_per_chip; k++)
+        {
+            best_row[(static_cast<int32_t>(peak_index) + k + n) % n] = 0.0;
+        }
+    uint32_t second_index = 0;
+    volk_gnsssdr_32f_index_max_32u(&second_index, best_row.data(), code_samples);
+    float second_peak = best_row[second_index];
+
+    result.test_statistic = second_peak > 0.0 ? peak / second_peak : 0.0;
+    result.detected = result.test_statistic > d_conf.threshold;
+    result.doppler_hz = static_cast<double>(peak_doppler);
+    result.code_phase_samples = static_cast<double>(peak_index);
+    result.code_phase_chips = static_cast<double>(peak_index) * sig.code_rate_hz / fs;
+
+    // The mean of the grid is dominated by noise. Peak over mean, minus one, is
+    // the post-correlation SNR, C/N0 times the coherent integration time.
+    double noise_mean = grid_sum / (static_cast<double>(num_doppler_bins) * static_cast<double>(code_samples));
+    double post_correlation_snr = noise_mean > 0.0 ? (static_cast<double>(peak) - noise_mean) / noise_mean : 0.0;
+    double coherent_s = static_cast<double>(dwell_samples) / fs;
+    result.cn0_db_hz = post_correlation_snr > 0.0 ? 10.0 * std::log10(post_correlation_snr / coherent_s) : 0.0;
+    return result;
+}
+
+
+std::vector<Snapshot_Acq_Result> Snapshot_Acquisition::run(const std::complex<float>* samples, size_t num_samples) const
+{
+    std::vector<std::pair<std::string, uint32_t>> jobs;
+    for (const auto& signal : d_conf.signals)
+        {
+            if (!is_supported(signal))
+                {
+                    LOG(WARNING) << "Snapshot acquisition of signal " << signal << " is not supported";
+                    continue;
+                }
+            for (uint32_t prn = 1; prn <= parameters(signal).num_prn; prn++)
+                {
+                    jobs.emplace_back(signal, prn);
+                }
+        }
+
+    std::vector<Snapshot_Acq_Result> results(jobs.size());
+    std::atomic<size_t> next_job(0);
+    auto worker = [&]() {
+        for (size_t job = next_job++; job < jobs.size(); job = next_job++)
+            {
+                try
+                    {
+                        results[job] = acquire(samples, num_samples, jobs[job].first, jobs[job].second);
+                    }
+                catch (const std::exception& e)
+                    {
+                        LOG(WARNING) << "Snapshot acquisition of " << jobs[job].first << " PRN " << jobs[job].second << " failed: " << e.what();
+                        results[job].Signal = jobs[job].first;
+                        results[job].PRN = jobs[job].second;
+                    }
+            }
+    };
+
+    uint32_t num_threads = d_conf.num_threads > 0 ? d_conf.num_threads : std::max(std::thread::hardware_concurrency(), 1U);
+    num_threads = static_cast<uint32_t>(std::min(static_cast<size_t>(num_threads), jobs.size()));
+    std::vector<std::thread> pool;
+    for (uint32_t i = 1; i < num_threads; i++)
+        {
+            pool.emplace_back(worker);
+        }
+    worker();
+    for (auto& thread : pool)
+        {
+            thread.join();
+        }
+    return results;
+}
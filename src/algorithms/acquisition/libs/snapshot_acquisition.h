@@ -0,0 +1,122 @@
+/*!
+ * \file snapshot_acquisition.h
+ * \brief Parallel acquisition of all the satellites of one or more signals
+ * in a snapshot of samples held in memory
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SNAPSHOT_ACQUISITION_H_
+#define GNSS_SDR_SNAPSHOT_ACQUISITION_H_
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Configuration of a snapshot acquisition.
+ */
+class Snapshot_Acq_Conf
+{
+public:
+    int64_t fs_in;                     // sampling rate of the snapshot [samples/s]
+    uint32_t coherent_ms;              // coherent integration, rounded up to a whole number of code periods
+    uint32_t max_dwells;               // non-coherent integrations (0: as many as fit in the snapshot)
+    uint32_t doppler_max;              // [Hz]
+    uint32_t doppler_step;             // [Hz]
+    float threshold;                   // first to second peak ratio for a positive acquisition
+    uint32_t num_threads;              // 0: one per hardware thread
+    std::vector<std::string> signals;  // "1C", "1B", "L5", "5X", "B1" and/or "B3"
+
+    Snapshot_Acq_Conf();
+};
+
+
+/*!
+ * \brief Acquisition result of one satellite signal.
+ */
+class Snapshot_Acq_Result
+{
+public:
+    char System;         // 'G', 'E' or 'C'
+    std::string Signal;  // as in Snapshot_Acq_Conf::signals
+    uint32_t PRN;
+    bool detected;
+    double doppler_hz;
+    double code_phase_samples;
+    double code_phase_chips;
+    double cn0_db_hz;      // estimated from the peak to mean ratio of the grid
+    float test_statistic;  // first to second peak ratio
+    uint32_t dwells;       // non-coherent integrations actually performed
+
+    Snapshot_Acq_Result();
+};
+
+
+/*!
+ * \brief Acquires all the PRNs of the configured signals in a snapshot.
+ *
+ * The search is the PCPS one of pcps_acquisition (FFT correlation per Doppler
+ * bin, non-coherent accumulation of the dwells, first to second peak test),
+ * but it runs on memory instead of a flowgraph. Each (signal, PRN) pair is a
+ * job, and jobs are distributed among a pool of worker threads. FFT plans are
+ * shared through Gnss_Fft_Plan_Manager, so only the buffers are per worker.
+ */
+class Snapshot_Acquisition
+{
+public:
+    explicit Snapshot_Acquisition(const Snapshot_Acq_Conf& conf);
+
+    /*!
+     * \brief Acquires all the configured signals in \p num_samples baseband
+     * samples. Results are sorted by signal, then by PRN.
+     */
+    std::vector<Snapshot_Acq_Result> run(const std::complex<float>* samples, size_t num_samples) const;
+
+    /*!
+     * \brief Returns true if \p signal is one of the signals that can be acquired.
+     */
+    static bool is_supported(const std::string& signal);
+
+private:
+    class Signal_Parameters
+    {
+    public:
+        char system;
+        uint32_t num_prn;
+        double code_rate_hz;
+        double code_length_chips;
+    };
+
+    static Signal_Parameters parameters(const std::string& signal);
+    Snapshot_Acq_Result acquire(const std::complex<float>* samples, size_t num_samples, const std::string& signal, uint32_t prn) const;
+    void generate_code(std::complex<float>* dest, const std::string& signal, uint32_t prn) const;
+
+    Snapshot_Acq_Conf d_conf;
+};
+
+#endif
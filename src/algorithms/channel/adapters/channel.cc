@@ -225,6 +225,13 @@ void Channel::set_signal(const Gnss_Signal& gnss_signal)
 }
 
 
+void Channel::set_doppler_window(int doppler_center, unsigned int doppler_window)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    acq_->set_doppler_window(doppler_center, doppler_window);
+}
+
+
 void Channel::stop_channel()
 {
     std::lock_guard<std::mutex> lk(mx);
@@ -84,6 +84,7 @@ public:
     void start_acquisition() override;                          //!< Start the State Machine
     void stop_channel() override;                               //!< Stop the State Machine
     void set_signal(const Gnss_Signal& gnss_signal_) override;  //!< Sets the channel GNSS signal
+    void set_doppler_window(int doppler_center, unsigned int doppler_window) override;  //!< Narrows the next acquisition Doppler search
 
     inline std::shared_ptr<AcquisitionInterface> acquisition() { return acq_; }
     inline std::shared_ptr<TrackingInterface> tracking() { return trk_; }
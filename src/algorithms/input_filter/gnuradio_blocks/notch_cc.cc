@@ -70,7 +70,7 @@ Notch::Notch(float pfa,
     angle_ = static_cast<float *>(volk_malloc(length_ * sizeof(float), volk_get_alignment()));
     power_spect = static_cast<float *>(volk_malloc(length_ * sizeof(float), volk_get_alignment()));
     last_out = gr_complex(0.0, 0.0);
-    d_fft = std::unique_ptr<gr::fft::fft_complex>(new gr::fft::fft_complex(length_, true));
+    d_fft = std::unique_ptr<Gnss_Fft_Complex>(new Gnss_Fft_Complex(length_, true));
 }
 
 
@@ -31,9 +31,9 @@
 #ifndef GNSS_SDR_NOTCH_H_
 #define GNSS_SDR_NOTCH_H_
 
+#include "gnss_sdr_fft.h"
 #include <boost/shared_ptr.hpp>
 #include <gnuradio/block.h>
-#include <gnuradio/fft/fft.h>
 #include <cstdint>
 #include <memory>
 
@@ -66,7 +66,7 @@ private:
     gr_complex *c_samples;
     float *angle_;
     float *power_spect;
-    std::unique_ptr<gr::fft::fft_complex> d_fft;
+    std::unique_ptr<Gnss_Fft_Complex> d_fft;
 
 public:
     Notch(float pfa, float p_c_factor, int32_t length_, int32_t n_segments_est, int32_t n_segments_reset);
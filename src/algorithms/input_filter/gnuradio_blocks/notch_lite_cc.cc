@@ -75,7 +75,7 @@ NotchLite::NotchLite(float p_c_factor,
     angle1 = 0.0;
     angle2 = 0.0;
     power_spect = static_cast<float *>(volk_malloc(length_ * sizeof(float), volk_get_alignment()));
-    d_fft = std::unique_ptr<gr::fft::fft_complex>(new gr::fft::fft_complex(length_, true));
+    d_fft = std::unique_ptr<Gnss_Fft_Complex>(new Gnss_Fft_Complex(length_, true));
 }
 
 
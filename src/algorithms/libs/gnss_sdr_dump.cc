@@ -0,0 +1,386 @@
+/*!
+ * \file gnss_sdr_dump.cc
+ * \brief Buffered writer of binary dump files, drained by a background
+ * thread, and reader that extracts the columns of those files.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_dump.h"
+#include <glog/logging.h>
+#include <algorithm>           // for find, min
+#include <chrono>              // for milliseconds
+#include <condition_variable>  // for condition_variable
+#include <mutex>               // for mutex, unique_lock
+#include <thread>              // for thread, yield, sleep_for
+
+
+/*!
+ * \brief Background thread that moves the contents of the rings of all the
+ * open Gnss_Dump_Writer objects to their files. It is started by the first
+ * writer that opens a file and runs until the end of the program.
+ */
+class Gnss_Dump_Writer_Thread
+{
+public:
+    static Gnss_Dump_Writer_Thread& instance()
+    {
+        static Gnss_Dump_Writer_Thread writer_thread;
+        return writer_thread;
+    }
+
+    void add(Gnss_Dump_Writer* writer)
+    {
+        std::unique_lock<std::mutex> lock(d_mutex);
+        d_writers.push_back(writer);
+        if (!d_thread.joinable())
+            {
+                d_thread = std::thread(&Gnss_Dump_Writer_Thread::run, this);
+            }
+    }
+
+    // When it returns, the thread does not access the writer anymore
+    void remove(Gnss_Dump_Writer* writer)
+    {
+        std::unique_lock<std::mutex> lock(d_mutex);
+        auto it = std::find(d_writers.begin(), d_writers.end(), writer);
+        if (it != d_writers.end())
+            {
+                d_writers.erase(it);
+            }
+        d_drained.wait(lock, [this, writer] { return d_draining != writer; });
+    }
+
+    // Asks for a drain now instead of at the next period
+    void wake()
+    {
+        d_wake.store(true);
+        d_cv.notify_all();
+    }
+
+private:
+    Gnss_Dump_Writer_Thread() : d_draining(nullptr), d_wake(false), d_stop(false) {}
+
+    ~Gnss_Dump_Writer_Thread()
+    {
+        {
+            std::unique_lock<std::mutex> lock(d_mutex);
+            d_stop = true;
+        }
+        d_cv.notify_all();
+        if (d_thread.joinable())
+            {
+                d_thread.join();
+            }
+    }
+
+    // The writers are drained without holding d_mutex, so that a slow
+    // handler does not block add(), remove() or the other writers
+    void run()
+    {
+        std::vector<Gnss_Dump_Writer*> writers;
+        std::unique_lock<std::mutex> lock(d_mutex);
+        while (!d_stop)
+            {
+                writers = d_writers;
+                for (auto* writer : writers)
+                    {
+                        if (std::find(d_writers.begin(), d_writers.end(), writer) == d_writers.end())
+                            {
+                                continue;  // removed during this pass
+                            }
+                        d_draining = writer;
+                        lock.unlock();
+                        writer->drain();
+                        lock.lock();
+                        d_draining = nullptr;
+                        d_drained.notify_all();
+                    }
+                d_cv.wait_for(lock, std::chrono::milliseconds(10), [this] { return d_stop or d_wake.exchange(false); });
+            }
+    }
+
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    std::condition_variable d_drained;
+    std::vector<Gnss_Dump_Writer*> d_writers;
+    Gnss_Dump_Writer* d_draining;  // writer being drained outside the lock
+    std::thread d_thread;
+    std::atomic<bool> d_wake;
+    bool d_stop;
+};
+
+
+Gnss_Dump_Writer::Gnss_Dump_Writer() : d_mask(0), d_head(0), d_tail(0), d_stalls(0), d_open(false), d_failed(false)
+{
+}
+
+
+Gnss_Dump_Writer::~Gnss_Dump_Writer()
+{
+    close();
+}
+
+
+bool Gnss_Dump_Writer::open(const std::string& filename, size_t buffer_size)
+{
+    close();
+    d_file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!d_file.is_open())
+        {
+            LOG(WARNING) << "Unable to open dump file " << filename;
+            return false;
+        }
+    d_filename = filename;
+    start(buffer_size);
+    return true;
+}
+
+
+bool Gnss_Dump_Writer::open(const std::function<void(const char* record, size_t size)>& handler, size_t buffer_size)
+{
+    close();
+    if (!handler)
+        {
+            return false;
+        }
+    d_handler = handler;
+    d_filename.clear();
+    start(buffer_size);
+    return true;
+}
+
+
+void Gnss_Dump_Writer::start(size_t buffer_size)
+{
+    size_t capacity = 4096;
+    while (capacity < buffer_size)
+        {
+            capacity <<= 1U;
+        }
+    d_ring.assign(capacity, 0);
+    d_mask = capacity - 1;
+    d_head.store(0);
+    d_tail.store(0);
+    d_stalls = 0;
+    d_failed.store(false);
+    d_open = true;
+    Gnss_Dump_Writer_Thread::instance().add(this);
+}
+
+
+bool Gnss_Dump_Writer::is_open() const
+{
+    return d_open;
+}
+
+
+void Gnss_Dump_Writer::close()
+{
+    if (!d_open)
+        {
+            return;
+        }
+    Gnss_Dump_Writer_Thread::instance().remove(this);
+    drain();
+    if (d_file.is_open())
+        {
+            d_file.close();
+        }
+    d_handler = nullptr;
+    d_open = false;
+    if (d_stalls > 0)
+        {
+            LOG(INFO) << "Dump file " << d_filename << ": the writer waited " << d_stalls << " times for a full buffer";
+        }
+    std::vector<char>().swap(d_ring);
+    std::vector<char>().swap(d_record);
+}
+
+
+void Gnss_Dump_Writer::flush()
+{
+    if (!d_open)
+        {
+            return;
+        }
+    const uint64_t head = d_head.load(std::memory_order_relaxed);
+    while (d_tail.load(std::memory_order_acquire) != head)
+        {
+            Gnss_Dump_Writer_Thread::instance().wake();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+}
+
+
+void Gnss_Dump_Writer::write(const void* data, size_t size)
+{
+    if (!d_open or d_handler)
+        {
+            return;
+        }
+    const auto* src = static_cast<const char*>(data);
+    const uint64_t capacity = d_mask + 1;
+    while (size > 0)
+        {
+            const uint64_t head = d_head.load(std::memory_order_relaxed);
+            uint64_t free_bytes = capacity - (head - d_tail.load(std::memory_order_acquire));
+            if (free_bytes == 0)
+                {
+                    d_stalls++;
+                    Gnss_Dump_Writer_Thread::instance().wake();
+                    while (free_bytes == 0)
+                        {
+                            std::this_thread::yield();
+                            free_bytes = capacity - (head - d_tail.load(std::memory_order_acquire));
+                        }
+                }
+            size_t chunk = std::min<uint64_t>(size, free_bytes);
+            copy_in(head, src, chunk);
+            d_head.store(head + chunk, std::memory_order_release);
+            src += chunk;
+            size -= chunk;
+        }
+}
+
+
+bool Gnss_Dump_Writer::try_write_record(std::initializer_list<Chunk> chunks)
+{
+    if (!d_open or !d_handler)
+        {
+            return false;
+        }
+    uint64_t size = 0;
+    for (const auto& chunk : chunks)
+        {
+            size += chunk.size;
+        }
+    // Each record is preceded by its size
+    const uint64_t head = d_head.load(std::memory_order_relaxed);
+    const uint64_t free_bytes = d_mask + 1 - (head - d_tail.load(std::memory_order_acquire));
+    if (sizeof(size) + size > free_bytes)
+        {
+            return false;
+        }
+    copy_in(head, &size, sizeof(size));
+    uint64_t pos = head + sizeof(size);
+    for (const auto& chunk : chunks)
+        {
+            copy_in(pos, chunk.data, chunk.size);
+            pos += chunk.size;
+        }
+    d_head.store(pos, std::memory_order_release);
+    return true;
+}
+
+
+void Gnss_Dump_Writer::copy_in(uint64_t pos, const void* src, size_t size)
+{
+    if (size == 0)
+        {
+            return;
+        }
+    size_t offset = pos & d_mask;
+    size_t first = std::min<uint64_t>(size, d_mask + 1 - offset);
+    std::memcpy(&d_ring[offset], src, first);
+    std::memcpy(&d_ring[0], static_cast<const char*>(src) + first, size - first);
+}
+
+
+void Gnss_Dump_Writer::copy_out(uint64_t pos, void* dst, size_t size) const
+{
+    size_t offset = pos & d_mask;
+    size_t first = std::min<uint64_t>(size, d_mask + 1 - offset);
+    std::memcpy(dst, &d_ring[offset], first);
+    std::memcpy(static_cast<char*>(dst) + first, &d_ring[0], size - first);
+}
+
+
+void Gnss_Dump_Writer::drain()
+{
+    uint64_t tail = d_tail.load(std::memory_order_relaxed);
+    const uint64_t head = d_head.load(std::memory_order_acquire);
+    if (head == tail)
+        {
+            return;
+        }
+    if (d_handler)
+        {
+            // The space of a record is released once the handler is done,
+            // so that flush() waits for it
+            while (tail != head)
+                {
+                    uint64_t size = 0;
+                    copy_out(tail, &size, sizeof(size));
+                    d_record.resize(size);
+                    copy_out(tail + sizeof(size), d_record.data(), size);
+                    d_handler(d_record.data(), size);
+                    tail += sizeof(size) + size;
+                    d_tail.store(tail, std::memory_order_release);
+                }
+            return;
+        }
+    const uint64_t capacity = d_mask + 1;
+    size_t pos = tail & d_mask;
+    size_t bytes = head - tail;
+    size_t first = std::min<uint64_t>(bytes, capacity - pos);
+    if (!d_failed.load(std::memory_order_relaxed))
+        {
+            d_file.write(&d_ring[pos], first);
+            d_file.write(&d_ring[0], bytes - first);
+            d_file.flush();
+            if (d_file.fail())
+                {
+                    // Keep consuming, so that the processing thread never blocks
+                    LOG(WARNING) << "Problem writing dump file " << d_filename;
+                    d_failed.store(true, std::memory_order_relaxed);
+                }
+        }
+    d_tail.store(head, std::memory_order_release);
+}
+
+
+bool Gnss_Dump_Reader::open(const std::string& filename, size_t record_size)
+{
+    d_data.clear();
+    d_record_size = record_size;
+    d_records = 0;
+    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+    if (!file.is_open() or record_size == 0)
+        {
+            return false;
+        }
+    std::streamoff size = file.tellg();
+    d_records = static_cast<size_t>(size) / record_size;
+    d_data.resize(d_records * record_size);
+    file.seekg(0, std::ios::beg);
+    if (!file.read(d_data.data(), d_data.size()))
+        {
+            d_data.clear();
+            d_records = 0;
+            return false;
+        }
+    return true;
+}
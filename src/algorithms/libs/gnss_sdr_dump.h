@@ -0,0 +1,189 @@
+/*!
+ * \file gnss_sdr_dump.h
+ * \brief Buffered writer of binary dump files, drained by a background
+ * thread, and reader that extracts the columns of those files.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_DUMP_H_
+#define GNSS_SDR_GNSS_SDR_DUMP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Writes the records of a binary dump file without doing file I/O in
+ * the calling (processing) thread.
+ *
+ * Records are copied into a single-producer / single-consumer ring buffer.
+ * A background thread, shared by all the open writers, moves the ring
+ * contents to the file in large writes. The file has exactly the bytes
+ * that were written, in order, so the layout of the existing dump files
+ * does not change.
+ *
+ * Each writer must be fed by a single thread. If the ring is full, write()
+ * waits for the background thread to make room.
+ *
+ * Outputs that are not a byte stream (e.g., one file per record) open the
+ * writer with a handler instead of a file name. Records written with
+ * try_write_record() are then passed whole to the handler, in the
+ * background thread.
+ */
+class Gnss_Dump_Writer
+{
+public:
+    Gnss_Dump_Writer();
+    ~Gnss_Dump_Writer();  //!< Closes the file, if open
+
+    Gnss_Dump_Writer(const Gnss_Dump_Writer&) = delete;
+    Gnss_Dump_Writer& operator=(const Gnss_Dump_Writer&) = delete;
+
+    /*!
+     * \brief Creates (truncates) \p filename. \p buffer_size is the size of
+     * the ring, in bytes, rounded up to a power of two.
+     */
+    bool open(const std::string& filename, size_t buffer_size = 1 << 22);
+
+    /*!
+     * \brief Passes each record to \p handler instead of writing a file.
+     */
+    bool open(const std::function<void(const char* record, size_t size)>& handler, size_t buffer_size = 1 << 22);
+
+    bool is_open() const;
+
+    /*!
+     * \brief Flushes the pending records and closes the file.
+     */
+    void close();
+
+    /*!
+     * \brief Waits until all the records written so far are in the file,
+     * e.g. when the flowgraph stops and the file is going to be read.
+     */
+    void flush();
+
+    void write(const void* data, size_t size);
+
+    /*!
+     * \brief Writes a fixed-layout record. Use packed structs when the
+     * layout must match an existing file format.
+     */
+    template <typename T>
+    inline void write(const T& record)
+    {
+        write(&record, sizeof(T));
+    }
+
+    struct Chunk
+    {
+        const void* data;
+        size_t size;
+    };
+
+    /*!
+     * \brief Writes the concatenation of \p chunks as one record of a writer
+     * opened with a handler. It never waits: if the record does not fit in
+     * the ring, it is dropped and false is returned.
+     */
+    bool try_write_record(std::initializer_list<Chunk> chunks);
+
+    inline uint64_t stalls() const { return d_stalls; }  //!< Number of times write() had to wait
+
+private:
+    friend class Gnss_Dump_Writer_Thread;
+    void start(size_t buffer_size);
+    void drain();
+    void copy_in(uint64_t pos, const void* src, size_t size);
+    void copy_out(uint64_t pos, void* dst, size_t size) const;
+
+    std::vector<char> d_ring;
+    uint64_t d_mask;
+    std::atomic<uint64_t> d_head;  // bytes written by the producer
+    std::atomic<uint64_t> d_tail;  // bytes moved to the file
+    std::ofstream d_file;
+    std::string d_filename;
+    std::function<void(const char*, size_t)> d_handler;
+    std::vector<char> d_record;  // whole record, passed to d_handler
+    uint64_t d_stalls;
+    bool d_open;
+    std::atomic<bool> d_failed;
+};
+
+
+/*!
+ * \brief Reads a whole dump file made of fixed-size records and extracts the
+ * values of one field (column) of all the records, e.g. to build the
+ * variables of a .mat file.
+ */
+class Gnss_Dump_Reader
+{
+public:
+    /*!
+     * \brief Reads \p filename in one go. Trailing bytes that do not
+     * make a whole record are ignored.
+     */
+    bool open(const std::string& filename, size_t record_size);
+
+    inline size_t records() const { return d_records; }
+
+    /*!
+     * \brief Copies the field of type T found at byte \p offset of each
+     * record (e.g., offsetof(Record, member)) into \p values.
+     */
+    template <typename T>
+    void column(size_t offset, std::vector<T>& values) const
+    {
+        values.resize(d_records);
+        const char* src = d_data.data() + offset;
+        for (size_t i = 0; i < d_records; i++)
+            {
+                std::memcpy(&values[i], src, sizeof(T));
+                src += d_record_size;
+            }
+    }
+
+    template <typename T>
+    std::vector<T> column(size_t offset) const
+    {
+        std::vector<T> result;
+        column(offset, result);
+        return result;
+    }
+
+private:
+    std::vector<char> d_data;
+    size_t d_record_size = 0;
+    size_t d_records = 0;
+};
+
+#endif
@@ -0,0 +1,235 @@
+/*!
+ * \file gnss_sdr_fft.cc
+ * \brief FFT plan manager shared by the processing blocks, with FFTW wisdom
+ * persistence, and a complex FFT class that executes the shared plans.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_fft.h"
+#include <glog/logging.h>
+#include <gnuradio/fft/fft.h>  // for gr::fft::planner
+#include <cstdio>              // for rename, remove
+#include <cstdlib>             // for getenv
+#include <stdexcept>           // for runtime_error
+
+
+uint32_t gnss_sdr_fft_smooth_size(uint32_t n)
+{
+    if (n <= 1)
+        {
+            return 1U;
+        }
+    uint32_t m = n;
+    while (true)
+        {
+            uint32_t r = m;
+            while (r % 2 == 0)
+                {
+                    r /= 2;
+                }
+            while (r % 3 == 0)
+                {
+                    r /= 3;
+                }
+            while (r % 5 == 0)
+                {
+                    r /= 5;
+                }
+            if (r == 1)
+                {
+                    return m;
+                }
+            m++;
+        }
+}
+
+
+Gnss_Fft_Plan_Manager& Gnss_Fft_Plan_Manager::instance()
+{
+    static Gnss_Fft_Plan_Manager manager;
+    return manager;
+}
+
+
+Gnss_Fft_Plan_Manager::Gnss_Fft_Plan_Manager()
+{
+    d_wisdom_file = "";
+    d_wisdom_loaded = false;
+}
+
+
+Gnss_Fft_Plan_Manager::~Gnss_Fft_Plan_Manager()
+{
+    // Called at program exit, when no block is planning anymore
+    for (auto& plan : d_plans)
+        {
+            fftwf_destroy_plan(plan.second);
+        }
+    d_plans.clear();
+}
+
+
+void Gnss_Fft_Plan_Manager::set_wisdom_file(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (filename != d_wisdom_file)
+        {
+            d_wisdom_file = filename;
+            d_wisdom_loaded = false;
+        }
+}
+
+
+std::string Gnss_Fft_Plan_Manager::wisdom_filename() const
+{
+    if (!d_wisdom_file.empty())
+        {
+            return d_wisdom_file;
+        }
+    const char* home = std::getenv("HOME");
+    if (home == nullptr)
+        {
+            return std::string(".gnss_sdr_fftw_wisdom");
+        }
+    return std::string(home) + "/.gnss_sdr_fftw_wisdom";
+}
+
+
+bool Gnss_Fft_Plan_Manager::load_wisdom()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return load_wisdom_unlocked();
+}
+
+
+bool Gnss_Fft_Plan_Manager::save_wisdom()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return save_wisdom_unlocked();
+}
+
+
+bool Gnss_Fft_Plan_Manager::load_wisdom_unlocked()
+{
+    d_wisdom_loaded = true;
+    std::string filename = wisdom_filename();
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());
+    if (fftwf_import_wisdom_from_filename(filename.c_str()) == 0)
+        {
+            DLOG(INFO) << "No FFTW wisdom could be read from " << filename;
+            return false;
+        }
+    LOG(INFO) << "FFTW wisdom loaded from " << filename;
+    return true;
+}
+
+
+bool Gnss_Fft_Plan_Manager::save_wisdom_unlocked()
+{
+    // Write to a temporary file and rename it, so concurrent receivers never read a truncated file
+    std::string filename = wisdom_filename();
+    std::string tmp_filename = filename + ".tmp";
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());
+    if (fftwf_export_wisdom_to_filename(tmp_filename.c_str()) == 0)
+        {
+            LOG(WARNING) << "Unable to write FFTW wisdom to " << tmp_filename;
+            return false;
+        }
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        {
+            LOG(WARNING) << "Unable to write FFTW wisdom to " << filename;
+            std::remove(tmp_filename.c_str());
+            return false;
+        }
+    return true;
+}
+
+
+fftwf_plan Gnss_Fft_Plan_Manager::get_plan(int32_t fft_size, bool forward)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto key = std::make_pair(fft_size, forward);
+    auto it = d_plans.find(key);
+    if (it != d_plans.end())
+        {
+            return it->second;
+        }
+    if (!d_wisdom_loaded)
+        {
+            load_wisdom_unlocked();
+        }
+
+    fftwf_plan plan;
+    {
+        // FFTW planner routines are not thread-safe. Share GNU Radio's planner mutex,
+        // since gr::fft blocks may be planning at the same time.
+        gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());
+        // FFTW_MEASURE overwrites the arrays, so plan on scratch buffers
+        auto* in = static_cast<fftwf_complex*>(fftwf_malloc(sizeof(fftwf_complex) * fft_size));
+        auto* out = static_cast<fftwf_complex*>(fftwf_malloc(sizeof(fftwf_complex) * fft_size));
+        plan = fftwf_plan_dft_1d(fft_size, in, out, forward ? FFTW_FORWARD : FFTW_BACKWARD, FFTW_MEASURE);
+        fftwf_free(in);
+        fftwf_free(out);
+    }
+    if (plan == nullptr)
+        {
+            throw std::runtime_error("Gnss_Fft_Plan_Manager: FFTW could not create a plan");
+        }
+    d_plans[key] = plan;
+    DLOG(INFO) << "New " << (forward ? "forward" : "inverse") << " FFT plan of " << fft_size << " points";
+    save_wisdom_unlocked();
+    return plan;
+}
+
+
+Gnss_Fft_Complex::Gnss_Fft_Complex(int32_t fft_size, bool forward)
+{
+    d_fft_size = fft_size;
+    d_inbuf = reinterpret_cast<gr_complex*>(fftwf_malloc(sizeof(gr_complex) * d_fft_size));
+    d_outbuf = reinterpret_cast<gr_complex*>(fftwf_malloc(sizeof(gr_complex) * d_fft_size));
+    if (d_inbuf == nullptr or d_outbuf == nullptr)
+        {
+            fftwf_free(d_inbuf);
+            fftwf_free(d_outbuf);
+            throw std::runtime_error("Gnss_Fft_Complex: fftwf_malloc failed");
+        }
+    d_plan = Gnss_Fft_Plan_Manager::instance().get_plan(d_fft_size, forward);
+}
+
+
+Gnss_Fft_Complex::~Gnss_Fft_Complex()
+{
+    fftwf_free(d_inbuf);
+    fftwf_free(d_outbuf);
+}
+
+
+void Gnss_Fft_Complex::execute()
+{
+    // New-array execute interface: thread-safe, and valid since the
+    // buffers share the fftwf_malloc alignment of the planning arrays
+    fftwf_execute_dft(d_plan, reinterpret_cast<fftwf_complex*>(d_inbuf), reinterpret_cast<fftwf_complex*>(d_outbuf));
+}
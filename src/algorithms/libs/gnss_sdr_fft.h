@@ -0,0 +1,124 @@
+/*!
+ * \file gnss_sdr_fft.h
+ * \brief FFT plan manager shared by the processing blocks, with FFTW wisdom
+ * persistence, and a complex FFT class that executes the shared plans.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_FFT_H_
+#define GNSS_SDR_GNSS_SDR_FFT_H_
+
+#include <fftw3.h>
+#include <gnuradio/gr_complex.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+/*!
+ * \brief Returns the smallest integer greater than or equal to \p n whose
+ * only prime factors are 2, 3 and 5. FFTW is fastest for those sizes.
+ */
+uint32_t gnss_sdr_fft_smooth_size(uint32_t n);
+
+
+/*!
+ * \brief Process-wide repository of FFTW plans.
+ *
+ * A plan is created only once for each (size, direction) pair and then shared
+ * by all the blocks (e.g., one acquisition block per channel) that request it.
+ * The FFTW wisdom is loaded from disk before computing the first plan and
+ * saved back each time a new plan is measured, so the costly FFTW_MEASURE
+ * planning is paid only once per machine.
+ */
+class Gnss_Fft_Plan_Manager
+{
+public:
+    static Gnss_Fft_Plan_Manager& instance();
+
+    /*!
+     * \brief Returns a plan for an out-of-place complex FFT of \p fft_size
+     * points. The plan can be executed on any pair of buffers allocated
+     * with fftwf_malloc by means of fftwf_execute_dft.
+     */
+    fftwf_plan get_plan(int32_t fft_size, bool forward);
+
+    /*!
+     * \brief Sets the file from which wisdom is read and to which it is
+     * written. If empty, $HOME/.gnss_sdr_fftw_wisdom is used.
+     */
+    void set_wisdom_file(const std::string& filename);
+
+    bool load_wisdom();
+    bool save_wisdom();
+
+    Gnss_Fft_Plan_Manager(const Gnss_Fft_Plan_Manager&) = delete;
+    Gnss_Fft_Plan_Manager& operator=(const Gnss_Fft_Plan_Manager&) = delete;
+
+private:
+    Gnss_Fft_Plan_Manager();
+    ~Gnss_Fft_Plan_Manager();
+    bool load_wisdom_unlocked();
+    bool save_wisdom_unlocked();
+    std::string wisdom_filename() const;
+
+    std::mutex d_mutex;
+    std::map<std::pair<int32_t, bool>, fftwf_plan> d_plans;
+    std::string d_wisdom_file;
+    bool d_wisdom_loaded;
+};
+
+
+/*!
+ * \brief Complex FFT with the same interface as gr::fft::fft_complex, but
+ * executing a plan owned by Gnss_Fft_Plan_Manager. Only the input and output
+ * buffers are private to each instance.
+ */
+class Gnss_Fft_Complex
+{
+public:
+    explicit Gnss_Fft_Complex(int32_t fft_size, bool forward = true);
+    ~Gnss_Fft_Complex();
+
+    Gnss_Fft_Complex(const Gnss_Fft_Complex&) = delete;
+    Gnss_Fft_Complex& operator=(const Gnss_Fft_Complex&) = delete;
+
+    inline gr_complex* get_inbuf() const { return d_inbuf; }
+    inline gr_complex* get_outbuf() const { return d_outbuf; }
+    inline int32_t inbuf_length() const { return d_fft_size; }
+    inline int32_t outbuf_length() const { return d_fft_size; }
+
+    void execute();
+
+private:
+    int32_t d_fft_size;
+    gr_complex* d_inbuf;
+    gr_complex* d_outbuf;
+    fftwf_plan d_plan;
+};
+
+#endif
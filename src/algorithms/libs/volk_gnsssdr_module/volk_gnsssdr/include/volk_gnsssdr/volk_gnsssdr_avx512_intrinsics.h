@@ -0,0 +1,58 @@
+/*!
+ * \file volk_gnsssdr_avx512_intrinsics.h
+ * \brief This file is intended to hold AVX-512 intrinsics of intrinsics.
+ * They should be used in VOLK kernels to avoid copy-paste.
+ *
+ * Copyright (C) 2010-2019 (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H_
+#define INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H_
+#include <immintrin.h>
+
+static inline __m512
+_mm512_complexmul_ps(__m512 x, __m512 y)
+{
+    __m512 yl, yh, tmp2;
+    yl = _mm512_moveldup_ps(y);              // Load yl with cr,cr,dr,dr ...
+    yh = _mm512_movehdup_ps(y);              // Load yh with ci,ci,di,di ...
+    tmp2 = _mm512_permute_ps(x, 0xB1);       // Re-arrange x to be ai,ar,bi,br ...
+    tmp2 = _mm512_mul_ps(tmp2, yh);          // tmp2 = ai*ci,ar*ci,bi*di,br*di ...
+    return _mm512_fmaddsub_ps(x, yl, tmp2);  // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di ...
+}
+
+static inline __m512
+_mm512_complexnormalise_ps(__m512 z)
+{
+    __m512 tmp1 = _mm512_mul_ps(z, z);                          // ar*ar,ai*ai,br*br,bi*bi ...
+    tmp1 = _mm512_add_ps(tmp1, _mm512_permute_ps(tmp1, 0xB1));  // |a|^2,|a|^2,|b|^2,|b|^2 ...
+    return _mm512_div_ps(z, _mm512_sqrt_ps(tmp1));
+}
+
+static inline void
+_mm512_complexstore_sum_ps(float* sum, __m512 x)
+{
+    // Adds the eight complex values held in x and stores the real and imaginary parts in sum[0] and sum[1]
+    __m256 tmp = _mm256_add_ps(_mm512_castps512_ps256(x), _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x), 1)));
+    __m128 tmp2 = _mm_add_ps(_mm256_castps256_ps128(tmp), _mm256_extractf128_ps(tmp, 1));
+    tmp2 = _mm_add_ps(tmp2, _mm_movehl_ps(tmp2, tmp2));
+    _mm_storel_pi((__m64*)sum, tmp2);
+}
+
+#endif /* INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H_ */
@@ -0,0 +1,403 @@
+/*!
+ * \file volk_gnsssdr_16ic_s32fc_x2_rotator_32fc.h
+ * \brief VOLK_GNSSSDR kernel: rotates a 16 bits complex vector into a 32 bits float complex vector.
+ *
+ * VOLK_GNSSSDR kernel that rotates a 16-bit complex vector and stores the result
+ * in 32-bit float complex format, fusing the carrier wipeoff with the conversion
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_16ic_s32fc_x2_rotator_32fc
+ *
+ * \b Overview
+ *
+ * Rotates a complex vector (16-bit integer samples each component) and stores
+ * the result as a complex vector of 32-bit floats, so that the input does not
+ * need to be converted before the rotation.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_16ic_s32fc_x2_rotator_32fc(lv_32fc_t* outVector, const lv_16sc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li inVector:   Vector to be rotated.
+ * \li phase_inc:  Phase increment in each sample = lv_cmake(cos(phase_step_rad), sin(phase_step_rad))
+ * \li phase:      Initial phase = lv_cmake(cos(initial_phase_rad), sin(initial_phase_rad))
+ * \li num_points: Number of complex values to be rotated and stored into \p outVector
+ *
+ * \b Outputs
+ * \li phase:      Final phase.
+ * \li outVector:  The rotated vector.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_16ic_s32fc_x2_rotator_32fc_H
+#define INCLUDED_volk_gnsssdr_16ic_s32fc_x2_rotator_32fc_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_16ic_s32fc_x2_rotator_32fc_generic(lv_32fc_t* outVector, const lv_16sc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points)
+{
+    unsigned int i = 0;
+    lv_16sc_t tmp16;
+    for (i = 0; i < (unsigned int)(num_points); ++i)
+        {
+            tmp16 = *inVector++;
+            *outVector++ = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            (*phase) *= phase_inc;
+            // Regenerate phase
+            if (i % 512 == 0)
+                {
+#ifdef __cplusplus
+                    (*phase) /= std::abs((*phase));
+#else
+                    (*phase) /= hypotf(lv_creal(*phase), lv_cimag(*phase));
+#endif
+                }
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_16ic_s32fc_x2_rotator_32fc_a_sse3(lv_32fc_t* outVector, const lv_16sc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 2;
+    unsigned int number;
+    __m128 a, b, two_phase_acc_reg, two_phase_inc_reg;
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t two_phase_inc[2];
+    two_phase_inc[0] = phase_inc * phase_inc;
+    two_phase_inc[1] = phase_inc * phase_inc;
+    two_phase_inc_reg = _mm_load_ps((float*)two_phase_inc);
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t two_phase_acc[2];
+    two_phase_acc[0] = (*phase);
+    two_phase_acc[1] = (*phase) * phase_inc;
+    two_phase_acc_reg = _mm_load_ps((float*)two_phase_acc);
+
+    const lv_16sc_t* _in = inVector;
+    lv_32fc_t* _out = outVector;
+
+    __m128 yl, yh, tmp1, tmp2, tmp3;
+    lv_16sc_t tmp16;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            a = _mm_set_ps((float)(lv_cimag(_in[1])), (float)(lv_creal(_in[1])), (float)(lv_cimag(_in[0])), (float)(lv_creal(_in[0])));  // load (2 byte imag, 2 byte real) x 2 into 128 bits reg
+            __VOLK_GNSSSDR_PREFETCH(_in + 8);
+            //complex 32fc multiplication b=a*two_phase_acc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);  // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);  // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(a, yl);                 // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            a = _mm_shuffle_ps(a, a, 0xB1);           // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(a, yh);                 // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            b = _mm_addsub_ps(tmp1, tmp2);            // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+            _mm_store_ps((float*)_out, b);
+
+            //complex 32fc multiplication two_phase_acc_reg=two_phase_acc_reg*two_phase_inc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);                            // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);                            // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(two_phase_inc_reg, yl);                           // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            tmp3 = _mm_shuffle_ps(two_phase_inc_reg, two_phase_inc_reg, 0xB1);  // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(tmp3, yh);                                        // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            two_phase_acc_reg = _mm_addsub_ps(tmp1, tmp2);                      // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+
+            // Regenerate phase
+            if ((number % 256) == 0)
+                {
+                    tmp1 = _mm_mul_ps(two_phase_acc_reg, two_phase_acc_reg);
+                    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                    tmp2 = _mm_sqrt_ps(tmp1);
+                    two_phase_acc_reg = _mm_div_ps(two_phase_acc_reg, tmp2);
+                }
+
+            _in += 2;
+            _out += 2;
+        }
+
+    _mm_store_ps((float*)two_phase_acc, two_phase_acc_reg);
+    (*phase) = two_phase_acc[0];
+
+    for (number = sse_iters * 2; number < num_points; ++number)
+        {
+            tmp16 = *_in++;
+            *_out++ = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            (*phase) *= phase_inc;
+        }
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_16ic_s32fc_x2_rotator_32fc_u_sse3(lv_32fc_t* outVector, const lv_16sc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 2;
+    unsigned int number;
+    __m128 a, b, two_phase_acc_reg, two_phase_inc_reg;
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t two_phase_inc[2];
+    two_phase_inc[0] = phase_inc * phase_inc;
+    two_phase_inc[1] = phase_inc * phase_inc;
+    two_phase_inc_reg = _mm_load_ps((float*)two_phase_inc);
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t two_phase_acc[2];
+    two_phase_acc[0] = (*phase);
+    two_phase_acc[1] = (*phase) * phase_inc;
+    two_phase_acc_reg = _mm_load_ps((float*)two_phase_acc);
+
+    const lv_16sc_t* _in = inVector;
+    lv_32fc_t* _out = outVector;
+
+    __m128 yl, yh, tmp1, tmp2, tmp3;
+    lv_16sc_t tmp16;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            a = _mm_set_ps((float)(lv_cimag(_in[1])), (float)(lv_creal(_in[1])), (float)(lv_cimag(_in[0])), (float)(lv_creal(_in[0])));  // load (2 byte imag, 2 byte real) x 2 into 128 bits reg
+            __VOLK_GNSSSDR_PREFETCH(_in + 8);
+            //complex 32fc multiplication b=a*two_phase_acc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);  // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);  // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(a, yl);                 // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            a = _mm_shuffle_ps(a, a, 0xB1);           // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(a, yh);                 // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            b = _mm_addsub_ps(tmp1, tmp2);            // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+            _mm_storeu_ps((float*)_out, b);
+
+            //complex 32fc multiplication two_phase_acc_reg=two_phase_acc_reg*two_phase_inc_reg
+            yl = _mm_moveldup_ps(two_phase_acc_reg);                            // Load yl with cr,cr,dr,dr
+            yh = _mm_movehdup_ps(two_phase_acc_reg);                            // Load yh with ci,ci,di,di
+            tmp1 = _mm_mul_ps(two_phase_inc_reg, yl);                           // tmp1 = ar*cr,ai*cr,br*dr,bi*dr
+            tmp3 = _mm_shuffle_ps(two_phase_inc_reg, two_phase_inc_reg, 0xB1);  // Re-arrange x to be ai,ar,bi,br
+            tmp2 = _mm_mul_ps(tmp3, yh);                                        // tmp2 = ai*ci,ar*ci,bi*di,br*di
+            two_phase_acc_reg = _mm_addsub_ps(tmp1, tmp2);                      // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+
+            // Regenerate phase
+            if ((number % 256) == 0)
+                {
+                    tmp1 = _mm_mul_ps(two_phase_acc_reg, two_phase_acc_reg);
+                    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                    tmp2 = _mm_sqrt_ps(tmp1);
+                    two_phase_acc_reg = _mm_div_ps(two_phase_acc_reg, tmp2);
+                }
+
+            _in += 2;
+            _out += 2;
+        }
+
+    _mm_storeu_ps((float*)two_phase_acc, two_phase_acc_reg);
+    (*phase) = two_phase_acc[0];
+
+    for (number = sse_iters * 2; number < num_points; ++number)
+        {
+            tmp16 = *_in++;
+            *_out++ = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            (*phase) *= phase_inc;
+        }
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_s32fc_x2_rotator_32fc_a_avx2(lv_32fc_t* outVector, const lv_16sc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 4;
+    unsigned int number;
+    __m256 a, b, four_phase_acc_reg, four_phase_inc_reg;
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t four_phase_inc[4];
+    const lv_32fc_t phase_inc2 = phase_inc * phase_inc;
+    const lv_32fc_t phase_inc4 = phase_inc2 * phase_inc2;
+    four_phase_inc[0] = phase_inc4;
+    four_phase_inc[1] = phase_inc4;
+    four_phase_inc[2] = phase_inc4;
+    four_phase_inc[3] = phase_inc4;
+    four_phase_inc_reg = _mm256_load_ps((float*)four_phase_inc);
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t four_phase_acc[4];
+    four_phase_acc[0] = (*phase);
+    four_phase_acc[1] = (*phase) * phase_inc;
+    four_phase_acc[2] = (*phase) * phase_inc2;
+    four_phase_acc[3] = (*phase) * phase_inc2 * phase_inc;
+    four_phase_acc_reg = _mm256_load_ps((float*)four_phase_acc);
+
+    const lv_16sc_t* _in = inVector;
+    lv_32fc_t* _out = outVector;
+
+    __m256 yl, yh, tmp1, tmp2, tmp3;
+    __m128i in16;
+    lv_16sc_t tmp16;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            in16 = _mm_loadu_si128((const __m128i*)_in);                // 4 x (2 byte real, 2 byte imag)
+            a = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(in16));         // convert from 16ic to 32fc
+            __VOLK_GNSSSDR_PREFETCH(_in + 16);
+            //complex 32fc multiplication b=a*four_phase_acc_reg
+            yl = _mm256_moveldup_ps(four_phase_acc_reg);  // Load yl with cr,cr,dr,dr ...
+            yh = _mm256_movehdup_ps(four_phase_acc_reg);  // Load yh with ci,ci,di,di ...
+            tmp1 = _mm256_mul_ps(a, yl);                  // tmp1 = ar*cr,ai*cr,br*dr,bi*dr ...
+            a = _mm256_shuffle_ps(a, a, 0xB1);            // Re-arrange x to be ai,ar,bi,br ...
+            tmp2 = _mm256_mul_ps(a, yh);                  // tmp2 = ai*ci,ar*ci,bi*di,br*di ...
+            b = _mm256_addsub_ps(tmp1, tmp2);             // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di ...
+            _mm256_store_ps((float*)_out, b);
+
+            //complex 32fc multiplication four_phase_acc_reg=four_phase_acc_reg*four_phase_inc_reg
+            yl = _mm256_moveldup_ps(four_phase_acc_reg);
+            yh = _mm256_movehdup_ps(four_phase_acc_reg);
+            tmp1 = _mm256_mul_ps(four_phase_inc_reg, yl);
+            tmp3 = _mm256_shuffle_ps(four_phase_inc_reg, four_phase_inc_reg, 0xB1);
+            tmp2 = _mm256_mul_ps(tmp3, yh);
+            four_phase_acc_reg = _mm256_addsub_ps(tmp1, tmp2);
+
+            // Regenerate phase
+            if ((number % 128) == 0)
+                {
+                    tmp1 = _mm256_mul_ps(four_phase_acc_reg, four_phase_acc_reg);
+                    tmp2 = _mm256_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm256_shuffle_ps(tmp2, tmp2, 0xD8);
+                    tmp2 = _mm256_sqrt_ps(tmp1);
+                    four_phase_acc_reg = _mm256_div_ps(four_phase_acc_reg, tmp2);
+                }
+
+            _in += 4;
+            _out += 4;
+        }
+
+    _mm256_store_ps((float*)four_phase_acc, four_phase_acc_reg);
+    (*phase) = four_phase_acc[0];
+
+    for (number = avx_iters * 4; number < num_points; ++number)
+        {
+            tmp16 = *_in++;
+            *_out++ = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            (*phase) *= phase_inc;
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_s32fc_x2_rotator_32fc_u_avx2(lv_32fc_t* outVector, const lv_16sc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 4;
+    unsigned int number;
+    __m256 a, b, four_phase_acc_reg, four_phase_inc_reg;
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t four_phase_inc[4];
+    const lv_32fc_t phase_inc2 = phase_inc * phase_inc;
+    const lv_32fc_t phase_inc4 = phase_inc2 * phase_inc2;
+    four_phase_inc[0] = phase_inc4;
+    four_phase_inc[1] = phase_inc4;
+    four_phase_inc[2] = phase_inc4;
+    four_phase_inc[3] = phase_inc4;
+    four_phase_inc_reg = _mm256_load_ps((float*)four_phase_inc);
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t four_phase_acc[4];
+    four_phase_acc[0] = (*phase);
+    four_phase_acc[1] = (*phase) * phase_inc;
+    four_phase_acc[2] = (*phase) * phase_inc2;
+    four_phase_acc[3] = (*phase) * phase_inc2 * phase_inc;
+    four_phase_acc_reg = _mm256_load_ps((float*)four_phase_acc);
+
+    const lv_16sc_t* _in = inVector;
+    lv_32fc_t* _out = outVector;
+
+    __m256 yl, yh, tmp1, tmp2, tmp3;
+    __m128i in16;
+    lv_16sc_t tmp16;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            in16 = _mm_loadu_si128((const __m128i*)_in);                // 4 x (2 byte real, 2 byte imag)
+            a = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(in16));         // convert from 16ic to 32fc
+            __VOLK_GNSSSDR_PREFETCH(_in + 16);
+            //complex 32fc multiplication b=a*four_phase_acc_reg
+            yl = _mm256_moveldup_ps(four_phase_acc_reg);  // Load yl with cr,cr,dr,dr ...
+            yh = _mm256_movehdup_ps(four_phase_acc_reg);  // Load yh with ci,ci,di,di ...
+            tmp1 = _mm256_mul_ps(a, yl);                  // tmp1 = ar*cr,ai*cr,br*dr,bi*dr ...
+            a = _mm256_shuffle_ps(a, a, 0xB1);            // Re-arrange x to be ai,ar,bi,br ...
+            tmp2 = _mm256_mul_ps(a, yh);                  // tmp2 = ai*ci,ar*ci,bi*di,br*di ...
+            b = _mm256_addsub_ps(tmp1, tmp2);             // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di ...
+            _mm256_storeu_ps((float*)_out, b);
+
+            //complex 32fc multiplication four_phase_acc_reg=four_phase_acc_reg*four_phase_inc_reg
+            yl = _mm256_moveldup_ps(four_phase_acc_reg);
+            yh = _mm256_movehdup_ps(four_phase_acc_reg);
+            tmp1 = _mm256_mul_ps(four_phase_inc_reg, yl);
+            tmp3 = _mm256_shuffle_ps(four_phase_inc_reg, four_phase_inc_reg, 0xB1);
+            tmp2 = _mm256_mul_ps(tmp3, yh);
+            four_phase_acc_reg = _mm256_addsub_ps(tmp1, tmp2);
+
+            // Regenerate phase
+            if ((number % 128) == 0)
+                {
+                    tmp1 = _mm256_mul_ps(four_phase_acc_reg, four_phase_acc_reg);
+                    tmp2 = _mm256_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm256_shuffle_ps(tmp2, tmp2, 0xD8);
+                    tmp2 = _mm256_sqrt_ps(tmp1);
+                    four_phase_acc_reg = _mm256_div_ps(four_phase_acc_reg, tmp2);
+                }
+
+            _in += 4;
+            _out += 4;
+        }
+
+    _mm256_storeu_ps((float*)four_phase_acc, four_phase_acc_reg);
+    (*phase) = four_phase_acc[0];
+
+    for (number = avx_iters * 4; number < num_points; ++number)
+        {
+            tmp16 = *_in++;
+            *_out++ = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            (*phase) *= phase_inc;
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_gnsssdr_16ic_s32fc_x2_rotator_32fc_H */
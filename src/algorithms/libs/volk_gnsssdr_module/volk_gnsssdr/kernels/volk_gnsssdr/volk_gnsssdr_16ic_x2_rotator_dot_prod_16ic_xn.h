@@ -1300,6 +1300,282 @@ static inline void volk_gnsssdr_16ic_x2_rotator_dot_prod_16ic_xn_a_avx2_reload(l
 #endif /* LV_HAVE_AVX2 */
 
 
+#ifdef LV_HAVE_AVX512BW
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_x2_rotator_dot_prod_16ic_xn_a_avx512bw(lv_16sc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_16sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int avx512_iters = num_points / 16;
+    const lv_16sc_t** _in_a = in_a;
+    const lv_16sc_t* _in_common = in_common;
+    lv_16sc_t* _out = result;
+    int n_vec;
+    unsigned int number;
+    unsigned int n;
+
+    lv_16sc_t tmp16;
+    lv_32fc_t tmp32;
+
+    __VOLK_ATTR_ALIGNED(64)
+    lv_16sc_t dotProductVector[16];
+    lv_16sc_t dotProduct = lv_cmake(0, 0);
+
+    __m512i* realcacc = (__m512i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m512i), 64);
+    __m512i* imagcacc = (__m512i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m512i), 64);
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            realcacc[n_vec] = _mm512_setzero_si512();
+            imagcacc[n_vec] = _mm512_setzero_si512();
+        }
+
+    const __mmask32 mask_imag = 0xAAAAAAAA;
+
+    __m512 a, eight_phase_acc_reg, eight_phase_inc_reg;
+    __m256i c1, c2;
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t eight_phase[8];
+    lv_32fc_t _phase = (*phase);
+    for (n = 0; n < 8; n++)
+        {
+            eight_phase[n] = _phase;
+            _phase *= phase_inc;
+        }
+    eight_phase_acc_reg = _mm512_load_ps((float*)eight_phase);
+    lv_32fc_t phase_inc8 = phase_inc * phase_inc;
+    phase_inc8 *= phase_inc8;
+    phase_inc8 *= phase_inc8;
+    for (n = 0; n < 8; n++)
+        {
+            eight_phase[n] = phase_inc8;
+        }
+    eight_phase_inc_reg = _mm512_load_ps((float*)eight_phase);
+
+    __m512i a2, b2, c, c_sr, real, imag;
+
+    for (number = 0; number < avx512_iters; number++)
+        {
+            // load 8 samples, widen them from 16ic to 32fc and rotate them
+            a = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_load_si256((__m256i*)_in_common)));
+            a = _mm512_complexmul_ps(a, eight_phase_acc_reg);
+            eight_phase_acc_reg = _mm512_complexmul_ps(eight_phase_acc_reg, eight_phase_inc_reg);
+            c1 = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(a));  // convert from 32fc to 16ic
+
+            // next eight samples
+            _in_common += 8;
+            a = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_load_si256((__m256i*)_in_common)));
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 16);
+            a = _mm512_complexmul_ps(a, eight_phase_acc_reg);
+            eight_phase_acc_reg = _mm512_complexmul_ps(eight_phase_acc_reg, eight_phase_inc_reg);
+            c2 = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(a));
+            _in_common += 8;
+
+            b2 = _mm512_inserti64x4(_mm512_castsi256_si512(c1), c2, 1);
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    a2 = _mm512_load_si512((__m512i*)&(_in_a[n_vec][number * 16]));
+
+                    c = _mm512_mullo_epi16(a2, b2);
+
+                    c_sr = _mm512_bsrli_epi128(c, 2);  // Shift a right by imm8 bytes while shifting in zeros, and store the results in dst.
+                    real = _mm512_subs_epi16(c, c_sr);
+
+                    c_sr = _mm512_bslli_epi128(b2, 2);
+                    c = _mm512_mullo_epi16(a2, c_sr);
+
+                    c_sr = _mm512_bslli_epi128(a2, 2);
+                    imag = _mm512_mullo_epi16(b2, c_sr);
+
+                    imag = _mm512_adds_epi16(c, imag);
+
+                    realcacc[n_vec] = _mm512_adds_epi16(realcacc[n_vec], real);
+                    imagcacc[n_vec] = _mm512_adds_epi16(imagcacc[n_vec], imag);
+                }
+            // Regenerate phase
+            if ((number % 64) == 0)
+                {
+                    eight_phase_acc_reg = _mm512_complexnormalise_ps(eight_phase_acc_reg);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            a2 = _mm512_mask_blend_epi16(mask_imag, realcacc[n_vec], imagcacc[n_vec]);
+
+            _mm512_store_si512((__m512i*)dotProductVector, a2);  // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0, 0);
+            for (number = 0; number < 16; ++number)
+                {
+                    dotProduct = lv_cmake(sat_adds16i(lv_creal(dotProduct), lv_creal(dotProductVector[number])),
+                        sat_adds16i(lv_cimag(dotProduct), lv_cimag(dotProductVector[number])));
+                }
+            _out[n_vec] = dotProduct;
+        }
+
+    volk_gnsssdr_free(realcacc);
+    volk_gnsssdr_free(imagcacc);
+
+    eight_phase_acc_reg = _mm512_complexnormalise_ps(eight_phase_acc_reg);
+    _mm512_store_ps((float*)eight_phase, eight_phase_acc_reg);
+    (*phase) = eight_phase[0];
+    _mm256_zeroupper();
+
+    for (n = avx512_iters * 16; n < num_points; n++)
+        {
+            tmp16 = in_common[n];
+            tmp32 = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            tmp16 = lv_cmake((int16_t)rintf(lv_creal(tmp32)), (int16_t)rintf(lv_cimag(tmp32)));
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    lv_16sc_t tmp = tmp16 * in_a[n_vec][n];
+                    _out[n_vec] = lv_cmake(sat_adds16i(lv_creal(_out[n_vec]), lv_creal(tmp)),
+                        sat_adds16i(lv_cimag(_out[n_vec]), lv_cimag(tmp)));
+                }
+        }
+}
+#endif /* LV_HAVE_AVX512BW */
+
+
+#ifdef LV_HAVE_AVX512BW
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_x2_rotator_dot_prod_16ic_xn_u_avx512bw(lv_16sc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_16sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int avx512_iters = num_points / 16;
+    const lv_16sc_t** _in_a = in_a;
+    const lv_16sc_t* _in_common = in_common;
+    lv_16sc_t* _out = result;
+    int n_vec;
+    unsigned int number;
+    unsigned int n;
+
+    lv_16sc_t tmp16;
+    lv_32fc_t tmp32;
+
+    __VOLK_ATTR_ALIGNED(64)
+    lv_16sc_t dotProductVector[16];
+    lv_16sc_t dotProduct = lv_cmake(0, 0);
+
+    __m512i* realcacc = (__m512i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m512i), 64);
+    __m512i* imagcacc = (__m512i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m512i), 64);
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            realcacc[n_vec] = _mm512_setzero_si512();
+            imagcacc[n_vec] = _mm512_setzero_si512();
+        }
+
+    const __mmask32 mask_imag = 0xAAAAAAAA;
+
+    __m512 a, eight_phase_acc_reg, eight_phase_inc_reg;
+    __m256i c1, c2;
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t eight_phase[8];
+    lv_32fc_t _phase = (*phase);
+    for (n = 0; n < 8; n++)
+        {
+            eight_phase[n] = _phase;
+            _phase *= phase_inc;
+        }
+    eight_phase_acc_reg = _mm512_load_ps((float*)eight_phase);
+    lv_32fc_t phase_inc8 = phase_inc * phase_inc;
+    phase_inc8 *= phase_inc8;
+    phase_inc8 *= phase_inc8;
+    for (n = 0; n < 8; n++)
+        {
+            eight_phase[n] = phase_inc8;
+        }
+    eight_phase_inc_reg = _mm512_load_ps((float*)eight_phase);
+
+    __m512i a2, b2, c, c_sr, real, imag;
+
+    for (number = 0; number < avx512_iters; number++)
+        {
+            // load 8 samples, widen them from 16ic to 32fc and rotate them
+            a = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i*)_in_common)));
+            a = _mm512_complexmul_ps(a, eight_phase_acc_reg);
+            eight_phase_acc_reg = _mm512_complexmul_ps(eight_phase_acc_reg, eight_phase_inc_reg);
+            c1 = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(a));  // convert from 32fc to 16ic
+
+            // next eight samples
+            _in_common += 8;
+            a = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i*)_in_common)));
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 16);
+            a = _mm512_complexmul_ps(a, eight_phase_acc_reg);
+            eight_phase_acc_reg = _mm512_complexmul_ps(eight_phase_acc_reg, eight_phase_inc_reg);
+            c2 = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(a));
+            _in_common += 8;
+
+            b2 = _mm512_inserti64x4(_mm512_castsi256_si512(c1), c2, 1);
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    a2 = _mm512_loadu_si512((__m512i*)&(_in_a[n_vec][number * 16]));
+
+                    c = _mm512_mullo_epi16(a2, b2);
+
+                    c_sr = _mm512_bsrli_epi128(c, 2);  // Shift a right by imm8 bytes while shifting in zeros, and store the results in dst.
+                    real = _mm512_subs_epi16(c, c_sr);
+
+                    c_sr = _mm512_bslli_epi128(b2, 2);
+                    c = _mm512_mullo_epi16(a2, c_sr);
+
+                    c_sr = _mm512_bslli_epi128(a2, 2);
+                    imag = _mm512_mullo_epi16(b2, c_sr);
+
+                    imag = _mm512_adds_epi16(c, imag);
+
+                    realcacc[n_vec] = _mm512_adds_epi16(realcacc[n_vec], real);
+                    imagcacc[n_vec] = _mm512_adds_epi16(imagcacc[n_vec], imag);
+                }
+            // Regenerate phase
+            if ((number % 64) == 0)
+                {
+                    eight_phase_acc_reg = _mm512_complexnormalise_ps(eight_phase_acc_reg);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            a2 = _mm512_mask_blend_epi16(mask_imag, realcacc[n_vec], imagcacc[n_vec]);
+
+            _mm512_store_si512((__m512i*)dotProductVector, a2);  // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0, 0);
+            for (number = 0; number < 16; ++number)
+                {
+                    dotProduct = lv_cmake(sat_adds16i(lv_creal(dotProduct), lv_creal(dotProductVector[number])),
+                        sat_adds16i(lv_cimag(dotProduct), lv_cimag(dotProductVector[number])));
+                }
+            _out[n_vec] = dotProduct;
+        }
+
+    volk_gnsssdr_free(realcacc);
+    volk_gnsssdr_free(imagcacc);
+
+    eight_phase_acc_reg = _mm512_complexnormalise_ps(eight_phase_acc_reg);
+    _mm512_store_ps((float*)eight_phase, eight_phase_acc_reg);
+    (*phase) = eight_phase[0];
+    _mm256_zeroupper();
+
+    for (n = avx512_iters * 16; n < num_points; n++)
+        {
+            tmp16 = in_common[n];
+            tmp32 = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            tmp16 = lv_cmake((int16_t)rintf(lv_creal(tmp32)), (int16_t)rintf(lv_cimag(tmp32)));
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    lv_16sc_t tmp = tmp16 * in_a[n_vec][n];
+                    _out[n_vec] = lv_cmake(sat_adds16i(lv_creal(_out[n_vec]), lv_creal(tmp)),
+                        sat_adds16i(lv_cimag(_out[n_vec]), lv_cimag(tmp)));
+                }
+        }
+}
+#endif /* LV_HAVE_AVX512BW */
+
+
 #ifdef LV_HAVE_NEONV7
 #include <arm_neon.h>
 
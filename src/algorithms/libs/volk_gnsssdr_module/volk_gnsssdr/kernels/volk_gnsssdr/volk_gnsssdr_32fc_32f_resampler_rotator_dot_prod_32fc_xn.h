@@ -0,0 +1,490 @@
+/*!
+ * \file volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: resamples a real local code at several delays, and correlates
+ * the copies with a phase-rotated complex vector, without storing the resampled codes.
+ *
+ * VOLK_GNSSSDR kernel that performs in a single pass the work of
+ * volk_gnsssdr_32f_xn_resampler_32f_xn followed by volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn.
+ * The code index of each tap is computed on the fly, the chip is read from the
+ * short chip-rate code table, and the products are accumulated in registers.
+ * It is optimized to perform the N tap correlation process in GNSS receivers.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn
+ *
+ * \b Overview
+ *
+ * Rotates the reference complex vector and multiplies it by an arbitrary number of
+ * delayed copies of a real local code, resampled at the signal rate, accumulating
+ * the results in the output vector. The rotation is done at a fixed rate per sample,
+ * from an initial \p phase offset. The code chip of tap k at sample n is
+ * local_code[floor(code_phase_step_chips * n + shifts_chips[k] - rem_code_phase_chips) mod code_length_chips].
+ * This function can be used for Doppler wipe-off and multiple correlator.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:             Pointer to the vector to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc:             Phase increment = lv_cmake(cos(phase_step_rad), sin(phase_step_rad))
+ * \li phase:                 Initial phase = lv_cmake(cos(initial_phase_rad), sin(initial_phase_rad))
+ * \li local_code:            One period of the local code, sampled at one sample per chip.
+ * \li rem_code_phase_chips:  Code phase at the first sample [chips].
+ * \li code_phase_step_chips: Code phase increment per sample [chips].
+ * \li shifts_chips:          Delay of each tap [chips].
+ * \li code_length_chips:     Number of chips in \p local_code.
+ * \li num_a_vectors:         Number of taps.
+ * \li num_points:            Number of samples of \p in_common to be correlated.
+ *
+ * \b Outputs
+ * \li phase:                 Final phase.
+ * \li result:                Vector of \p num_a_vectors correlations.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_H
+
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+#include <stdlib.h>
+
+
+static inline int volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_index(float code_phase_chips, unsigned int code_length_chips)
+{
+    int local_code_chip_index = (int)floor(code_phase_chips);
+    // Take into account that in multitap correlators, the shifts can be negative!
+    if (local_code_chip_index < 0) local_code_chip_index += (int)code_length_chips * (abs(local_code_chip_index) / code_length_chips + 1);
+    return local_code_chip_index % code_length_chips;
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_generic(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points)
+{
+    lv_32fc_t tmp32_1;
+    int n_vec;
+    unsigned int n;
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake(0, 0);
+        }
+    for (n = 0; n < num_points; n++)
+        {
+            tmp32_1 = *in_common++ * (*phase);
+
+            // Regenerate phase
+            if (n % 256 == 0)
+                {
+#ifdef __cplusplus
+                    (*phase) /= std::abs((*phase));
+#else
+                    (*phase) /= hypotf(lv_creal(*phase), lv_cimag(*phase));
+#endif
+                }
+
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    result[n_vec] += tmp32_1 * local_code[volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_index(code_phase_step_chips * (float)n + (shifts_chips[n_vec] - rem_code_phase_chips), code_length_chips)];
+                }
+        }
+}
+
+#endif /*LV_HAVE_GENERIC*/
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <volk_gnsssdr/volk_gnsssdr_sse3_intrinsics.h>
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_u_sse4_1(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int quarterPoints = num_points / 4;
+    const float* aPtr = (const float*)in_common;
+    unsigned int number;
+    unsigned int k;
+    int vec_ind;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(16)
+    int local_code_chip_index[4];
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t phase_vec[4];
+
+    const __m128 fours = _mm_set1_ps(4.0f);
+    const __m128 code_phase_step_chips_reg = _mm_set_ps1(code_phase_step_chips);
+    const __m128 code_length_chips_reg_f = _mm_set_ps1((float)code_length_chips);
+    const __m128i code_length_chips_reg_i = _mm_set1_epi32((int)code_length_chips);
+    const __m128i zeros = _mm_setzero_si128();
+    __m128 indexn = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    __m128 a0Val, a1Val, code_phase, aux, c, base, code, b0Val, b1Val;
+    __m128i i, local_code_chip_index_reg, negatives;
+    __m128 tap_offset[num_a_vectors];
+    __m128 dotProdVal0[num_a_vectors];
+    __m128 dotProdVal1[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            tap_offset[vec_ind] = _mm_set_ps1(shifts_chips[vec_ind] - rem_code_phase_chips);
+            dotProdVal0[vec_ind] = _mm_setzero_ps();
+            dotProdVal1[vec_ind] = _mm_setzero_ps();
+        }
+
+    // Set up the complex rotator
+    __m128 z0, z1, dz_reg;
+    for (k = 0; k < 4; ++k)
+        {
+            phase_vec[k] = _phase;
+            _phase *= phase_inc;
+        }
+    z0 = _mm_load_ps((float*)phase_vec);
+    z1 = _mm_load_ps((float*)(phase_vec + 2));
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^4
+    phase_vec[0] = dz;
+    phase_vec[1] = dz;
+    dz_reg = _mm_load_ps((float*)phase_vec);
+
+    for (number = 0; number < quarterPoints; number++)
+        {
+            a0Val = _mm_loadu_ps(aPtr);
+            a1Val = _mm_loadu_ps(aPtr + 4);
+            a0Val = _mm_complexmul_ps(a0Val, z0);
+            a1Val = _mm_complexmul_ps(a1Val, z1);
+            z0 = _mm_complexmul_ps(z0, dz_reg);
+            z1 = _mm_complexmul_ps(z1, dz_reg);
+
+            code_phase = _mm_mul_ps(code_phase_step_chips_reg, indexn);
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    aux = _mm_floor_ps(_mm_add_ps(code_phase, tap_offset[vec_ind]));
+                    // fmod
+                    c = _mm_div_ps(aux, code_length_chips_reg_f);
+                    i = _mm_cvttps_epi32(c);
+                    base = _mm_mul_ps(_mm_cvtepi32_ps(i), code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm_cvtps_epi32(_mm_sub_ps(aux, base));
+                    negatives = _mm_cmplt_epi32(local_code_chip_index_reg, zeros);
+                    local_code_chip_index_reg = _mm_add_epi32(local_code_chip_index_reg, _mm_and_si128(code_length_chips_reg_i, negatives));
+                    _mm_store_si128((__m128i*)local_code_chip_index, local_code_chip_index_reg);
+
+                    code = _mm_set_ps(local_code[local_code_chip_index[3]], local_code[local_code_chip_index[2]], local_code[local_code_chip_index[1]], local_code[local_code_chip_index[0]]);
+                    b0Val = _mm_unpacklo_ps(code, code);  // c0|c0|c1|c1
+                    b1Val = _mm_unpackhi_ps(code, code);  // c2|c2|c3|c3
+                    dotProdVal0[vec_ind] = _mm_add_ps(dotProdVal0[vec_ind], _mm_mul_ps(a0Val, b0Val));
+                    dotProdVal1[vec_ind] = _mm_add_ps(dotProdVal1[vec_ind], _mm_mul_ps(a1Val, b1Val));
+                }
+            indexn = _mm_add_ps(indexn, fours);
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    aux = _mm_hadd_ps(_mm_mul_ps(z0, z0), _mm_mul_ps(z1, z1));  // |z0|^2|z1|^2|z2|^2|z3|^2
+                    z0 = _mm_div_ps(z0, _mm_sqrt_ps(_mm_unpacklo_ps(aux, aux)));
+                    z1 = _mm_div_ps(z1, _mm_sqrt_ps(_mm_unpackhi_ps(aux, aux)));
+                }
+            aPtr += 8;
+        }
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            _mm_store_ps((float*)phase_vec, _mm_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]));
+            result[vec_ind] = phase_vec[0] + phase_vec[1];
+        }
+
+    _mm_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    for (number = quarterPoints * 4; number < num_points; number++)
+        {
+            lv_32fc_t wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * local_code[volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_index(code_phase_step_chips * (float)number + (shifts_chips[vec_ind] - rem_code_phase_chips), code_length_chips)];
+                }
+        }
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <volk_gnsssdr/volk_gnsssdr_avx_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_u_avx2(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int eighthPoints = num_points / 8;
+    const float* aPtr = (const float*)in_common;
+    unsigned int number;
+    unsigned int k;
+    int vec_ind;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t phase_vec[8];
+
+    const __m256 eights = _mm256_set1_ps(8.0f);
+    const __m256 code_phase_step_chips_reg = _mm256_set1_ps(code_phase_step_chips);
+    const __m256 code_length_chips_reg_f = _mm256_set1_ps((float)code_length_chips);
+    const __m256i code_length_chips_reg_i = _mm256_set1_epi32((int)code_length_chips);
+    const __m256i zeros = _mm256_setzero_si256();
+    __m256 indexn = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    __m256 a0Val, a1Val, code_phase, aux, c, base, code, lo, hi, b0Val, b1Val;
+    __m256i i, local_code_chip_index_reg, negatives;
+    __m256 tap_offset[num_a_vectors];
+    __m256 dotProdVal0[num_a_vectors];
+    __m256 dotProdVal1[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            tap_offset[vec_ind] = _mm256_set1_ps(shifts_chips[vec_ind] - rem_code_phase_chips);
+            dotProdVal0[vec_ind] = _mm256_setzero_ps();
+            dotProdVal1[vec_ind] = _mm256_setzero_ps();
+        }
+
+    // Set up the complex rotator
+    __m256 z0, z1, dz_reg;
+    for (k = 0; k < 8; ++k)
+        {
+            phase_vec[k] = _phase;
+            _phase *= phase_inc;
+        }
+    z0 = _mm256_load_ps((float*)phase_vec);
+    z1 = _mm256_load_ps((float*)(phase_vec + 4));
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^8
+    for (k = 0; k < 4; ++k)
+        {
+            phase_vec[k] = dz;
+        }
+    dz_reg = _mm256_complexnormalise_ps(_mm256_load_ps((float*)phase_vec));
+
+    for (number = 0; number < eighthPoints; number++)
+        {
+            a0Val = _mm256_loadu_ps(aPtr);
+            a1Val = _mm256_loadu_ps(aPtr + 8);
+            a0Val = _mm256_complexmul_ps(a0Val, z0);
+            a1Val = _mm256_complexmul_ps(a1Val, z1);
+            z0 = _mm256_complexmul_ps(z0, dz_reg);
+            z1 = _mm256_complexmul_ps(z1, dz_reg);
+
+            code_phase = _mm256_mul_ps(code_phase_step_chips_reg, indexn);
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    aux = _mm256_floor_ps(_mm256_add_ps(code_phase, tap_offset[vec_ind]));
+                    // fmod
+                    c = _mm256_div_ps(aux, code_length_chips_reg_f);
+                    i = _mm256_cvttps_epi32(c);
+                    base = _mm256_mul_ps(_mm256_cvtepi32_ps(i), code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm256_cvtps_epi32(_mm256_sub_ps(aux, base));
+                    negatives = _mm256_cmpgt_epi32(zeros, local_code_chip_index_reg);
+                    local_code_chip_index_reg = _mm256_add_epi32(local_code_chip_index_reg, _mm256_and_si256(code_length_chips_reg_i, negatives));
+
+                    code = _mm256_i32gather_ps(local_code, local_code_chip_index_reg, 4);
+                    lo = _mm256_unpacklo_ps(code, code);                // c0|c0|c1|c1|c4|c4|c5|c5
+                    hi = _mm256_unpackhi_ps(code, code);                // c2|c2|c3|c3|c6|c6|c7|c7
+                    b0Val = _mm256_permute2f128_ps(lo, hi, 0x20);       // c0|c0|c1|c1|c2|c2|c3|c3
+                    b1Val = _mm256_permute2f128_ps(lo, hi, 0x31);       // c4|c4|c5|c5|c6|c6|c7|c7
+                    dotProdVal0[vec_ind] = _mm256_add_ps(dotProdVal0[vec_ind], _mm256_mul_ps(a0Val, b0Val));
+                    dotProdVal1[vec_ind] = _mm256_add_ps(dotProdVal1[vec_ind], _mm256_mul_ps(a1Val, b1Val));
+                }
+            indexn = _mm256_add_ps(indexn, eights);
+
+            // Force the rotators back onto the unit circle
+            if ((number % 32) == 0)
+                {
+                    z0 = _mm256_complexnormalise_ps(z0);
+                    z1 = _mm256_complexnormalise_ps(z1);
+                }
+            aPtr += 16;
+        }
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            _mm256_store_ps((float*)phase_vec, _mm256_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]));
+            result[vec_ind] = lv_cmake(0, 0);
+            for (k = 0; k < 4; ++k)
+                {
+                    result[vec_ind] += phase_vec[k];
+                }
+        }
+
+    _mm256_store_ps((float*)phase_vec, _mm256_complexnormalise_ps(z0));
+    _phase = phase_vec[0];
+    _mm256_zeroupper();
+
+    for (number = eighthPoints * 8; number < num_points; number++)
+        {
+            lv_32fc_t wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * local_code[volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_index(code_phase_step_chips * (float)number + (shifts_chips[vec_ind] - rem_code_phase_chips), code_length_chips)];
+                }
+        }
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_u_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int sixteenthPoints = num_points / 16;
+    const float* aPtr = (const float*)in_common;
+    unsigned int number;
+    unsigned int k;
+    int vec_ind;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[16];
+    __VOLK_ATTR_ALIGNED(16)
+    float dotProduct[2];
+
+    const __m512 sixteens = _mm512_set1_ps(16.0f);
+    const __m512 code_phase_step_chips_reg = _mm512_set1_ps(code_phase_step_chips);
+    const __m512 code_length_chips_reg_f = _mm512_set1_ps((float)code_length_chips);
+    const __m512 zeros = _mm512_setzero_ps();
+    const __m512i lo_idx = _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0);
+    const __m512i hi_idx = _mm512_set_epi32(15, 15, 14, 14, 13, 13, 12, 12, 11, 11, 10, 10, 9, 9, 8, 8);
+    __m512 indexn = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f, 7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    __m512 a0Val, a1Val, code_phase, aux, cTrunc, code;
+    __m512i local_code_chip_index_reg;
+    __mmask16 negatives;
+    __m512 tap_offset[num_a_vectors];
+    __m512 dotProdVal0[num_a_vectors];
+    __m512 dotProdVal1[num_a_vectors];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; vec_ind++)
+        {
+            tap_offset[vec_ind] = _mm512_set1_ps(shifts_chips[vec_ind] - rem_code_phase_chips);
+            dotProdVal0[vec_ind] = _mm512_setzero_ps();
+            dotProdVal1[vec_ind] = _mm512_setzero_ps();
+        }
+
+    // Set up the complex rotator
+    __m512 z0, z1, dz_reg;
+    for (k = 0; k < 16; ++k)
+        {
+            phase_vec[k] = _phase;
+            _phase *= phase_inc;
+        }
+    z0 = _mm512_load_ps((float*)phase_vec);
+    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^16
+    for (k = 0; k < 8; ++k)
+        {
+            phase_vec[k] = dz;
+        }
+    dz_reg = _mm512_complexnormalise_ps(_mm512_load_ps((float*)phase_vec));
+
+    for (number = 0; number < sixteenthPoints; number++)
+        {
+            a0Val = _mm512_loadu_ps(aPtr);
+            a1Val = _mm512_loadu_ps(aPtr + 16);
+            a0Val = _mm512_complexmul_ps(a0Val, z0);
+            a1Val = _mm512_complexmul_ps(a1Val, z1);
+            z0 = _mm512_complexmul_ps(z0, dz_reg);
+            z1 = _mm512_complexmul_ps(z1, dz_reg);
+
+            code_phase = _mm512_mul_ps(code_phase_step_chips_reg, indexn);
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    aux = _mm512_roundscale_ps(_mm512_add_ps(code_phase, tap_offset[vec_ind]), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+                    // fmod
+                    cTrunc = _mm512_roundscale_ps(_mm512_div_ps(aux, code_length_chips_reg_f), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                    aux = _mm512_fnmadd_ps(cTrunc, code_length_chips_reg_f, aux);
+                    negatives = _mm512_cmp_ps_mask(aux, zeros, _CMP_LT_OS);
+                    aux = _mm512_mask_add_ps(aux, negatives, aux, code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm512_cvttps_epi32(aux);
+
+                    code = _mm512_i32gather_ps(local_code_chip_index_reg, local_code, 4);
+                    dotProdVal0[vec_ind] = _mm512_fmadd_ps(a0Val, _mm512_permutexvar_ps(lo_idx, code), dotProdVal0[vec_ind]);  // c0|c0|c1|c1|...|c7|c7
+                    dotProdVal1[vec_ind] = _mm512_fmadd_ps(a1Val, _mm512_permutexvar_ps(hi_idx, code), dotProdVal1[vec_ind]);  // c8|c8|c9|c9|...|c15|c15
+                }
+            indexn = _mm512_add_ps(indexn, sixteens);
+
+            // Force the rotators back onto the unit circle
+            if ((number % 16) == 0)
+                {
+                    z0 = _mm512_complexnormalise_ps(z0);
+                    z1 = _mm512_complexnormalise_ps(z1);
+                }
+            aPtr += 32;
+        }
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            _mm512_complexstore_sum_ps(dotProduct, _mm512_add_ps(dotProdVal0[vec_ind], dotProdVal1[vec_ind]));
+            result[vec_ind] = lv_cmake(dotProduct[0], dotProduct[1]);
+        }
+
+    _mm512_store_ps((float*)phase_vec, _mm512_complexnormalise_ps(z0));
+    _phase = phase_vec[0];
+    _mm256_zeroupper();
+
+    for (number = sixteenthPoints * 16; number < num_points; number++)
+        {
+            lv_32fc_t wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * local_code[volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_index(code_phase_step_chips * (float)number + (shifts_chips[vec_ind] - rem_code_phase_chips), code_length_chips)];
+                }
+        }
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_H */
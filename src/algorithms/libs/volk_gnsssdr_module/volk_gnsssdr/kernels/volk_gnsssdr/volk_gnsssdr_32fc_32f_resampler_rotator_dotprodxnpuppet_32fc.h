@@ -0,0 +1,120 @@
+/*!
+ * \file volk_gnsssdr_32fc_32f_resampler_rotator_dotprodxnpuppet_32fc.h
+ * \brief Volk puppet for the fused resampler, rotator and multiple dot product kernel.
+ *
+ * Volk puppet for integrating the fused resampler and correlator into volk's test system
+ *
+ * -------------------------------------------------------------------------
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_32f_resampler_rotator_dotprodxnpuppet_32fc_H
+#define INCLUDED_volk_gnsssdr_32fc_32f_resampler_rotator_dotprodxnpuppet_32fc_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dotprodxnpuppet_32fc_generic(lv_32fc_t* result, const lv_32fc_t* local_code, const float* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.25;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    // the real input is used as the code table, with chip boundaries away from the sampling instants
+    float rem_code_phase_chips = 0.25;
+    float code_phase_step_chips = 0.375;
+    float shifts_chips[3] = {-0.5, 0.0, 0.5};
+    int num_a_vectors = 3;
+    volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_generic(result, local_code, phase_inc[0], phase, in, rem_code_phase_chips, code_phase_step_chips, shifts_chips, num_points, num_a_vectors, num_points);
+}
+
+#endif  // Generic
+
+#ifdef LV_HAVE_SSE4_1
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dotprodxnpuppet_32fc_u_sse4_1(lv_32fc_t* result, const lv_32fc_t* local_code, const float* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.25;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    // the real input is used as the code table, with chip boundaries away from the sampling instants
+    float rem_code_phase_chips = 0.25;
+    float code_phase_step_chips = 0.375;
+    float shifts_chips[3] = {-0.5, 0.0, 0.5};
+    int num_a_vectors = 3;
+    volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_u_sse4_1(result, local_code, phase_inc[0], phase, in, rem_code_phase_chips, code_phase_step_chips, shifts_chips, num_points, num_a_vectors, num_points);
+}
+
+#endif  // SSE4_1
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dotprodxnpuppet_32fc_u_avx2(lv_32fc_t* result, const lv_32fc_t* local_code, const float* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.25;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    // the real input is used as the code table, with chip boundaries away from the sampling instants
+    float rem_code_phase_chips = 0.25;
+    float code_phase_step_chips = 0.375;
+    float shifts_chips[3] = {-0.5, 0.0, 0.5};
+    int num_a_vectors = 3;
+    volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_u_avx2(result, local_code, phase_inc[0], phase, in, rem_code_phase_chips, code_phase_step_chips, shifts_chips, num_points, num_a_vectors, num_points);
+}
+
+#endif  // AVX2
+
+#ifdef LV_HAVE_AVX512F
+static inline void volk_gnsssdr_32fc_32f_resampler_rotator_dotprodxnpuppet_32fc_u_avx512f(lv_32fc_t* result, const lv_32fc_t* local_code, const float* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.25;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    // the real input is used as the code table, with chip boundaries away from the sampling instants
+    float rem_code_phase_chips = 0.25;
+    float code_phase_step_chips = 0.375;
+    float shifts_chips[3] = {-0.5, 0.0, 0.5};
+    int num_a_vectors = 3;
+    volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn_u_avx512f(result, local_code, phase_inc[0], phase, in, rem_code_phase_chips, code_phase_step_chips, shifts_chips, num_points, num_a_vectors, num_points);
+}
+
+#endif  // AVX512F
+
+#endif  // INCLUDED_volk_gnsssdr_32fc_32f_resampler_rotator_dotprodxnpuppet_32fc_H
@@ -0,0 +1,401 @@
+/*!
+ * \file volk_gnsssdr_32fc_mag_squared_accumulate_max_32f.h
+ * \brief VOLK_GNSSSDR kernel: accumulates the squared magnitude of a complex
+ * vector and finds the maximum of the result.
+ *
+ * VOLK_GNSSSDR kernel that computes the squared magnitude of a 32-bit float
+ * complex vector, adds it to (or stores it into) a vector of floats, and
+ * returns the maximum of the result and its index, all in a single pass over
+ * the data.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32fc_mag_squared_accumulate_max_32f
+ *
+ * \b Overview
+ *
+ * Computes the squared magnitude of each element of a complex vector and
+ * adds it to the accumulator vector (or overwrites it, for the first of a
+ * series of non-coherent integrations). It also returns the maximum value
+ * of the updated accumulator and the index of its first occurrence.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_mag_squared_accumulate_max_32f(float* accumulator, uint32_t* max_index, float* max_value, const lv_32fc_t* inVector, int accumulate, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li accumulator: Vector of floats to which the squared magnitudes are added, if \p accumulate is not 0.
+ * \li inVector:    Complex input vector.
+ * \li accumulate:  If 0, the accumulator is overwritten with the squared magnitudes.
+ * \li num_points:  Number of elements of \p inVector and \p accumulator.
+ *
+ * \b Outputs
+ * \li accumulator: Updated vector.
+ * \li max_index:   Index of the maximum value of the updated accumulator.
+ * \li max_value:   Maximum value of the updated accumulator.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_H
+#define INCLUDED_volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <float.h>
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_generic(float* accumulator, uint32_t* max_index, float* max_value, const lv_32fc_t* inVector, int accumulate, unsigned int num_points)
+{
+    const float* in = (const float*)inVector;
+    float max = -FLT_MAX;
+    uint32_t index = 0;
+    float mag;
+    unsigned int number;
+    for (number = 0; number < num_points; number++)
+        {
+            mag = in[2 * number] * in[2 * number] + in[2 * number + 1] * in[2 * number + 1];
+            accumulator[number] = (accumulate ? accumulator[number] + mag : mag);
+            if (accumulator[number] > max)
+                {
+                    max = accumulator[number];
+                    index = number;
+                }
+        }
+    *max_index = index;
+    *max_value = max;
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_a_sse3(float* accumulator, uint32_t* max_index, float* max_value, const lv_32fc_t* inVector, int accumulate, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    const float* in = (const float*)inVector;
+    float* acc = accumulator;
+    unsigned int number;
+    unsigned int i;
+
+    __m128 a, b, mag, accValues, compareResults;
+    __m128 maxValues = _mm_set1_ps(-FLT_MAX);
+    __m128 maxValuesIndex = _mm_setzero_ps();
+    __m128 currentIndexes = _mm_set_ps(-1, -2, -3, -4);
+    const __m128 indexIncrementValues = _mm_set1_ps(4);
+
+    __VOLK_ATTR_ALIGNED(16)
+    float maxValuesBuffer[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float maxIndexesBuffer[4];
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            a = _mm_load_ps(in);
+            b = _mm_load_ps(in + 4);
+            in += 8;
+            a = _mm_mul_ps(a, a);     // ar*ar, ai*ai, br*br, bi*bi
+            b = _mm_mul_ps(b, b);     // cr*cr, ci*ci, dr*dr, di*di
+            mag = _mm_hadd_ps(a, b);  // |a|^2, |b|^2, |c|^2, |d|^2
+            accValues = (accumulate ? _mm_add_ps(_mm_load_ps(acc), mag) : mag);
+            _mm_store_ps(acc, accValues);
+            acc += 4;
+
+            currentIndexes = _mm_add_ps(currentIndexes, indexIncrementValues);
+            compareResults = _mm_cmpgt_ps(accValues, maxValues);
+            maxValuesIndex = _mm_or_ps(_mm_and_ps(compareResults, currentIndexes), _mm_andnot_ps(compareResults, maxValuesIndex));
+            maxValues = _mm_or_ps(_mm_and_ps(compareResults, accValues), _mm_andnot_ps(compareResults, maxValues));
+        }
+
+    _mm_store_ps(maxValuesBuffer, maxValues);
+    _mm_store_ps(maxIndexesBuffer, maxValuesIndex);
+
+    // Each lane holds its first maximum, so ties are solved by the lowest index
+    float max = -FLT_MAX;
+    float index = 0;
+    for (i = 0; i < 4; i++)
+        {
+            if (maxValuesBuffer[i] > max || (maxValuesBuffer[i] == max && maxIndexesBuffer[i] < index))
+                {
+                    index = maxIndexesBuffer[i];
+                    max = maxValuesBuffer[i];
+                }
+        }
+
+    uint32_t max_idx = (uint32_t)index;
+    float mag_tail;
+    for (number = sse_iters * 4; number < num_points; number++)
+        {
+            mag_tail = in[0] * in[0] + in[1] * in[1];
+            in += 2;
+            accumulator[number] = (accumulate ? accumulator[number] + mag_tail : mag_tail);
+            if (accumulator[number] > max)
+                {
+                    max = accumulator[number];
+                    max_idx = number;
+                }
+        }
+    *max_index = max_idx;
+    *max_value = max;
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_u_sse3(float* accumulator, uint32_t* max_index, float* max_value, const lv_32fc_t* inVector, int accumulate, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    const float* in = (const float*)inVector;
+    float* acc = accumulator;
+    unsigned int number;
+    unsigned int i;
+
+    __m128 a, b, mag, accValues, compareResults;
+    __m128 maxValues = _mm_set1_ps(-FLT_MAX);
+    __m128 maxValuesIndex = _mm_setzero_ps();
+    __m128 currentIndexes = _mm_set_ps(-1, -2, -3, -4);
+    const __m128 indexIncrementValues = _mm_set1_ps(4);
+
+    __VOLK_ATTR_ALIGNED(16)
+    float maxValuesBuffer[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float maxIndexesBuffer[4];
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            a = _mm_loadu_ps(in);
+            b = _mm_loadu_ps(in + 4);
+            in += 8;
+            a = _mm_mul_ps(a, a);     // ar*ar, ai*ai, br*br, bi*bi
+            b = _mm_mul_ps(b, b);     // cr*cr, ci*ci, dr*dr, di*di
+            mag = _mm_hadd_ps(a, b);  // |a|^2, |b|^2, |c|^2, |d|^2
+            accValues = (accumulate ? _mm_add_ps(_mm_loadu_ps(acc), mag) : mag);
+            _mm_storeu_ps(acc, accValues);
+            acc += 4;
+
+            currentIndexes = _mm_add_ps(currentIndexes, indexIncrementValues);
+            compareResults = _mm_cmpgt_ps(accValues, maxValues);
+            maxValuesIndex = _mm_or_ps(_mm_and_ps(compareResults, currentIndexes), _mm_andnot_ps(compareResults, maxValuesIndex));
+            maxValues = _mm_or_ps(_mm_and_ps(compareResults, accValues), _mm_andnot_ps(compareResults, maxValues));
+        }
+
+    _mm_store_ps(maxValuesBuffer, maxValues);
+    _mm_store_ps(maxIndexesBuffer, maxValuesIndex);
+
+    // Each lane holds its first maximum, so ties are solved by the lowest index
+    float max = -FLT_MAX;
+    float index = 0;
+    for (i = 0; i < 4; i++)
+        {
+            if (maxValuesBuffer[i] > max || (maxValuesBuffer[i] == max && maxIndexesBuffer[i] < index))
+                {
+                    index = maxIndexesBuffer[i];
+                    max = maxValuesBuffer[i];
+                }
+        }
+
+    uint32_t max_idx = (uint32_t)index;
+    float mag_tail;
+    for (number = sse_iters * 4; number < num_points; number++)
+        {
+            mag_tail = in[0] * in[0] + in[1] * in[1];
+            in += 2;
+            accumulator[number] = (accumulate ? accumulator[number] + mag_tail : mag_tail);
+            if (accumulator[number] > max)
+                {
+                    max = accumulator[number];
+                    max_idx = number;
+                }
+        }
+    *max_index = max_idx;
+    *max_value = max;
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_a_avx(float* accumulator, uint32_t* max_index, float* max_value, const lv_32fc_t* inVector, int accumulate, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 8;
+    const float* in = (const float*)inVector;
+    float* acc = accumulator;
+    unsigned int number;
+    unsigned int i;
+
+    __m256 a, b, lo, hi, mag, accValues, compareResults;
+    __m256 maxValues = _mm256_set1_ps(-FLT_MAX);
+    __m256 maxValuesIndex = _mm256_setzero_ps();
+    __m256 currentIndexes = _mm256_set_ps(-1, -2, -3, -4, -5, -6, -7, -8);
+    const __m256 indexIncrementValues = _mm256_set1_ps(8);
+
+    __VOLK_ATTR_ALIGNED(32)
+    float maxValuesBuffer[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float maxIndexesBuffer[8];
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            a = _mm256_load_ps(in);
+            b = _mm256_load_ps(in + 8);
+            in += 16;
+            a = _mm256_mul_ps(a, a);
+            b = _mm256_mul_ps(b, b);
+            lo = _mm256_permute2f128_ps(a, b, 0x20);  // elements 0, 1, 4, 5
+            hi = _mm256_permute2f128_ps(a, b, 0x31);  // elements 2, 3, 6, 7
+            mag = _mm256_hadd_ps(lo, hi);             // |x_0|^2 ... |x_7|^2, in order
+            accValues = (accumulate ? _mm256_add_ps(_mm256_load_ps(acc), mag) : mag);
+            _mm256_store_ps(acc, accValues);
+            acc += 8;
+
+            currentIndexes = _mm256_add_ps(currentIndexes, indexIncrementValues);
+            compareResults = _mm256_cmp_ps(accValues, maxValues, _CMP_GT_OS);
+            maxValuesIndex = _mm256_blendv_ps(maxValuesIndex, currentIndexes, compareResults);
+            maxValues = _mm256_blendv_ps(maxValues, accValues, compareResults);
+        }
+
+    _mm256_store_ps(maxValuesBuffer, maxValues);
+    _mm256_store_ps(maxIndexesBuffer, maxValuesIndex);
+
+    // Each lane holds its first maximum, so ties are solved by the lowest index
+    float max = -FLT_MAX;
+    float index = 0;
+    for (i = 0; i < 8; i++)
+        {
+            if (maxValuesBuffer[i] > max || (maxValuesBuffer[i] == max && maxIndexesBuffer[i] < index))
+                {
+                    index = maxIndexesBuffer[i];
+                    max = maxValuesBuffer[i];
+                }
+        }
+
+    uint32_t max_idx = (uint32_t)index;
+    float mag_tail;
+    for (number = avx_iters * 8; number < num_points; number++)
+        {
+            mag_tail = in[0] * in[0] + in[1] * in[1];
+            in += 2;
+            accumulator[number] = (accumulate ? accumulator[number] + mag_tail : mag_tail);
+            if (accumulator[number] > max)
+                {
+                    max = accumulator[number];
+                    max_idx = number;
+                }
+        }
+    *max_index = max_idx;
+    *max_value = max;
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_u_avx(float* accumulator, uint32_t* max_index, float* max_value, const lv_32fc_t* inVector, int accumulate, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 8;
+    const float* in = (const float*)inVector;
+    float* acc = accumulator;
+    unsigned int number;
+    unsigned int i;
+
+    __m256 a, b, lo, hi, mag, accValues, compareResults;
+    __m256 maxValues = _mm256_set1_ps(-FLT_MAX);
+    __m256 maxValuesIndex = _mm256_setzero_ps();
+    __m256 currentIndexes = _mm256_set_ps(-1, -2, -3, -4, -5, -6, -7, -8);
+    const __m256 indexIncrementValues = _mm256_set1_ps(8);
+
+    __VOLK_ATTR_ALIGNED(32)
+    float maxValuesBuffer[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float maxIndexesBuffer[8];
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            a = _mm256_loadu_ps(in);
+            b = _mm256_loadu_ps(in + 8);
+            in += 16;
+            a = _mm256_mul_ps(a, a);
+            b = _mm256_mul_ps(b, b);
+            lo = _mm256_permute2f128_ps(a, b, 0x20);  // elements 0, 1, 4, 5
+            hi = _mm256_permute2f128_ps(a, b, 0x31);  // elements 2, 3, 6, 7
+            mag = _mm256_hadd_ps(lo, hi);             // |x_0|^2 ... |x_7|^2, in order
+            accValues = (accumulate ? _mm256_add_ps(_mm256_loadu_ps(acc), mag) : mag);
+            _mm256_storeu_ps(acc, accValues);
+            acc += 8;
+
+            currentIndexes = _mm256_add_ps(currentIndexes, indexIncrementValues);
+            compareResults = _mm256_cmp_ps(accValues, maxValues, _CMP_GT_OS);
+            maxValuesIndex = _mm256_blendv_ps(maxValuesIndex, currentIndexes, compareResults);
+            maxValues = _mm256_blendv_ps(maxValues, accValues, compareResults);
+        }
+
+    _mm256_store_ps(maxValuesBuffer, maxValues);
+    _mm256_store_ps(maxIndexesBuffer, maxValuesIndex);
+
+    // Each lane holds its first maximum, so ties are solved by the lowest index
+    float max = -FLT_MAX;
+    float index = 0;
+    for (i = 0; i < 8; i++)
+        {
+            if (maxValuesBuffer[i] > max || (maxValuesBuffer[i] == max && maxIndexesBuffer[i] < index))
+                {
+                    index = maxIndexesBuffer[i];
+                    max = maxValuesBuffer[i];
+                }
+        }
+
+    uint32_t max_idx = (uint32_t)index;
+    float mag_tail;
+    for (number = avx_iters * 8; number < num_points; number++)
+        {
+            mag_tail = in[0] * in[0] + in[1] * in[1];
+            in += 2;
+            accumulator[number] = (accumulate ? accumulator[number] + mag_tail : mag_tail);
+            if (accumulator[number] > max)
+                {
+                    max = accumulator[number];
+                    max_idx = number;
+                }
+        }
+    *max_index = max_idx;
+    *max_value = max;
+}
+
+#endif /* LV_HAVE_AVX */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_H */
@@ -0,0 +1,130 @@
+/*!
+ * \file volk_gnsssdr_32fc_magaccumulatemaxpuppet_32f.h
+ * \brief VOLK_GNSSSDR puppet for the volk_gnsssdr_32fc_mag_squared_accumulate_max_32f kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the volk_gnsssdr_32fc_mag_squared_accumulate_max_32f
+ * kernel into the test system
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_magaccumulatemaxpuppet_32f_H
+#define INCLUDED_volk_gnsssdr_32fc_magaccumulatemaxpuppet_32f_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32fc_mag_squared_accumulate_max_32f.h"
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_32fc_magaccumulatemaxpuppet_32f_generic(float* result, const lv_32fc_t* inVector, unsigned int num_points)
+{
+    // Two dwells of the same input, so that both storing and accumulating are checked
+    uint32_t max_index = 0;
+    float max_value = 0.0f;
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_generic(result, &max_index, &max_value, inVector, 0, num_points);
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_generic(result, &max_index, &max_value, inVector, 1, num_points);
+    if (num_points > 1)
+        {
+            result[0] = max_value;
+            result[1] = (float)max_index;
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE3
+static inline void volk_gnsssdr_32fc_magaccumulatemaxpuppet_32f_a_sse3(float* result, const lv_32fc_t* inVector, unsigned int num_points)
+{
+    // Two dwells of the same input, so that both storing and accumulating are checked
+    uint32_t max_index = 0;
+    float max_value = 0.0f;
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_a_sse3(result, &max_index, &max_value, inVector, 0, num_points);
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_a_sse3(result, &max_index, &max_value, inVector, 1, num_points);
+    if (num_points > 1)
+        {
+            result[0] = max_value;
+            result[1] = (float)max_index;
+        }
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_SSE3
+static inline void volk_gnsssdr_32fc_magaccumulatemaxpuppet_32f_u_sse3(float* result, const lv_32fc_t* inVector, unsigned int num_points)
+{
+    // Two dwells of the same input, so that both storing and accumulating are checked
+    uint32_t max_index = 0;
+    float max_value = 0.0f;
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_u_sse3(result, &max_index, &max_value, inVector, 0, num_points);
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_u_sse3(result, &max_index, &max_value, inVector, 1, num_points);
+    if (num_points > 1)
+        {
+            result[0] = max_value;
+            result[1] = (float)max_index;
+        }
+}
+
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_AVX
+static inline void volk_gnsssdr_32fc_magaccumulatemaxpuppet_32f_a_avx(float* result, const lv_32fc_t* inVector, unsigned int num_points)
+{
+    // Two dwells of the same input, so that both storing and accumulating are checked
+    uint32_t max_index = 0;
+    float max_value = 0.0f;
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_a_avx(result, &max_index, &max_value, inVector, 0, num_points);
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_a_avx(result, &max_index, &max_value, inVector, 1, num_points);
+    if (num_points > 1)
+        {
+            result[0] = max_value;
+            result[1] = (float)max_index;
+        }
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_AVX
+static inline void volk_gnsssdr_32fc_magaccumulatemaxpuppet_32f_u_avx(float* result, const lv_32fc_t* inVector, unsigned int num_points)
+{
+    // Two dwells of the same input, so that both storing and accumulating are checked
+    uint32_t max_index = 0;
+    float max_value = 0.0f;
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_u_avx(result, &max_index, &max_value, inVector, 0, num_points);
+    volk_gnsssdr_32fc_mag_squared_accumulate_max_32f_u_avx(result, &max_index, &max_value, inVector, 1, num_points);
+    if (num_points > 1)
+        {
+            result[0] = max_value;
+            result[1] = (float)max_index;
+        }
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_magaccumulatemaxpuppet_32f_H */
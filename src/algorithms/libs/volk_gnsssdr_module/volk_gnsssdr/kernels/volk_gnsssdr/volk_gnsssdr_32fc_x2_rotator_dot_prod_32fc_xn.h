@@ -647,6 +647,194 @@ static inline void volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn_a_avx(lv_32fc_t
 #endif /* LV_HAVE_AVX */
 
 
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn_u_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_32fc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    lv_32fc_t tmp32_1, tmp32_2;
+    const unsigned int avx512_iters = num_points / 8;
+    int n_vec;
+    unsigned int number;
+    unsigned int n;
+    const lv_32fc_t** _in_a = in_a;
+    const lv_32fc_t* _in_common = in_common;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(16)
+    float dotProduct[2];
+
+    __m512* acc = (__m512*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m512), 64);
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm512_setzero_ps();
+            result[n_vec] = lv_cmake(0, 0);
+        }
+
+    // phase rotation registers
+    __m512 a, eight_phase_acc_reg, z;
+
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t eight_phase_acc[8];
+    for (n_vec = 0; n_vec < 8; n_vec++)
+        {
+            eight_phase_acc[n_vec] = _phase;
+            _phase *= phase_inc;
+        }
+    eight_phase_acc_reg = _mm512_load_ps((float*)eight_phase_acc);
+
+    lv_32fc_t phase_inc8 = phase_inc * phase_inc;
+    phase_inc8 *= phase_inc8;
+    phase_inc8 *= phase_inc8;
+    for (n_vec = 0; n_vec < 8; n_vec++)
+        {
+            eight_phase_acc[n_vec] = phase_inc8;
+        }
+    const __m512 eight_phase_inc_reg = _mm512_load_ps((float*)eight_phase_acc);
+
+    for (number = 0; number < avx512_iters; number++)
+        {
+            // Phase rotation on operand in_common starts here:
+            a = _mm512_loadu_ps((float*)_in_common);
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 16);
+            z = _mm512_complexmul_ps(a, eight_phase_acc_reg);
+            eight_phase_acc_reg = _mm512_complexmul_ps(eight_phase_acc_reg, eight_phase_inc_reg);
+            _in_common += 8;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    a = _mm512_loadu_ps((float*)&(_in_a[n_vec][number * 8]));
+                    acc[n_vec] = _mm512_add_ps(acc[n_vec], _mm512_complexmul_ps(a, z));
+                }
+            // Regenerate phase
+            if ((number % 128) == 0)
+                {
+                    eight_phase_acc_reg = _mm512_complexnormalise_ps(eight_phase_acc_reg);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            _mm512_complexstore_sum_ps(dotProduct, acc[n_vec]);
+            result[n_vec] = lv_cmake(dotProduct[0], dotProduct[1]);
+        }
+    volk_gnsssdr_free(acc);
+
+    eight_phase_acc_reg = _mm512_complexnormalise_ps(eight_phase_acc_reg);
+    _mm512_store_ps((float*)eight_phase_acc, eight_phase_acc_reg);
+    _phase = eight_phase_acc[0];
+    _mm256_zeroupper();
+
+    for (n = avx512_iters * 8; n < num_points; n++)
+        {
+            tmp32_1 = *_in_common++ * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    tmp32_2 = tmp32_1 * _in_a[n_vec][n];
+                    result[n_vec] += tmp32_2;
+                }
+        }
+    (*phase) = _phase;
+}
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn_a_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_32fc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    lv_32fc_t tmp32_1, tmp32_2;
+    const unsigned int avx512_iters = num_points / 8;
+    int n_vec;
+    unsigned int number;
+    unsigned int n;
+    const lv_32fc_t** _in_a = in_a;
+    const lv_32fc_t* _in_common = in_common;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(16)
+    float dotProduct[2];
+
+    __m512* acc = (__m512*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m512), 64);
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm512_setzero_ps();
+            result[n_vec] = lv_cmake(0, 0);
+        }
+
+    // phase rotation registers
+    __m512 a, eight_phase_acc_reg, z;
+
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t eight_phase_acc[8];
+    for (n_vec = 0; n_vec < 8; n_vec++)
+        {
+            eight_phase_acc[n_vec] = _phase;
+            _phase *= phase_inc;
+        }
+    eight_phase_acc_reg = _mm512_load_ps((float*)eight_phase_acc);
+
+    lv_32fc_t phase_inc8 = phase_inc * phase_inc;
+    phase_inc8 *= phase_inc8;
+    phase_inc8 *= phase_inc8;
+    for (n_vec = 0; n_vec < 8; n_vec++)
+        {
+            eight_phase_acc[n_vec] = phase_inc8;
+        }
+    const __m512 eight_phase_inc_reg = _mm512_load_ps((float*)eight_phase_acc);
+
+    for (number = 0; number < avx512_iters; number++)
+        {
+            // Phase rotation on operand in_common starts here:
+            a = _mm512_load_ps((float*)_in_common);
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 16);
+            z = _mm512_complexmul_ps(a, eight_phase_acc_reg);
+            eight_phase_acc_reg = _mm512_complexmul_ps(eight_phase_acc_reg, eight_phase_inc_reg);
+            _in_common += 8;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    a = _mm512_load_ps((float*)&(_in_a[n_vec][number * 8]));
+                    acc[n_vec] = _mm512_add_ps(acc[n_vec], _mm512_complexmul_ps(a, z));
+                }
+            // Regenerate phase
+            if ((number % 128) == 0)
+                {
+                    eight_phase_acc_reg = _mm512_complexnormalise_ps(eight_phase_acc_reg);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            _mm512_complexstore_sum_ps(dotProduct, acc[n_vec]);
+            result[n_vec] = lv_cmake(dotProduct[0], dotProduct[1]);
+        }
+    volk_gnsssdr_free(acc);
+
+    eight_phase_acc_reg = _mm512_complexnormalise_ps(eight_phase_acc_reg);
+    _mm512_store_ps((float*)eight_phase_acc, eight_phase_acc_reg);
+    _phase = eight_phase_acc[0];
+    _mm256_zeroupper();
+
+    for (n = avx512_iters * 8; n < num_points; n++)
+        {
+            tmp32_1 = *_in_common++ * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    tmp32_2 = tmp32_1 * _in_a[n_vec][n];
+                    result[n_vec] += tmp32_2;
+                }
+        }
+    (*phase) = _phase;
+}
+#endif /* LV_HAVE_AVX512F */
+
+
 #ifdef LV_HAVE_NEONV7
 #include <arm_neon.h>
 
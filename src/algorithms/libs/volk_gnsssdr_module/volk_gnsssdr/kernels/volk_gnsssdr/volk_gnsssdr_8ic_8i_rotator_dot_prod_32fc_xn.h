@@ -0,0 +1,423 @@
+/*!
+ * \file volk_gnsssdr_8ic_8i_rotator_dot_prod_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: multiplies N 8 bits real vectors by a common 8 bits
+ * complex vector phase rotated and accumulates the results in N float complex outputs.
+ *
+ * VOLK_GNSSSDR kernel that multiplies N 8 bits real vectors by a common vector, which is
+ * phase-rotated by phase offset and phase increment, and accumulates the results
+ * in N 32 bits float complex outputs.
+ * The carrier replica is quantized to 8 bits, so that the wipe-off and the code
+ * products can be computed in 16 bits lanes and accumulated in 32 bits lanes with
+ * widening multiply-add instructions.
+ * It is optimized to perform the N tap correlation process in GNSS receivers
+ * working with 8 bits (or less) input samples.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8ic_8i_rotator_dot_prod_32fc_xn
+ *
+ * \b Overview
+ *
+ * Rotates the reference complex vector, multiplies it by an arbitrary number of real vectors,
+ * accumulates the results and stores them in the output vector.
+ * The rotation is done at a fixed rate per sample, from an initial \p phase offset.
+ * At each sample, the rotating phasor is scaled by 128 and rounded to the nearest
+ * integer before it multiplies the input sample, and the accumulated values are scaled
+ * back by 1/128 at the output.
+ * This function can be used for Doppler wipe-off and multiple correlator.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8ic_8i_rotator_dot_prod_32fc_xn(lv_32fc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const int8_t** in_a, int num_a_vectors, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:     Pointer to one of the vectors to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc:     Phase increment = lv_cmake(cos(phase_step_rad), sin(phase_step_rad))
+ * \li phase:         Initial phase = lv_cmake(cos(initial_phase_rad), sin(initial_phase_rad))
+ * \li in_a:          Pointer to an array of pointers to multiple vectors to be multiplied and accumulated.
+ * \li num_a_vectors: Number of vectors to be multiplied by the reference vector and accumulated.
+ * \li num_points:    Number of complex values to be multiplied together, accumulated and stored into \p result.
+ *
+ * \b Outputs
+ * \li phase:         Final phase.
+ * \li result:        Vector of \p num_a_vectors components with the multiple vectors of \p in_a rotated, multiplied by \p in_common and accumulated.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_8i_rotator_dot_prod_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_8ic_8i_rotator_dot_prod_32fc_xn_H
+
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8ic_8i_rotator_dot_prod_32fc_xn_generic(lv_32fc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const int8_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    int32_t carrier_re, carrier_im, rotated_re, rotated_im;
+    int64_t acc_re[num_a_vectors];
+    int64_t acc_im[num_a_vectors];
+    int n_vec;
+    unsigned int n;
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            acc_re[n_vec] = 0;
+            acc_im[n_vec] = 0;
+        }
+    for (n = 0; n < num_points; n++)
+        {
+            // Regenerate phase
+            if (n % 256 == 0)
+                {
+#ifdef __cplusplus
+                    (*phase) /= std::abs((*phase));
+#else
+                    (*phase) /= hypotf(lv_creal(*phase), lv_cimag(*phase));
+#endif
+                }
+            carrier_re = (int32_t)rintf(128.0f * lv_creal(*phase));
+            carrier_im = (int32_t)rintf(128.0f * lv_cimag(*phase));
+            rotated_re = (int32_t)lv_creal(in_common[n]) * carrier_re - (int32_t)lv_cimag(in_common[n]) * carrier_im;
+            rotated_im = (int32_t)lv_creal(in_common[n]) * carrier_im + (int32_t)lv_cimag(in_common[n]) * carrier_re;
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    acc_re[n_vec] += (int64_t)in_a[n_vec][n] * rotated_re;
+                    acc_im[n_vec] += (int64_t)in_a[n_vec][n] * rotated_im;
+                }
+        }
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake((float)acc_re[n_vec] / 128.0f, (float)acc_im[n_vec] / 128.0f);
+        }
+}
+
+#endif /*LV_HAVE_GENERIC*/
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_8i_rotator_dot_prod_32fc_xn_u_sse4_1(lv_32fc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const int8_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int eighthPoints = num_points / 8;
+    const lv_8sc_t* _in_common = in_common;
+    int32_t carrier_re, carrier_im, rotated_re, rotated_im;
+    int n_vec;
+    unsigned int number;
+    unsigned int k;
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t dz;
+
+    __VOLK_ATTR_ALIGNED(16)
+    float phase_re[8];
+    __VOLK_ATTR_ALIGNED(16)
+    float phase_im[8];
+    __VOLK_ATTR_ALIGNED(16)
+    float dotProduct_re[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float dotProduct_im[4];
+
+    // The 32 bits integer accumulators are flushed into the float ones every 256 iterations,
+    // which keeps them away from overflow for any 8 bits input
+    __m128i acc_re[num_a_vectors];
+    __m128i acc_im[num_a_vectors];
+    __m128 accf_re[num_a_vectors];
+    __m128 accf_im[num_a_vectors];
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            acc_re[n_vec] = _mm_setzero_si128();
+            acc_im[n_vec] = _mm_setzero_si128();
+            accf_re[n_vec] = _mm_setzero_ps();
+            accf_im[n_vec] = _mm_setzero_ps();
+        }
+
+    const __m128i deinterleave = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+    const __m128 scale = _mm_set1_ps(128.0f);
+
+    // Set up the complex rotator, with real and imaginary parts in separate registers
+    for (k = 0; k < 8; ++k)
+        {
+            phase_re[k] = lv_creal(_phase);
+            phase_im[k] = lv_cimag(_phase);
+            _phase *= phase_inc;
+        }
+    __m128 p0_re = _mm_load_ps(phase_re);
+    __m128 p0_im = _mm_load_ps(phase_im);
+    __m128 p1_re = _mm_load_ps(phase_re + 4);
+    __m128 p1_im = _mm_load_ps(phase_im + 4);
+
+    dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^8
+    dz /= hypotf(lv_creal(dz), lv_cimag(dz));
+    const __m128 dz_re = _mm_set1_ps(lv_creal(dz));
+    const __m128 dz_im = _mm_set1_ps(lv_cimag(dz));
+
+    __m128i s, s_re, s_im, c_re, c_im, x_re, x_im, code;
+    __m128 tmp, mag;
+
+    for (number = 0; number < eighthPoints; number++)
+        {
+            s = _mm_loadu_si128((const __m128i*)_in_common);  // r0|i0|r1|i1|...|r7|i7
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 16);
+            s = _mm_shuffle_epi8(s, deinterleave);  // r0|...|r7|i0|...|i7
+            s_re = _mm_cvtepi8_epi16(s);
+            s_im = _mm_cvtepi8_epi16(_mm_srli_si128(s, 8));
+
+            // quantize the carrier replica
+            c_re = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(p0_re, scale)), _mm_cvtps_epi32(_mm_mul_ps(p1_re, scale)));
+            c_im = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(p0_im, scale)), _mm_cvtps_epi32(_mm_mul_ps(p1_im, scale)));
+
+            // carrier wipe-off, exact in 16 bits
+            x_re = _mm_sub_epi16(_mm_mullo_epi16(s_re, c_re), _mm_mullo_epi16(s_im, c_im));
+            x_im = _mm_add_epi16(_mm_mullo_epi16(s_re, c_im), _mm_mullo_epi16(s_im, c_re));
+
+            tmp = _mm_sub_ps(_mm_mul_ps(p0_re, dz_re), _mm_mul_ps(p0_im, dz_im));
+            p0_im = _mm_add_ps(_mm_mul_ps(p0_re, dz_im), _mm_mul_ps(p0_im, dz_re));
+            p0_re = tmp;
+            tmp = _mm_sub_ps(_mm_mul_ps(p1_re, dz_re), _mm_mul_ps(p1_im, dz_im));
+            p1_im = _mm_add_ps(_mm_mul_ps(p1_re, dz_im), _mm_mul_ps(p1_im, dz_re));
+            p1_re = tmp;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i*)&(in_a[n_vec][number * 8])));
+                    acc_re[n_vec] = _mm_add_epi32(acc_re[n_vec], _mm_madd_epi16(x_re, code));
+                    acc_im[n_vec] = _mm_add_epi32(acc_im[n_vec], _mm_madd_epi16(x_im, code));
+                }
+
+            if ((number % 256) == 255)
+                {
+                    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                        {
+                            accf_re[n_vec] = _mm_add_ps(accf_re[n_vec], _mm_cvtepi32_ps(acc_re[n_vec]));
+                            accf_im[n_vec] = _mm_add_ps(accf_im[n_vec], _mm_cvtepi32_ps(acc_im[n_vec]));
+                            acc_re[n_vec] = _mm_setzero_si128();
+                            acc_im[n_vec] = _mm_setzero_si128();
+                        }
+                    // Force the rotators back onto the unit circle
+                    mag = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(p0_re, p0_re), _mm_mul_ps(p0_im, p0_im)));
+                    p0_re = _mm_div_ps(p0_re, mag);
+                    p0_im = _mm_div_ps(p0_im, mag);
+                    mag = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(p1_re, p1_re), _mm_mul_ps(p1_im, p1_im)));
+                    p1_re = _mm_div_ps(p1_re, mag);
+                    p1_im = _mm_div_ps(p1_im, mag);
+                }
+            _in_common += 8;
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            _mm_store_ps(dotProduct_re, _mm_add_ps(accf_re[n_vec], _mm_cvtepi32_ps(acc_re[n_vec])));
+            _mm_store_ps(dotProduct_im, _mm_add_ps(accf_im[n_vec], _mm_cvtepi32_ps(acc_im[n_vec])));
+            result[n_vec] = lv_cmake((dotProduct_re[0] + dotProduct_re[1] + dotProduct_re[2] + dotProduct_re[3]) / 128.0f,
+                (dotProduct_im[0] + dotProduct_im[1] + dotProduct_im[2] + dotProduct_im[3]) / 128.0f);
+        }
+
+    _mm_store_ps(phase_re, p0_re);
+    _mm_store_ps(phase_im, p0_im);
+    _phase = lv_cmake(phase_re[0], phase_im[0]);
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+
+    for (number = eighthPoints * 8; number < num_points; number++)
+        {
+            carrier_re = (int32_t)rintf(128.0f * lv_creal(_phase));
+            carrier_im = (int32_t)rintf(128.0f * lv_cimag(_phase));
+            rotated_re = (int32_t)lv_creal(in_common[number]) * carrier_re - (int32_t)lv_cimag(in_common[number]) * carrier_im;
+            rotated_im = (int32_t)lv_creal(in_common[number]) * carrier_im + (int32_t)lv_cimag(in_common[number]) * carrier_re;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    result[n_vec] += lv_cmake((float)(in_a[n_vec][number] * rotated_re) / 128.0f, (float)(in_a[n_vec][number] * rotated_im) / 128.0f);
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8ic_8i_rotator_dot_prod_32fc_xn_u_avx2(lv_32fc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const int8_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int sixteenthPoints = num_points / 16;
+    const lv_8sc_t* _in_common = in_common;
+    int32_t carrier_re, carrier_im, rotated_re, rotated_im;
+    int n_vec;
+    unsigned int number;
+    unsigned int k;
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t dz;
+
+    __VOLK_ATTR_ALIGNED(32)
+    float phase_re[16];
+    __VOLK_ATTR_ALIGNED(32)
+    float phase_im[16];
+    __VOLK_ATTR_ALIGNED(32)
+    float dotProduct_re[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float dotProduct_im[8];
+
+    // The 32 bits integer accumulators are flushed into the float ones every 256 iterations,
+    // which keeps them away from overflow for any 8 bits input
+    __m256i acc_re[num_a_vectors];
+    __m256i acc_im[num_a_vectors];
+    __m256 accf_re[num_a_vectors];
+    __m256 accf_im[num_a_vectors];
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            acc_re[n_vec] = _mm256_setzero_si256();
+            acc_im[n_vec] = _mm256_setzero_si256();
+            accf_re[n_vec] = _mm256_setzero_ps();
+            accf_im[n_vec] = _mm256_setzero_ps();
+        }
+
+    const __m256i deinterleave = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+        0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+    const __m256 scale = _mm256_set1_ps(128.0f);
+
+    // Set up the complex rotator, with real and imaginary parts in separate registers
+    for (k = 0; k < 16; ++k)
+        {
+            phase_re[k] = lv_creal(_phase);
+            phase_im[k] = lv_cimag(_phase);
+            _phase *= phase_inc;
+        }
+    __m256 p0_re = _mm256_load_ps(phase_re);
+    __m256 p0_im = _mm256_load_ps(phase_im);
+    __m256 p1_re = _mm256_load_ps(phase_re + 8);
+    __m256 p1_im = _mm256_load_ps(phase_im + 8);
+
+    dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^16
+    dz /= hypotf(lv_creal(dz), lv_cimag(dz));
+    const __m256 dz_re = _mm256_set1_ps(lv_creal(dz));
+    const __m256 dz_im = _mm256_set1_ps(lv_cimag(dz));
+
+    __m256i s, s_re, s_im, c_re, c_im, x_re, x_im, code;
+    __m256 tmp, mag;
+
+    for (number = 0; number < sixteenthPoints; number++)
+        {
+            s = _mm256_loadu_si256((const __m256i*)_in_common);  // r0|i0|r1|i1|...|r15|i15
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 32);
+            s = _mm256_shuffle_epi8(s, deinterleave);  // r0|...|r7|i0|...|i7|r8|...|r15|i8|...|i15
+            s = _mm256_permute4x64_epi64(s, 0xD8);     // r0|...|r15|i0|...|i15
+            s_re = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(s));
+            s_im = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(s, 1));
+
+            // quantize the carrier replica
+            c_re = _mm256_packs_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(p0_re, scale)), _mm256_cvtps_epi32(_mm256_mul_ps(p1_re, scale)));
+            c_im = _mm256_packs_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(p0_im, scale)), _mm256_cvtps_epi32(_mm256_mul_ps(p1_im, scale)));
+            c_re = _mm256_permute4x64_epi64(c_re, 0xD8);
+            c_im = _mm256_permute4x64_epi64(c_im, 0xD8);
+
+            // carrier wipe-off, exact in 16 bits
+            x_re = _mm256_sub_epi16(_mm256_mullo_epi16(s_re, c_re), _mm256_mullo_epi16(s_im, c_im));
+            x_im = _mm256_add_epi16(_mm256_mullo_epi16(s_re, c_im), _mm256_mullo_epi16(s_im, c_re));
+
+            tmp = _mm256_sub_ps(_mm256_mul_ps(p0_re, dz_re), _mm256_mul_ps(p0_im, dz_im));
+            p0_im = _mm256_add_ps(_mm256_mul_ps(p0_re, dz_im), _mm256_mul_ps(p0_im, dz_re));
+            p0_re = tmp;
+            tmp = _mm256_sub_ps(_mm256_mul_ps(p1_re, dz_re), _mm256_mul_ps(p1_im, dz_im));
+            p1_im = _mm256_add_ps(_mm256_mul_ps(p1_re, dz_im), _mm256_mul_ps(p1_im, dz_re));
+            p1_re = tmp;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)&(in_a[n_vec][number * 16])));
+                    acc_re[n_vec] = _mm256_add_epi32(acc_re[n_vec], _mm256_madd_epi16(x_re, code));
+                    acc_im[n_vec] = _mm256_add_epi32(acc_im[n_vec], _mm256_madd_epi16(x_im, code));
+                }
+
+            if ((number % 256) == 255)
+                {
+                    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                        {
+                            accf_re[n_vec] = _mm256_add_ps(accf_re[n_vec], _mm256_cvtepi32_ps(acc_re[n_vec]));
+                            accf_im[n_vec] = _mm256_add_ps(accf_im[n_vec], _mm256_cvtepi32_ps(acc_im[n_vec]));
+                            acc_re[n_vec] = _mm256_setzero_si256();
+                            acc_im[n_vec] = _mm256_setzero_si256();
+                        }
+                    // Force the rotators back onto the unit circle
+                    mag = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(p0_re, p0_re), _mm256_mul_ps(p0_im, p0_im)));
+                    p0_re = _mm256_div_ps(p0_re, mag);
+                    p0_im = _mm256_div_ps(p0_im, mag);
+                    mag = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(p1_re, p1_re), _mm256_mul_ps(p1_im, p1_im)));
+                    p1_re = _mm256_div_ps(p1_re, mag);
+                    p1_im = _mm256_div_ps(p1_im, mag);
+                }
+            _in_common += 16;
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            _mm256_store_ps(dotProduct_re, _mm256_add_ps(accf_re[n_vec], _mm256_cvtepi32_ps(acc_re[n_vec])));
+            _mm256_store_ps(dotProduct_im, _mm256_add_ps(accf_im[n_vec], _mm256_cvtepi32_ps(acc_im[n_vec])));
+            result[n_vec] = lv_cmake(0, 0);
+            for (k = 0; k < 8; ++k)
+                {
+                    result[n_vec] += lv_cmake(dotProduct_re[k], dotProduct_im[k]);
+                }
+            result[n_vec] /= 128.0f;
+        }
+
+    _mm256_store_ps(phase_re, p0_re);
+    _mm256_store_ps(phase_im, p0_im);
+    _mm256_zeroupper();
+    _phase = lv_cmake(phase_re[0], phase_im[0]);
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+
+    for (number = sixteenthPoints * 16; number < num_points; number++)
+        {
+            carrier_re = (int32_t)rintf(128.0f * lv_creal(_phase));
+            carrier_im = (int32_t)rintf(128.0f * lv_cimag(_phase));
+            rotated_re = (int32_t)lv_creal(in_common[number]) * carrier_re - (int32_t)lv_cimag(in_common[number]) * carrier_im;
+            rotated_im = (int32_t)lv_creal(in_common[number]) * carrier_im + (int32_t)lv_cimag(in_common[number]) * carrier_re;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    result[n_vec] += lv_cmake((float)(in_a[n_vec][number] * rotated_re) / 128.0f, (float)(in_a[n_vec][number] * rotated_im) / 128.0f);
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_gnsssdr_8ic_8i_rotator_dot_prod_32fc_xn_H */
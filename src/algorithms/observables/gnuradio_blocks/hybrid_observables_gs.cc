@@ -34,17 +34,37 @@
 #include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT
 #include "gnss_circular_deque.h"
 #include "gnss_sdr_create_directory.h"
+#include "gnss_sdr_dump.h"
 #include "gnss_synchro.h"
 #include <boost/filesystem/path.hpp>
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <matio.h>
 #include <cmath>      // for round
+#include <cstddef>    // for offsetof
 #include <cstdlib>    // for size_t, llabs
 #include <exception>  // for exception
 #include <iostream>   // for cerr, cout
 #include <limits>     // for numeric_limits
-#include <utility>    // for move
+#include <utility>    // for move, pair
+#include <vector>     // for vector
+
+
+namespace
+{
+// Record of one channel in the observables dump file. Each epoch has one
+// record per output channel.
+struct Obs_Dump_Record
+{
+    double RX_time;
+    double TOW_at_current_symbol_s;
+    double Carrier_Doppler_hz;
+    double Carrier_phase_cycles;
+    double Pseudorange_m;
+    double PRN;
+    double Flag_valid_pseudorange;
+};
+}  // namespace
 
 
 hybrid_observables_gs_sptr hybrid_observables_gs_make(unsigned int nchannels_in, unsigned int nchannels_out, bool dump, bool dump_mat, std::string dump_filename)
@@ -101,15 +121,13 @@ hybrid_observables_gs::hybrid_observables_gs(uint32_t nchannels_in,
                     std::cerr << "GNSS-SDR cannot create dump file for the Observables block. Wrong permissions?" << std::endl;
                     d_dump = false;
                 }
-            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-            try
+            if (d_dump and d_dump_file.open(d_dump_filename))
                 {
-                    d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
                     LOG(INFO) << "Observables dump enabled Log file: " << d_dump_filename.c_str();
                 }
-            catch (const std::ifstream::failure &e)
+            else
                 {
-                    LOG(WARNING) << "Exception opening observables dump file " << e.what();
+                    LOG(WARNING) << "Problem opening observables dump file " << d_dump_filename;
                     d_dump = false;
                 }
         }
@@ -128,14 +146,7 @@ hybrid_observables_gs::~hybrid_observables_gs()
     delete d_gnss_synchro_history;
     if (d_dump_file.is_open())
         {
-            try
-                {
-                    d_dump_file.close();
-                }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor closing the dump file " << ex.what();
-                }
+            d_dump_file.close();
         }
     if (d_dump_mat)
         {
@@ -155,118 +166,16 @@ int32_t hybrid_observables_gs::save_matfile()
 {
     // READ DUMP FILE
     std::string dump_filename = d_dump_filename;
-    std::ifstream::pos_type size;
-    int32_t number_of_double_vars = 7;
-    int32_t epoch_size_bytes = sizeof(double) * number_of_double_vars * d_nchannels_out;
-    std::ifstream dump_file;
     std::cout << "Generating .mat file for " << dump_filename << std::endl;
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
-        {
-            dump_file.open(dump_filename.c_str(), std::ios::binary | std::ios::ate);
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem opening dump file:" << e.what() << std::endl;
-            return 1;
-        }
-    // count number of epochs and rewind
-    int64_t num_epoch = 0LL;
-    if (dump_file.is_open())
-        {
-            size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
-        }
-    else
-        {
-            return 1;
-        }
-    auto **RX_time = new double *[d_nchannels_out];
-    auto **TOW_at_current_symbol_s = new double *[d_nchannels_out];
-    auto **Carrier_Doppler_hz = new double *[d_nchannels_out];
-    auto **Carrier_phase_cycles = new double *[d_nchannels_out];
-    auto **Pseudorange_m = new double *[d_nchannels_out];
-    auto **PRN = new double *[d_nchannels_out];
-    auto **Flag_valid_pseudorange = new double *[d_nchannels_out];
-
-    for (uint32_t i = 0; i < d_nchannels_out; i++)
-        {
-            RX_time[i] = new double[num_epoch];
-            TOW_at_current_symbol_s[i] = new double[num_epoch];
-            Carrier_Doppler_hz[i] = new double[num_epoch];
-            Carrier_phase_cycles[i] = new double[num_epoch];
-            Pseudorange_m[i] = new double[num_epoch];
-            PRN[i] = new double[num_epoch];
-            Flag_valid_pseudorange[i] = new double[num_epoch];
-        }
-
-    try
-        {
-            if (dump_file.is_open())
-                {
-                    for (int64_t i = 0; i < num_epoch; i++)
-                        {
-                            for (uint32_t chan = 0; chan < d_nchannels_out; chan++)
-                                {
-                                    dump_file.read(reinterpret_cast<char *>(&RX_time[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&TOW_at_current_symbol_s[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Carrier_Doppler_hz[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Carrier_phase_cycles[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Pseudorange_m[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&PRN[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Flag_valid_pseudorange[chan][i]), sizeof(double));
-                                }
-                        }
-                }
-            dump_file.close();
-        }
-    catch (const std::ifstream::failure &e)
+    Gnss_Dump_Reader dump_file;
+    if (!dump_file.open(dump_filename, sizeof(Obs_Dump_Record)))
         {
-            std::cerr << "Problem reading dump file:" << e.what() << std::endl;
-            for (uint32_t i = 0; i < d_nchannels_out; i++)
-                {
-                    delete[] RX_time[i];
-                    delete[] TOW_at_current_symbol_s[i];
-                    delete[] Carrier_Doppler_hz[i];
-                    delete[] Carrier_phase_cycles[i];
-                    delete[] Pseudorange_m[i];
-                    delete[] PRN[i];
-                    delete[] Flag_valid_pseudorange[i];
-                }
-            delete[] RX_time;
-            delete[] TOW_at_current_symbol_s;
-            delete[] Carrier_Doppler_hz;
-            delete[] Carrier_phase_cycles;
-            delete[] Pseudorange_m;
-            delete[] PRN;
-            delete[] Flag_valid_pseudorange;
-
+            std::cerr << "Problem opening dump file: " << dump_filename << std::endl;
             return 1;
         }
-
-    auto *RX_time_aux = new double[d_nchannels_out * num_epoch];
-    auto *TOW_at_current_symbol_s_aux = new double[d_nchannels_out * num_epoch];
-    auto *Carrier_Doppler_hz_aux = new double[d_nchannels_out * num_epoch];
-    auto *Carrier_phase_cycles_aux = new double[d_nchannels_out * num_epoch];
-    auto *Pseudorange_m_aux = new double[d_nchannels_out * num_epoch];
-    auto *PRN_aux = new double[d_nchannels_out * num_epoch];
-    auto *Flag_valid_pseudorange_aux = new double[d_nchannels_out * num_epoch];
-    uint32_t k = 0U;
-    for (int64_t j = 0; j < num_epoch; j++)
-        {
-            for (uint32_t i = 0; i < d_nchannels_out; i++)
-                {
-                    RX_time_aux[k] = RX_time[i][j];
-                    TOW_at_current_symbol_s_aux[k] = TOW_at_current_symbol_s[i][j];
-                    Carrier_Doppler_hz_aux[k] = Carrier_Doppler_hz[i][j];
-                    Carrier_phase_cycles_aux[k] = Carrier_phase_cycles[i][j];
-                    Pseudorange_m_aux[k] = Pseudorange_m[i][j];
-                    PRN_aux[k] = PRN[i][j];
-                    Flag_valid_pseudorange_aux[k] = Flag_valid_pseudorange[i][j];
-                    k++;
-                }
-        }
+    // Records are stored epoch after epoch, channel after channel, which is
+    // the (column-major) order of a d_nchannels_out x num_epoch matrix
+    auto num_epoch = static_cast<size_t>(dump_file.records() / d_nchannels_out);
 
     // WRITE MAT FILE
     mat_t *matfp;
@@ -280,62 +189,25 @@ int32_t hybrid_observables_gs::save_matfile()
     matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
     if (reinterpret_cast<int64_t *>(matfp) != nullptr)
         {
-            size_t dims[2] = {static_cast<size_t>(d_nchannels_out), static_cast<size_t>(num_epoch)};
-            matvar = Mat_VarCreate("RX_time", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, RX_time_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("TOW_at_current_symbol_s", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, TOW_at_current_symbol_s_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Carrier_Doppler_hz", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, Carrier_Doppler_hz_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Carrier_phase_cycles", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, Carrier_phase_cycles_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Pseudorange_m", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, Pseudorange_m_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, PRN_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Flag_valid_pseudorange", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, Flag_valid_pseudorange_aux, MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+            size_t dims[2] = {static_cast<size_t>(d_nchannels_out), num_epoch};
+            std::vector<double> column;
+            const std::vector<std::pair<std::string, size_t>> vars = {
+                {"RX_time", offsetof(Obs_Dump_Record, RX_time)},
+                {"TOW_at_current_symbol_s", offsetof(Obs_Dump_Record, TOW_at_current_symbol_s)},
+                {"Carrier_Doppler_hz", offsetof(Obs_Dump_Record, Carrier_Doppler_hz)},
+                {"Carrier_phase_cycles", offsetof(Obs_Dump_Record, Carrier_phase_cycles)},
+                {"Pseudorange_m", offsetof(Obs_Dump_Record, Pseudorange_m)},
+                {"PRN", offsetof(Obs_Dump_Record, PRN)},
+                {"Flag_valid_pseudorange", offsetof(Obs_Dump_Record, Flag_valid_pseudorange)}};
+            for (const auto &var : vars)
+                {
+                    dump_file.column(var.second, column);
+                    matvar = Mat_VarCreate(var.first.c_str(), MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, column.data(), MAT_F_DONT_COPY_DATA);
+                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+                    Mat_VarFree(matvar);
+                }
         }
     Mat_Close(matfp);
-
-    for (uint32_t i = 0; i < d_nchannels_out; i++)
-        {
-            delete[] RX_time[i];
-            delete[] TOW_at_current_symbol_s[i];
-            delete[] Carrier_Doppler_hz[i];
-            delete[] Carrier_phase_cycles[i];
-            delete[] Pseudorange_m[i];
-            delete[] PRN[i];
-            delete[] Flag_valid_pseudorange[i];
-        }
-    delete[] RX_time;
-    delete[] TOW_at_current_symbol_s;
-    delete[] Carrier_Doppler_hz;
-    delete[] Carrier_phase_cycles;
-    delete[] Pseudorange_m;
-    delete[] PRN;
-    delete[] Flag_valid_pseudorange;
-
-    delete[] RX_time_aux;
-    delete[] TOW_at_current_symbol_s_aux;
-    delete[] Carrier_Doppler_hz_aux;
-    delete[] Carrier_phase_cycles_aux;
-    delete[] Pseudorange_m_aux;
-    delete[] PRN_aux;
-    delete[] Flag_valid_pseudorange_aux;
     return 0;
 }
 
@@ -496,6 +368,13 @@ void hybrid_observables_gs::compute_pranges(std::vector<Gnss_Synchro> &data)
 }
 
 
+bool hybrid_observables_gs::stop()
+{
+    d_dump_file.flush();
+    return true;
+}
+
+
 int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)),
     gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
@@ -617,31 +496,17 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
             if (d_dump)
                 {
                     // MULTIPLEXED FILE RECORDING - Record results to file
-                    try
-                        {
-                            double tmp_double;
-                            for (uint32_t i = 0; i < d_nchannels_out; i++)
-                                {
-                                    tmp_double = out[i][0].RX_time;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].interp_TOW_ms / 1000.0;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Carrier_Doppler_hz;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Carrier_phase_rads / GPS_TWO_PI;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Pseudorange_m;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = static_cast<double>(out[i][0].PRN);
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = static_cast<double>(out[i][0].Flag_valid_pseudorange);
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                }
-                        }
-                    catch (const std::ifstream::failure &e)
+                    Obs_Dump_Record record{};
+                    for (uint32_t i = 0; i < d_nchannels_out; i++)
                         {
-                            LOG(WARNING) << "Exception writing observables dump file " << e.what();
-                            d_dump = false;
+                            record.RX_time = out[i][0].RX_time;
+                            record.TOW_at_current_symbol_s = out[i][0].interp_TOW_ms / 1000.0;
+                            record.Carrier_Doppler_hz = out[i][0].Carrier_Doppler_hz;
+                            record.Carrier_phase_cycles = out[i][0].Carrier_phase_rads / GPS_TWO_PI;
+                            record.Pseudorange_m = out[i][0].Pseudorange_m;
+                            record.PRN = static_cast<double>(out[i][0].PRN);
+                            record.Flag_valid_pseudorange = static_cast<double>(out[i][0].Flag_valid_pseudorange);
+                            d_dump_file.write(record);
                         }
                 }
             return 1;
@@ -34,12 +34,13 @@
 #ifndef GNSS_SDR_HYBRID_OBSERVABLES_GS_H
 #define GNSS_SDR_HYBRID_OBSERVABLES_GS_H
 
+#include "gnss_sdr_dump.h"             // for Gnss_Dump_Writer
 #include <boost/circular_buffer.hpp>  // for boost::curcular_buffer
 #include <boost/shared_ptr.hpp>       // for boost::shared_ptr
 #include <gnuradio/block.h>           // for block
 #include <gnuradio/types.h>           // for gr_vector_int
 #include <cstdint>                    // for int32_t
-#include <fstream>                    // for string, ofstream
+#include <string>                     // for string
 #include <vector>                     // for vector
 
 class Gnss_Synchro;
@@ -60,6 +61,8 @@ class hybrid_observables_gs : public gr::block
 {
 public:
     ~hybrid_observables_gs();
+    bool stop();  //!< Completes the dump file when the flowgraph stops
+
     int general_work(int noutput_items, gr_vector_int& ninput_items,
         gr_vector_const_void_star& input_items, gr_vector_void_star& output_items);
     void forecast(int noutput_items, gr_vector_int& ninput_items_required);
@@ -89,7 +92,7 @@ private:
     uint32_t d_nchannels_in;
     uint32_t d_nchannels_out;
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 };
 
 #endif
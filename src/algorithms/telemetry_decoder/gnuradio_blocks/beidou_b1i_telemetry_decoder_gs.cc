@@ -146,14 +146,7 @@ beidou_b1i_telemetry_decoder_gs::~beidou_b1i_telemetry_decoder_gs()
 
     if (d_dump_file.is_open() == true)
         {
-            try
-                {
-                    d_dump_file.close();
-                }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor closing the dump file " << ex.what();
-                }
+            d_dump_file.close();
         }
 }
 
@@ -367,24 +360,25 @@ void beidou_b1i_telemetry_decoder_gs::set_channel(int32_t channel)
         {
             if (d_dump_file.is_open() == false)
                 {
-                    try
+                    d_dump_filename = "telemetry";
+                    d_dump_filename.append(std::to_string(d_channel));
+                    d_dump_filename.append(".dat");
+                    if (d_dump_file.open(d_dump_filename))
                         {
-                            d_dump_filename = "telemetry";
-                            d_dump_filename.append(std::to_string(d_channel));
-                            d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
                             LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
                         }
-                    catch (const std::ifstream::failure &e)
-                        {
-                            LOG(WARNING) << "channel " << d_channel << ": exception opening Beidou TLM dump file. " << e.what();
-                        }
                 }
         }
 }
 
 
+bool beidou_b1i_telemetry_decoder_gs::stop()
+{
+    d_dump_file.flush();
+    return true;
+}
+
+
 int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
@@ -569,23 +563,16 @@ int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute_
     if (d_dump == true)
         {
             // MULTIPLEXED FILE RECORDING - Record results to file
-            try
-                {
-                    double tmp_double;
-                    uint64_t tmp_ulong_int;
-                    tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
-                    tmp_double = d_nav.d_SOW;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    tmp_ulong_int = static_cast<uint64_t>(d_required_symbols);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
-                }
-            catch (const std::ifstream::failure &e)
-                {
-                    LOG(WARNING) << "Exception writing observables dump file " << e.what();
-                }
+            double tmp_double;
+            uint64_t tmp_ulong_int;
+            tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms);
+            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+            tmp_ulong_int = current_symbol.Tracking_sample_counter;
+            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
+            tmp_double = d_nav.d_SOW;
+            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+            tmp_ulong_int = static_cast<uint64_t>(d_required_symbols);
+            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
         }
 
     // 3. Make the output (copy the object contents to the GNURadio reserved memory)
@@ -33,12 +33,12 @@
 
 #include "beidou_dnav_navigation_message.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_dump.h"
 #include <boost/circular_buffer.hpp>
 #include <boost/shared_ptr.hpp>  // for boost::shared_ptr
 #include <gnuradio/block.h>      // for block
 #include <gnuradio/types.h>      // for gr_vector_const_void_star
 #include <cstdint>
-#include <fstream>
 #include <string>
 
 class beidou_b3i_telemetry_decoder_gs;
@@ -64,6 +64,8 @@ public:
     {
         return;
     }
+    bool stop();  //!< Completes the dump file when the flowgraph stops
+
     /*!
      * \brief This is where all signal processing takes place
      */
@@ -118,7 +120,7 @@ private:
     int32_t d_channel;
     bool d_dump;
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 };
 
 #endif
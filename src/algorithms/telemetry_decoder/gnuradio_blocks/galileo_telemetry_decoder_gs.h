@@ -36,12 +36,12 @@
 #include "galileo_fnav_message.h"
 #include "galileo_navigation_message.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_dump.h"
 #include <boost/circular_buffer.hpp>
 #include <boost/shared_ptr.hpp>  // for boost::shared_ptr
 #include <gnuradio/block.h>      // for block
 #include <gnuradio/types.h>      // for gr_vector_const_void_star
 #include <cstdint>
-#include <fstream>
 #include <string>
 
 class galileo_telemetry_decoder_gs;
@@ -62,6 +62,8 @@ public:
     void reset();
     int32_t flag_even_word_arrived;
 
+    bool stop();  //!< Completes the dump file when the flowgraph stops
+
     /*!
      * \brief This is where all signal processing takes place
      */
@@ -122,7 +124,7 @@ private:
     double delta_t;  //GPS-GALILEO time offset
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     // vars for Viterbi decoder
     int32_t *out0, *out1, *state0, *state1;
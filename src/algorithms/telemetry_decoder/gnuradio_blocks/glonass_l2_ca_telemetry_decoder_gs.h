@@ -35,13 +35,13 @@
 #include "GLONASS_L1_L2_CA.h"
 #include "glonass_gnav_navigation_message.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_dump.h"
 #include "gnss_synchro.h"
 #include <boost/circular_buffer.hpp>
 #include <boost/shared_ptr.hpp>  // for boost::shared_ptr
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstdint>
-#include <fstream>
 #include <string>
 
 
@@ -66,6 +66,8 @@ public:
     {
         return;
     }
+    bool stop();  //!< Completes the dump file when the flowgraph stops
+
     /*!
     * \brief This is where all signal processing takes place
     */
@@ -114,7 +116,7 @@ private:
     int32_t d_channel;
     bool d_dump;
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 };
 
 #endif
@@ -33,6 +33,7 @@
 
 #include "GPS_L1_CA.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_dump.h"
 #include "gnss_synchro.h"
 #include "gps_navigation_message.h"
 #include <boost/circular_buffer.hpp>
@@ -40,7 +41,6 @@
 #include <gnuradio/block.h>      // for block
 #include <gnuradio/types.h>      // for gr_vector_const_void_star
 #include <cstdint>               // for int32_t
-#include <fstream>               // for ofstream
 #include <string>                // for string
 
 
@@ -62,6 +62,8 @@ public:
     void set_satellite(const Gnss_Satellite &satellite);  //!< Set satellite PRN
     void set_channel(int channel);                        //!< Set receiver's channel
     void reset();
+    bool stop();  //!< Completes the dump file when the flowgraph stops
+
     /*!
      * \brief This is where all signal processing takes place
      */
@@ -114,7 +116,7 @@ private:
     bool flag_PLL_180_deg_phase_locked;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 };
 
 #endif
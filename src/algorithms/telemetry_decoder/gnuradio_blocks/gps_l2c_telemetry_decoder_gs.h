@@ -33,12 +33,12 @@
 
 
 #include "gnss_satellite.h"
+#include "gnss_sdr_dump.h"
 #include "gps_cnav_navigation_message.h"
 #include <boost/shared_ptr.hpp>  // for boost::shared_ptr
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstdint>
-#include <fstream>
 #include <string>
 
 extern "C" {
@@ -64,6 +64,8 @@ public:
     void set_satellite(const Gnss_Satellite &satellite);  //!< Set satellite PRN
     void set_channel(int32_t channel);                    //!< Set receiver's channel
     void reset();
+    bool stop();  //!< Completes the dump file when the flowgraph stops
+
     /*!
      * \brief This is where all signal processing takes place
      */
@@ -80,7 +82,7 @@ private:
     int32_t d_channel;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     cnav_msg_decoder_t d_cnav_decoder{};
 
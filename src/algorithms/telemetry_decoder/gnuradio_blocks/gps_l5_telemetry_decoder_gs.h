@@ -33,13 +33,13 @@
 
 #include "GPS_L5.h"                       // for GPS_L5I_NH_CODE_LENGTH
 #include "gnss_satellite.h"               // for Gnss_Satellite
+#include "gnss_sdr_dump.h"                // for Gnss_Dump_Writer
 #include "gps_cnav_navigation_message.h"  // for Gps_CNAV_Navigation_Message
 #include <boost/circular_buffer.hpp>
 #include <boost/shared_ptr.hpp>  // for boost::shared_ptr
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstdint>
-#include <fstream>
 #include <string>
 
 extern "C" {
@@ -65,6 +65,8 @@ public:
     void set_satellite(const Gnss_Satellite &satellite);  //!< Set satellite PRN
     void set_channel(int32_t channel);                    //!< Set receiver's channel
     void reset();
+    bool stop();  //!< Completes the dump file when the flowgraph stops
+
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
@@ -78,7 +80,7 @@ private:
     int32_t d_channel;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     cnav_msg_decoder_t d_cnav_decoder{};
 
@@ -76,14 +76,7 @@ sbas_l1_telemetry_decoder_gs::~sbas_l1_telemetry_decoder_gs()
 {
     if (d_dump_file.is_open() == true)
         {
-            try
-                {
-                    d_dump_file.close();
-                }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor closing the dump file " << ex.what();
-                }
+            d_dump_file.close();
         }
 }
 
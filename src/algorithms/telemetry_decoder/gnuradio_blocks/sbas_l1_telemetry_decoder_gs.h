@@ -32,6 +32,7 @@
 #define GNSS_SDR_SBAS_L1_TELEMETRY_DECODER_GS_H
 
 #include "gnss_satellite.h"
+#include "gnss_sdr_dump.h"
 #include <boost/crc.hpp>         // for crc_optimal
 #include <boost/shared_ptr.hpp>  // for boost::shared_ptr
 #include <gnuradio/block.h>
@@ -39,7 +40,6 @@
 #include <cstddef>           // for size_t
 #include <cstdint>
 #include <deque>
-#include <fstream>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
@@ -90,7 +90,7 @@ private:
     int32_t d_channel;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     size_t d_block_size;               //!< number of samples which are processed during one invocation of the algorithms
     std::vector<double> d_sample_buf;  //!< input buffer holding the samples to be processed in one block
@@ -41,6 +41,7 @@
 #include "dll_pll_conf.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 
 
 BeidouB1iDllPllTracking::BeidouB1iDllPllTracking(
@@ -158,6 +159,7 @@ BeidouB1iDllPllTracking::BeidouB1iDllPllTracking(
             cn0_samples = FLAGS_cn0_samples;
         }
     trk_param.cn0_samples = cn0_samples;
+    trk_param.cn0_estimator = configuration->property(role + ".cn0_estimator", std::string("SNV"));
     int cn0_min = configuration->property(role + ".cn0_min", 25);
     if (FLAGS_cn0_min != 25)
         {
@@ -176,6 +178,11 @@ BeidouB1iDllPllTracking::BeidouB1iDllPllTracking(
             carrier_lock_th = FLAGS_carrier_lock_th;
         }
     trk_param.carrier_lock_th = carrier_lock_th;
+    trk_param.multichannel_correlator = configuration->property(role + ".multichannel_correlator", false);
+    trk_param.adaptive_correlation = configuration->property(role + ".adaptive_correlation", false);
+    trk_param.adaptive_strong_cn0_db_hz = configuration->property(role + ".adaptive_strong_cn0_db_hz", 45.0);
+    trk_param.adaptive_weak_cn0_db_hz = configuration->property(role + ".adaptive_weak_cn0_db_hz", 30.0);
+    trk_param.adaptive_hysteresis_db = configuration->property(role + ".adaptive_hysteresis_db", 3.0);
 
     //################# MAKE TRACKING GNURadio object ###################
     if (item_type == "gr_complex")
@@ -183,6 +190,12 @@ BeidouB1iDllPllTracking::BeidouB1iDllPllTracking(
             item_size_ = sizeof(gr_complex);
             tracking_ = dll_pll_veml_make_tracking(trk_param);
         }
+    else if (item_type == "cbyte")
+        {
+            item_size_ = sizeof(lv_8sc_t);
+            trk_param.item_type = item_type;
+            tracking_ = dll_pll_veml_make_tracking(trk_param);
+        }
     else
         {
             item_size_ = sizeof(gr_complex);
@@ -41,6 +41,7 @@
 #include "dll_pll_conf.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 
 using google::LogMessage;
 
@@ -150,6 +151,7 @@ BeidouB3iDllPllTracking::BeidouB3iDllPllTracking(
     int cn0_samples = configuration->property(role + ".cn0_samples", 20);
     if (FLAGS_cn0_samples != 20) cn0_samples = FLAGS_cn0_samples;
     trk_param.cn0_samples = cn0_samples;
+    trk_param.cn0_estimator = configuration->property(role + ".cn0_estimator", std::string("SNV"));
     int cn0_min = configuration->property(role + ".cn0_min", 25);
     if (FLAGS_cn0_min != 25) cn0_min = FLAGS_cn0_min;
     trk_param.cn0_min = cn0_min;
@@ -159,6 +161,11 @@ BeidouB3iDllPllTracking::BeidouB3iDllPllTracking(
     double carrier_lock_th = configuration->property(role + ".carrier_lock_th", 0.85);
     if (FLAGS_carrier_lock_th != 0.85) carrier_lock_th = FLAGS_carrier_lock_th;
     trk_param.carrier_lock_th = carrier_lock_th;
+    trk_param.multichannel_correlator = configuration->property(role + ".multichannel_correlator", false);
+    trk_param.adaptive_correlation = configuration->property(role + ".adaptive_correlation", false);
+    trk_param.adaptive_strong_cn0_db_hz = configuration->property(role + ".adaptive_strong_cn0_db_hz", 45.0);
+    trk_param.adaptive_weak_cn0_db_hz = configuration->property(role + ".adaptive_weak_cn0_db_hz", 30.0);
+    trk_param.adaptive_hysteresis_db = configuration->property(role + ".adaptive_hysteresis_db", 3.0);
 
     //################# MAKE TRACKING GNURadio object ###################
     if (item_type == "gr_complex")
@@ -166,6 +173,12 @@ BeidouB3iDllPllTracking::BeidouB3iDllPllTracking(
             item_size_ = sizeof(gr_complex);
             tracking_ = dll_pll_veml_make_tracking(trk_param);
         }
+    else if (item_type == "cbyte")
+        {
+            item_size_ = sizeof(lv_8sc_t);
+            trk_param.item_type = item_type;
+            tracking_ = dll_pll_veml_make_tracking(trk_param);
+        }
     else
         {
             item_size_ = sizeof(gr_complex);
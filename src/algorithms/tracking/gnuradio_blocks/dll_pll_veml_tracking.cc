@@ -48,24 +48,63 @@
 #include "galileo_e1_signal_processing.h"
 #include "galileo_e5_signal_processing.h"
 #include "gnss_sdr_create_directory.h"
+#include "gnss_sdr_dump.h"
 #include "gnss_synchro.h"
 #include "gps_l2c_signal.h"
 #include "gps_l5_signal.h"
 #include "gps_sdr_signal_processing.h"
-#include "lock_detectors.h"
+#include "multichannel_correlator_engine.h"
 #include "tracking_discriminators.h"
 #include <boost/filesystem/path.hpp>
 #include <glog/logging.h>
+#include <gnuradio/block_detail.h>   // for block_detail
+#include <gnuradio/buffer.h>         // for buffer_reader
 #include <gnuradio/io_signature.h>   // for io_signature
 #include <gnuradio/thread/thread.h>  // for scoped_lock
 #include <matio.h>                   // for Mat_VarCreate
 #include <pmt/pmt_sugar.h>           // for mp
 #include <volk_gnsssdr/volk_gnsssdr.h>
-#include <algorithm>  // for fill_n
+#include <algorithm>  // for fill_n, max
 #include <cmath>      // for fmod, round, floor
+#include <cstddef>    // for offsetof
 #include <exception>  // for exception
 #include <iostream>   // for cout, cerr
 #include <map>
+#include <utility>    // for pair
+#include <vector>     // for vector
+
+
+namespace
+{
+// One record of the tracking dump file
+#pragma pack(push, 1)
+struct Trk_Dump_Record
+{
+    float abs_VE;
+    float abs_E;
+    float abs_P;
+    float abs_L;
+    float abs_VL;
+    float Prompt_I;
+    float Prompt_Q;
+    uint64_t PRN_start_sample_count;
+    float acc_carrier_phase_rad;
+    float carrier_doppler_hz;
+    float carrier_doppler_rate_hz;
+    float code_freq_chips;
+    float code_freq_rate_chips;
+    float carr_error_hz;
+    float carr_error_filt_hz;
+    float code_error_chips;
+    float code_error_filt_chips;
+    float CN0_SNV_dB_Hz;
+    float carrier_lock_test;
+    float aux1;
+    double aux2;
+    uint32_t PRN;
+};
+#pragma pack(pop)
+}  // namespace
 
 
 dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
@@ -74,7 +113,7 @@ dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 }
 
 
-dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, conf_.item_type == "cbyte" ? sizeof(lv_8sc_t) : sizeof(gr_complex)),
                                                                               gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
 {
     trk_parameters = conf_;
@@ -391,9 +430,29 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
 
     multicorrelator_cpu.init(2 * trk_parameters.vector_length, d_n_correlator_taps);
 
+    // 8-bit complex input: correlate against 8-bit replicas of the same codes
+    d_use_8sc = (trk_parameters.item_type == "cbyte");
+    d_tracking_code_8i = nullptr;
+    d_data_code_8i = nullptr;
+    if (d_use_8sc)
+        {
+            if (trk_parameters.high_dyn)
+                {
+                    LOG(WARNING) << "High dynamics resampler not available for cbyte samples, code and carrier rates will be ignored";
+                }
+            if (trk_parameters.multichannel_correlator)
+                {
+                    LOG(WARNING) << "Multichannel correlator not available for cbyte samples, using the per-channel correlator";
+                    trk_parameters.multichannel_correlator = false;
+                }
+            d_tracking_code_8i = static_cast<int8_t *>(volk_gnsssdr_malloc(2 * d_code_length_chips * sizeof(int8_t), volk_gnsssdr_get_alignment()));
+            multicorrelator_cpu_8sc.init(2 * trk_parameters.vector_length, d_n_correlator_taps);
+        }
+
     if (trk_parameters.extend_correlation_symbols > 1)
         {
-            d_enable_extended_integration = true;
+            // With adaptive correlation, the extension is only used for weak signals
+            d_enable_extended_integration = !trk_parameters.adaptive_correlation;
         }
     else
         {
@@ -401,6 +460,17 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
             trk_parameters.extend_correlation_symbols = 1;
         }
 
+    // CN0-adaptive correlator configuration
+    d_tracking_mode = Tracking_Mode_Policy::NOMINAL;
+    d_reduced_taps = false;
+    d_enable_reduced_taps = trk_parameters.adaptive_correlation and d_veml and !d_use_8sc;
+    d_mode_policy.set_thresholds(trk_parameters.adaptive_strong_cn0_db_hz, trk_parameters.adaptive_weak_cn0_db_hz, trk_parameters.adaptive_hysteresis_db, 3);
+    if (d_enable_reduced_taps)
+        {
+            multicorrelator_cpu_elp.init(2 * trk_parameters.vector_length, 3);
+            multicorrelator_cpu_elp.set_high_dynamics_resampler(trk_parameters.high_dyn);
+        }
+
     // Enable Data component prompt correlator (slave to Pilot prompt) if tracking uses Pilot signal
     if (trk_parameters.track_pilot)
         {
@@ -408,6 +478,11 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
             correlator_data_cpu.init(2 * trk_parameters.vector_length, 1);
             correlator_data_cpu.set_high_dynamics_resampler(trk_parameters.high_dyn);
             d_data_code = static_cast<float *>(volk_gnsssdr_malloc(2 * d_code_length_chips * sizeof(float), volk_gnsssdr_get_alignment()));
+            if (d_use_8sc)
+                {
+                    d_data_code_8i = static_cast<int8_t *>(volk_gnsssdr_malloc(2 * d_code_length_chips * sizeof(int8_t), volk_gnsssdr_get_alignment()));
+                    correlator_data_cpu_8sc.init(2 * trk_parameters.vector_length, 1);
+                }
         }
     else
         {
@@ -431,9 +506,9 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_) : gr::bl
     d_current_prn_length_samples = static_cast<int32_t>(trk_parameters.vector_length);
     d_current_correlation_time_s = 0.0;
 
-    // CN0 estimation and lock detector buffers
+    // CN0 estimation and lock detectors
     d_cn0_estimation_counter = 0;
-    d_Prompt_buffer = new gr_complex[trk_parameters.cn0_samples];
+    d_lock_detectors = Lock_Detectors(trk_parameters.cn0_samples, trk_parameters.cn0_estimator == "M2M4" ? Lock_Detectors::M2M4 : Lock_Detectors::SNV);
     d_carrier_lock_test = 1.0;
     d_CN0_SNV_dB_Hz = 0.0;
     d_carrier_lock_fail_counter = 0;
@@ -510,6 +585,13 @@ void dll_pll_veml_tracking::forecast(int noutput_items,
     if (noutput_items != 0)
         {
             ninput_items_required[0] = static_cast<int32_t>(trk_parameters.vector_length) * 2;
+            if (d_state == 0 and detail())
+                {
+                    // Standby: wait for half of the input buffer and drop it in a single
+                    // call, so that idle channels are scheduled a couple of times per
+                    // buffer turn instead of on every write of the source.
+                    ninput_items_required[0] = std::max(ninput_items_required[0], detail()->input(0)->max_possible_items_available() / 2);
+                }
         }
 }
 
@@ -706,6 +788,35 @@ void dll_pll_veml_tracking::start_tracking()
         }
 
     multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code, d_local_code_shift_chips);
+    if (d_enable_reduced_taps)
+        {
+            multicorrelator_cpu_elp.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code, &d_local_code_shift_chips[1]);
+        }
+    if (trk_parameters.adaptive_correlation)
+        {
+            d_mode_policy.reset();
+            d_tracking_mode = Tracking_Mode_Policy::NOMINAL;
+            d_reduced_taps = false;
+            d_enable_extended_integration = false;
+        }
+    if (d_use_8sc)
+        {
+            // Codes are generated as +/-1, so the conversion to int8 is exact
+            int32_t code_samples = d_code_samples_per_chip * d_code_length_chips;
+            for (int32_t i = 0; i < code_samples; i++)
+                {
+                    d_tracking_code_8i[i] = static_cast<int8_t>(std::round(d_tracking_code[i]));
+                }
+            multicorrelator_cpu_8sc.set_local_code_and_taps(code_samples, d_tracking_code_8i, d_local_code_shift_chips);
+            if (trk_parameters.track_pilot)
+                {
+                    for (int32_t i = 0; i < code_samples; i++)
+                        {
+                            d_data_code_8i[i] = static_cast<int8_t>(std::round(d_data_code[i]));
+                        }
+                    correlator_data_cpu_8sc.set_local_code_and_taps(code_samples, d_data_code_8i, d_prompt_data_shift);
+                }
+        }
     std::fill_n(d_correlator_outs, d_n_correlator_taps, gr_complex(0.0, 0.0));
 
     d_carrier_lock_fail_counter = 0;
@@ -714,6 +825,7 @@ void dll_pll_veml_tracking::start_tracking()
     d_rem_code_phase_chips = 0.0;
     d_acc_carrier_phase_rad = 0.0;
     d_cn0_estimation_counter = 0;
+    d_lock_detectors.reset();
     d_carrier_lock_test = 1.0;
     d_CN0_SNV_dB_Hz = 0.0;
 
@@ -756,14 +868,7 @@ dll_pll_veml_tracking::~dll_pll_veml_tracking()
 
     if (d_dump_file.is_open())
         {
-            try
-                {
-                    d_dump_file.close();
-                }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor " << ex.what();
-                }
+            d_dump_file.close();
         }
     if (d_dump_mat)
         {
@@ -787,8 +892,21 @@ dll_pll_veml_tracking::~dll_pll_veml_tracking()
                     volk_gnsssdr_free(d_data_code);
                     correlator_data_cpu.free();
                 }
-            delete[] d_Prompt_buffer;
             multicorrelator_cpu.free();
+            if (d_enable_reduced_taps)
+                {
+                    multicorrelator_cpu_elp.free();
+                }
+            if (d_use_8sc)
+                {
+                    volk_gnsssdr_free(d_tracking_code_8i);
+                    multicorrelator_cpu_8sc.free();
+                    if (trk_parameters.track_pilot)
+                        {
+                            volk_gnsssdr_free(d_data_code_8i);
+                            correlator_data_cpu_8sc.free();
+                        }
+                }
         }
     catch (const std::exception &ex)
         {
@@ -839,18 +957,27 @@ bool dll_pll_veml_tracking::acquire_secondary()
 bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_time_s)
 {
     // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
-    if (d_cn0_estimation_counter < trk_parameters.cn0_samples)
+    d_lock_detectors.update(d_P_accu);
+    if (!d_lock_detectors.ready())
         {
-            // fill buffer with prompt correlator output values
-            d_Prompt_buffer[d_cn0_estimation_counter] = d_P_accu;
-            d_cn0_estimation_counter++;
             return true;
         }
-    d_cn0_estimation_counter = 0;
     // Code lock indicator
-    d_CN0_SNV_dB_Hz = cn0_svn_estimator(d_Prompt_buffer, trk_parameters.cn0_samples, coh_integration_time_s);
+    d_CN0_SNV_dB_Hz = d_lock_detectors.cn0_dB_Hz(coh_integration_time_s);
     // Carrier lock indicator
-    d_carrier_lock_test = carrier_lock_detector(d_Prompt_buffer, trk_parameters.cn0_samples);
+    d_carrier_lock_test = d_lock_detectors.carrier_lock();
+    // The indicators follow the last cn0_samples values at every epoch, but
+    // the lock decisions are taken once every cn0_samples epochs, as before
+    bool decide = (d_cn0_estimation_counter == 0);
+    d_cn0_estimation_counter = (d_cn0_estimation_counter + 1) % trk_parameters.cn0_samples;
+    if (!decide)
+        {
+            return true;
+        }
+    if (trk_parameters.adaptive_correlation and !d_pull_in_transitory)
+        {
+            d_mode_policy.update(d_CN0_SNV_dB_Hz);
+        }
     // Loss of lock detection
     if (!d_pull_in_transitory)
         {
@@ -883,12 +1010,68 @@ bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_
 // - updated remnant code phase in samples (d_rem_code_phase_samples)
 // - d_code_freq_chips
 // - d_carrier_doppler_hz
-void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
+void dll_pll_veml_tracking::do_correlation_step(const void *input_samples)
 {
     // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
     // perform carrier wipe-off and compute Early, Prompt and Late correlation
-    multicorrelator_cpu.set_input_output_vectors(d_correlator_outs, input_samples);
-    multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(
+    if (d_use_8sc)
+        {
+            const auto *in_8sc = static_cast<const lv_8sc_t *>(input_samples);
+            multicorrelator_cpu_8sc.set_input_output_vectors(d_correlator_outs, in_8sc);
+            multicorrelator_cpu_8sc.Carrier_wipeoff_multicorrelator_resampler(
+                d_rem_carr_phase_rad,
+                d_carrier_phase_step_rad,
+                static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                trk_parameters.vector_length);
+            if (trk_parameters.track_pilot)
+                {
+                    correlator_data_cpu_8sc.set_input_output_vectors(d_Prompt_Data, in_8sc);
+                    correlator_data_cpu_8sc.Carrier_wipeoff_multicorrelator_resampler(
+                        d_rem_carr_phase_rad,
+                        d_carrier_phase_step_rad,
+                        static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+                        static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                        trk_parameters.vector_length);
+                }
+            return;
+        }
+    const auto *in = static_cast<const gr_complex *>(input_samples);
+    Cpu_Multicorrelator_Real_Codes *correlator = &multicorrelator_cpu;
+    if (d_reduced_taps)
+        {
+            // Strong signal: Very Early and Very Late are not needed
+            correlator = &multicorrelator_cpu_elp;
+            correlator->set_input_output_vectors(d_Early, in);
+        }
+    else
+        {
+            correlator->set_input_output_vectors(d_correlator_outs, in);
+        }
+    if (trk_parameters.multichannel_correlator)
+        {
+            // Batched with the other channels reading the same input samples
+            Correlation_Request requests[2];
+            requests[0].correlator = correlator;
+            requests[0].rem_carrier_phase_in_rad = d_rem_carr_phase_rad;
+            requests[0].phase_step_rad = d_carrier_phase_step_rad;
+            requests[0].phase_rate_step_rad = d_carrier_phase_rate_step_rad;
+            requests[0].rem_code_phase_chips = d_rem_code_phase_chips * d_code_samples_per_chip;
+            requests[0].code_phase_step_chips = d_code_phase_step_chips * d_code_samples_per_chip;
+            requests[0].code_phase_rate_step_chips = d_code_phase_rate_step_chips * d_code_samples_per_chip;
+            requests[0].signal_length_samples = trk_parameters.vector_length;
+            int n_requests = 1;
+            if (trk_parameters.track_pilot)
+                {
+                    correlator_data_cpu.set_input_output_vectors(d_Prompt_Data, in);
+                    requests[1] = requests[0];
+                    requests[1].correlator = &correlator_data_cpu;
+                    n_requests = 2;
+                }
+            Multichannel_Correlator_Engine::instance().correlate(requests, n_requests);
+            return;
+        }
+    correlator->Carrier_wipeoff_multicorrelator_resampler(
         d_rem_carr_phase_rad,
         d_carrier_phase_step_rad, d_carrier_phase_rate_step_rad,
         static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
@@ -899,7 +1082,7 @@ void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
     // DATA CORRELATOR (if tracking tracks the pilot signal)
     if (trk_parameters.track_pilot)
         {
-            correlator_data_cpu.set_input_output_vectors(d_Prompt_Data, input_samples);
+            correlator_data_cpu.set_input_output_vectors(d_Prompt_Data, in);
             correlator_data_cpu.Carrier_wipeoff_multicorrelator_resampler(
                 d_rem_carr_phase_rad,
                 d_carrier_phase_step_rad, d_carrier_phase_rate_step_rad,
@@ -957,7 +1140,7 @@ void dll_pll_veml_tracking::run_dll_pll()
     //    std::cout << "d_CN0_SNV_dB_Hz: " << this->d_CN0_SNV_dB_Hz << std::endl;
     // ################## DLL ##########################################################
     // DLL discriminator
-    if (d_veml)
+    if (d_veml and !d_reduced_taps)
         {
             d_code_error_chips = dll_nc_vemlp_normalized(d_VE_accu, d_E_accu, d_L_accu, d_VL_accu);  // [chips/Ti]
         }
@@ -1125,17 +1308,113 @@ void dll_pll_veml_tracking::save_correlation_results()
 }
 
 
+void dll_pll_veml_tracking::start_extended_integration()
+{
+    // UPDATE INTEGRATION TIME
+    d_extend_correlation_symbols_count = 0;
+    d_current_correlation_time_s = static_cast<float>(trk_parameters.extend_correlation_symbols) * static_cast<float>(d_code_period);
+    d_state = 3;  // next state is the extended correlator integrator
+    LOG(INFO) << "Enabled " << trk_parameters.extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
+              << d_channel
+              << " for satellite " << Gnss_Satellite(systemName, d_acquisition_gnss_synchro->PRN);
+    std::cout << "Enabled " << trk_parameters.extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
+              << d_channel
+              << " for satellite " << Gnss_Satellite(systemName, d_acquisition_gnss_synchro->PRN) << std::endl;
+    // Set narrow taps delay values [chips]
+    d_code_loop_filter.set_update_interval(d_current_correlation_time_s);
+    d_code_loop_filter.set_noise_bandwidth(trk_parameters.dll_bw_narrow_hz);
+    d_carrier_loop_filter.set_params(trk_parameters.fll_bw_hz, trk_parameters.pll_bw_narrow_hz, trk_parameters.pll_filter_order);
+    if (d_veml)
+        {
+            d_local_code_shift_chips[0] = -trk_parameters.very_early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[1] = -trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[3] = trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[4] = trk_parameters.very_early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
+        }
+    else
+        {
+            d_local_code_shift_chips[0] = -trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[2] = trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
+        }
+}
+
+
+void dll_pll_veml_tracking::stop_extended_integration()
+{
+    // Back to one code period per loop update, with the wide loops and taps
+    d_extend_correlation_symbols_count = 0;
+    d_current_correlation_time_s = d_code_period;
+    d_state = 4;
+    d_code_loop_filter.set_update_interval(d_current_correlation_time_s);
+    d_code_loop_filter.set_noise_bandwidth(trk_parameters.dll_bw_hz);
+    d_carrier_loop_filter.set_params(trk_parameters.fll_bw_hz, trk_parameters.pll_bw_hz, trk_parameters.pll_filter_order);
+    if (d_veml)
+        {
+            d_local_code_shift_chips[0] = -trk_parameters.very_early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[1] = -trk_parameters.early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[3] = trk_parameters.early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[4] = trk_parameters.very_early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+        }
+    else
+        {
+            d_local_code_shift_chips[0] = -trk_parameters.early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[2] = trk_parameters.early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+        }
+}
+
+
+// Applies the mode chosen by the CN0 policy. Called at the end of a loop
+// update (states 2 and 4), once the accumulators have been used.
+void dll_pll_veml_tracking::update_tracking_mode()
+{
+    int32_t mode = d_mode_policy.mode();
+    if (!trk_parameters.adaptive_correlation or mode == d_tracking_mode)
+        {
+            return;
+        }
+    bool extend = (mode == Tracking_Mode_Policy::WEAK and trk_parameters.extend_correlation_symbols > 1);
+    if (d_state == 4)
+        {
+            if (extend and !d_enable_extended_integration)
+                {
+                    // The extended integration has to start at a symbol boundary
+                    if (d_current_symbol % trk_parameters.extend_correlation_symbols != 0)
+                        {
+                            return;
+                        }
+                    start_extended_integration();
+                }
+            else if (!extend and d_enable_extended_integration)
+                {
+                    stop_extended_integration();
+                }
+            // The CN0 window must not mix integration times
+            d_cn0_estimation_counter = 0;
+            d_lock_detectors.reset();
+        }
+    d_enable_extended_integration = extend;
+    d_reduced_taps = (d_enable_reduced_taps and mode == Tracking_Mode_Policy::STRONG);
+    if (d_reduced_taps)
+        {
+            *d_Very_Early = gr_complex(0.0, 0.0);
+            *d_Very_Late = gr_complex(0.0, 0.0);
+        }
+    d_tracking_mode = mode;
+    LOG(INFO) << "Tracking mode " << (mode == Tracking_Mode_Policy::STRONG ? "strong" : (mode == Tracking_Mode_Policy::WEAK ? "weak" : "nominal"))
+              << " (CN0 = " << d_CN0_SNV_dB_Hz << " dB-Hz) in channel " << d_channel
+              << " for satellite " << Gnss_Satellite(systemName, d_acquisition_gnss_synchro->PRN);
+}
+
+
 void dll_pll_veml_tracking::log_data(bool integrating)
 {
     if (d_dump)
         {
             // Dump results to file
+            Trk_Dump_Record record{};
             float prompt_I;
             float prompt_Q;
             float tmp_VE, tmp_E, tmp_P, tmp_L, tmp_VL;
-            float tmp_float;
-            double tmp_double;
-            uint64_t tmp_long_int;
             if (trk_parameters.track_pilot)
                 {
                     if (interchange_iq)
@@ -1190,62 +1469,42 @@ void dll_pll_veml_tracking::log_data(bool integrating)
                         }
                 }
 
-            try
-                {
-                    // Dump correlators output
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VE), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_E), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_P), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_L), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VL), sizeof(float));
-                    // PROMPT I and Q (to analyze navigation symbols)
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_I), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
-                    // PRN start sample stamp
-                    tmp_long_int = d_sample_counter + static_cast<uint64_t>(d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_long_int), sizeof(uint64_t));
-                    // accumulated carrier phase
-                    tmp_float = d_acc_carrier_phase_rad;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // carrier and code frequency
-                    tmp_float = d_carrier_doppler_hz;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // carrier phase rate [Hz/s]
-                    tmp_float = d_carrier_phase_rate_step_rad * trk_parameters.fs_in * trk_parameters.fs_in / PI_2;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = d_code_freq_chips;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // code phase rate [chips/s^2]
-                    tmp_float = d_code_phase_rate_step_chips * trk_parameters.fs_in * trk_parameters.fs_in;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // PLL commands
-                    tmp_float = d_carr_phase_error_hz;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = d_carr_error_filt_hz;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // DLL commands
-                    tmp_float = d_code_error_chips;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = d_code_error_filt_chips;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // CN0 and carrier lock test
-                    tmp_float = d_CN0_SNV_dB_Hz;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = d_carrier_lock_test;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // AUX vars (for debug purposes)
-                    tmp_float = d_rem_code_phase_samples;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_double = static_cast<double>(d_sample_counter + d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    // PRN
-                    uint32_t prn_ = d_acquisition_gnss_synchro->PRN;
-                    d_dump_file.write(reinterpret_cast<char *>(&prn_), sizeof(uint32_t));
-                }
-            catch (const std::ifstream::failure &e)
-                {
-                    LOG(WARNING) << "Exception writing trk dump file " << e.what();
-                }
+            // Correlators output
+            record.abs_VE = tmp_VE;
+            record.abs_E = tmp_E;
+            record.abs_P = tmp_P;
+            record.abs_L = tmp_L;
+            record.abs_VL = tmp_VL;
+            // PROMPT I and Q (to analyze navigation symbols)
+            record.Prompt_I = prompt_I;
+            record.Prompt_Q = prompt_Q;
+            // PRN start sample stamp
+            record.PRN_start_sample_count = d_sample_counter + static_cast<uint64_t>(d_current_prn_length_samples);
+            // accumulated carrier phase
+            record.acc_carrier_phase_rad = d_acc_carrier_phase_rad;
+            // carrier and code frequency
+            record.carrier_doppler_hz = d_carrier_doppler_hz;
+            // carrier phase rate [Hz/s]
+            record.carrier_doppler_rate_hz = d_carrier_phase_rate_step_rad * trk_parameters.fs_in * trk_parameters.fs_in / PI_2;
+            record.code_freq_chips = d_code_freq_chips;
+            // code phase rate [chips/s^2]
+            record.code_freq_rate_chips = d_code_phase_rate_step_chips * trk_parameters.fs_in * trk_parameters.fs_in;
+            // PLL commands
+            record.carr_error_hz = d_carr_phase_error_hz;
+            record.carr_error_filt_hz = d_carr_error_filt_hz;
+            // DLL commands
+            record.code_error_chips = d_code_error_chips;
+            record.code_error_filt_chips = d_code_error_filt_chips;
+            // CN0 and carrier lock test
+            record.CN0_SNV_dB_Hz = d_CN0_SNV_dB_Hz;
+            record.carrier_lock_test = d_carrier_lock_test;
+            // AUX vars (for debug purposes)
+            record.aux1 = d_rem_code_phase_samples;
+            record.aux2 = static_cast<double>(d_sample_counter + d_current_prn_length_samples);
+            // PRN
+            record.PRN = d_acquisition_gnss_synchro->PRN;
+            // The record is copied to a buffer, the file is written by a background thread
+            d_dump_file.write(record);
         }
 }
 
@@ -1253,122 +1512,19 @@ void dll_pll_veml_tracking::log_data(bool integrating)
 int32_t dll_pll_veml_tracking::save_matfile()
 {
     // READ DUMP FILE
-    std::ifstream::pos_type size;
-    int32_t number_of_double_vars = 1;
-    int32_t number_of_float_vars = 19;
-    int32_t epoch_size_bytes = sizeof(uint64_t) + sizeof(double) * number_of_double_vars +
-                               sizeof(float) * number_of_float_vars + sizeof(uint32_t);
-    std::ifstream dump_file;
     std::string dump_filename_ = d_dump_filename;
     // add channel number to the filename
     dump_filename_.append(std::to_string(d_channel));
     // add extension
     dump_filename_.append(".dat");
     std::cout << "Generating .mat file for " << dump_filename_ << std::endl;
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
+    Gnss_Dump_Reader dump_file;
+    if (!dump_file.open(dump_filename_, sizeof(Trk_Dump_Record)))
         {
-            dump_file.open(dump_filename_.c_str(), std::ios::binary | std::ios::ate);
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem opening dump file:" << e.what() << std::endl;
-            return 1;
-        }
-    // count number of epochs and rewind
-    int64_t num_epoch = 0;
-    if (dump_file.is_open())
-        {
-            size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
-        }
-    else
-        {
-            return 1;
-        }
-    auto *abs_VE = new float[num_epoch];
-    auto *abs_E = new float[num_epoch];
-    auto *abs_P = new float[num_epoch];
-    auto *abs_L = new float[num_epoch];
-    auto *abs_VL = new float[num_epoch];
-    auto *Prompt_I = new float[num_epoch];
-    auto *Prompt_Q = new float[num_epoch];
-    auto *PRN_start_sample_count = new uint64_t[num_epoch];
-    auto *acc_carrier_phase_rad = new float[num_epoch];
-    auto *carrier_doppler_hz = new float[num_epoch];
-    auto *carrier_doppler_rate_hz = new float[num_epoch];
-    auto *code_freq_chips = new float[num_epoch];
-    auto *code_freq_rate_chips = new float[num_epoch];
-    auto *carr_error_hz = new float[num_epoch];
-    auto *carr_error_filt_hz = new float[num_epoch];
-    auto *code_error_chips = new float[num_epoch];
-    auto *code_error_filt_chips = new float[num_epoch];
-    auto *CN0_SNV_dB_Hz = new float[num_epoch];
-    auto *carrier_lock_test = new float[num_epoch];
-    auto *aux1 = new float[num_epoch];
-    auto *aux2 = new double[num_epoch];
-    auto *PRN = new uint32_t[num_epoch];
-
-    try
-        {
-            if (dump_file.is_open())
-                {
-                    for (int64_t i = 0; i < num_epoch; i++)
-                        {
-                            dump_file.read(reinterpret_cast<char *>(&abs_VE[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_E[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_P[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_L[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_VL[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_I[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_Q[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&PRN_start_sample_count[i]), sizeof(uint64_t));
-                            dump_file.read(reinterpret_cast<char *>(&acc_carrier_phase_rad[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_rate_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_rate_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_filt_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_filt_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&CN0_SNV_dB_Hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_lock_test[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux1[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux2[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&PRN[i]), sizeof(uint32_t));
-                        }
-                }
-            dump_file.close();
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem reading dump file:" << e.what() << std::endl;
-            delete[] abs_VE;
-            delete[] abs_E;
-            delete[] abs_P;
-            delete[] abs_L;
-            delete[] abs_VL;
-            delete[] Prompt_I;
-            delete[] Prompt_Q;
-            delete[] PRN_start_sample_count;
-            delete[] acc_carrier_phase_rad;
-            delete[] carrier_doppler_hz;
-            delete[] carrier_doppler_rate_hz;
-            delete[] code_freq_chips;
-            delete[] code_freq_rate_chips;
-            delete[] carr_error_hz;
-            delete[] carr_error_filt_hz;
-            delete[] code_error_chips;
-            delete[] code_error_filt_chips;
-            delete[] CN0_SNV_dB_Hz;
-            delete[] carrier_lock_test;
-            delete[] aux1;
-            delete[] aux2;
-            delete[] PRN;
+            std::cerr << "Problem opening dump file: " << dump_filename_ << std::endl;
             return 1;
         }
+    auto num_epoch = static_cast<size_t>(dump_file.records());
 
     // WRITE MAT FILE
     mat_t *matfp;
@@ -1379,118 +1535,53 @@ int32_t dll_pll_veml_tracking::save_matfile()
     matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
     if (reinterpret_cast<int64_t *>(matfp) != nullptr)
         {
-            size_t dims[2] = {1, static_cast<size_t>(num_epoch)};
-            matvar = Mat_VarCreate("abs_VE", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_VE, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_E", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_E, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_P", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_P, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_L", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_L, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_VL", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, abs_VL, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Prompt_I", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, Prompt_I, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Prompt_Q", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, Prompt_Q, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN_start_sample_count", MAT_C_UINT64, MAT_T_UINT64, 2, dims, PRN_start_sample_count, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("acc_carrier_phase_rad", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, acc_carrier_phase_rad, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carrier_doppler_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_doppler_rate_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carrier_doppler_rate_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_freq_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_freq_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_freq_rate_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_freq_rate_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carr_error_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carr_error_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carr_error_filt_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carr_error_filt_hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_error_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_error_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_error_filt_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, code_error_filt_chips, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("CN0_SNV_dB_Hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, CN0_SNV_dB_Hz, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_lock_test", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, carrier_lock_test, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
+            size_t dims[2] = {1, num_epoch};
+            // One column at a time, read in bulk from the records
+            std::vector<float> float_column;
+            const std::vector<std::pair<std::string, size_t>> float_vars = {
+                {"abs_VE", offsetof(Trk_Dump_Record, abs_VE)},
+                {"abs_E", offsetof(Trk_Dump_Record, abs_E)},
+                {"abs_P", offsetof(Trk_Dump_Record, abs_P)},
+                {"abs_L", offsetof(Trk_Dump_Record, abs_L)},
+                {"abs_VL", offsetof(Trk_Dump_Record, abs_VL)},
+                {"Prompt_I", offsetof(Trk_Dump_Record, Prompt_I)},
+                {"Prompt_Q", offsetof(Trk_Dump_Record, Prompt_Q)},
+                {"acc_carrier_phase_rad", offsetof(Trk_Dump_Record, acc_carrier_phase_rad)},
+                {"carrier_doppler_hz", offsetof(Trk_Dump_Record, carrier_doppler_hz)},
+                {"carrier_doppler_rate_hz", offsetof(Trk_Dump_Record, carrier_doppler_rate_hz)},
+                {"code_freq_chips", offsetof(Trk_Dump_Record, code_freq_chips)},
+                {"code_freq_rate_chips", offsetof(Trk_Dump_Record, code_freq_rate_chips)},
+                {"carr_error_hz", offsetof(Trk_Dump_Record, carr_error_hz)},
+                {"carr_error_filt_hz", offsetof(Trk_Dump_Record, carr_error_filt_hz)},
+                {"code_error_chips", offsetof(Trk_Dump_Record, code_error_chips)},
+                {"code_error_filt_chips", offsetof(Trk_Dump_Record, code_error_filt_chips)},
+                {"CN0_SNV_dB_Hz", offsetof(Trk_Dump_Record, CN0_SNV_dB_Hz)},
+                {"carrier_lock_test", offsetof(Trk_Dump_Record, carrier_lock_test)},
+                {"aux1", offsetof(Trk_Dump_Record, aux1)}};
+            for (const auto &var : float_vars)
+                {
+                    dump_file.column(var.second, float_column);
+                    matvar = Mat_VarCreate(var.first.c_str(), MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, float_column.data(), 0);
+                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+                    Mat_VarFree(matvar);
+                }
 
-            matvar = Mat_VarCreate("aux1", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, aux1, 0);
+            std::vector<uint64_t> PRN_start_sample_count = dump_file.column<uint64_t>(offsetof(Trk_Dump_Record, PRN_start_sample_count));
+            matvar = Mat_VarCreate("PRN_start_sample_count", MAT_C_UINT64, MAT_T_UINT64, 2, dims, PRN_start_sample_count.data(), 0);
             Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
             Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("aux2", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, aux2, 0);
+            std::vector<double> aux2 = dump_file.column<double>(offsetof(Trk_Dump_Record, aux2));
+            matvar = Mat_VarCreate("aux2", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, aux2.data(), 0);
             Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
             Mat_VarFree(matvar);
 
-            matvar = Mat_VarCreate("PRN", MAT_C_UINT32, MAT_T_UINT32, 2, dims, PRN, 0);
+            std::vector<uint32_t> PRN = dump_file.column<uint32_t>(offsetof(Trk_Dump_Record, PRN));
+            matvar = Mat_VarCreate("PRN", MAT_C_UINT32, MAT_T_UINT32, 2, dims, PRN.data(), 0);
             Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
             Mat_VarFree(matvar);
         }
     Mat_Close(matfp);
-    delete[] abs_VE;
-    delete[] abs_E;
-    delete[] abs_P;
-    delete[] abs_L;
-    delete[] abs_VL;
-    delete[] Prompt_I;
-    delete[] Prompt_Q;
-    delete[] PRN_start_sample_count;
-    delete[] acc_carrier_phase_rad;
-    delete[] carrier_doppler_hz;
-    delete[] carrier_doppler_rate_hz;
-    delete[] code_freq_chips;
-    delete[] code_freq_rate_chips;
-    delete[] carr_error_hz;
-    delete[] carr_error_filt_hz;
-    delete[] code_error_chips;
-    delete[] code_error_filt_chips;
-    delete[] CN0_SNV_dB_Hz;
-    delete[] carrier_lock_test;
-    delete[] aux1;
-    delete[] aux2;
-    delete[] PRN;
     return 0;
 }
 
@@ -1511,17 +1602,13 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
 
             if (!d_dump_file.is_open())
                 {
-                    try
+                    if (d_dump_file.open(dump_filename_))
                         {
-                            //trk_parameters.dump_filename.append(boost::lexical_cast<std::string>(d_channel));
-                            //trk_parameters.dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(dump_filename_.c_str(), std::ios::out | std::ios::binary);
                             LOG(INFO) << "Tracking dump enabled on channel " << d_channel << " Log file: " << dump_filename_.c_str();
                         }
-                    catch (const std::ifstream::failure &e)
+                    else
                         {
-                            LOG(WARNING) << "channel " << d_channel << " Exception opening trk dump file " << e.what();
+                            LOG(WARNING) << "channel " << d_channel << " Problem opening trk dump file " << dump_filename_;
                         }
                 }
         }
@@ -1541,14 +1628,9 @@ void dll_pll_veml_tracking::stop_tracking()
     d_state = 0;
 }
 
-int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
-{
-    gr::thread::scoped_lock l(d_setlock);
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
-    Gnss_Synchro current_synchro_data = Gnss_Synchro();
 
+int32_t dll_pll_veml_tracking::process_epoch(const void *in, int32_t available_samples, Gnss_Synchro &current_synchro_data)
+{
     if (d_pull_in_transitory == true)
         {
             if (trk_parameters.pull_in_time_s < (d_sample_counter - d_acq_sample_stamp) / static_cast<int>(trk_parameters.fs_in))
@@ -1560,10 +1642,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
         {
         case 0:  // Standby - Consume samples at full throttle, do nothing
             {
-                d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
-                consume_each(ninput_items[0]);
-                return 0;
-                break;
+                d_sample_counter += static_cast<uint64_t>(available_samples);
+                return available_samples;
             }
         case 1:  // Pull-in
             {
@@ -1583,7 +1663,17 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 double T_prn_mod_seconds = T_chip_mod_seconds * static_cast<double>(d_code_length_chips);
                 double T_prn_mod_samples = T_prn_mod_seconds * trk_parameters.fs_in;
 
-                d_acq_code_phase_samples = T_prn_mod_samples - std::fmod(delta_trk_to_acq_prn_start_samples, T_prn_mod_samples);
+                // The channel may still be behind the acquisition sample stamp if it was
+                // waiting for a standby batch, so wrap negative delays as well
+                double delta_mod_prn_samples = std::fmod(delta_trk_to_acq_prn_start_samples, T_prn_mod_samples);
+                if (delta_mod_prn_samples >= 0.0)
+                    {
+                        d_acq_code_phase_samples = T_prn_mod_samples - delta_mod_prn_samples;
+                    }
+                else
+                    {
+                        d_acq_code_phase_samples = -delta_mod_prn_samples;
+                    }
                 d_current_prn_length_samples = round(T_prn_mod_samples);
 
                 int32_t samples_offset = round(d_acq_code_phase_samples);
@@ -1595,8 +1685,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_hz
                            << ". PULL-IN Code Phase [samples] = " << d_acq_code_phase_samples;
 
-                consume_each(samples_offset);  // shift input to perform alignment with local replica
-                return 0;
+                return samples_offset;  // shift input to perform alignment with local replica
             }
         case 2:  // Wide tracking and symbol synchronization
             {
@@ -1723,6 +1812,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
                         current_synchro_data.Flag_valid_symbol_output = true;
                         current_synchro_data.correlation_length_ms = d_correlation_length_ms;
+                        current_synchro_data.tracking_mode = d_tracking_mode;
+                        update_tracking_mode();
 
                         if (next_state)
                             {  // reset extended correlator
@@ -1736,32 +1827,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
 
                                 if (d_enable_extended_integration)
                                     {
-                                        // UPDATE INTEGRATION TIME
-                                        d_extend_correlation_symbols_count = 0;
-                                        d_current_correlation_time_s = static_cast<float>(trk_parameters.extend_correlation_symbols) * static_cast<float>(d_code_period);
-                                        d_state = 3;  // next state is the extended correlator integrator
-                                        LOG(INFO) << "Enabled " << trk_parameters.extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
-                                                  << d_channel
-                                                  << " for satellite " << Gnss_Satellite(systemName, d_acquisition_gnss_synchro->PRN);
-                                        std::cout << "Enabled " << trk_parameters.extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
-                                                  << d_channel
-                                                  << " for satellite " << Gnss_Satellite(systemName, d_acquisition_gnss_synchro->PRN) << std::endl;
-                                        // Set narrow taps delay values [chips]
-                                        d_code_loop_filter.set_update_interval(d_current_correlation_time_s);
-                                        d_code_loop_filter.set_noise_bandwidth(trk_parameters.dll_bw_narrow_hz);
-                                        d_carrier_loop_filter.set_params(trk_parameters.fll_bw_hz, trk_parameters.pll_bw_narrow_hz, trk_parameters.pll_filter_order);
-                                        if (d_veml)
-                                            {
-                                                d_local_code_shift_chips[0] = -trk_parameters.very_early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                                d_local_code_shift_chips[1] = -trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                                d_local_code_shift_chips[3] = trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                                d_local_code_shift_chips[4] = trk_parameters.very_early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                            }
-                                        else
-                                            {
-                                                d_local_code_shift_chips[0] = -trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                                d_local_code_shift_chips[2] = trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                            }
+                                        start_extended_integration();
                                     }
                                 else
                                     {
@@ -1815,6 +1881,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
                 current_synchro_data.Flag_valid_symbol_output = true;
                 current_synchro_data.correlation_length_ms = d_correlation_length_ms;
+                current_synchro_data.tracking_mode = d_tracking_mode;
                 d_extend_correlation_symbols_count++;
                 if (d_extend_correlation_symbols_count == (trk_parameters.extend_correlation_symbols - 1))
                     {
@@ -1834,7 +1901,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 save_correlation_results();
 
                 // check lock status
-                if (!cn0_and_tracking_lock_status(d_code_period * static_cast<double>(trk_parameters.extend_correlation_symbols)))
+                if (!cn0_and_tracking_lock_status(static_cast<double>(d_current_correlation_time_s)))
                     {
                         clear_tracking_vars();
                         d_state = 0;  // loss-of-lock detected
@@ -1879,6 +1946,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
                         current_synchro_data.Flag_valid_symbol_output = true;
                         current_synchro_data.correlation_length_ms = d_correlation_length_ms;
+                        current_synchro_data.tracking_mode = d_tracking_mode;
                         // enable write dump file this cycle (valid DLL/PLL cycle)
                         log_data(false);
                         // reset extended correlator
@@ -1887,6 +1955,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         d_P_accu = gr_complex(0.0, 0.0);
                         d_L_accu = gr_complex(0.0, 0.0);
                         d_VL_accu = gr_complex(0.0, 0.0);
+                        update_tracking_mode();
                         if (d_enable_extended_integration)
                             {
                                 d_state = 3;  // new coherent integration (correlation time extension) cycle
@@ -1894,14 +1963,47 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     }
             }
         }
-    consume_each(d_current_prn_length_samples);
     d_sample_counter += static_cast<uint64_t>(d_current_prn_length_samples);
-    if (current_synchro_data.Flag_valid_symbol_output)
+    return d_current_prn_length_samples;
+}
+
+
+bool dll_pll_veml_tracking::stop()
+{
+    d_dump_file.flush();
+    return true;
+}
+
+
+int dll_pll_veml_tracking::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    const auto *in = static_cast<const uint8_t *>(input_items[0]);
+    const size_t item_size = input_signature()->sizeof_stream_item(0);
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);
+
+    // Process as many integration periods as the input and the output space
+    // allow. Each period needs what forecast() asks for a single call, so the
+    // loop filters see exactly the same sequence of epochs as with one call
+    // per period.
+    int32_t required_samples = static_cast<int32_t>(trk_parameters.vector_length) * 2;
+    int32_t consumed_samples = 0;
+    int produced_items = 0;
+    do
         {
-            current_synchro_data.fs = static_cast<int64_t>(trk_parameters.fs_in);
-            current_synchro_data.Tracking_sample_counter = d_sample_counter;
-            *out[0] = current_synchro_data;
-            return 1;
+            Gnss_Synchro current_synchro_data = Gnss_Synchro();
+            consumed_samples += process_epoch(in + consumed_samples * item_size, ninput_items[0] - consumed_samples, current_synchro_data);
+            if (current_synchro_data.Flag_valid_symbol_output)
+                {
+                    current_synchro_data.fs = static_cast<int64_t>(trk_parameters.fs_in);
+                    current_synchro_data.Tracking_sample_counter = d_sample_counter;
+                    out[produced_items] = current_synchro_data;
+                    produced_items++;
+                }
         }
-    return 0;
+    while (d_state != 0 and produced_items < noutput_items and ninput_items[0] - consumed_samples >= required_samples);
+
+    consume_each(consumed_samples);
+    return produced_items;
 }
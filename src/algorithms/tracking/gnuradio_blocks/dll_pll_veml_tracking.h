@@ -32,10 +32,14 @@
 #ifndef GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 #define GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 
+#include "cpu_multicorrelator_8sc.h"
 #include "cpu_multicorrelator_real_codes.h"
 #include "dll_pll_conf.h"
+#include "gnss_sdr_dump.h"
+#include "lock_detectors.h"
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
 #include "tracking_loop_filter.h"     // for DLL filter
+#include "tracking_mode_policy.h"
 #include <boost/circular_buffer.hpp>
 #include <boost/shared_ptr.hpp>   // for boost::shared_ptr
 #include <gnuradio/block.h>       // for block
@@ -43,7 +47,7 @@
 #include <gnuradio/types.h>       // for gr_vector_int, gr_vector...
 #include <pmt/pmt.h>              // for pmt_t
 #include <cstdint>                // for int32_t
-#include <fstream>                // for string, ofstream
+#include <string>                 // for string
 #include <utility>                // for pair
 
 class Gnss_Synchro;
@@ -66,6 +70,8 @@ public:
     void start_tracking();
     void stop_tracking();
 
+    bool stop();  //!< Completes the dump file when the flowgraph stops
+
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
@@ -78,11 +84,15 @@ private:
 
     bool cn0_and_tracking_lock_status(double coh_integration_time_s);
     bool acquire_secondary();
-    void do_correlation_step(const gr_complex *input_samples);
+    void do_correlation_step(const void *input_samples);
+    int32_t process_epoch(const void *in, int32_t available_samples, Gnss_Synchro &current_synchro_data);
     void run_dll_pll();
     void update_tracking_vars();
     void clear_tracking_vars();
     void save_correlation_results();
+    void start_extended_integration();
+    void stop_extended_integration();
+    void update_tracking_mode();
     void log_data(bool integrating);
     int32_t save_matfile();
 
@@ -125,6 +135,12 @@ private:
     float *d_prompt_data_shift;
     Cpu_Multicorrelator_Real_Codes multicorrelator_cpu;
     Cpu_Multicorrelator_Real_Codes correlator_data_cpu;  //for data channel
+    // 8-bit integer replicas and correlators used when item_type is cbyte
+    bool d_use_8sc;
+    int8_t *d_tracking_code_8i;
+    int8_t *d_data_code_8i;
+    Cpu_Multicorrelator_8sc multicorrelator_cpu_8sc;
+    Cpu_Multicorrelator_8sc correlator_data_cpu_8sc;
     /*  TODO: currently the multicorrelator does not support adding extra correlator
         with different local code, thus we need extra multicorrelator instance.
         Implement this functionality inside multicorrelator class
@@ -138,6 +154,12 @@ private:
     gr_complex *d_Very_Late;
 
     bool d_enable_extended_integration;
+    // CN0-adaptive correlator configuration
+    Tracking_Mode_Policy d_mode_policy;
+    int32_t d_tracking_mode;
+    bool d_enable_reduced_taps;
+    bool d_reduced_taps;
+    Cpu_Multicorrelator_Real_Codes multicorrelator_cpu_elp;  // Early, Prompt and Late only, for strong signals
     int32_t d_extend_correlation_symbols_count;
     int32_t d_current_symbol;
 
@@ -196,10 +218,10 @@ private:
     double d_CN0_SNV_dB_Hz;
     double d_carrier_lock_threshold;
     boost::circular_buffer<gr_complex> d_Prompt_circular_buffer;
-    gr_complex *d_Prompt_buffer;
+    Lock_Detectors d_lock_detectors;
 
     // file dump
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
     std::string d_dump_filename;
     bool d_dump;
     bool d_dump_mat;
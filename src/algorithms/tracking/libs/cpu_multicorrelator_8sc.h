@@ -0,0 +1,71 @@
+/*!
+ * \file cpu_multicorrelator_8sc.h
+ * \brief Highly optimized CPU vector multiTAP correlator class for lv_8sc_t (byte complex)
+ * input samples and real-valued local codes
+ *
+ * Class that implements a highly optimized vector multiTAP correlator class for CPUs,
+ * intended for front-ends delivering 8 bits (or less) per sample component.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CPU_MULTICORRELATOR_8SC_H_
+#define GNSS_SDR_CPU_MULTICORRELATOR_8SC_H_
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <complex>
+#include <cstdint>
+
+
+/*!
+ * \brief Class that implements carrier wipe-off and correlators for 8-bit complex samples.
+ *
+ * The local code replicas are stored as 8-bit integers and the correlator outputs
+ * are delivered as std::complex<float>, in the same units as the input samples.
+ */
+class Cpu_Multicorrelator_8sc
+{
+public:
+    Cpu_Multicorrelator_8sc();
+    ~Cpu_Multicorrelator_8sc();
+    bool init(int max_signal_length_samples, int n_correlators);
+    bool set_local_code_and_taps(int code_length_chips, const int8_t *local_code_in, float *shifts_chips);
+    bool set_input_output_vectors(std::complex<float> *corr_out, const lv_8sc_t *sig_in);
+    void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips);
+    bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float rem_code_phase_chips, float code_phase_step_chips, int signal_length_samples);
+    bool free();
+
+private:
+    const lv_8sc_t *d_sig_in;
+    int8_t **d_local_codes_resampled;
+    const int8_t *d_local_code_in;
+    std::complex<float> *d_corr_out;
+    float *d_shifts_chips;
+    int d_code_length_chips;
+    int d_n_correlators;
+};
+
+
+#endif /* GNSS_SDR_CPU_MULTICORRELATOR_8SC_H_ */
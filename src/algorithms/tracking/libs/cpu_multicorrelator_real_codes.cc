@@ -43,6 +43,7 @@ Cpu_Multicorrelator_Real_Codes::Cpu_Multicorrelator_Real_Codes()
     d_local_code_in = nullptr;
     d_shifts_chips = nullptr;
     d_corr_out = nullptr;
+    d_segment_corr_out = nullptr;
     d_local_codes_resampled = nullptr;
     d_code_length_chips = 0;
     d_n_correlators = 0;
@@ -71,6 +72,7 @@ bool Cpu_Multicorrelator_Real_Codes::init(
         {
             d_local_codes_resampled[n] = static_cast<float*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
         }
+    d_segment_corr_out = static_cast<std::complex<float>*>(volk_gnsssdr_malloc(n_correlators * sizeof(std::complex<float>), volk_gnsssdr_get_alignment()));
     d_n_correlators = n_correlators;
     return true;
 }
@@ -135,18 +137,19 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     float code_phase_rate_step_chips,
     int signal_length_samples)
 {
-    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
     // Regenerate phase at each call in order to avoid numerical issues
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
     // call VOLK_GNSSSDR kernel
     if (d_use_high_dynamics_resampler)
         {
+            update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
             volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
         }
     else
         {
-            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+            // resample the local code on the fly, without storing the resampled replicas
+            volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, d_local_code_in, rem_code_phase_chips, code_phase_step_chips, d_shifts_chips, d_code_length_chips, d_n_correlators, signal_length_samples);
         }
     return true;
 }
@@ -160,16 +163,63 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     float code_phase_rate_step_chips,
     int signal_length_samples)
 {
-    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
     // Regenerate phase at each call in order to avoid numerical issues
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
     // call VOLK_GNSSSDR kernel
-    volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+    if (d_use_high_dynamics_resampler)
+        {
+            update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
+            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+        }
+    else
+        {
+            volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, d_local_code_in, rem_code_phase_chips, code_phase_step_chips, d_shifts_chips, d_code_length_chips, d_n_correlators, signal_length_samples);
+        }
     return true;
 }
 
 
+void Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler_segment(
+    double rem_carrier_phase_in_rad,
+    double phase_step_rad,
+    double phase_rate_step_rad,
+    double rem_code_phase_chips,
+    double code_phase_step_chips,
+    double code_phase_rate_step_chips,
+    int first_sample,
+    int segment_length_samples,
+    bool accumulate)
+{
+    if (!d_use_high_dynamics_resampler)
+        {
+            phase_rate_step_rad = 0.0;
+            code_phase_rate_step_chips = 0.0;
+        }
+    // Phases at the first sample of the segment. The rate terms are folded into
+    // the steps (secant over the segment), which is accurate to a small fraction
+    // of a chip and of a radian for segments of a few thousand samples.
+    const auto n0 = static_cast<double>(first_sample);
+    const auto length = static_cast<double>(segment_length_samples);
+    double carrier_phase_rad = rem_carrier_phase_in_rad + phase_step_rad * n0 + phase_rate_step_rad * n0 * n0;
+    double carrier_step_rad = phase_step_rad + phase_rate_step_rad * (2.0 * n0 + length);
+    double code_phase_chips = rem_code_phase_chips - code_phase_step_chips * n0 - code_phase_rate_step_chips * n0 * n0;
+    double code_step_chips = code_phase_step_chips + code_phase_rate_step_chips * (2.0 * n0 + length);
+
+    lv_32fc_t phase_offset_as_complex[1];
+    phase_offset_as_complex[0] = lv_cmake(static_cast<float>(std::cos(carrier_phase_rad)), static_cast<float>(-std::sin(carrier_phase_rad)));
+    std::complex<float>* corr_out = accumulate ? d_segment_corr_out : d_corr_out;
+    volk_gnsssdr_32fc_32f_resampler_rotator_dot_prod_32fc_xn(corr_out, d_sig_in + first_sample, std::exp(lv_32fc_t(0.0, -static_cast<float>(carrier_step_rad))), phase_offset_as_complex, d_local_code_in, static_cast<float>(code_phase_chips), static_cast<float>(code_step_chips), d_shifts_chips, d_code_length_chips, d_n_correlators, segment_length_samples);
+    if (accumulate)
+        {
+            for (int n = 0; n < d_n_correlators; n++)
+                {
+                    d_corr_out[n] += d_segment_corr_out[n];
+                }
+        }
+}
+
+
 bool Cpu_Multicorrelator_Real_Codes::free()
 {
     // Free memory
@@ -182,6 +232,11 @@ bool Cpu_Multicorrelator_Real_Codes::free()
             volk_gnsssdr_free(d_local_codes_resampled);
             d_local_codes_resampled = nullptr;
         }
+    if (d_segment_corr_out != nullptr)
+        {
+            volk_gnsssdr_free(d_segment_corr_out);
+            d_segment_corr_out = nullptr;
+        }
     return true;
 }
 
@@ -54,6 +54,14 @@ public:
     void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips = 0.0);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    /*!
+     * \brief Correlates the samples [first_sample, first_sample + segment_length_samples)
+     * of the current input vector. The phases and rates refer to the first sample
+     * of the input vector, as in Carrier_wipeoff_multicorrelator_resampler. If
+     * \p accumulate is true, the result is added to the correlator outputs.
+     */
+    void Carrier_wipeoff_multicorrelator_resampler_segment(double rem_carrier_phase_in_rad, double phase_step_rad, double phase_rate_step_rad, double rem_code_phase_chips, double code_phase_step_chips, double code_phase_rate_step_chips, int first_sample, int segment_length_samples, bool accumulate);
+    inline const std::complex<float> *get_input_vector() const { return d_sig_in; }
     bool free();
 
 private:
@@ -62,6 +70,7 @@ private:
     float **d_local_codes_resampled;
     const float *d_local_code_in;
     std::complex<float> *d_corr_out;
+    std::complex<float> *d_segment_corr_out;
     float *d_shifts_chips;
     bool d_use_high_dynamics_resampler;
     int d_code_length_chips;
@@ -62,11 +62,18 @@ Dll_Pll_Conf::Dll_Pll_Conf()
     very_early_late_space_narrow_chips = 0.1;
     extend_correlation_symbols = 5;
     cn0_samples = 20;
+    cn0_estimator = "SNV";
     carrier_lock_det_mav_samples = 20;
     cn0_min = 25;
     max_lock_fail = 50;
     carrier_lock_th = 0.85;
     track_pilot = false;
+    multichannel_correlator = false;
+    adaptive_correlation = false;
+    adaptive_strong_cn0_db_hz = 45.0;
+    adaptive_weak_cn0_db_hz = 30.0;
+    adaptive_hysteresis_db = 3.0;
+    item_type = "gr_complex";
     system = 'G';
     char sig_[3] = "1C";
     std::memcpy(signal, sig_, 3);
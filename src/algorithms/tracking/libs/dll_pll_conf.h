@@ -67,12 +67,19 @@ public:
     int32_t extend_correlation_symbols;
     bool high_dyn;
     int32_t cn0_samples;
+    std::string cn0_estimator;
     int32_t carrier_lock_det_mav_samples;
     int32_t cn0_min;
     int32_t max_lock_fail;
     uint32_t smoother_length;
     double carrier_lock_th;
     bool track_pilot;
+    bool multichannel_correlator;
+    bool adaptive_correlation;
+    float adaptive_strong_cn0_db_hz;
+    float adaptive_weak_cn0_db_hz;
+    float adaptive_hysteresis_db;
+    std::string item_type;
     char system;
     char signal[3]{};
 
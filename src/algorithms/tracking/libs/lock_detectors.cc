@@ -6,6 +6,8 @@
  * based on the Signal-to-Noise Variance (SNV) estimator [1].
  * Carrier lock detector using normalised estimate of the cosine
  * of twice the carrier phase error [2].
+ * M2M4_CN0 is a moment-based CN0 estimator [3]. Lock_Detectors keeps
+ * both lock detectors up to date, sample by sample, over a sliding window.
  *
  * [1] Marco Pini, Emanuela Falletti and Maurizio Fantino, "Performance
  * Evaluation of C/N0 Estimators using a Real Time GNSS Software Receiver,"
@@ -16,6 +18,10 @@
  * Applications,
  * Volume I, Chapter 8: GPS Receivers, AJ Systems, Los Altos, CA 94024.
  * Inc.: 329-407.
+ *
+ * [3] David R. Pauluzzi and Norman C. Beaulieu, "A Comparison of SNR
+ * Estimation Techniques for the AWGN Channel," IEEE Transactions on
+ * Communications, vol. 48, no. 10, pp. 1681-1691, October 2000.
  * \authors <ul>
  *          <li> Javier Arribas, 2011. jarribas(at)cttc.es
  *          <li> Luis Esteve, 2012. luis(at)epsilon-formacion.com
@@ -47,8 +53,12 @@
  */
 
 #include "lock_detectors.h"
+#include <algorithm>
 #include <cmath>
 
+// Number of updates between two recomputations of the running sums
+const int32_t LOCK_DETECTORS_RENORMALISATION_PERIOD = 1000;
+
 /*
  * Signal-to-Noise (SNR) (\f$\rho\f$) estimator using the Signal-to-Noise Variance (SNV) estimator:
  * \f{equation}
@@ -109,3 +119,111 @@ float carrier_lock_detector(gr_complex* Prompt_buffer, int length)
     NBD = tmp_sum_I * tmp_sum_I - tmp_sum_Q * tmp_sum_Q;
     return NBD / NBP;
 }
+
+
+Lock_Detectors::Lock_Detectors(int32_t length, Cn0_Estimator estimator)
+{
+    d_length = std::max(length, 1);
+    d_estimator = estimator;
+    d_window.resize(d_length);
+    reset();
+}
+
+
+void Lock_Detectors::reset()
+{
+    std::fill(d_window.begin(), d_window.end(), gr_complex(0.0, 0.0));
+    d_count = 0;
+    d_index = 0;
+    d_updates = 0;
+    d_sum_abs_I = 0.0;
+    d_sum_I = 0.0;
+    d_sum_Q = 0.0;
+    d_sum_power = 0.0;
+    d_sum_power2 = 0.0;
+}
+
+
+void Lock_Detectors::update(const gr_complex& prompt)
+{
+    // The slots not yet used hold zeros, which do not change the sums
+    const double old_I = d_window[d_index].real();
+    const double old_Q = d_window[d_index].imag();
+    const double old_power = old_I * old_I + old_Q * old_Q;
+    const double I = prompt.real();
+    const double Q = prompt.imag();
+    const double power = I * I + Q * Q;
+    d_sum_abs_I += std::abs(I) - std::abs(old_I);
+    d_sum_I += I - old_I;
+    d_sum_Q += Q - old_Q;
+    d_sum_power += power - old_power;
+    d_sum_power2 += power * power - old_power * old_power;
+    d_window[d_index] = prompt;
+    d_index++;
+    if (d_index == d_length)
+        {
+            d_index = 0;
+        }
+    if (d_count < d_length)
+        {
+            d_count++;
+        }
+    d_updates++;
+    if (d_updates == LOCK_DETECTORS_RENORMALISATION_PERIOD)
+        {
+            renormalise();
+        }
+}
+
+
+void Lock_Detectors::renormalise()
+{
+    d_updates = 0;
+    d_sum_abs_I = 0.0;
+    d_sum_I = 0.0;
+    d_sum_Q = 0.0;
+    d_sum_power = 0.0;
+    d_sum_power2 = 0.0;
+    for (const gr_complex& value : d_window)
+        {
+            const double I = value.real();
+            const double Q = value.imag();
+            const double power = I * I + Q * Q;
+            d_sum_abs_I += std::abs(I);
+            d_sum_I += I;
+            d_sum_Q += Q;
+            d_sum_power += power;
+            d_sum_power2 += power * power;
+        }
+}
+
+
+float Lock_Detectors::cn0_dB_Hz(double coh_integration_time_s) const
+{
+    const double N = static_cast<double>(d_count);
+    double Psig;
+    double Pnoise;
+    if (d_estimator == M2M4)
+        {
+            const double M2 = d_sum_power / N;
+            const double M4 = d_sum_power2 / N;
+            Psig = std::sqrt(std::max(2.0 * M2 * M2 - M4, 0.0));
+            Pnoise = M2 - Psig;
+        }
+    else
+        {
+            Psig = d_sum_abs_I / N;
+            Psig = Psig * Psig;
+            Pnoise = d_sum_power / N - Psig;
+        }
+    const double SNR = Psig / Pnoise;
+    return static_cast<float>(10.0 * log10(SNR) - 10.0 * log10(coh_integration_time_s));
+}
+
+
+float Lock_Detectors::carrier_lock() const
+{
+    const double NBP = d_sum_I * d_sum_I + d_sum_Q * d_sum_Q;
+    const double NBD = d_sum_I * d_sum_I - d_sum_Q * d_sum_Q;
+    return static_cast<float>(NBD / NBP);
+}
@@ -6,6 +6,8 @@
  * based on the Signal-to-Noise Variance (SNV) estimator [1].
  * Carrier lock detector using normalised estimate of the cosine
  * of twice the carrier phase error [2].
+ * M2M4_CN0 is a moment-based CN0 estimator [3]. Lock_Detectors keeps
+ * both lock detectors up to date, sample by sample, over a sliding window.
  *
  * [1] Marco Pini, Emanuela Falletti and Maurizio Fantino, "Performance
  * Evaluation of C/N0 Estimators using a Real Time GNSS Software Receiver,"
@@ -16,6 +18,10 @@
  * Applications,
  * Volume I, Chapter 8: GPS Receivers, AJ Systems, Los Altos, CA 94024.
  * Inc.: 329-407.
+ *
+ * [3] David R. Pauluzzi and Norman C. Beaulieu, "A Comparison of SNR
+ * Estimation Techniques for the AWGN Channel," IEEE Transactions on
+ * Communications, vol. 48, no. 10, pp. 1681-1691, October 2000.
  * \authors <ul>
  *          <li> Javier Arribas, 2011. jarribas(at)cttc.es
  *          <li> Luis Esteve, 2012. luis(at)epsilon-formacion.com
@@ -49,6 +55,8 @@
 #define GNSS_SDR_LOCK_DETECTORS_H_
 
 #include <gnuradio/gr_complex.h>
+#include <cstdint>
+#include <vector>
 
 
 /*! \brief CN0_SNV is a Carrier-to-Noise (CN0) estimator
@@ -91,4 +99,57 @@ float cn0_svn_estimator(const gr_complex* Prompt_buffer, int length, double coh_
  */
 float carrier_lock_detector(gr_complex* Prompt_buffer, int length);
 
+
+/*! \brief CN0 estimator and carrier lock detector of a tracking channel,
+ * computed over the last N prompt correlator outputs.
+ *
+ * The sums used by cn0_svn_estimator() and carrier_lock_detector() are
+ * updated in O(1) for each new prompt value: the new value is added and the
+ * one leaving the window is subtracted. Once the window is full, the
+ * estimates are the same as those of the functions above applied to the
+ * last N values. The sums are recomputed from the window from time to time,
+ * so that rounding errors do not build up.
+ *
+ * The CN0 can also be estimated with the second and fourth order moments
+ * (M2M4) estimator [3]:
+ * \f{equation}
+ *     \hat{P}_s=\sqrt{2M_2^2-M_4},\quad \hat{P}_n=M_2-\hat{P}_s,
+ * \f}
+ * where \f$M_2=\frac{1}{N}\sum^{N-1}_{i=0}|Pc(i)|^2\f$ and
+ * \f$M_4=\frac{1}{N}\sum^{N-1}_{i=0}|Pc(i)|^4\f$. It does not depend on
+ * the carrier phase, while SNV only looks at \f$Re(Pc(i))\f$.
+ */
+class Lock_Detectors
+{
+public:
+    enum Cn0_Estimator
+    {
+        SNV,
+        M2M4
+    };
+
+    explicit Lock_Detectors(int32_t length = 20, Cn0_Estimator estimator = SNV);
+    void reset();                           //!< Empties the window, e.g. when the integration time changes
+    void update(const gr_complex& prompt);  //!< Adds a new prompt correlator output
+    inline bool ready() const { return d_count == d_length; }  //!< True once the window is full
+
+    float cn0_dB_Hz(double coh_integration_time_s) const;  //!< CN0 [dB-Hz] of the values in the window
+    float carrier_lock() const;                            //!< Estimate of cos(2*phase error) of the values in the window
+
+private:
+    void renormalise();
+
+    std::vector<gr_complex> d_window;
+    int32_t d_length;
+    int32_t d_count;
+    int32_t d_index;
+    int32_t d_updates;
+    Cn0_Estimator d_estimator;
+    double d_sum_abs_I;
+    double d_sum_I;
+    double d_sum_Q;
+    double d_sum_power;
+    double d_sum_power2;
+};
+
 #endif
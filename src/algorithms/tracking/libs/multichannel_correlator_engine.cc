@@ -0,0 +1,185 @@
+/*!
+ * \file multichannel_correlator_engine.cc
+ * \brief Correlation of several tracking channels in a single pass over
+ * the shared input samples
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "multichannel_correlator_engine.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include <algorithm>
+#include <complex>
+#include <functional>
+
+
+Multichannel_Correlator_Engine &Multichannel_Correlator_Engine::instance()
+{
+    static Multichannel_Correlator_Engine engine;
+    return engine;
+}
+
+
+Multichannel_Correlator_Engine::Multichannel_Correlator_Engine()
+{
+    d_pending_threads = 0;
+    d_submitted = 0ULL;
+    d_completed = 0ULL;
+    d_next_group = 0;
+    d_groups_done = 0;
+    d_batch_last = 0ULL;
+    d_batch_block_size_samples = 0;
+    d_batch_active = false;
+    // 16 KB of input samples, leaving room in the L1/L2 cache for the
+    // resampled local codes of the channels
+    d_block_size_samples = 2048;
+}
+
+
+void Multichannel_Correlator_Engine::set_block_size(int block_size_samples)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_block_size_samples = std::max(block_size_samples, 1);
+}
+
+
+void Multichannel_Correlator_Engine::correlate(const Correlation_Request *requests, int n_requests)
+{
+    if (n_requests <= 0)
+        {
+            return;
+        }
+    std::unique_lock<std::mutex> lock(d_mutex);
+    for (int i = 0; i < n_requests; i++)
+        {
+            d_pending.push_back(&requests[i]);
+        }
+    d_submitted += static_cast<uint64_t>(n_requests);
+    d_pending_threads++;
+    // Requests are served in submission order, one batch at a time
+    const uint64_t ticket = d_submitted;
+    while (d_completed < ticket)
+        {
+            if (!d_batch_active)
+                {
+                    start_batch();
+                    d_batch_changed.notify_all();  // the waiting threads help
+                }
+            if (d_next_group < d_groups.size())
+                {
+                    const std::pair<size_t, size_t> group = d_groups[d_next_group++];
+                    const int64_t block_size_samples = d_batch_block_size_samples;
+                    lock.unlock();
+                    run_group(group.first, group.second, block_size_samples);
+                    lock.lock();
+                    if (++d_groups_done == d_groups.size())
+                        {
+                            d_completed = d_batch_last;
+                            d_batch_active = false;
+                            d_batch_changed.notify_all();
+                        }
+                    continue;
+                }
+            d_batch_changed.wait(lock);
+        }
+}
+
+
+void Multichannel_Correlator_Engine::start_batch()
+{
+    d_batch.clear();
+    d_batch.swap(d_pending);
+    const auto n_threads = static_cast<size_t>(std::max(d_pending_threads, 1));
+    d_pending_threads = 0;
+
+    std::less<const std::complex<float> *> before;
+    std::sort(d_batch.begin(), d_batch.end(), [&before](const Correlation_Request *a, const Correlation_Request *b) {
+        return before(a->correlator->get_input_vector(), b->correlator->get_input_vector());
+    });
+
+    // Channels that read overlapping input vectors are kept together, in
+    // groups of at most group_size, so that each thread gets a similar share
+    const size_t group_size = (d_batch.size() + n_threads - 1) / n_threads;
+    d_groups.clear();
+    size_t first = 0;
+    while (first < d_batch.size())
+        {
+            const std::complex<float> *overlap_end = d_batch[first]->correlator->get_input_vector() + d_batch[first]->signal_length_samples;
+            size_t last = first + 1;
+            while (last < d_batch.size() and last - first < group_size and before(d_batch[last]->correlator->get_input_vector(), overlap_end))
+                {
+                    overlap_end = std::max(overlap_end, d_batch[last]->correlator->get_input_vector() + d_batch[last]->signal_length_samples, before);
+                    last++;
+                }
+            d_groups.emplace_back(first, last);
+            first = last;
+        }
+
+    d_next_group = 0;
+    d_groups_done = 0;
+    d_batch_last = d_submitted;
+    d_batch_block_size_samples = d_block_size_samples;
+    d_batch_active = true;
+}
+
+
+void Multichannel_Correlator_Engine::run_group(size_t first, size_t last, int64_t block_size_samples) const
+{
+    // One pass over the input samples shared by the channels of the group
+    std::less<const std::complex<float> *> before;
+    const std::complex<float> *group_start = d_batch[first]->correlator->get_input_vector();
+    const std::complex<float> *group_end = group_start + d_batch[first]->signal_length_samples;
+    for (size_t i = first + 1; i < last; i++)
+        {
+            group_end = std::max(group_end, d_batch[i]->correlator->get_input_vector() + d_batch[i]->signal_length_samples, before);
+        }
+
+    const int64_t group_length = group_end - group_start;
+    for (int64_t offset = 0; offset < group_length; offset += block_size_samples)
+        {
+            const std::complex<float> *block_start = group_start + offset;
+            const std::complex<float> *block_end = group_start + std::min(offset + block_size_samples, group_length);
+            for (size_t i = first; i < last; i++)
+                {
+                    const Correlation_Request *request = d_batch[i];
+                    const std::complex<float> *input = request->correlator->get_input_vector();
+                    const std::complex<float> *segment_start = std::max(block_start, input, before);
+                    const std::complex<float> *segment_end = std::min(block_end, input + request->signal_length_samples, before);
+                    if (before(segment_start, segment_end))
+                        {
+                            request->correlator->Carrier_wipeoff_multicorrelator_resampler_segment(
+                                request->rem_carrier_phase_in_rad,
+                                request->phase_step_rad,
+                                request->phase_rate_step_rad,
+                                request->rem_code_phase_chips,
+                                request->code_phase_step_chips,
+                                request->code_phase_rate_step_chips,
+                                static_cast<int>(segment_start - input),
+                                static_cast<int>(segment_end - segment_start),
+                                segment_start != input);
+                        }
+                }
+        }
+}
@@ -0,0 +1,125 @@
+/*!
+ * \file multichannel_correlator_engine.h
+ * \brief Correlation of several tracking channels in a single pass over
+ * the shared input samples
+ *
+ * The input samples of all the channels fed by the same signal conditioner
+ * live in the same buffer. Instead of reading that buffer from memory once
+ * per channel, the engine walks it in cache-sized blocks and applies the
+ * carrier wipe-off, code resampling and correlators of every channel that
+ * overlaps a block before moving to the next one.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MULTICHANNEL_CORRELATOR_ENGINE_H_
+#define GNSS_SDR_MULTICHANNEL_CORRELATOR_ENGINE_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+class Cpu_Multicorrelator_Real_Codes;
+
+/*!
+ * \brief One correlation to be performed by the engine, with the same
+ * arguments as Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler.
+ * The correlator must have its input and output vectors already set.
+ */
+struct Correlation_Request
+{
+    Cpu_Multicorrelator_Real_Codes *correlator;
+    double rem_carrier_phase_in_rad;
+    double phase_step_rad;
+    double phase_rate_step_rad;
+    double rem_code_phase_chips;
+    double code_phase_step_chips;
+    double code_phase_rate_step_chips;
+    int signal_length_samples;
+};
+
+
+/*!
+ * \brief Process-wide engine that batches the correlations of the tracking
+ * channels.
+ *
+ * Each channel thread submits its correlations and waits for them. The first
+ * submitting thread that finds the engine idle becomes the combiner: it takes
+ * all the pending requests and splits them into groups of channels, one per
+ * submitting thread. Each group is processed in a cache-blocked pass over the
+ * input samples its channels share. The threads waiting for the batch (or
+ * for the next one) take the groups, so the correlations still run on as
+ * many cores as there are channels waiting. No thread ever waits for a
+ * channel that has not submitted yet, so a channel never stalls the others.
+ * Loop filters and state machines stay in each channel.
+ */
+class Multichannel_Correlator_Engine
+{
+public:
+    static Multichannel_Correlator_Engine &instance();
+
+    /*!
+     * \brief Performs the \p n_requests correlations, batched with the ones
+     * submitted by other channels in the meantime. Returns when all of them
+     * are done.
+     */
+    void correlate(const Correlation_Request *requests, int n_requests);
+
+    /*!
+     * \brief Sets the number of input samples processed by all the channels
+     * before moving to the next block.
+     */
+    void set_block_size(int block_size_samples);
+
+    Multichannel_Correlator_Engine(const Multichannel_Correlator_Engine &) = delete;
+    Multichannel_Correlator_Engine &operator=(const Multichannel_Correlator_Engine &) = delete;
+
+private:
+    Multichannel_Correlator_Engine();
+    void start_batch();
+    void run_group(size_t first, size_t last, int64_t block_size_samples) const;
+
+    std::mutex d_mutex;
+    std::condition_variable d_batch_changed;
+    std::vector<const Correlation_Request *> d_pending;
+    int d_pending_threads;  // threads with requests in d_pending
+    uint64_t d_submitted;
+    uint64_t d_completed;
+
+    // Batch in progress. It is not modified until all its groups are done.
+    std::vector<const Correlation_Request *> d_batch;
+    std::vector<std::pair<size_t, size_t>> d_groups;  // [first, last) of d_batch
+    size_t d_next_group;
+    size_t d_groups_done;
+    uint64_t d_batch_last;  // ticket of the last request in the batch
+    int64_t d_batch_block_size_samples;
+    bool d_batch_active;
+    int d_block_size_samples;
+};
+
+#endif
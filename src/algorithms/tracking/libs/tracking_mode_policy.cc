@@ -0,0 +1,110 @@
+/*!
+ * \file tracking_mode_policy.cc
+ * \brief Selection of the correlator configuration of a tracking channel
+ * from its CN0 estimate
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "tracking_mode_policy.h"
+
+const int32_t Tracking_Mode_Policy::NOMINAL;
+const int32_t Tracking_Mode_Policy::STRONG;
+const int32_t Tracking_Mode_Policy::WEAK;
+
+Tracking_Mode_Policy::Tracking_Mode_Policy()
+{
+    d_strong_cn0_db_hz = 45.0;
+    d_weak_cn0_db_hz = 30.0;
+    d_hysteresis_db = 3.0;
+    d_min_dwell = 3;
+    reset();
+}
+
+
+void Tracking_Mode_Policy::set_thresholds(double strong_cn0_db_hz, double weak_cn0_db_hz, double hysteresis_db, int32_t min_dwell)
+{
+    d_strong_cn0_db_hz = strong_cn0_db_hz;
+    d_weak_cn0_db_hz = weak_cn0_db_hz;
+    d_hysteresis_db = hysteresis_db;
+    d_min_dwell = min_dwell > 0 ? min_dwell : 1;
+    reset();
+}
+
+
+void Tracking_Mode_Policy::reset()
+{
+    d_mode = NOMINAL;
+    d_candidate_mode = NOMINAL;
+    d_candidate_count = 0;
+}
+
+
+int32_t Tracking_Mode_Policy::update(double cn0_db_hz)
+{
+    int32_t target = d_mode;
+    switch (d_mode)
+        {
+        case STRONG:
+            if (cn0_db_hz < d_strong_cn0_db_hz - d_hysteresis_db)
+                {
+                    target = (cn0_db_hz <= d_weak_cn0_db_hz) ? WEAK : NOMINAL;
+                }
+            break;
+        case WEAK:
+            if (cn0_db_hz > d_weak_cn0_db_hz + d_hysteresis_db)
+                {
+                    target = (cn0_db_hz >= d_strong_cn0_db_hz) ? STRONG : NOMINAL;
+                }
+            break;
+        default:
+            if (cn0_db_hz >= d_strong_cn0_db_hz)
+                {
+                    target = STRONG;
+                }
+            else if (cn0_db_hz <= d_weak_cn0_db_hz)
+                {
+                    target = WEAK;
+                }
+        }
+
+    if (target == d_mode)
+        {
+            d_candidate_count = 0;
+            return d_mode;
+        }
+    if (target != d_candidate_mode)
+        {
+            d_candidate_mode = target;
+            d_candidate_count = 0;
+        }
+    d_candidate_count++;
+    if (d_candidate_count >= d_min_dwell)
+        {
+            d_mode = target;
+            d_candidate_count = 0;
+        }
+    return d_mode;
+}
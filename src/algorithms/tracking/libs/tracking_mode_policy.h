@@ -0,0 +1,73 @@
+/*!
+ * \file tracking_mode_policy.h
+ * \brief Selection of the correlator configuration of a tracking channel
+ * from its CN0 estimate
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_MODE_POLICY_H_
+#define GNSS_SDR_TRACKING_MODE_POLICY_H_
+
+#include <cstdint>
+
+/*!
+ * \brief Chooses how much correlator work a tracking channel needs from its
+ * CN0 estimates:
+ *  <ul>
+ *  <li> STRONG: CN0 at or above the strong threshold. Early, Prompt and Late
+ *       are enough, the Very Early and Very Late taps are skipped.
+ *  <li> NOMINAL: the configured taps and integration time.
+ *  <li> WEAK: CN0 at or below the weak threshold. The coherent integration is
+ *       extended.
+ *  </ul>
+ * A mode is left only when the CN0 crosses back its threshold by more than
+ * the hysteresis, and a new mode is entered only after \p min_dwell
+ * consecutive estimates ask for it.
+ */
+class Tracking_Mode_Policy
+{
+public:
+    static const int32_t NOMINAL = 0;
+    static const int32_t STRONG = 1;
+    static const int32_t WEAK = 2;
+
+    Tracking_Mode_Policy();
+    void set_thresholds(double strong_cn0_db_hz, double weak_cn0_db_hz, double hysteresis_db, int32_t min_dwell);
+    void reset();                      //!< Back to NOMINAL, e.g. when tracking restarts
+    int32_t update(double cn0_db_hz);  //!< Feeds a new CN0 estimate and returns the mode to use
+    inline int32_t mode() const { return d_mode; }
+
+private:
+    double d_strong_cn0_db_hz;
+    double d_weak_cn0_db_hz;
+    double d_hysteresis_db;
+    int32_t d_min_dwell;
+    int32_t d_mode;
+    int32_t d_candidate_mode;
+    int32_t d_candidate_count;
+};
+
+#endif
@@ -62,6 +62,8 @@ public:
     virtual void set_threshold(float threshold) = 0;
     virtual void set_doppler_max(unsigned int doppler_max) = 0;
     virtual void set_doppler_step(unsigned int doppler_step) = 0;
+    // Restricts the Doppler search to doppler_center +/- doppler_window [Hz]. Zero window means full search.
+    virtual void set_doppler_window(int doppler_center __attribute__((unused)), unsigned int doppler_window __attribute__((unused))) {}
     virtual void init() = 0;
     virtual void set_local_code() = 0;
     virtual void set_state(int state) = 0;
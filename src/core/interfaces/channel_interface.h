@@ -59,6 +59,7 @@ public:
     virtual void start_acquisition() = 0;
     virtual void stop_channel() = 0;
     virtual void set_signal(const Gnss_Signal&) = 0;
+    virtual void set_doppler_window(int doppler_center, unsigned int doppler_window) = 0;
 };
 
 #endif /* GNSS_SDR_CHANNEL_INTERFACE_H_ */
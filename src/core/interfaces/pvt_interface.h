@@ -40,6 +40,7 @@
 #include "galileo_almanac.h"
 #include "galileo_ephemeris.h"
 #include "gnss_block_interface.h"
+#include "gnss_signal.h"
 #include "gps_almanac.h"
 #include "gps_ephemeris.h"
 
@@ -68,6 +69,10 @@ public:
         double* ground_speed_kmh,
         double* course_over_ground_deg,
         time_t* UTC_time) = 0;
+
+    virtual bool get_predicted_doppler(const Gnss_Signal& signal,
+        double* doppler_hz,
+        double* age_s) = 0;
 };
 
 #endif /* GNSS_SDR_PVT_INTERFACE_H_ */
@@ -0,0 +1,271 @@
+/*!
+ * \file channel_cpu_allocator.cc
+ * \brief Placement of the processing channels on a fixed set of CPU cores
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "channel_cpu_allocator.h"
+#include <algorithm>  // for find, max
+#include <exception>  // for exception
+#include <fstream>    // for ifstream
+#include <sstream>    // for istringstream
+#include <thread>     // for thread
+#if defined(__linux__)
+#include <sched.h>  // for sched_getaffinity
+#endif
+
+
+namespace
+{
+// Parses a sysfs CPU list such as "0-3,8,10-11"
+std::vector<int> parse_cpu_list(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::istringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ','))
+        {
+            if (range.empty())
+                {
+                    continue;
+                }
+            size_t dash = range.find('-');
+            try
+                {
+                    int first = std::stoi(range.substr(0, dash));
+                    int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+                    for (int cpu = first; cpu <= last; cpu++)
+                        {
+                            cpus.push_back(cpu);
+                        }
+                }
+            catch (const std::exception&)
+                {
+                    return std::vector<int>();
+                }
+        }
+    return cpus;
+}
+
+
+bool read_line(const std::string& file_name, std::string& line)
+{
+    std::ifstream file(file_name);
+    return file.is_open() and static_cast<bool>(std::getline(file, line));
+}
+
+
+// CPUs where the process is allowed to run, empty if unknown
+std::vector<int> affinity_cpus()
+{
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+        {
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                {
+                    if (CPU_ISSET(cpu, &mask))
+                        {
+                            cpus.push_back(cpu);
+                        }
+                }
+        }
+#endif
+    return cpus;
+}
+
+
+bool is_allowed(const std::vector<int>& allowed_cpus, int cpu)
+{
+    return allowed_cpus.empty() or std::find(allowed_cpus.cbegin(), allowed_cpus.cend(), cpu) != allowed_cpus.cend();
+}
+
+
+// True if the cpu is the first allowed hardware thread of its core
+bool first_sibling(const std::string& sysfs_root, const std::vector<int>& allowed_cpus, int cpu)
+{
+    if (!is_allowed(allowed_cpus, cpu))
+        {
+            return false;
+        }
+    std::string siblings;
+    if (read_line(sysfs_root + "/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list", siblings))
+        {
+            for (int sibling : parse_cpu_list(siblings))
+                {
+                    if (sibling < cpu and is_allowed(allowed_cpus, sibling))
+                        {
+                            return false;
+                        }
+                }
+        }
+    return true;
+}
+}  // namespace
+
+
+Channel_Cpu_Allocator::Channel_Cpu_Allocator(int max_workers, const std::string& sysfs_root, const std::string& procfs_root, const std::vector<int>& allowed_cpus) : d_procfs_root(procfs_root)
+{
+    std::vector<int> allowed = allowed_cpus.empty() ? affinity_cpus() : allowed_cpus;
+
+    // Physical cores, node after node
+    std::string cpulist;
+    for (int node = 0; read_line(sysfs_root + "/devices/system/node/node" + std::to_string(node) + "/cpulist", cpulist); node++)
+        {
+            for (int cpu : parse_cpu_list(cpulist))
+                {
+                    if (first_sibling(sysfs_root, allowed, cpu))
+                        {
+                            d_cpus.push_back(cpu);
+                            d_nodes.push_back(node);
+                        }
+                }
+        }
+    if (d_cpus.empty() and read_line(sysfs_root + "/devices/system/cpu/online", cpulist))
+        {
+            for (int cpu : parse_cpu_list(cpulist))
+                {
+                    if (first_sibling(sysfs_root, allowed, cpu))
+                        {
+                            d_cpus.push_back(cpu);
+                            d_nodes.push_back(0);
+                        }
+                }
+        }
+    if (d_cpus.empty() and !allowed.empty())
+        {
+            d_cpus = allowed;
+            d_nodes.assign(allowed.size(), 0);
+        }
+    if (d_cpus.empty())
+        {
+            int n_cpus = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+            for (int cpu = 0; cpu < n_cpus; cpu++)
+                {
+                    d_cpus.push_back(cpu);
+                    d_nodes.push_back(0);
+                }
+        }
+    if (max_workers > 0 and max_workers < static_cast<int>(d_cpus.size()))
+        {
+            d_cpus.resize(max_workers);
+            d_nodes.resize(max_workers);
+        }
+}
+
+
+int Channel_Cpu_Allocator::workers() const
+{
+    return static_cast<int>(d_cpus.size());
+}
+
+
+int Channel_Cpu_Allocator::cpu(int worker) const
+{
+    return d_cpus.at(worker);
+}
+
+
+int Channel_Cpu_Allocator::numa_node(int worker) const
+{
+    return d_nodes.at(worker);
+}
+
+
+int Channel_Cpu_Allocator::worker_of_channel(unsigned int channel) const
+{
+    return static_cast<int>(channel % d_cpus.size());
+}
+
+
+std::vector<uint64_t> Channel_Cpu_Allocator::read_busy_ticks(std::vector<uint64_t>& total_ticks) const
+{
+    // Lines "cpuN user nice system idle iowait irq softirq steal guest guest_nice"
+    // of /proc/stat. The guest times are already included in user and nice.
+    std::vector<uint64_t> busy_ticks(d_cpus.size(), 0);
+    total_ticks.assign(d_cpus.size(), 0);
+    std::vector<bool> found(d_cpus.size(), false);
+    std::ifstream stat(d_procfs_root + "/stat");
+    std::string line;
+    while (std::getline(stat, line))
+        {
+            if (line.compare(0, 3, "cpu") != 0 or line.size() < 4 or line[3] < '0' or line[3] > '9')
+                {
+                    continue;
+                }
+            std::istringstream ss(line.substr(3));
+            int cpu;
+            ss >> cpu;
+            auto it = std::find(d_cpus.cbegin(), d_cpus.cend(), cpu);
+            if (it == d_cpus.cend())
+                {
+                    continue;
+                }
+            size_t worker = it - d_cpus.cbegin();
+            uint64_t ticks;
+            for (int field = 0; field < 8 and ss >> ticks; field++)
+                {
+                    total_ticks[worker] += ticks;
+                    if (field != 3 and field != 4)  // idle and iowait
+                        {
+                            busy_ticks[worker] += ticks;
+                        }
+                }
+            found[worker] = true;
+        }
+    if (std::find(found.cbegin(), found.cend(), false) != found.cend())
+        {
+            return std::vector<uint64_t>();
+        }
+    return busy_ticks;
+}
+
+
+void Channel_Cpu_Allocator::start_statistics()
+{
+    d_start_busy_ticks = read_busy_ticks(d_start_total_ticks);
+}
+
+
+std::vector<double> Channel_Cpu_Allocator::utilisation() const
+{
+    std::vector<uint64_t> total_ticks;
+    std::vector<uint64_t> busy_ticks = read_busy_ticks(total_ticks);
+    std::vector<double> result;
+    if (busy_ticks.empty() or d_start_busy_ticks.size() != busy_ticks.size())
+        {
+            return result;
+        }
+    for (size_t worker = 0; worker < busy_ticks.size(); worker++)
+        {
+            uint64_t total = total_ticks[worker] - d_start_total_ticks[worker];
+            uint64_t busy = busy_ticks[worker] - d_start_busy_ticks[worker];
+            result.push_back(total > 0 ? static_cast<double>(busy) / static_cast<double>(total) : 0.0);
+        }
+    return result;
+}
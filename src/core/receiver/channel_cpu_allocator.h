@@ -0,0 +1,88 @@
+/*!
+ * \file channel_cpu_allocator.h
+ * \brief Placement of the processing channels on a fixed set of CPU cores
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CHANNEL_CPU_ALLOCATOR_H_
+#define GNSS_SDR_CHANNEL_CPU_ALLOCATOR_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Selects the CPU cores (workers) where the processing channels run
+ * and keeps track of their utilisation.
+ *
+ * Workers are physical cores: only the first hardware thread of each core is
+ * used. They are taken NUMA node after NUMA node, so that a small pool stays
+ * within the memory of a single node. Channels are spread over the workers
+ * in round robin, all the blocks of a channel going to the same worker.
+ *
+ * Only the CPUs in the affinity mask of the process are candidates, so that
+ * the receiver respects taskset, cpusets and container limits. The topology
+ * is read from sysfs. If it is not available, the workers are the allowed
+ * CPUs (or CPUs 0 to N-1) of a single node.
+ */
+class Channel_Cpu_Allocator
+{
+public:
+    /*!
+     * \brief Selects up to \p max_workers cores (all the physical cores if
+     * \p max_workers <= 0). \p sysfs_root and \p procfs_root are the mount
+     * points of sysfs and procfs. \p allowed_cpus replaces the affinity mask
+     * of the process if it is not empty.
+     */
+    explicit Channel_Cpu_Allocator(int max_workers, const std::string& sysfs_root = "/sys", const std::string& procfs_root = "/proc", const std::vector<int>& allowed_cpus = std::vector<int>());
+
+    int workers() const;                                //!< Number of workers
+    int cpu(int worker) const;                          //!< CPU index of a worker
+    int numa_node(int worker) const;                    //!< NUMA node of a worker
+    int worker_of_channel(unsigned int channel) const;  //!< Worker assigned to a channel
+
+    /*!
+     * \brief Starts measuring the utilisation of the workers.
+     */
+    void start_statistics();
+
+    /*!
+     * \brief Fraction of time each worker has been busy since the last call
+     * to start_statistics(). Empty if the CPU times are not available.
+     */
+    std::vector<double> utilisation() const;
+
+private:
+    std::vector<uint64_t> read_busy_ticks(std::vector<uint64_t>& total_ticks) const;
+
+    std::vector<int> d_cpus;
+    std::vector<int> d_nodes;
+    std::string d_procfs_root;
+    std::vector<uint64_t> d_start_busy_ticks;
+    std::vector<uint64_t> d_start_total_ticks;
+};
+
+#endif
@@ -123,6 +123,8 @@ void ControlThread::init()
     control_message_factory_ = std::make_shared<ControlMessageFactory>();
     stop_ = false;
     processed_control_messages_ = 0;
+    visibility_update_period_s_ = configuration_->property("GNSS-SDR.visibility_update_period_s", 60);
+    next_visibility_update_ = std::chrono::steady_clock::now();
     applied_actions_ = 0;
     supl_mcc = 0;
     supl_mns = 0;
@@ -293,6 +295,7 @@ int ControlThread::run()
                 {
                     process_control_messages();
                 }
+            update_visible_sats();
         }
     std::cout << "Stopping GNSS-SDR, please wait!" << std::endl;
     flowgraph_->stop();
@@ -887,7 +890,7 @@ void ControlThread::apply_action(unsigned int what)
 }
 
 
-std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time_t rx_utc_time, const arma::vec &LLH)
+std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time_t rx_utc_time, const arma::vec &LLH, bool verbose)
 {
     // 1. Compute rx ECEF position from LLH WGS84
     arma::vec LLH_rad = arma::vec{degtorad(LLH(0)), degtorad(LLH(1)), LLH(2)};
@@ -913,8 +916,11 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
     tstruct = *gmtime(&rx_utc_time);
     strftime(buf, sizeof(buf), "%d/%m/%Y %H:%M:%S ", &tstruct);
     std::string str_time = std::string(buf);
-    std::cout << "Get visible satellites at " << str_time
-              << "UTC, assuming RX position " << LLH(0) << " [deg], " << LLH(1) << " [deg], " << LLH(2) << " [m]" << std::endl;
+    if (verbose)
+        {
+            std::cout << "Get visible satellites at " << str_time
+                      << "UTC, assuming RX position " << LLH(0) << " [deg], " << LLH(1) << " [deg], " << LLH(2) << " [m]" << std::endl;
+        }
 
     std::map<int, Gps_Ephemeris> gps_eph_map = pvt_ptr->get_gps_ephemeris();
     for (auto &it : gps_eph_map)
@@ -932,7 +938,10 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
             // push sat
             if (El > 0)
                 {
-                    std::cout << "Using GPS Ephemeris: Sat " << it.second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
+                    if (verbose)
+                        {
+                            std::cout << "Using GPS Ephemeris: Sat " << it.second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
+                        }
                     available_satellites.push_back(std::pair<int, Gnss_Satellite>(floor(El),
                         (Gnss_Satellite(std::string("GPS"), it.second.i_satellite_PRN))));
                     visible_gps.push_back(it.second.i_satellite_PRN);
@@ -955,7 +964,10 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
             // push sat
             if (El > 0)
                 {
-                    std::cout << "Using Galileo Ephemeris: Sat " << it.second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
+                    if (verbose)
+                        {
+                            std::cout << "Using Galileo Ephemeris: Sat " << it.second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
+                        }
                     available_satellites.push_back(std::pair<int, Gnss_Satellite>(floor(El),
                         (Gnss_Satellite(std::string("Galileo"), it.second.i_satellite_PRN))));
                     visible_gal.push_back(it.second.i_satellite_PRN);
@@ -983,7 +995,10 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                     it2 = std::find(visible_gps.begin(), visible_gps.end(), it.second.i_satellite_PRN);
                     if (it2 == visible_gps.end())
                         {
-                            std::cout << "Using GPS Almanac:  Sat " << it.second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
+                            if (verbose)
+                                {
+                                    std::cout << "Using GPS Almanac:  Sat " << it.second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
+                                }
                             available_satellites.push_back(std::pair<int, Gnss_Satellite>(floor(El),
                                 (Gnss_Satellite(std::string("GPS"), it.second.i_satellite_PRN))));
                         }
@@ -1011,7 +1026,10 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                     it2 = std::find(visible_gal.begin(), visible_gal.end(), it.second.i_satellite_PRN);
                     if (it2 == visible_gal.end())
                         {
-                            std::cout << "Using Galileo Almanac:  Sat " << it.second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
+                            if (verbose)
+                                {
+                                    std::cout << "Using Galileo Almanac:  Sat " << it.second.i_satellite_PRN << " Az: " << Az << " El: " << El << std::endl;
+                                }
                             available_satellites.push_back(std::pair<int, Gnss_Satellite>(floor(El),
                                 (Gnss_Satellite(std::string("Galileo"), it.second.i_satellite_PRN))));
                         }
@@ -1028,6 +1046,28 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
 }
 
 
+void ControlThread::update_visible_sats()
+{
+    if (visibility_update_period_s_ <= 0 or std::chrono::steady_clock::now() < next_visibility_update_)
+        {
+            return;
+        }
+    next_visibility_update_ = std::chrono::steady_clock::now() + std::chrono::seconds(visibility_update_period_s_);
+    std::shared_ptr<PvtInterface> pvt_ptr = flowgraph_->get_pvt();
+    double longitude_deg;
+    double latitude_deg;
+    double height_m;
+    double ground_speed_kmh;
+    double course_over_ground_deg;
+    time_t UTC_time;
+    if (pvt_ptr != nullptr and pvt_ptr->get_latest_PVT(&longitude_deg, &latitude_deg, &height_m, &ground_speed_kmh, &course_over_ground_deg, &UTC_time))
+        {
+            arma::vec LLH = arma::vec{latitude_deg, longitude_deg, height_m};
+            flowgraph_->priorize_satellites(get_visible_sats(UTC_time, LLH, false));
+        }
+}
+
+
 void ControlThread::gps_acq_assist_data_collector()
 {
     // ############ 1.bis READ EPHEMERIS/UTC_MODE/IONO QUEUE ####################
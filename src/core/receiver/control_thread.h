@@ -43,6 +43,7 @@
 #include <armadillo>                  // for arma::vec
 #include <boost/thread.hpp>           // for boost::thread
 #include <gnuradio/msg_queue.h>       // for msg_queue, msg_queue::sptr
+#include <chrono>                     // for steady_clock
 #include <ctime>                      // for time_t
 #include <memory>                     // for shared_ptr
 #include <string>                     // for string
@@ -153,7 +154,12 @@ private:
      * Compute elevations for the specified time and position for all the available satellites in ephemeris and almanac queues
      * returns a vector filled with the available satellites ordered from high elevation to low elevation angle.
      */
-    std::vector<std::pair<int, Gnss_Satellite>> get_visible_sats(time_t rx_utc_time, const arma::vec& LLH);
+    std::vector<std::pair<int, Gnss_Satellite>> get_visible_sats(time_t rx_utc_time, const arma::vec& LLH, bool verbose = true);
+
+    /*
+     * Periodically ranks the acquisition search lists by the satellite elevations seen from the latest PVT solution
+     */
+    void update_visible_sats();
 
     /*
      * Read initial GNSS assistance from SUPL server or local XML files
@@ -171,6 +177,8 @@ private:
     bool delete_configuration_;
     unsigned int processed_control_messages_;
     unsigned int applied_actions_;
+    int visibility_update_period_s_;
+    std::chrono::steady_clock::time_point next_visibility_update_;
 
     boost::thread fpga_helper_thread_;
 
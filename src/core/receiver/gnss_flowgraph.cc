@@ -45,7 +45,9 @@
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_fft.h"
 #include "gnss_synchro_monitor.h"
+#include "pvt_interface.h"
 #include <boost/lexical_cast.hpp>    // for boost::lexical_cast
 #include <boost/shared_ptr.hpp>      // for boost::shared_ptr
 #include <boost/tokenizer.hpp>       // for boost::tokenizer
@@ -113,6 +115,10 @@ void GNSSFlowgraph::start()
             return;
         }
 
+    if (channel_cpu_allocator_)
+        {
+            channel_cpu_allocator_->start_statistics();
+        }
     running_ = true;
 }
 
@@ -121,6 +127,16 @@ void GNSSFlowgraph::stop()
 {
     top_block_->stop();
     running_ = false;
+    if (channel_cpu_allocator_)
+        {
+            std::vector<double> utilisation = channel_cpu_allocator_->utilisation();
+            for (size_t worker = 0; worker < utilisation.size(); worker++)
+                {
+                    LOG(INFO) << "Channel worker " << worker << " (CPU " << channel_cpu_allocator_->cpu(worker)
+                              << ", NUMA node " << channel_cpu_allocator_->numa_node(worker) << ") was busy "
+                              << 100.0 * utilisation[worker] << " % of the time";
+                }
+        }
 }
 
 
@@ -704,12 +720,41 @@ void GNSSFlowgraph::connect()
                 }
         }
 #endif
+    if (channel_cpu_allocator_)
+        {
+            pin_channels();
+        }
     connected_ = true;
     LOG(INFO) << "Flowgraph connected";
     top_block_->dump();
 }
 
 
+void GNSSFlowgraph::pin_channels()
+{
+    for (unsigned int i = 0; i < channels_count_; i++)
+        {
+            int worker = channel_cpu_allocator_->worker_of_channel(i);
+            std::vector<int> mask(1, channel_cpu_allocator_->cpu(worker));
+            try
+                {
+                    if (channels_.at(i)->get_left_block_trk() != nullptr)
+                        {
+                            channels_.at(i)->get_left_block_trk()->set_processor_affinity(mask);
+                        }
+                    channels_.at(i)->get_right_block()->set_processor_affinity(mask);
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Can't bind channel " << i << " to CPU " << mask[0];
+                    LOG(ERROR) << e.what();
+                    continue;
+                }
+            LOG(INFO) << "Channel " << i << " bound to CPU " << mask[0] << " (NUMA node " << channel_cpu_allocator_->numa_node(worker) << ")";
+        }
+}
+
+
 void GNSSFlowgraph::disconnect()
 {
     LOG(INFO) << "Disconnecting flowgraph";
@@ -1081,47 +1126,47 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                     switch (mapStringValues_[gs.get_signal_str()])
                         {
                         case evGPS_1C:
-                            available_GPS_1C_signals_.remove(gs);
+                            available_GPS_1C_signals_.count_failure(gs.get_satellite());
                             available_GPS_1C_signals_.push_back(gs);
                             break;
 
                         case evGPS_2S:
-                            available_GPS_2S_signals_.remove(gs);
+                            available_GPS_2S_signals_.count_failure(gs.get_satellite());
                             available_GPS_2S_signals_.push_back(gs);
                             break;
 
                         case evGPS_L5:
-                            available_GPS_L5_signals_.remove(gs);
+                            available_GPS_L5_signals_.count_failure(gs.get_satellite());
                             available_GPS_L5_signals_.push_back(gs);
                             break;
 
                         case evGAL_1B:
-                            available_GAL_1B_signals_.remove(gs);
+                            available_GAL_1B_signals_.count_failure(gs.get_satellite());
                             available_GAL_1B_signals_.push_back(gs);
                             break;
 
                         case evGAL_5X:
-                            available_GAL_5X_signals_.remove(gs);
+                            available_GAL_5X_signals_.count_failure(gs.get_satellite());
                             available_GAL_5X_signals_.push_back(gs);
                             break;
 
                         case evGLO_1G:
-                            available_GLO_1G_signals_.remove(gs);
+                            available_GLO_1G_signals_.count_failure(gs.get_satellite());
                             available_GLO_1G_signals_.push_back(gs);
                             break;
 
                         case evGLO_2G:
-                            available_GLO_2G_signals_.remove(gs);
+                            available_GLO_2G_signals_.count_failure(gs.get_satellite());
                             available_GLO_2G_signals_.push_back(gs);
                             break;
 
                         case evBDS_B1:
-                            available_BDS_B1_signals_.remove(gs);
+                            available_BDS_B1_signals_.count_failure(gs.get_satellite());
                             available_BDS_B1_signals_.push_back(gs);
                             break;
 
                         case evBDS_B3:
-                            available_BDS_B3_signals_.remove(gs);
+                            available_BDS_B3_signals_.count_failure(gs.get_satellite());
                             available_BDS_B3_signals_.push_back(gs);
                             break;
 
@@ -1154,6 +1199,7 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                             acq_channels_count_++;
                             DLOG(INFO) << "Channel " << ch_index << " Starting acquisition " << channels_[ch_index]->get_signal().get_satellite() << ", Signal " << channels_[ch_index]->get_signal().get_signal_str();
 
+                            set_acquisition_doppler_window(ch_index);
 #ifndef ENABLE_FPGA
                             channels_[ch_index]->start_acquisition();
 #else
@@ -1174,38 +1220,47 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                 {
                 case evGPS_1C:
                     available_GPS_1C_signals_.remove(channels_[who]->get_signal());
+                    available_GPS_1C_signals_.reset_failures(channels_[who]->get_signal().get_satellite());
                     break;
 
                 case evGPS_2S:
                     available_GPS_2S_signals_.remove(channels_[who]->get_signal());
+                    available_GPS_2S_signals_.reset_failures(channels_[who]->get_signal().get_satellite());
                     break;
 
                 case evGPS_L5:
                     available_GPS_L5_signals_.remove(channels_[who]->get_signal());
+                    available_GPS_L5_signals_.reset_failures(channels_[who]->get_signal().get_satellite());
                     break;
 
                 case evGAL_1B:
                     available_GAL_1B_signals_.remove(channels_[who]->get_signal());
+                    available_GAL_1B_signals_.reset_failures(channels_[who]->get_signal().get_satellite());
                     break;
 
                 case evGAL_5X:
                     available_GAL_5X_signals_.remove(channels_[who]->get_signal());
+                    available_GAL_5X_signals_.reset_failures(channels_[who]->get_signal().get_satellite());
                     break;
 
                 case evGLO_1G:
                     available_GLO_1G_signals_.remove(channels_[who]->get_signal());
+                    available_GLO_1G_signals_.reset_failures(channels_[who]->get_signal().get_satellite());
                     break;
 
                 case evGLO_2G:
                     available_GLO_2G_signals_.remove(channels_[who]->get_signal());
+                    available_GLO_2G_signals_.reset_failures(channels_[who]->get_signal().get_satellite());
                     break;
 
                 case evBDS_B1:
                     available_BDS_B1_signals_.remove(channels_[who]->get_signal());
+                    available_BDS_B1_signals_.reset_failures(channels_[who]->get_signal().get_satellite());
                     break;
 
                 case evBDS_B3:
                     available_BDS_B3_signals_.remove(channels_[who]->get_signal());
+                    available_BDS_B3_signals_.reset_failures(channels_[who]->get_signal().get_satellite());
                     break;
 
                 default:
@@ -1235,6 +1290,7 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                                 }
                             acq_channels_count_++;
                             DLOG(INFO) << "Channel " << i << " Starting acquisition " << channels_[i]->get_signal().get_satellite() << ", Signal " << channels_[i]->get_signal().get_signal_str();
+                            set_acquisition_doppler_window(i);
 #ifndef ENABLE_FPGA
                             channels_[i]->start_acquisition();
 #else
@@ -1256,6 +1312,7 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                     channels_state_[who] = 1;
                     acq_channels_count_++;
                     LOG(INFO) << "Channel " << who << " Starting acquisition " << channels_[who]->get_signal().get_satellite() << ", Signal " << channels_[who]->get_signal().get_signal_str();
+                    set_acquisition_doppler_window(who);
 #ifndef ENABLE_FPGA
                     channels_[who]->start_acquisition();
 #else
@@ -1404,6 +1461,7 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                                 }
                             acq_channels_count_++;
                             DLOG(INFO) << "Channel " << ch_index << " Starting acquisition " << channels_[ch_index]->get_signal().get_satellite() << ", Signal " << channels_[ch_index]->get_signal().get_signal_str();
+                            set_acquisition_doppler_window(ch_index);
 #ifndef ENABLE_FPGA
                             channels_[ch_index]->start_acquisition();
 #else
@@ -1438,6 +1496,7 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                                 }
                             acq_channels_count_++;
                             DLOG(INFO) << "Channel " << ch_index << " Starting acquisition " << channels_[ch_index]->get_signal().get_satellite() << ", Signal " << channels_[ch_index]->get_signal().get_signal_str();
+                            set_acquisition_doppler_window(ch_index);
 #ifndef ENABLE_FPGA
                             channels_[ch_index]->start_acquisition();
 #else
@@ -1473,6 +1532,7 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                                 }
                             acq_channels_count_++;
                             DLOG(INFO) << "Channel " << ch_index << " Starting acquisition " << channels_[ch_index]->get_signal().get_satellite() << ", Signal " << channels_[ch_index]->get_signal().get_signal_str();
+                            set_acquisition_doppler_window(ch_index);
 #ifndef ENABLE_FPGA
                             channels_[ch_index]->start_acquisition();
 #else
@@ -1491,55 +1551,61 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
 }
 
 
+void GNSSFlowgraph::set_acquisition_doppler_window(unsigned int ch)
+{
+    if (!enable_doppler_prediction_)
+        {
+            return;
+        }
+    int doppler_center = 0;
+    unsigned int doppler_window = 0;  // full search
+    double doppler_hz;
+    double age_s;
+    std::shared_ptr<PvtInterface> pvt = get_pvt();
+    if (pvt != nullptr and pvt->get_predicted_doppler(channels_[ch]->get_signal(), &doppler_hz, &age_s))
+        {
+            // Widen the window as the prediction ages (satellite Doppler rates stay below 1 Hz/s)
+            doppler_center = static_cast<int>(std::round(doppler_hz));
+            doppler_window = doppler_prediction_window_hz_ + static_cast<unsigned int>(std::ceil(age_s));
+            DLOG(INFO) << "Channel " << ch << " predicted Doppler " << doppler_center << " +/- " << doppler_window << " [Hz]";
+        }
+    channels_[ch]->set_doppler_window(doppler_center, doppler_window);
+}
+
+
 void GNSSFlowgraph::priorize_satellites(std::vector<std::pair<int, Gnss_Satellite>> visible_satellites)
 {
-    size_t old_size;
-    Gnss_Signal gs;
+    std::lock_guard<std::mutex> lock(signal_list_mutex);
+    // The new prediction replaces the former one
+    for (auto* available_signals : {&available_GPS_1C_signals_, &available_GPS_2S_signals_, &available_GPS_L5_signals_,
+             &available_GAL_1B_signals_, &available_GAL_5X_signals_, &available_GLO_1G_signals_, &available_GLO_2G_signals_,
+             &available_BDS_B1_signals_, &available_BDS_B3_signals_})
+        {
+            available_signals->clear_elevations();
+        }
+    // Visible satellites go first, the highest ones ahead
     for (auto& visible_satellite : visible_satellites)
         {
             if (visible_satellite.second.get_system() == "GPS")
                 {
-                    gs = Gnss_Signal(visible_satellite.second, "1C");
-                    old_size = available_GPS_1C_signals_.size();
-                    available_GPS_1C_signals_.remove(gs);
-                    if (old_size > available_GPS_1C_signals_.size())
-                        {
-                            available_GPS_1C_signals_.push_front(gs);
-                        }
-
-                    gs = Gnss_Signal(visible_satellite.second, "2S");
-                    old_size = available_GPS_2S_signals_.size();
-                    available_GPS_2S_signals_.remove(gs);
-                    if (old_size > available_GPS_2S_signals_.size())
-                        {
-                            available_GPS_2S_signals_.push_front(gs);
-                        }
-
-                    gs = Gnss_Signal(visible_satellite.second, "L5");
-                    old_size = available_GPS_L5_signals_.size();
-                    available_GPS_L5_signals_.remove(gs);
-                    if (old_size > available_GPS_L5_signals_.size())
-                        {
-                            available_GPS_L5_signals_.push_front(gs);
-                        }
+                    available_GPS_1C_signals_.set_elevation(visible_satellite.second, visible_satellite.first);
+                    available_GPS_2S_signals_.set_elevation(visible_satellite.second, visible_satellite.first);
+                    available_GPS_L5_signals_.set_elevation(visible_satellite.second, visible_satellite.first);
                 }
             else if (visible_satellite.second.get_system() == "Galileo")
                 {
-                    gs = Gnss_Signal(visible_satellite.second, "1B");
-                    old_size = available_GAL_1B_signals_.size();
-                    available_GAL_1B_signals_.remove(gs);
-                    if (old_size > available_GAL_1B_signals_.size())
-                        {
-                            available_GAL_1B_signals_.push_front(gs);
-                        }
-
-                    gs = Gnss_Signal(visible_satellite.second, "5X");
-                    old_size = available_GAL_5X_signals_.size();
-                    available_GAL_5X_signals_.remove(gs);
-                    if (old_size > available_GAL_5X_signals_.size())
-                        {
-                            available_GAL_5X_signals_.push_front(gs);
-                        }
+                    available_GAL_1B_signals_.set_elevation(visible_satellite.second, visible_satellite.first);
+                    available_GAL_5X_signals_.set_elevation(visible_satellite.second, visible_satellite.first);
+                }
+            else if (visible_satellite.second.get_system() == "Glonass")
+                {
+                    available_GLO_1G_signals_.set_elevation(visible_satellite.second, visible_satellite.first);
+                    available_GLO_2G_signals_.set_elevation(visible_satellite.second, visible_satellite.first);
+                }
+            else if (visible_satellite.second.get_system() == "Beidou")
+                {
+                    available_BDS_B1_signals_.set_elevation(visible_satellite.second, visible_satellite.first);
+                    available_BDS_B3_signals_.set_elevation(visible_satellite.second, visible_satellite.first);
                 }
         }
 }
@@ -1590,6 +1656,10 @@ void GNSSFlowgraph::init()
      */
     std::unique_ptr<GNSSBlockFactory> block_factory_(new GNSSBlockFactory());
 
+    // FFT plans are shared by all blocks. Set where FFTW wisdom is stored before any plan is created
+    std::string empty_string;
+    Gnss_Fft_Plan_Manager::instance().set_wisdom_file(configuration_->property("GNSS-SDR.fftw_wisdom_file", empty_string));
+
     // 1. read the number of RF front-ends available (one file_source per RF front-end)
     sources_count_ = configuration_->property("Receiver.sources_count", 1);
 
@@ -1682,6 +1752,16 @@ void GNSSFlowgraph::init()
     set_signals_list();
     set_channels_state();
     applied_actions_ = 0;
+
+    // Reacquisitions search around the Doppler predicted from the PVT solution, when available
+    enable_doppler_prediction_ = configuration_->property("GNSS-SDR.doppler_prediction", false);
+    doppler_prediction_window_hz_ = configuration_->property("GNSS-SDR.doppler_prediction_window_hz", 250);
+
+    // Tracking and telemetry blocks of each channel bound to one of a fixed set of cores
+    if (configuration_->property("GNSS-SDR.pin_channels", false))
+        {
+            channel_cpu_allocator_ = std::unique_ptr<Channel_Cpu_Allocator>(new Channel_Cpu_Allocator(configuration_->property("GNSS-SDR.channel_workers", 0)));
+        }
     DLOG(INFO) << "Blocks instantiated. " << channels_count_ << " channels.";
 
     /*
@@ -37,14 +37,15 @@
 #ifndef GNSS_SDR_GNSS_FLOWGRAPH_H_
 #define GNSS_SDR_GNSS_FLOWGRAPH_H_
 
+#include "channel_cpu_allocator.h"
 #include "gnss_sdr_sample_counter.h"
 #include "gnss_signal.h"
+#include "gnss_signal_priority_list.h"
 #include "pvt_interface.h"
 #include <gnuradio/blocks/null_sink.h>  //for null_sink
 #include <gnuradio/msg_queue.h>         // for msg_queue, msg_queue::sptr
 #include <gnuradio/runtime_types.h>     // for basic_block_sptr, top_block_sptr
 #include <pmt/pmt.h>                    // for pmt_t
-#include <list>                         // for list
 #include <map>                          // for map
 #include <memory>                       // for for shared_ptr, dynamic_pointer_cast
 #include <mutex>                        // for mutex
@@ -150,6 +151,8 @@ private:
     void set_channels_state();  // Initializes the channels state (start acquisition or keep standby)
                                 // using the configuration parameters (number of channels and max channels in acquisition)
     Gnss_Signal search_next_signal(const std::string& searched_signal, bool pop, bool tracked = false);
+    void set_acquisition_doppler_window(unsigned int ch);  // Narrows the Doppler search of the next acquisition, if a prediction is available
+    void pin_channels();                                   // Binds the tracking and telemetry blocks of each channel to a worker core
     bool connected_;
     bool running_;
     int sources_count_;
@@ -177,16 +180,16 @@ private:
     gr::top_block_sptr top_block_;
     gr::msg_queue::sptr queue_;
 
-    std::list<Gnss_Signal> available_GPS_1C_signals_;
-    std::list<Gnss_Signal> available_GPS_2S_signals_;
-    std::list<Gnss_Signal> available_GPS_L5_signals_;
-    std::list<Gnss_Signal> available_SBAS_1C_signals_;
-    std::list<Gnss_Signal> available_GAL_1B_signals_;
-    std::list<Gnss_Signal> available_GAL_5X_signals_;
-    std::list<Gnss_Signal> available_GLO_1G_signals_;
-    std::list<Gnss_Signal> available_GLO_2G_signals_;
-    std::list<Gnss_Signal> available_BDS_B1_signals_;
-    std::list<Gnss_Signal> available_BDS_B3_signals_;
+    Gnss_Signal_Priority_List available_GPS_1C_signals_;
+    Gnss_Signal_Priority_List available_GPS_2S_signals_;
+    Gnss_Signal_Priority_List available_GPS_L5_signals_;
+    Gnss_Signal_Priority_List available_SBAS_1C_signals_;
+    Gnss_Signal_Priority_List available_GAL_1B_signals_;
+    Gnss_Signal_Priority_List available_GAL_5X_signals_;
+    Gnss_Signal_Priority_List available_GLO_1G_signals_;
+    Gnss_Signal_Priority_List available_GLO_2G_signals_;
+    Gnss_Signal_Priority_List available_BDS_B1_signals_;
+    Gnss_Signal_Priority_List available_BDS_B3_signals_;
     enum StringValue
     {
         evGPS_1C,
@@ -205,6 +208,11 @@ private:
     std::vector<unsigned int> channels_state_;
     std::mutex signal_list_mutex;
 
+    bool enable_doppler_prediction_;
+    unsigned int doppler_prediction_window_hz_;
+
+    std::unique_ptr<Channel_Cpu_Allocator> channel_cpu_allocator_;
+
     bool enable_monitor_;
     gr::basic_block_sptr GnssSynchroMonitor_;
     std::vector<std::string> split_string(const std::string& s, char delim);
@@ -0,0 +1,192 @@
+/*!
+ * \file gnss_signal_priority_list.cc
+ * \brief Ranked list of the signals waiting to be assigned to an acquisition channel
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_signal_priority_list.h"
+
+
+Gnss_Signal_Priority_List::Gnss_Signal_Priority_List()
+{
+    d_front_order = 0;
+    d_back_order = 0;
+}
+
+
+Gnss_Signal_Priority_List::Sat_Key Gnss_Signal_Priority_List::key(const Gnss_Satellite& satellite)
+{
+    return Sat_Key(satellite.get_system(), satellite.get_PRN());
+}
+
+
+Gnss_Signal_Priority_List::Rank Gnss_Signal_Priority_List::rank(const Sat_Key& sat, bool promoted, int64_t order) const
+{
+    if (promoted)
+        {
+            return Rank(0, 0U, 0, order);
+        }
+    auto history = d_history.find(sat);
+    if (history == d_history.cend())
+        {
+            return Rank(2, 0U, 0, order);
+        }
+    if (history->second.visible)
+        {
+            return Rank(1, history->second.failures, -history->second.elevation_deg, order);
+        }
+    return Rank(2, history->second.failures, 0, order);
+}
+
+
+void Gnss_Signal_Priority_List::insert(const Gnss_Signal& signal, bool promoted, int64_t order)
+{
+    remove(signal);
+    Sat_Key sat = key(signal.get_satellite());
+    Entry entry;
+    entry.rank = rank(sat, promoted, order);
+    entry.promoted = promoted;
+    entry.order = order;
+    d_ranked.insert(std::make_pair(entry.rank, signal));
+    d_index[sat] = entry;
+}
+
+
+void Gnss_Signal_Priority_List::rerank(const Sat_Key& sat)
+{
+    auto it = d_index.find(sat);
+    if (it == d_index.end())
+        {
+            return;
+        }
+    Rank new_rank = rank(sat, it->second.promoted, it->second.order);
+    if (new_rank != it->second.rank)
+        {
+            auto ranked = d_ranked.find(it->second.rank);
+            Gnss_Signal signal = ranked->second;
+            d_ranked.erase(ranked);
+            d_ranked.insert(std::make_pair(new_rank, signal));
+            it->second.rank = new_rank;
+        }
+}
+
+
+void Gnss_Signal_Priority_List::push_front(const Gnss_Signal& signal)
+{
+    insert(signal, true, --d_front_order);
+}
+
+
+void Gnss_Signal_Priority_List::push_back(const Gnss_Signal& signal)
+{
+    insert(signal, false, ++d_back_order);
+}
+
+
+void Gnss_Signal_Priority_List::remove(const Gnss_Signal& signal)
+{
+    auto it = d_index.find(key(signal.get_satellite()));
+    if (it != d_index.end())
+        {
+            d_ranked.erase(it->second.rank);
+            d_index.erase(it);
+        }
+}
+
+
+Gnss_Signal Gnss_Signal_Priority_List::front() const
+{
+    if (d_ranked.empty())
+        {
+            return Gnss_Signal();
+        }
+    return d_ranked.cbegin()->second;
+}
+
+
+void Gnss_Signal_Priority_List::pop_front()
+{
+    if (!d_ranked.empty())
+        {
+            remove(d_ranked.cbegin()->second);
+        }
+}
+
+
+size_t Gnss_Signal_Priority_List::size() const
+{
+    return d_ranked.size();
+}
+
+
+bool Gnss_Signal_Priority_List::empty() const
+{
+    return d_ranked.empty();
+}
+
+
+void Gnss_Signal_Priority_List::set_elevation(const Gnss_Satellite& satellite, int elevation_deg)
+{
+    Sat_Key sat = key(satellite);
+    Satellite_History& history = d_history[sat];
+    history.visible = true;
+    history.elevation_deg = elevation_deg;
+    rerank(sat);
+}
+
+
+void Gnss_Signal_Priority_List::clear_elevations()
+{
+    for (auto& history : d_history)
+        {
+            if (history.second.visible)
+                {
+                    history.second.visible = false;
+                    history.second.elevation_deg = 0;
+                    rerank(history.first);
+                }
+        }
+}
+
+
+void Gnss_Signal_Priority_List::count_failure(const Gnss_Satellite& satellite)
+{
+    Sat_Key sat = key(satellite);
+    d_history[sat].failures++;
+    rerank(sat);
+}
+
+
+void Gnss_Signal_Priority_List::reset_failures(const Gnss_Satellite& satellite)
+{
+    Sat_Key sat = key(satellite);
+    auto history = d_history.find(sat);
+    if (history != d_history.end() and history->second.failures > 0)
+        {
+            history->second.failures = 0;
+            rerank(sat);
+        }
+}
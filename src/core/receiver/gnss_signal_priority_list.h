@@ -0,0 +1,118 @@
+/*!
+ * \file gnss_signal_priority_list.h
+ * \brief Ranked list of the signals waiting to be assigned to an acquisition channel
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SIGNAL_PRIORITY_LIST_H_
+#define GNSS_SDR_GNSS_SIGNAL_PRIORITY_LIST_H_
+
+#include "gnss_satellite.h"
+#include "gnss_signal.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+
+/*!
+ * \brief Ranked list of the signals waiting to be assigned to an acquisition channel.
+ *
+ * It keeps the interface of the std::list it replaces (push_front, push_back,
+ * remove, front, pop_front), but candidates are ranked by:
+ *  <ol>
+ *  <li> Promotion: signals inserted with push_front (e.g. the other signals of
+ *       a satellite already in track) go first, the latest one ahead.
+ *  <li> Predicted visibility: satellites known to be above the horizon, then
+ *       the rest.
+ *  <li> Acquisition history: fewer failed acquisitions go first.
+ *  <li> Predicted elevation, higher first.
+ *  <li> Insertion order: push_back goes after the candidates of the same rank.
+ *  </ol>
+ * Without visibility information nor failures, the order is the one of the
+ * former list. Candidates are indexed by satellite, so that every operation
+ * is O(log n) instead of a linear scan.
+ */
+class Gnss_Signal_Priority_List
+{
+public:
+    Gnss_Signal_Priority_List();
+
+    void push_front(const Gnss_Signal& signal);  //!< Promotes the signal ahead of all the candidates
+    void push_back(const Gnss_Signal& signal);   //!< Inserts (or moves) the signal at the end of its rank
+    void remove(const Gnss_Signal& signal);      //!< Removes the signal, if present
+    Gnss_Signal front() const;                   //!< Best ranked candidate
+    void pop_front();                            //!< Removes the best ranked candidate
+    size_t size() const;
+    bool empty() const;
+
+    /*!
+     * \brief Sets the predicted elevation [deg] of a satellite above the horizon.
+     */
+    void set_elevation(const Gnss_Satellite& satellite, int elevation_deg);
+
+    /*!
+     * \brief Forgets all the visibility predictions.
+     */
+    void clear_elevations();
+
+    void count_failure(const Gnss_Satellite& satellite);  //!< Records a failed acquisition of the satellite
+    void reset_failures(const Gnss_Satellite& satellite);  //!< Clears the acquisition history of the satellite
+
+private:
+    using Rank = std::tuple<int32_t, uint32_t, int32_t, int64_t>;  // tier, failures, -elevation, order
+    using Sat_Key = std::pair<std::string, uint32_t>;             // system, PRN
+
+    class Satellite_History
+    {
+    public:
+        bool visible = false;
+        int32_t elevation_deg = 0;
+        uint32_t failures = 0;
+    };
+
+    class Entry
+    {
+    public:
+        Rank rank;
+        bool promoted;
+        int64_t order;
+    };
+
+    static Sat_Key key(const Gnss_Satellite& satellite);
+    Rank rank(const Sat_Key& sat, bool promoted, int64_t order) const;
+    void insert(const Gnss_Signal& signal, bool promoted, int64_t order);
+    void rerank(const Sat_Key& sat);
+
+    std::map<Rank, Gnss_Signal> d_ranked;
+    std::map<Sat_Key, Entry> d_index;
+    std::map<Sat_Key, Satellite_History> d_history;
+    int64_t d_front_order;
+    int64_t d_back_order;
+};
+
+#endif
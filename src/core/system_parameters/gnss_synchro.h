@@ -35,6 +35,7 @@
 
 #include "gnss_signal.h"
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/version.hpp>
 #include <cstdint>
 
 /*!
@@ -68,6 +69,7 @@ public:
     uint64_t Tracking_sample_counter;  //!< Set by Tracking processing block
     bool Flag_valid_symbol_output;     //!< Set by Tracking processing block
     int32_t correlation_length_ms;     //!< Set by Tracking processing block
+    int32_t tracking_mode;             //!< Set by Tracking processing block
 
     // Telemetry Decoder
     bool Flag_valid_word;               //!< Set by Telemetry Decoder processing block
@@ -87,9 +89,6 @@ public:
 
     void serialize(Archive& ar, const unsigned int version)
     {
-        if (version)
-            {
-            };
         // Satellite and signal info
         ar& BOOST_SERIALIZATION_NVP(System);
         ar& BOOST_SERIALIZATION_NVP(Signal);
@@ -120,7 +119,18 @@ public:
         ar& BOOST_SERIALIZATION_NVP(RX_time);
         ar& BOOST_SERIALIZATION_NVP(Flag_valid_pseudorange);
         ar& BOOST_SERIALIZATION_NVP(interp_TOW_ms);
+        // Added in version 1, older archives do not have it
+        if (version > 0)
+            {
+                ar& BOOST_SERIALIZATION_NVP(tracking_mode);
+            }
+        else
+            {
+                tracking_mode = 0;
+            }
     }
 };
 
+BOOST_CLASS_VERSION(Gnss_Synchro, 1)
+
 #endif
@@ -0,0 +1,204 @@
+/*!
+ * \file gnss_sdr_dump_test.cc
+ * \brief  This file implements tests for the buffered dump writer and
+ *         the dump file reader
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_dump.h"
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+#pragma pack(push, 1)
+struct Dump_Test_Record
+{
+    float a;
+    uint64_t b;
+    double c;
+    uint8_t d;
+};
+#pragma pack(pop)
+}  // namespace
+
+
+TEST(GnssSdrDumpTest, WriteAndReadColumns)
+{
+    std::string filename = (boost::filesystem::temp_directory_path() / "gnss_sdr_dump_test.dat").string();
+    const int n_records = 100000;  // larger than the ring, so that the writer has to wait
+    {
+        Gnss_Dump_Writer writer;
+        ASSERT_TRUE(writer.open(filename, 4096));
+        for (int i = 0; i < n_records; i++)
+            {
+                Dump_Test_Record record{static_cast<float>(i) * 0.5F, static_cast<uint64_t>(i) * 1000000007ULL, -static_cast<double>(i), static_cast<uint8_t>(i % 256)};
+                writer.write(record);
+            }
+        // Same layout written field by field
+        float a = 1.0F;
+        uint64_t b = 2;
+        double c = 3.0;
+        uint8_t d = 4;
+        writer.write(&a, sizeof(a));
+        writer.write(&b, sizeof(b));
+        writer.write(&c, sizeof(c));
+        writer.write(&d, sizeof(d));
+        writer.close();
+        EXPECT_FALSE(writer.is_open());
+    }
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    EXPECT_EQ(static_cast<size_t>(file.tellg()), (n_records + 1) * sizeof(Dump_Test_Record));
+    file.close();
+
+    Gnss_Dump_Reader reader;
+    ASSERT_TRUE(reader.open(filename, sizeof(Dump_Test_Record)));
+    ASSERT_EQ(reader.records(), static_cast<size_t>(n_records + 1));
+    std::vector<float> a = reader.column<float>(offsetof(Dump_Test_Record, a));
+    std::vector<uint64_t> b = reader.column<uint64_t>(offsetof(Dump_Test_Record, b));
+    std::vector<double> c = reader.column<double>(offsetof(Dump_Test_Record, c));
+    std::vector<uint8_t> d = reader.column<uint8_t>(offsetof(Dump_Test_Record, d));
+    for (int i = 0; i < n_records; i++)
+        {
+            ASSERT_EQ(a[i], static_cast<float>(i) * 0.5F);
+            ASSERT_EQ(b[i], static_cast<uint64_t>(i) * 1000000007ULL);
+            ASSERT_EQ(c[i], -static_cast<double>(i));
+            ASSERT_EQ(d[i], static_cast<uint8_t>(i % 256));
+        }
+    EXPECT_EQ(a[n_records], 1.0F);
+    EXPECT_EQ(b[n_records], 2U);
+    EXPECT_EQ(c[n_records], 3.0);
+    EXPECT_EQ(d[n_records], 4U);
+    boost::filesystem::remove(filename);
+}
+
+
+TEST(GnssSdrDumpTest, MissingFile)
+{
+    Gnss_Dump_Writer writer;
+    EXPECT_FALSE(writer.open("/nonexistent_folder/gnss_sdr_dump_test.dat"));
+    EXPECT_FALSE(writer.is_open());
+    writer.write(&writer, 1);  // ignored
+    Gnss_Dump_Reader reader;
+    EXPECT_FALSE(reader.open("/nonexistent_folder/gnss_sdr_dump_test.dat", 8));
+    EXPECT_EQ(reader.records(), 0U);
+}
+
+
+TEST(GnssSdrDumpTest, Flush)
+{
+    std::string filename = (boost::filesystem::temp_directory_path() / "gnss_sdr_dump_flush_test.dat").string();
+    Gnss_Dump_Writer writer;
+    ASSERT_TRUE(writer.open(filename));
+    double value = 1.0;
+    for (int i = 0; i < 1000; i++)
+        {
+            writer.write(value);
+        }
+    writer.flush();
+    EXPECT_TRUE(writer.is_open());
+    EXPECT_EQ(boost::filesystem::file_size(filename), 1000 * sizeof(double));
+    writer.close();
+    boost::filesystem::remove(filename);
+}
+
+
+TEST(GnssSdrDumpTest, Records)
+{
+    std::vector<std::vector<char>> received;
+    Gnss_Dump_Writer writer;
+    ASSERT_TRUE(writer.open([&received](const char* record, size_t size) { received.emplace_back(record, record + size); }, 4096));
+    const int n_records = 50;  // records wrap around the ring
+    for (int i = 0; i < n_records; i++)
+        {
+            uint32_t header = i;
+            std::vector<char> payload(1000 + i, static_cast<char>(i));
+            ASSERT_TRUE(writer.try_write_record({{&header, sizeof(header)}, {payload.data(), payload.size()}, {nullptr, 0}}));
+            writer.flush();
+        }
+    std::vector<char> too_large(4096);
+    EXPECT_FALSE(writer.try_write_record({{too_large.data(), too_large.size()}}));
+    writer.write(too_large.data(), too_large.size());  // ignored, it would break the records
+    writer.close();
+
+    ASSERT_EQ(received.size(), static_cast<size_t>(n_records));
+    for (int i = 0; i < n_records; i++)
+        {
+            ASSERT_EQ(received[i].size(), sizeof(uint32_t) + 1000 + i);
+            uint32_t header = 0;
+            std::memcpy(&header, received[i].data(), sizeof(header));
+            EXPECT_EQ(header, static_cast<uint32_t>(i));
+            EXPECT_EQ(received[i].back(), static_cast<char>(i));
+        }
+}
+
+
+TEST(GnssSdrDumpTest, SlowHandler)
+{
+    std::atomic<bool> entered(false);
+    std::atomic<bool> release(false);
+    Gnss_Dump_Writer slow_writer;
+    ASSERT_TRUE(slow_writer.open([&entered, &release](const char* /*record*/, size_t /*size*/) {
+        entered.store(true);
+        while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+    },
+        4096));
+    uint32_t header = 0;
+    ASSERT_TRUE(slow_writer.try_write_record({{&header, sizeof(header)}}));
+    while (!entered.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+    // The background thread is inside the handler, other writers can still be opened and closed
+    std::string filename = (boost::filesystem::temp_directory_path() / "gnss_sdr_dump_slow_test.dat").string();
+    Gnss_Dump_Writer writer;
+    ASSERT_TRUE(writer.open(filename, 1 << 16));
+    double value = 1.0;
+    for (int i = 0; i < 1000; i++)
+        {
+            writer.write(value);
+        }
+    writer.close();
+    EXPECT_EQ(boost::filesystem::file_size(filename), 1000 * sizeof(double));
+    boost::filesystem::remove(filename);
+
+    release.store(true);
+    slow_writer.close();
+}
@@ -0,0 +1,98 @@
+/*!
+ * \file gnss_sdr_fft_test.cc
+ * \brief  This file implements tests for the shared FFT plans
+ *         and the smooth FFT length selection
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_fft.h"
+#include <gnuradio/fft/fft.h>
+#include <algorithm>
+#include <complex>
+#include <functional>
+#include <random>
+
+
+TEST(GnssSdrFftTest, SmoothSize)
+{
+    EXPECT_EQ(gnss_sdr_fft_smooth_size(1), 1U);
+    EXPECT_EQ(gnss_sdr_fft_smooth_size(4096), 4096U);
+    EXPECT_EQ(gnss_sdr_fft_smooth_size(4000), 4000U);
+    EXPECT_EQ(gnss_sdr_fft_smooth_size(7), 8U);
+    EXPECT_EQ(gnss_sdr_fft_smooth_size(12276), 12288U);  // 2 x 6.138 Msps x 1 ms
+    EXPECT_EQ(gnss_sdr_fft_smooth_size(2221), 2250U);
+    for (uint32_t n = 2; n < 20000; n += 37)
+        {
+            uint32_t m = gnss_sdr_fft_smooth_size(n);
+            EXPECT_GE(m, n);
+            uint32_t r = m;
+            for (uint32_t p : {2U, 3U, 5U})
+                {
+                    while (r % p == 0)
+                        {
+                            r /= p;
+                        }
+                }
+            EXPECT_EQ(r, 1U);
+        }
+}
+
+
+TEST(GnssSdrFftTest, SharedPlanMatchesGnuRadio)
+{
+    const int32_t fft_size = 2221;  // prime
+    std::default_random_engine e1(1);
+    std::uniform_real_distribution<float> uniform_dist(-1, 1);
+    auto gen = [&]() { return gr_complex(uniform_dist(e1), uniform_dist(e1)); };
+
+    gr::fft::fft_complex gr_fft(fft_size, true);
+    Gnss_Fft_Complex fft_a(fft_size, true);
+    Gnss_Fft_Complex fft_b(fft_size, true);
+    Gnss_Fft_Complex ifft(fft_size, false);
+
+    std::generate_n(gr_fft.get_inbuf(), fft_size, gen);
+    std::copy_n(gr_fft.get_inbuf(), fft_size, fft_a.get_inbuf());
+    std::fill_n(fft_b.get_inbuf(), fft_size, gr_complex(1.0, 0.0));
+    gr_fft.execute();
+    fft_a.execute();
+    fft_b.execute();
+
+    // Two instances share the plan but not the buffers
+    EXPECT_NEAR(fft_b.get_outbuf()[0].real(), static_cast<float>(fft_size), 1e-2);
+    for (int32_t i = 0; i < fft_size; i++)
+        {
+            EXPECT_NEAR(std::abs(gr_fft.get_outbuf()[i] - fft_a.get_outbuf()[i]), 0.0, 1e-3);
+        }
+
+    // The inverse transform recovers the input, scaled by the FFT length
+    std::copy_n(fft_a.get_outbuf(), fft_size, ifft.get_inbuf());
+    ifft.execute();
+    for (int32_t i = 0; i < fft_size; i++)
+        {
+            EXPECT_NEAR(std::abs(ifft.get_outbuf()[i] / static_cast<float>(fft_size) - gr_fft.get_inbuf()[i]), 0.0, 1e-4);
+        }
+}
@@ -0,0 +1,136 @@
+/*!
+ * \file quicksync_speed_test.cc
+ * \brief  This file implements timing tests of the QuickSync folded search
+ *         against the plain PCPS search for long code lengths
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_fft.h"
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <cstring>
+#include <random>
+
+DEFINE_int32(quicksync_speed_iterations_test, 100, "Number of averaged iterations in QuickSync timing test");
+
+
+/*
+ * Both searches process the same dwell of folding_factor code periods for one
+ * Doppler bin, with the kernels used by pcps_acquisition (coherent integration
+ * of the whole dwell) and by pcps_quicksync_acquisition_cc (folded FFTs of
+ * code_length / folding_factor points plus the time-domain disambiguation).
+ */
+TEST(QuickSyncSpeedTest, FoldedSearchVsPcps)
+{
+    const uint32_t folding_factor = 4;
+    const uint32_t code_lengths[4] = {4096, 16384, 40960, 81920};
+    std::chrono::time_point<std::chrono::system_clock> start, end;
+    std::chrono::duration<double> elapsed_seconds;
+
+    std::default_random_engine e1(1);
+    std::uniform_real_distribution<float> uniform_dist(-1, 1);
+    auto gen = [&]() { return gr_complex(uniform_dist(e1), uniform_dist(e1)); };
+
+    for (uint32_t code_length : code_lengths)
+        {
+            const uint32_t dwell_length = code_length * folding_factor;
+            const uint32_t folded_size = code_length / folding_factor;
+            uint32_t indext = 0;
+            auto* input = static_cast<gr_complex*>(volk_gnsssdr_malloc(dwell_length * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            auto* wipeoff = static_cast<gr_complex*>(volk_gnsssdr_malloc(dwell_length * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            auto* wiped = static_cast<gr_complex*>(volk_gnsssdr_malloc(dwell_length * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            auto* code = static_cast<gr_complex*>(volk_gnsssdr_malloc(dwell_length * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            auto* magnitude = static_cast<float*>(volk_gnsssdr_malloc(dwell_length * sizeof(float), volk_gnsssdr_get_alignment()));
+            auto* corr = static_cast<gr_complex*>(volk_gnsssdr_malloc(folding_factor * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+            std::generate_n(input, dwell_length, gen);
+            std::generate_n(wipeoff, dwell_length, gen);
+            std::generate_n(code, dwell_length, gen);
+
+            // Plain PCPS
+            Gnss_Fft_Complex pcps_fft(dwell_length, true);
+            Gnss_Fft_Complex pcps_ifft(dwell_length, false);
+            start = std::chrono::system_clock::now();
+            for (int32_t k = 0; k < FLAGS_quicksync_speed_iterations_test; k++)
+                {
+                    volk_32fc_x2_multiply_32fc(pcps_fft.get_inbuf(), input, wipeoff, dwell_length);
+                    pcps_fft.execute();
+                    volk_32fc_x2_multiply_32fc(pcps_ifft.get_inbuf(), pcps_fft.get_outbuf(), code, dwell_length);
+                    pcps_ifft.execute();
+                    volk_32fc_magnitude_squared_32f(magnitude, pcps_ifft.get_outbuf(), dwell_length);
+                    volk_gnsssdr_32f_index_max_32u(&indext, magnitude, dwell_length);
+                }
+            end = std::chrono::system_clock::now();
+            elapsed_seconds = end - start;
+            double pcps_time = elapsed_seconds.count() / static_cast<double>(FLAGS_quicksync_speed_iterations_test);
+
+            // QuickSync
+            Gnss_Fft_Complex quicksync_fft(folded_size, true);
+            Gnss_Fft_Complex quicksync_ifft(folded_size, false);
+            start = std::chrono::system_clock::now();
+            for (int32_t k = 0; k < FLAGS_quicksync_speed_iterations_test; k++)
+                {
+                    volk_32fc_x2_multiply_32fc(wiped, input, wipeoff, dwell_length);
+                    memcpy(quicksync_fft.get_inbuf(), wiped, sizeof(gr_complex) * folded_size);
+                    for (uint32_t i = 1; i < folding_factor * folding_factor; i++)
+                        {
+                            volk_32f_x2_add_32f(reinterpret_cast<float*>(quicksync_fft.get_inbuf()),
+                                reinterpret_cast<const float*>(quicksync_fft.get_inbuf()),
+                                reinterpret_cast<const float*>(wiped + i * folded_size),
+                                2 * folded_size);
+                        }
+                    quicksync_fft.execute();
+                    volk_32fc_x2_multiply_32fc(quicksync_ifft.get_inbuf(), quicksync_fft.get_outbuf(), code, folded_size);
+                    quicksync_ifft.execute();
+                    volk_32fc_magnitude_squared_32f(magnitude, quicksync_ifft.get_outbuf(), folded_size);
+                    volk_gnsssdr_32f_index_max_32u(&indext, magnitude, folded_size);
+                    // Worst case: every Doppler bin improves the maximum and needs the disambiguation
+                    for (uint32_t i = 0; i < folding_factor; i++)
+                        {
+                            volk_32fc_x2_dot_prod_32fc(&corr[i], &wiped[indext + i * folded_size], code, code_length);
+                        }
+                }
+            end = std::chrono::system_clock::now();
+            elapsed_seconds = end - start;
+            double quicksync_time = elapsed_seconds.count() / static_cast<double>(FLAGS_quicksync_speed_iterations_test);
+
+            std::cout << "Code length = " << code_length << ", folding factor = " << folding_factor
+                      << ". PCPS: " << pcps_time * 1e6 << " [us], QuickSync: " << quicksync_time * 1e6
+                      << " [us] per Doppler bin" << std::endl;
+            ASSERT_LE(0, pcps_time);
+            ASSERT_LE(0, quicksync_time);
+
+            volk_gnsssdr_free(input);
+            volk_gnsssdr_free(wipeoff);
+            volk_gnsssdr_free(wiped);
+            volk_gnsssdr_free(code);
+            volk_gnsssdr_free(magnitude);
+            volk_gnsssdr_free(corr);
+        }
+}
@@ -0,0 +1,145 @@
+/*!
+ * \file channel_cpu_allocator_test.cc
+ * \brief This file implements tests for the Channel_Cpu_Allocator class.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "channel_cpu_allocator.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+void write_file(const boost::filesystem::path& file, const std::string& content)
+{
+    boost::filesystem::create_directories(file.parent_path());
+    std::ofstream out(file.string());
+    out << content;
+}
+}  // namespace
+
+
+TEST(ChannelCpuAllocatorTest, PhysicalCoresNodeAfterNode)
+{
+    // Two nodes with two cores each, two hardware threads per core
+    boost::filesystem::path root = boost::filesystem::temp_directory_path() / "gnss_sdr_cpu_allocator_test";
+    boost::filesystem::remove_all(root);
+    write_file(root / "sys/devices/system/node/node0/cpulist", "0-1,4-5\n");
+    write_file(root / "sys/devices/system/node/node1/cpulist", "2-3,6-7\n");
+    for (int cpu = 0; cpu < 8; cpu++)
+        {
+            write_file(root / "sys/devices/system/cpu" / ("cpu" + std::to_string(cpu)) / "topology/thread_siblings_list",
+                std::to_string(cpu % 4) + "," + std::to_string(cpu % 4 + 4) + "\n");
+        }
+    write_file(root / "proc/stat",
+        "cpu  40 0 40 120 0 0 0 0 0 0\n"
+        "cpu0 10 0 10 80 0 0 0 0 5 0\n"
+        "cpu1 0 0 0 100 0 0 0 0 0 0\n"
+        "cpu2 50 0 0 50 0 0 0 0 0 0\n"
+        "cpu3 0 0 0 100 0 0 0 0 0 0\n");
+
+    const std::vector<int> all_cpus = {0, 1, 2, 3, 4, 5, 6, 7};
+    Channel_Cpu_Allocator all(0, (root / "sys").string(), (root / "proc").string(), all_cpus);
+    ASSERT_EQ(all.workers(), 4);
+    EXPECT_EQ(all.cpu(0), 0);
+    EXPECT_EQ(all.cpu(1), 1);
+    EXPECT_EQ(all.cpu(2), 2);
+    EXPECT_EQ(all.cpu(3), 3);
+    EXPECT_EQ(all.numa_node(1), 0);
+    EXPECT_EQ(all.numa_node(2), 1);
+
+    // A small pool stays in the first node, channels in round robin
+    Channel_Cpu_Allocator pool(2, (root / "sys").string(), (root / "proc").string(), all_cpus);
+    ASSERT_EQ(pool.workers(), 2);
+    EXPECT_EQ(pool.numa_node(1), 0);
+    EXPECT_EQ(pool.worker_of_channel(0), 0);
+    EXPECT_EQ(pool.worker_of_channel(1), 1);
+    EXPECT_EQ(pool.worker_of_channel(4), 0);
+
+    all.start_statistics();
+    write_file(root / "proc/stat",
+        "cpu  120 0 40 190 0 0 0 0 40 0\n"
+        "cpu0 60 0 10 130 0 0 0 0 45 0\n"
+        "cpu1 0 0 0 200 0 0 0 0 0 0\n"
+        "cpu2 75 0 0 75 0 0 0 0 0 0\n"
+        "cpu3 0 0 0 100 0 0 0 0 0 0\n");
+    std::vector<double> utilisation = all.utilisation();
+    ASSERT_EQ(utilisation.size(), 4U);
+    EXPECT_DOUBLE_EQ(utilisation[0], 0.5);  // guest time is already part of user time
+    EXPECT_DOUBLE_EQ(utilisation[1], 0.0);
+    EXPECT_DOUBLE_EQ(utilisation[2], 0.5);
+    EXPECT_DOUBLE_EQ(utilisation[3], 0.0);
+
+    boost::filesystem::remove_all(root);
+}
+
+
+TEST(ChannelCpuAllocatorTest, AffinityMask)
+{
+    // Two nodes with two cores each, two hardware threads per core
+    boost::filesystem::path root = boost::filesystem::temp_directory_path() / "gnss_sdr_cpu_allocator_affinity_test";
+    boost::filesystem::remove_all(root);
+    write_file(root / "sys/devices/system/node/node0/cpulist", "0-1,4-5\n");
+    write_file(root / "sys/devices/system/node/node1/cpulist", "2-3,6-7\n");
+    for (int cpu = 0; cpu < 8; cpu++)
+        {
+            write_file(root / "sys/devices/system/cpu" / ("cpu" + std::to_string(cpu)) / "topology/thread_siblings_list",
+                std::to_string(cpu % 4) + "," + std::to_string(cpu % 4 + 4) + "\n");
+        }
+
+    // The second hardware thread is used when the first one is not allowed
+    Channel_Cpu_Allocator allocator(0, (root / "sys").string(), (root / "proc").string(), {2, 5, 6, 7});
+    ASSERT_EQ(allocator.workers(), 3);
+    EXPECT_EQ(allocator.cpu(0), 5);
+    EXPECT_EQ(allocator.cpu(1), 2);
+    EXPECT_EQ(allocator.cpu(2), 7);
+    EXPECT_EQ(allocator.numa_node(0), 0);
+    EXPECT_EQ(allocator.numa_node(1), 1);
+    EXPECT_EQ(allocator.numa_node(2), 1);
+
+    // Without topology, the workers are the allowed CPUs
+    Channel_Cpu_Allocator no_topology(2, "/nonexistent_sysfs", "/nonexistent_procfs", {3, 5, 9});
+    ASSERT_EQ(no_topology.workers(), 2);
+    EXPECT_EQ(no_topology.cpu(0), 3);
+    EXPECT_EQ(no_topology.cpu(1), 5);
+
+    boost::filesystem::remove_all(root);
+}
+
+
+TEST(ChannelCpuAllocatorTest, FallsBackWithoutTopology)
+{
+    Channel_Cpu_Allocator allocator(3, "/nonexistent_sysfs", "/nonexistent_procfs");
+    EXPECT_GE(allocator.workers(), 1);
+    EXPECT_LE(allocator.workers(), 3);
+    EXPECT_GE(allocator.cpu(0), 0);  // first CPU of the affinity mask
+    EXPECT_EQ(allocator.numa_node(0), 0);
+    allocator.start_statistics();
+    EXPECT_TRUE(allocator.utilisation().empty());
+}
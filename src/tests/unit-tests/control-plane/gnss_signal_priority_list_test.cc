@@ -0,0 +1,101 @@
+/*!
+ * \file gnss_signal_priority_list_test.cc
+ * \brief  This file implements tests for the ranked list of signals
+ *         waiting for an acquisition channel
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_signal_priority_list.h"
+#include <vector>
+
+
+namespace
+{
+std::vector<uint32_t> prn_order(Gnss_Signal_Priority_List list)
+{
+    std::vector<uint32_t> prns;
+    while (!list.empty())
+        {
+            prns.push_back(list.front().get_satellite().get_PRN());
+            list.pop_front();
+        }
+    return prns;
+}
+}  // namespace
+
+
+TEST(GnssSignalPriorityListTest, BehavesAsListWithoutPredictions)
+{
+    Gnss_Signal_Priority_List list;
+    for (uint32_t prn = 1; prn <= 5; prn++)
+        {
+            list.push_back(Gnss_Signal(Gnss_Satellite("GPS", prn), "1C"));
+        }
+    EXPECT_EQ(list.size(), 5U);
+    EXPECT_EQ(list.front().get_satellite().get_PRN(), 1U);
+
+    // Search without popping: rotate
+    Gnss_Signal gs = list.front();
+    list.pop_front();
+    list.push_back(gs);
+    EXPECT_EQ(prn_order(list), std::vector<uint32_t>({2, 3, 4, 5, 1}));
+
+    list.remove(Gnss_Signal(Gnss_Satellite("GPS", 4), "1C"));
+    list.push_front(Gnss_Signal(Gnss_Satellite("GPS", 5), "1C"));
+    EXPECT_EQ(prn_order(list), std::vector<uint32_t>({5, 2, 3, 1}));
+
+    // Moving an existing signal does not duplicate it
+    list.push_back(Gnss_Signal(Gnss_Satellite("GPS", 2), "1C"));
+    EXPECT_EQ(prn_order(list), std::vector<uint32_t>({5, 3, 1, 2}));
+}
+
+
+TEST(GnssSignalPriorityListTest, RanksByVisibilityAndHistory)
+{
+    Gnss_Signal_Priority_List list;
+    for (uint32_t prn = 1; prn <= 6; prn++)
+        {
+            list.push_back(Gnss_Signal(Gnss_Satellite("GPS", prn), "1C"));
+        }
+    list.set_elevation(Gnss_Satellite("GPS", 4), 30);
+    list.set_elevation(Gnss_Satellite("GPS", 6), 75);
+    list.set_elevation(Gnss_Satellite("GPS", 2), 10);
+    EXPECT_EQ(prn_order(list), std::vector<uint32_t>({6, 4, 2, 1, 3, 5}));
+
+    // A failed acquisition goes after the visible satellites not tried yet
+    list.count_failure(Gnss_Satellite("GPS", 6));
+    list.push_back(Gnss_Signal(Gnss_Satellite("GPS", 6), "1C"));
+    EXPECT_EQ(prn_order(list), std::vector<uint32_t>({4, 2, 6, 1, 3, 5}));
+
+    // Promoted signals go first
+    list.push_front(Gnss_Signal(Gnss_Satellite("GPS", 5), "1C"));
+    EXPECT_EQ(list.front().get_satellite().get_PRN(), 5U);
+
+    list.reset_failures(Gnss_Satellite("GPS", 6));
+    list.clear_elevations();
+    EXPECT_EQ(prn_order(list), std::vector<uint32_t>({5, 1, 2, 3, 4, 6}));
+}
@@ -69,6 +69,7 @@ DEFINE_bool(acq_test_bit_transition_flag, false, "Bit transition flag.");
 DEFINE_bool(acq_test_make_two_steps, false, "Perform second step in a thinner grid.");
 DEFINE_int32(acq_test_second_nbins, 4, "If --acq_test_make_two_steps is set to true, this parameter sets the number of bins done in the acquisition refinement stage.");
 DEFINE_int32(acq_test_second_doppler_step, 10, "If --acq_test_make_two_steps is set to true, this parameter sets the Doppler step applied in the acquisition refinement stage, in Hz.");
+DEFINE_int32(acq_test_coarse_decimation_factor, 1, "If greater than 1, the first acquisition step runs on the input decimated by this factor and the second step refines code phase and Doppler at full rate.");
 
 DEFINE_int32(acq_test_signal_duration_s, 2, "Generated signal duration, in s");
 DEFINE_int32(acq_test_num_meas, 0, "Number of measurements per run. 0 means the complete file.");
@@ -536,6 +537,7 @@ int AcquisitionPerformanceTest::configure_receiver(double cn0, float pfa, unsign
                 {
                     config->set_property("Acquisition.make_two_steps", "false");
                 }
+            config->set_property("Acquisition.coarse_decimation_factor", std::to_string(FLAGS_acq_test_coarse_decimation_factor));
 
             if (FLAGS_acq_test_dump)
                 {
@@ -0,0 +1,526 @@
+/*!
+ * \file acq_throughput_test.cc
+ * \brief  This file implements a throughput benchmark of the acquisition
+ *         implementations, all of them fed with the same synthetic signal
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "Galileo_E1.h"
+#include "Galileo_E5a.h"
+#include "GPS_L1_CA.h"
+#include "acquisition_interface.h"
+#include "concurrent_queue.h"
+#include "gnss_block_factory.h"
+#include "gnss_synchro.h"
+#include "in_memory_configuration.h"
+#include "signal_generator.h"
+#include <boost/shared_ptr.hpp>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/msg_queue.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+DEFINE_string(acq_throughput_implementations, std::string("GPS_L1_CA_PCPS_Acquisition,GPS_L1_CA_PCPS_Tong_Acquisition,Galileo_E1_PCPS_CCCWSR_Ambiguous_Acquisition,GPS_L1_CA_PCPS_QuickSync_Acquisition,Galileo_E1_PCPS_8ms_Ambiguous_Acquisition,Galileo_E5a_Noncoherent_IQ_Acquisition_CAF,GPS_L1_CA_PCPS_Acquisition_Fine_Doppler,GPS_L1_CA_PCPS_Assisted_Acquisition"), "Comma-separated list of the acquisition implementations under test");
+DEFINE_string(acq_throughput_samples_per_chip, std::string("2,4"), "Comma-separated list of sampling rates, in samples per chip of the signal of each implementation");
+DEFINE_string(acq_throughput_coherent_ms, std::string("1,4"), "Comma-separated list of coherent integration times, in ms. They are rounded up to the shortest time supported by each implementation");
+DEFINE_string(acq_throughput_doppler_steps, std::string("250,500"), "Comma-separated list of Doppler steps, in Hz");
+DEFINE_int32(acq_throughput_doppler_max, 5000, "Maximum Doppler, in Hz");
+DEFINE_int32(acq_throughput_acquisitions, 20, "Number of acquisitions per test point");
+DEFINE_double(acq_throughput_cn0, 45.0, "C/N0 of the generated signal, in dB-Hz");
+DEFINE_double(acq_throughput_doppler_hz, 1200.0, "Doppler shift of the generated signal, in Hz");
+DEFINE_double(acq_throughput_pfa, 1e-3, "Probability of false alarm, for the implementations that set their threshold from it");
+DEFINE_string(acq_throughput_csv, std::string(""), "If not empty, the results are also written to this CSV file");
+
+
+// ######## GNURADIO BLOCK MESSAGE RECEVER #########
+class AcqThroughputTest_msg_rx;
+
+using AcqThroughputTest_msg_rx_sptr = boost::shared_ptr<AcqThroughputTest_msg_rx>;
+
+AcqThroughputTest_msg_rx_sptr AcqThroughputTest_msg_rx_make(Concurrent_Queue<int>& queue);
+
+class AcqThroughputTest_msg_rx : public gr::block
+{
+private:
+    friend AcqThroughputTest_msg_rx_sptr AcqThroughputTest_msg_rx_make(Concurrent_Queue<int>& queue);
+    void msg_handler_events(pmt::pmt_t msg);
+    AcqThroughputTest_msg_rx(Concurrent_Queue<int>& queue);
+    Concurrent_Queue<int>& channel_internal_queue;
+
+public:
+    int rx_message;
+    ~AcqThroughputTest_msg_rx();
+};
+
+
+AcqThroughputTest_msg_rx_sptr AcqThroughputTest_msg_rx_make(Concurrent_Queue<int>& queue)
+{
+    return AcqThroughputTest_msg_rx_sptr(new AcqThroughputTest_msg_rx(queue));
+}
+
+
+void AcqThroughputTest_msg_rx::msg_handler_events(pmt::pmt_t msg)
+{
+    try
+        {
+            int64_t message = pmt::to_long(std::move(msg));
+            rx_message = message;
+            channel_internal_queue.push(rx_message);
+        }
+    catch (boost::bad_any_cast& e)
+        {
+            LOG(WARNING) << "msg_handler_telemetry Bad any cast!";
+            rx_message = 0;
+        }
+}
+
+
+AcqThroughputTest_msg_rx::AcqThroughputTest_msg_rx(Concurrent_Queue<int>& queue) : gr::block("AcqThroughputTest_msg_rx", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0)), channel_internal_queue(queue)
+{
+    this->message_port_register_in(pmt::mp("events"));
+    this->set_msg_handler(pmt::mp("events"), boost::bind(&AcqThroughputTest_msg_rx::msg_handler_events, this, _1));
+    rx_message = 0;
+}
+
+
+AcqThroughputTest_msg_rx::~AcqThroughputTest_msg_rx() = default;
+
+// -----------------------------------------
+
+
+/*!
+ * \brief Acquisition implementation under test, with the signal it acquires
+ * and the settings it needs on top of the common ones.
+ */
+class Acq_Throughput_Implementation
+{
+public:
+    std::string name;
+    std::string signal;
+    char system;
+    double chip_rate;
+    uint32_t min_coherent_ms;
+    std::vector<std::pair<std::string, std::string>> properties;
+};
+
+
+/*!
+ * \brief Measurements of one implementation at one test point
+ */
+class Acq_Throughput_Result
+{
+public:
+    std::string implementation;
+    int64_t fs;
+    uint32_t coherent_ms;
+    uint32_t doppler_step;
+    uint32_t doppler_bins;
+    int acquisitions;
+    int positives;
+    int correct;
+    double wall_s;
+    double cpu_s;
+    int64_t memory_kb;
+};
+
+
+class AcquisitionThroughputTest : public ::testing::Test
+{
+protected:
+    AcquisitionThroughputTest()
+    {
+        queue = gr::msg_queue::make(0);
+        stop = false;
+        max_coherent_ms = 4;
+    }
+
+    ~AcquisitionThroughputTest() = default;
+
+    static std::vector<std::string> split(const std::string& list);
+    static const Acq_Throughput_Implementation* find_implementation(const std::string& name);
+    static int64_t resident_memory_kb();
+
+    const std::vector<gr_complex>& generate_signal(const Acq_Throughput_Implementation& impl, int64_t fs, size_t num_samples);
+    Acq_Throughput_Result run_point(const Acq_Throughput_Implementation& impl, int64_t fs, uint32_t coherent_ms, uint32_t doppler_step);
+
+    void start_queue();
+    void wait_message();
+    void process_message();
+    void print_results();
+
+    Concurrent_Queue<int> channel_internal_queue;
+    gr::msg_queue::sptr queue;
+    gr::top_block_sptr top_block;
+    std::shared_ptr<AcquisitionInterface> acquisition;
+    Gnss_Synchro gnss_synchro;
+    std::thread ch_thread;
+    bool stop;
+    int message;
+
+    uint32_t max_coherent_ms;
+    int num_acquisitions;
+    int num_positives;
+    int num_correct;
+    double doppler_tolerance_hz;
+
+    std::map<std::pair<std::string, int64_t>, std::vector<gr_complex>> signals;
+    std::vector<Acq_Throughput_Result> results;
+};
+
+
+std::vector<std::string> AcquisitionThroughputTest::split(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        {
+            if (!item.empty())
+                {
+                    items.push_back(item);
+                }
+        }
+    return items;
+}
+
+
+const Acq_Throughput_Implementation* AcquisitionThroughputTest::find_implementation(const std::string& name)
+{
+    // Thresholds of the implementations that do not set them from a probability of false alarm are the ones of their unit tests
+    static const std::vector<Acq_Throughput_Implementation> implementations = {
+        {"GPS_L1_CA_PCPS_Acquisition", "1C", 'G', GPS_L1_CA_CODE_RATE_HZ, 1, {{"threshold", "0.8"}, {"bit_transition_flag", "false"}}},
+        {"GPS_L1_CA_PCPS_Tong_Acquisition", "1C", 'G', GPS_L1_CA_CODE_RATE_HZ, 1, {{"threshold", "0.8"}, {"tong_init_val", "1"}, {"tong_max_val", "8"}}},
+        {"Galileo_E1_PCPS_CCCWSR_Ambiguous_Acquisition", "1B", 'E', GALILEO_E1_CODE_CHIP_RATE_HZ, 4, {{"threshold", "0.7"}}},
+        {"GPS_L1_CA_PCPS_QuickSync_Acquisition", "1C", 'G', GPS_L1_CA_CODE_RATE_HZ, 4, {{"threshold", "250"}, {"folding_factor", "2"}, {"bit_transition_flag", "false"}}},
+        {"Galileo_E1_PCPS_8ms_Ambiguous_Acquisition", "1B", 'E', GALILEO_E1_CODE_CHIP_RATE_HZ, 4, {{"threshold", "0.2"}}},
+        {"Galileo_E5a_Noncoherent_IQ_Acquisition_CAF", "5X", 'E', GALILEO_E5A_CODE_CHIP_RATE_HZ, 1, {{"threshold", "0.0"}, {"CAF_window_hz", "0"}, {"Zero_padding", "0"}}},
+        {"GPS_L1_CA_PCPS_Acquisition_Fine_Doppler", "1C", 'G', GPS_L1_CA_CODE_RATE_HZ, 1, {{"threshold", "0.8"}}},
+        {"GPS_L1_CA_PCPS_Assisted_Acquisition", "1C", 'G', GPS_L1_CA_CODE_RATE_HZ, 1, {{"threshold", "0.8"}}}};
+
+    for (const auto& impl : implementations)
+        {
+            if (impl.name == name)
+                {
+                    return &impl;
+                }
+        }
+    return nullptr;
+}
+
+
+int64_t AcquisitionThroughputTest::resident_memory_kb()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        {
+            if (line.compare(0, 6, "VmRSS:") == 0)
+                {
+                    return std::stoll(line.substr(6));
+                }
+        }
+    return 0;
+}
+
+
+const std::vector<gr_complex>& AcquisitionThroughputTest::generate_signal(const Acq_Throughput_Implementation& impl, int64_t fs, size_t num_samples)
+{
+    std::vector<gr_complex>& samples = signals[std::make_pair(impl.signal, fs)];
+    if (samples.size() >= num_samples)
+        {
+            return samples;
+        }
+
+    std::shared_ptr<InMemoryConfiguration> config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(fs));
+    config->set_property("SignalSource.fs_hz", std::to_string(fs));
+    config->set_property("SignalSource.item_type", "gr_complex");
+    config->set_property("SignalSource.num_satellites", "1");
+    config->set_property("SignalSource.system_0", std::string(1, impl.system));
+    config->set_property("SignalSource.signal_0", impl.signal);
+    config->set_property("SignalSource.PRN_0", "1");
+    config->set_property("SignalSource.CN0_dB_0", std::to_string(FLAGS_acq_throughput_cn0));
+    config->set_property("SignalSource.doppler_Hz_0", std::to_string(FLAGS_acq_throughput_doppler_hz));
+    config->set_property("SignalSource.delay_chips_0", "600");
+    config->set_property("SignalSource.noise_flag", "true");
+    config->set_property("SignalSource.data_flag", "false");
+    config->set_property("SignalSource.BW_BB", "0.97");
+    config->set_property("SignalSource.dump", "false");
+
+    gr::top_block_sptr generator_block = gr::make_top_block("Acquisition throughput signal");
+    std::shared_ptr<SignalGenerator> signal_generator = std::make_shared<SignalGenerator>(config.get(), "SignalSource", 0, 1, queue);
+    gr::blocks::head::sptr head = gr::blocks::head::make(sizeof(gr_complex), num_samples);
+    gr::blocks::vector_sink_c::sptr sink = gr::blocks::vector_sink_c::make();
+    signal_generator->connect(generator_block);
+    generator_block->connect(signal_generator->get_right_block(), 0, head, 0);
+    generator_block->connect(head, 0, sink, 0);
+    generator_block->run();
+
+    samples = sink->data();
+    return samples;
+}
+
+
+void AcquisitionThroughputTest::start_queue()
+{
+    stop = false;
+    ch_thread = std::thread(&AcquisitionThroughputTest::wait_message, this);
+}
+
+
+void AcquisitionThroughputTest::wait_message()
+{
+    while (!stop)
+        {
+            channel_internal_queue.wait_and_pop(message);
+            if (message < 0)
+                {
+                    stop = true;  // End of the input samples
+                }
+            else
+                {
+                    process_message();
+                }
+        }
+}
+
+
+void AcquisitionThroughputTest::process_message()
+{
+    num_acquisitions++;
+    if (message == 1)
+        {
+            num_positives++;
+            if (std::abs(gnss_synchro.Acq_doppler_hz - FLAGS_acq_throughput_doppler_hz) <= doppler_tolerance_hz)
+                {
+                    num_correct++;
+                }
+        }
+    if (num_acquisitions == FLAGS_acq_throughput_acquisitions)
+        {
+            stop = true;
+            top_block->stop();
+        }
+    else
+        {
+            acquisition->reset();
+            acquisition->set_state(1);
+        }
+}
+
+
+Acq_Throughput_Result AcquisitionThroughputTest::run_point(const Acq_Throughput_Implementation& impl, int64_t fs, uint32_t coherent_ms, uint32_t doppler_step)
+{
+    const std::string role = "Acquisition_" + impl.signal;
+    const auto doppler_max = static_cast<uint32_t>(FLAGS_acq_throughput_doppler_max);
+
+    // Enough samples for all the acquisitions at any test point, even if the blocks skip some of them while
+    // they are re-armed, so that all the implementations of a signal are fed with the same samples
+    const auto samples_per_ms = static_cast<size_t>(fs / 1000);
+    const size_t num_samples = samples_per_ms * (static_cast<size_t>(FLAGS_acq_throughput_acquisitions) * 3 * std::max(max_coherent_ms, 8U) + 100);
+    const std::vector<gr_complex>& samples = generate_signal(impl, fs, num_samples);
+
+    std::shared_ptr<InMemoryConfiguration> config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(fs));
+    config->set_property("Channel.signal", impl.signal);
+    config->set_property(role + ".implementation", impl.name);
+    config->set_property(role + ".item_type", "gr_complex");
+    config->set_property(role + ".coherent_integration_time_ms", std::to_string(coherent_ms));
+    config->set_property(role + ".max_dwells", "1");
+    config->set_property(role + ".doppler_max", std::to_string(doppler_max));
+    config->set_property(role + ".doppler_min", std::to_string(-static_cast<int32_t>(doppler_max)));
+    config->set_property(role + ".doppler_step", std::to_string(doppler_step));
+    config->set_property(role + ".pfa", std::to_string(FLAGS_acq_throughput_pfa));
+    config->set_property(role + ".blocking", "true");
+    config->set_property(role + ".dump", "false");
+    for (const auto& property : impl.properties)
+        {
+            config->set_property(role + "." + property.first, property.second);
+        }
+
+    Acq_Throughput_Result result;
+    result.implementation = impl.name;
+    result.fs = fs;
+    result.coherent_ms = coherent_ms;
+    result.doppler_step = doppler_step;
+    result.doppler_bins = 2 * doppler_max / doppler_step + 1;
+
+    num_acquisitions = 0;
+    num_positives = 0;
+    num_correct = 0;
+    // One Doppler step, or the frequency resolution of the coherent integration for the implementations that refine the Doppler
+    doppler_tolerance_hz = std::max(static_cast<double>(doppler_step), 2000.0 / (3.0 * static_cast<double>(coherent_ms)));
+
+    const int64_t memory_before = resident_memory_kb();
+    top_block = gr::make_top_block("Acquisition throughput test");
+    AcqThroughputTest_msg_rx_sptr msg_rx = AcqThroughputTest_msg_rx_make(channel_internal_queue);
+    gr::blocks::vector_source_c::sptr source = gr::blocks::vector_source_c::make(samples);
+
+    GNSSBlockFactory factory;
+    std::unique_ptr<GNSSBlockInterface> block = factory.GetBlock(config, role, impl.name, 1, 0);
+    acquisition = std::shared_ptr<AcquisitionInterface>(dynamic_cast<AcquisitionInterface*>(block.release()));
+    EXPECT_NE(acquisition, nullptr) << "Unable to create " << impl.name;
+    if (acquisition == nullptr)
+        {
+            result.acquisitions = 0;
+            result.positives = 0;
+            result.correct = 0;
+            result.wall_s = 0.0;
+            result.cpu_s = 0.0;
+            result.memory_kb = 0;
+            return result;
+        }
+
+    gnss_synchro = Gnss_Synchro();
+    gnss_synchro.Channel_ID = 0;
+    gnss_synchro.System = impl.system;
+    impl.signal.copy(gnss_synchro.Signal, 2, 0);
+    gnss_synchro.PRN = 1;
+
+    acquisition->set_gnss_synchro(&gnss_synchro);
+    acquisition->set_channel(0);
+    acquisition->set_doppler_max(doppler_max);
+    acquisition->set_doppler_step(doppler_step);
+    acquisition->set_threshold(config->property(role + ".threshold", 0.0));
+    acquisition->init();
+    acquisition->set_local_code();
+    acquisition->set_state(1);
+    acquisition->connect(top_block);
+    acquisition->reset();
+
+    top_block->connect(source, 0, acquisition->get_left_block(), 0);
+    top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+
+    start_queue();
+    std::chrono::time_point<std::chrono::system_clock> start, end;
+    const std::clock_t cpu_start = std::clock();
+    start = std::chrono::system_clock::now();
+    top_block->run();  // Returns after the last acquisition, or when the samples run out
+    end = std::chrono::system_clock::now();
+    const std::clock_t cpu_end = std::clock();
+    channel_internal_queue.push(-1);
+    ch_thread.join();
+    const int64_t memory_after = resident_memory_kb();
+
+    std::chrono::duration<double> elapsed_seconds = end - start;
+    result.acquisitions = num_acquisitions;
+    result.positives = num_positives;
+    result.correct = num_correct;
+    result.wall_s = elapsed_seconds.count();
+    result.cpu_s = static_cast<double>(cpu_end - cpu_start) / static_cast<double>(CLOCKS_PER_SEC);
+    result.memory_kb = memory_after - memory_before;
+
+    top_block->disconnect_all();
+    acquisition.reset();
+    return result;
+}
+
+
+void AcquisitionThroughputTest::print_results()
+{
+    std::cout << std::setw(46) << std::left << "Implementation" << std::right
+              << std::setw(10) << "fs [MHz]" << std::setw(6) << "T [ms]" << std::setw(8) << "Step"
+              << std::setw(6) << "Bins" << std::setw(6) << "Acq" << std::setw(12) << "us/bin"
+              << std::setw(14) << "dwells/s/core" << std::setw(10) << "RSS [kB]" << std::setw(6) << "Pd" << std::endl;
+    for (const auto& result : results)
+        {
+            const double bin_dwells = static_cast<double>(result.doppler_bins) * static_cast<double>(result.acquisitions);
+            std::cout << std::setw(46) << std::left << result.implementation << std::right << std::fixed
+                      << std::setw(10) << std::setprecision(3) << static_cast<double>(result.fs) / 1e6
+                      << std::setw(6) << result.coherent_ms << std::setw(8) << result.doppler_step
+                      << std::setw(6) << result.doppler_bins << std::setw(6) << result.acquisitions
+                      << std::setw(12) << std::setprecision(1) << (bin_dwells > 0 ? result.wall_s * 1e6 / bin_dwells : 0.0)
+                      << std::setw(14) << (result.cpu_s > 0 ? static_cast<double>(result.acquisitions) / result.cpu_s : 0.0)
+                      << std::setw(10) << result.memory_kb
+                      << std::setw(6) << std::setprecision(2) << (result.acquisitions > 0 ? static_cast<double>(result.correct) / static_cast<double>(result.acquisitions) : 0.0)
+                      << std::endl;
+        }
+
+    if (!FLAGS_acq_throughput_csv.empty())
+        {
+            std::ofstream csv(FLAGS_acq_throughput_csv);
+            csv << "implementation,fs_hz,coherent_ms,doppler_step_hz,doppler_bins,acquisitions,positives,correct,wall_s,cpu_s,rss_growth_kb" << std::endl;
+            for (const auto& result : results)
+                {
+                    csv << result.implementation << "," << result.fs << "," << result.coherent_ms << ","
+                        << result.doppler_step << "," << result.doppler_bins << "," << result.acquisitions << ","
+                        << result.positives << "," << result.correct << "," << result.wall_s << ","
+                        << result.cpu_s << "," << result.memory_kb << std::endl;
+                }
+            std::cout << "Generated file: " << FLAGS_acq_throughput_csv << std::endl;
+        }
+}
+
+
+TEST_F(AcquisitionThroughputTest, AllImplementations)
+{
+    for (const auto& coherent : split(FLAGS_acq_throughput_coherent_ms))
+        {
+            max_coherent_ms = std::max(max_coherent_ms, static_cast<uint32_t>(std::stoul(coherent)) + 3);
+        }
+    for (const auto& name : split(FLAGS_acq_throughput_implementations))
+        {
+            const Acq_Throughput_Implementation* impl = find_implementation(name);
+            EXPECT_NE(impl, nullptr) << "Unknown implementation " << name;
+            if (impl == nullptr)
+                {
+                    continue;
+                }
+            for (const auto& samples_per_chip : split(FLAGS_acq_throughput_samples_per_chip))
+                {
+                    const auto fs = static_cast<int64_t>(std::stod(samples_per_chip) * impl->chip_rate);
+                    for (const auto& coherent : split(FLAGS_acq_throughput_coherent_ms))
+                        {
+                            auto coherent_ms = static_cast<uint32_t>(std::stoul(coherent));
+                            coherent_ms = ((coherent_ms + impl->min_coherent_ms - 1) / impl->min_coherent_ms) * impl->min_coherent_ms;
+                            for (const auto& step : split(FLAGS_acq_throughput_doppler_steps))
+                                {
+                                    std::cout << "Running " << name << " at " << fs << " sps, " << coherent_ms << " ms, " << step << " Hz steps..." << std::endl;
+                                    Acq_Throughput_Result result = run_point(*impl, fs, coherent_ms, static_cast<uint32_t>(std::stoul(step)));
+                                    EXPECT_GT(result.acquisitions, 0) << name << " did not complete any acquisition";
+                                    results.push_back(result);
+                                }
+                        }
+                }
+        }
+    print_results();
+}
@@ -50,8 +50,11 @@
 #include <gnuradio/msg_queue.h>
 #include <gnuradio/top_block.h>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
+#include <string>
 #include <utility>
+#include <vector>
 #ifdef GR_GREATER_38
 #include <gnuradio/analog/sig_source.h>
 #else
@@ -130,6 +133,7 @@ protected:
 
     void init();
     void plot_grid();
+    int run_acquisition(const std::vector<std::pair<std::string, std::string>> &properties, unsigned int prn = 1);
 
     gr::top_block_sptr top_block;
     std::shared_ptr<GNSSBlockFactory> factory;
@@ -236,6 +240,53 @@ void GpsL1CaPcpsAcquisitionTest::plot_grid()
 }
 
 
+/*
+ * Runs the acquisition of satellite prn on the 2 ms of the test file, with the
+ * default configuration (no dump) plus the given properties, and returns the
+ * message sent by the block (0 if none).
+ */
+int GpsL1CaPcpsAcquisitionTest::run_acquisition(const std::vector<std::pair<std::string, std::string>> &properties, unsigned int prn)
+{
+    top_block = gr::make_top_block("Acquisition test");
+    config = std::make_shared<InMemoryConfiguration>();
+    init();
+    gnss_synchro.PRN = prn;
+    config->set_property("Acquisition_1C.dump", "false");
+    for (const auto &property : properties)
+        {
+            config->set_property(property.first, property.second);
+        }
+
+    std::shared_ptr<GpsL1CaPcpsAcquisition> acquisition = std::make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
+    boost::shared_ptr<GpsL1CaPcpsAcquisitionTest_msg_rx> msg_rx = GpsL1CaPcpsAcquisitionTest_msg_rx_make();
+    acquisition->set_channel(1);
+    acquisition->set_gnss_synchro(&gnss_synchro);
+    acquisition->set_threshold(0.001);
+    acquisition->set_doppler_max(doppler_max);
+    acquisition->set_doppler_step(doppler_step);
+
+    EXPECT_NO_THROW({
+        acquisition->connect(top_block);
+        std::string path = std::string(TEST_PATH);
+        std::string file = path + "signal_samples/GPS_L1_CA_ID_1_Fs_4Msps_2ms.dat";
+        const char *file_name = file.c_str();
+        gr::blocks::file_source::sptr file_source = gr::blocks::file_source::make(sizeof(gr_complex), file_name, false);
+        top_block->connect(file_source, 0, acquisition->get_left_block(), 0);
+        top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+    }) << "Failure connecting the blocks of acquisition test.";
+
+    acquisition->set_local_code();
+    acquisition->set_state(1);  // Ensure that acquisition starts at the first sample
+    acquisition->init();
+
+    EXPECT_NO_THROW({
+        top_block->run();  // Start threads and wait
+    }) << "Failure running the top_block.";
+
+    return msg_rx->rx_message;
+}
+
+
 TEST_F(GpsL1CaPcpsAcquisitionTest, Instantiate)
 {
     init();
@@ -360,3 +411,135 @@ TEST_F(GpsL1CaPcpsAcquisitionTest, ValidationOfResults)
             plot_grid();
         }
 }
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest, ValidationOfPeakInterpolation)
+{
+    double expected_delay_samples = 524;
+    double expected_doppler_hz = 1680;
+    doppler_step = 250;
+
+    // Two-step search, interpolation of the coarse grid, and interpolation
+    // followed by the prompt FFT refinement
+    std::vector<std::vector<std::pair<std::string, std::string>>> refinements = {
+        {{"Acquisition_1C.make_two_steps", "true"}, {"Acquisition_1C.second_doppler_step", "25"}, {"Acquisition_1C.second_nbins", "20"}},
+        {{"Acquisition_1C.interpolate_peak", "true"}},
+        {{"Acquisition_1C.interpolate_peak", "true"}, {"Acquisition_1C.prompt_fft_blocks", "4"}}};
+    std::vector<double> doppler_error_hz;
+    for (const auto &refinement : refinements)
+        {
+            ASSERT_EQ(1, run_acquisition(refinement)) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+
+            double delay_error_samples = std::abs(expected_delay_samples - gnss_synchro.Acq_delay_samples);
+            auto delay_error_chips = static_cast<float>(delay_error_samples * 1023 / 4000);
+            EXPECT_LT(delay_error_chips, 0.5) << "Delay error exceeds the expected value: 0.5 chips";
+            doppler_error_hz.push_back(std::abs(expected_doppler_hz - gnss_synchro.Acq_doppler_hz));
+            std::cout << "Doppler " << gnss_synchro.Acq_doppler_hz << " Hz, code phase " << gnss_synchro.Acq_delay_samples << " samples" << std::endl;
+        }
+
+    // The interpolated estimates must be as good as the two-step search, give or take a fraction of the coarse step
+    EXPECT_LE(doppler_error_hz[0], static_cast<double>(doppler_step) / 4.0);
+    EXPECT_LE(doppler_error_hz[1], doppler_error_hz[0] + static_cast<double>(doppler_step) / 4.0);
+    EXPECT_LE(doppler_error_hz[2], doppler_error_hz[0] + static_cast<double>(doppler_step) / 4.0);
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest, ValidationOfPromptFftRefinement2ms)
+{
+    // 2 ms of coherent integration, so that the FFT is twice the replica length
+    double expected_delay_samples = 524;
+    double expected_doppler_hz = 1680;
+    doppler_step = 250;
+    ASSERT_EQ(1, run_acquisition({{"Acquisition_1C.coherent_integration_time_ms", "2"},
+                     {"Acquisition_1C.interpolate_peak", "true"},
+                     {"Acquisition_1C.prompt_fft_blocks", "4"}}))
+        << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+
+    double delay_error_samples = std::abs(expected_delay_samples - gnss_synchro.Acq_delay_samples);
+    auto delay_error_chips = static_cast<float>(delay_error_samples * 1023 / 4000);
+    EXPECT_LT(delay_error_chips, 0.5) << "Delay error exceeds the expected value: 0.5 chips";
+    EXPECT_LE(std::abs(expected_doppler_hz - gnss_synchro.Acq_doppler_hz), static_cast<double>(doppler_step) / 2.0) << "Doppler error exceeds half the Doppler step";
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest, ValidationOfSequentialDetection)
+{
+    // The file holds 2 ms, so a search that is not decided within two dwells
+    // sends no message. PRN 1 is present in the file, PRN 2 is not.
+    struct Sequential_Case
+    {
+        uint32_t prn;
+        std::string cn0_dbhz;
+        std::string max_dwells;
+        int expected_message;
+    };
+    std::vector<Sequential_Case> cases = {
+        {1, "40", "2", 1},
+        {2, "45", "10", 2}};  // dismissed on the first dwell, well before max_dwells
+
+    for (const auto &c : cases)
+        {
+            int message = run_acquisition({{"Acquisition_1C.sequential_detection", "true"},
+                                              {"Acquisition_1C.pfa", "0.01"},
+                                              {"Acquisition_1C.sequential_cn0_dbhz", c.cn0_dbhz},
+                                              {"Acquisition_1C.max_dwells", c.max_dwells}},
+                c.prn);
+            EXPECT_EQ(c.expected_message, message) << "PRN " << c.prn << ". Expected message: 1=ACQ SUCCESS, 2=ACQ FAIL.";
+            if (c.expected_message == 1)
+                {
+                    double delay_error_samples = std::abs(524.0 - gnss_synchro.Acq_delay_samples);
+                    EXPECT_LT(static_cast<float>(delay_error_samples * 1023 / 4000), 0.5) << "Delay error exceeds the expected value: 0.5 chips";
+                    EXPECT_LE(std::abs(1680.0 - gnss_synchro.Acq_doppler_hz), 666) << "Doppler error exceeds the expected value: 666 Hz = 2/(3*integration period)";
+                }
+        }
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest, ValidationOfCompactGrid)
+{
+    // Same search, with the grid stored as floats and as 16-bit integers.
+    // Two dwells, so that the compact grid is also read back and accumulated.
+    std::vector<Acquisition_Dump_Reader> dumps;
+    std::vector<Gnss_Synchro> results;
+    for (const std::string compact_grid : {"false", "true"})
+        {
+            std::string data_str = "./tmp-acq-gps1";
+            if (boost::filesystem::exists(data_str))
+                {
+                    boost::filesystem::remove_all(data_str);
+                }
+            boost::filesystem::create_directory(data_str);
+
+            int message = run_acquisition({{"Acquisition_1C.dump", "true"},
+                {"Acquisition_1C.max_dwells", "2"},
+                {"Acquisition_1C.compact_grid", compact_grid}});
+            ASSERT_EQ(1, message) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+            results.push_back(gnss_synchro);
+
+            // The dump is on disk once the flowgraph has stopped
+            auto samples_per_code = static_cast<unsigned int>(round(4000000 / (GPS_L1_CA_CODE_RATE_HZ / GPS_L1_CA_CODE_LENGTH_CHIPS)));
+            dumps.emplace_back("./tmp-acq-gps1/acquisition_G_1C", gnss_synchro.PRN, doppler_max, doppler_step, samples_per_code, 1);
+            ASSERT_TRUE(dumps.back().read_binary_acq()) << "Error reading the acquisition dump";
+        }
+
+    EXPECT_EQ(results[0].Acq_delay_samples, results[1].Acq_delay_samples);
+    EXPECT_EQ(results[0].Acq_doppler_hz, results[1].Acq_doppler_hz);
+    EXPECT_EQ(dumps[0].positive_acq, dumps[1].positive_acq);
+    EXPECT_NEAR(dumps[0].test_statistic, dumps[1].test_statistic, 1e-3 * dumps[0].test_statistic);
+
+    // Quantization error of each cell, relative to the maximum of its Doppler bin
+    for (size_t i = 0; i < dumps[0].mag.size(); i++)
+        {
+            float row_max = *std::max_element(dumps[0].mag[i].begin(), dumps[0].mag[i].end());
+            for (size_t k = 0; k < dumps[0].mag[i].size(); k++)
+                {
+                    ASSERT_NEAR(dumps[0].mag[i][k], dumps[1].mag[i][k], 1e-4 * row_max) << "Doppler bin " << i << ", sample " << k;
+                }
+        }
+
+    std::string data_str = "./tmp-acq-gps1";
+    if (boost::filesystem::exists(data_str))
+        {
+            boost::filesystem::remove_all(data_str);
+        }
+}
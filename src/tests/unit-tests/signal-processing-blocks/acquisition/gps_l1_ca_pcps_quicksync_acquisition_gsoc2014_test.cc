@@ -664,6 +664,120 @@ TEST_F(GpsL1CaPcpsQuickSyncAcquisitionGSoC2014Test, ValidationOfResults)
 }
 
 
+TEST_F(GpsL1CaPcpsQuickSyncAcquisitionGSoC2014Test, ValidationOfResultsNonBlocking)
+{
+    config_1();
+    // Dwells processed by the worker thread, with an explicit folding of 4 code periods
+    config->set_property("Acquisition_1C.blocking", "false");
+    config->set_property("Acquisition_1C.folding_factor", "4");
+    top_block = gr::make_top_block("Acquisition test");
+    queue = gr::msg_queue::make(0);
+    acquisition = std::make_shared<GpsL1CaPcpsQuickSyncAcquisition>(config.get(), "Acquisition_1C", 1, 0);
+    boost::shared_ptr<GpsL1CaPcpsAcquisitionGSoC2013Test_msg_rx> msg_rx = GpsL1CaPcpsAcquisitionGSoC2013Test_msg_rx_make(channel_internal_queue);
+
+    ASSERT_NO_THROW({
+        acquisition->set_channel(1);
+    }) << "Failure setting channel.";
+
+    ASSERT_NO_THROW({
+        acquisition->set_gnss_synchro(&gnss_synchro);
+    }) << "Failure setting gnss_synchro.";
+
+    ASSERT_NO_THROW({
+        acquisition->set_doppler_max(10000);
+    }) << "Failure setting doppler_max.";
+
+    ASSERT_NO_THROW({
+        acquisition->set_doppler_step(250);
+    }) << "Failure setting doppler_step.";
+
+    ASSERT_NO_THROW({
+        acquisition->set_threshold(100);
+    }) << "Failure setting threshold.";
+
+    ASSERT_NO_THROW({
+        acquisition->connect(top_block);
+    }) << "Failure connecting acquisition to the top_block.";
+
+    acquisition->init();
+    acquisition->reset();
+
+    ASSERT_NO_THROW({
+        boost::shared_ptr<GenSignalSource> signal_source;
+        SignalGenerator* signal_generator = new SignalGenerator(config.get(), "SignalSource", 0, 1, queue);
+        FirFilter* filter = new FirFilter(config.get(), "InputFilter", 1, 1);
+        signal_source.reset(new GenSignalSource(signal_generator, filter, "SignalSource", queue));
+        signal_source->connect(top_block);
+        top_block->connect(signal_source->get_right_block(), 0, acquisition->get_left_block(), 0);
+        top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+    }) << "Failure connecting the blocks of acquisition test.";
+
+    init();
+    gnss_synchro.PRN = 10;  // This satellite is visible
+    acquisition->reset();
+    acquisition->set_gnss_synchro(&gnss_synchro);
+    acquisition->set_local_code();
+    acquisition->set_state(1);
+    start_queue();
+
+    EXPECT_NO_THROW({
+        top_block->run();  // Start threads and wait
+    }) << "Failure running the top_block.";
+
+    stop_queue();
+
+    EXPECT_EQ(1, message) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+    if (message == 1)
+        {
+            // The term -5 is here to correct the additional delay introduced by the FIR filter
+            double delay_chips = static_cast<double>(gnss_synchro.Acq_delay_samples - 5) * 1023.0 / (static_cast<double>(fs_in) * 1e-3);
+            EXPECT_NEAR(expected_delay_chips, delay_chips, max_delay_error_chips) << "Acquisition failure. Incorrect code phase.";
+            EXPECT_NEAR(expected_doppler_hz, gnss_synchro.Acq_doppler_hz, max_doppler_error_hz) << "Acquisition failure. Incorrect Doppler.";
+        }
+
+    ch_thread.join();
+}
+
+
+TEST_F(GpsL1CaPcpsQuickSyncAcquisitionGSoC2014Test, NonBlockingWorkDuringSearch)
+{
+    config_1();
+    // A slow search that never ends, fed by a free-running source
+    config->set_property("Acquisition_1C.blocking", "false");
+    config->set_property("Acquisition_1C.max_dwells", "1000000");
+    top_block = gr::make_top_block("Acquisition test");
+    acquisition = std::make_shared<GpsL1CaPcpsQuickSyncAcquisition>(config.get(), "Acquisition_1C", 1, 0);
+    init();
+    gnss_synchro.PRN = 10;
+    acquisition->set_channel(1);
+    acquisition->set_gnss_synchro(&gnss_synchro);
+    acquisition->set_doppler_max(10000);
+    acquisition->set_doppler_step(10);
+    acquisition->set_threshold(1e9);
+
+    ASSERT_NO_THROW({
+        acquisition->connect(top_block);
+        boost::shared_ptr<gr::analog::sig_source_c> source = gr::analog::sig_source_c::make(fs_in, gr::analog::GR_SIN_WAVE, 1000, 1, gr_complex(0));
+        top_block->connect(source, 0, acquisition->get_left_block(), 0);
+    }) << "Failure connecting the blocks of acquisition test.";
+
+    acquisition->init();
+    acquisition->reset();
+    acquisition->set_local_code();
+    acquisition->set_state(1);
+
+    top_block->start();
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    uint64_t dwells_read = boost::dynamic_pointer_cast<gr::block>(acquisition->get_right_block())->nitems_read(0);
+    top_block->stop();
+    top_block->wait();
+
+    // Each search over 2001 Doppler bins takes much longer than a dwell. If
+    // general_work() waited for the search, only a few dwells would be read.
+    EXPECT_GT(dwells_read, 100U) << "general_work() did not run while the search was in progress";
+}
+
+
 TEST_F(GpsL1CaPcpsQuickSyncAcquisitionGSoC2014Test, ValidationOfResultsWithNoise)
 {
     //config_3();
@@ -0,0 +1,257 @@
+/*!
+ * \file gps_l5i_pcps_acquisition_test.cc
+ * \brief Tests of the GpsL5iPcpsAcquisition class with the PMF-FFT search,
+ * on a synthetic GPS L5I signal.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "GPS_L5.h"
+#include "gnss_sdr_fft.h"
+#include "gnss_synchro.h"
+#include "gps_l5_signal.h"
+#include "gps_l5i_pcps_acquisition.h"
+#include "in_memory_configuration.h"
+#include <glog/logging.h>
+#include <gnuradio/msg_queue.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_source_c.h>
+#endif
+
+
+// ######## GNURADIO BLOCK MESSAGE RECEVER #########
+class GpsL5iPcpsAcquisitionTest_msg_rx;
+
+using GpsL5iPcpsAcquisitionTest_msg_rx_sptr = boost::shared_ptr<GpsL5iPcpsAcquisitionTest_msg_rx>;
+
+GpsL5iPcpsAcquisitionTest_msg_rx_sptr GpsL5iPcpsAcquisitionTest_msg_rx_make();
+
+class GpsL5iPcpsAcquisitionTest_msg_rx : public gr::block
+{
+private:
+    friend GpsL5iPcpsAcquisitionTest_msg_rx_sptr GpsL5iPcpsAcquisitionTest_msg_rx_make();
+    void msg_handler_events(pmt::pmt_t msg);
+    GpsL5iPcpsAcquisitionTest_msg_rx();
+
+public:
+    int rx_message;
+    ~GpsL5iPcpsAcquisitionTest_msg_rx();  //!< Default destructor
+};
+
+
+GpsL5iPcpsAcquisitionTest_msg_rx_sptr GpsL5iPcpsAcquisitionTest_msg_rx_make()
+{
+    return GpsL5iPcpsAcquisitionTest_msg_rx_sptr(new GpsL5iPcpsAcquisitionTest_msg_rx());
+}
+
+
+void GpsL5iPcpsAcquisitionTest_msg_rx::msg_handler_events(pmt::pmt_t msg)
+{
+    try
+        {
+            int64_t message = pmt::to_long(std::move(msg));
+            rx_message = message;
+        }
+    catch (boost::bad_any_cast &e)
+        {
+            LOG(WARNING) << "msg_handler_telemetry Bad any cast!";
+            rx_message = 0;
+        }
+}
+
+
+GpsL5iPcpsAcquisitionTest_msg_rx::GpsL5iPcpsAcquisitionTest_msg_rx() : gr::block("GpsL5iPcpsAcquisitionTest_msg_rx", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
+{
+    this->message_port_register_in(pmt::mp("events"));
+    this->set_msg_handler(pmt::mp("events"), boost::bind(&GpsL5iPcpsAcquisitionTest_msg_rx::msg_handler_events, this, _1));
+    rx_message = 0;
+}
+
+
+GpsL5iPcpsAcquisitionTest_msg_rx::~GpsL5iPcpsAcquisitionTest_msg_rx() = default;
+
+
+// ###########################################################
+
+class GpsL5iPcpsAcquisitionTest : public ::testing::Test
+{
+protected:
+    GpsL5iPcpsAcquisitionTest()
+    {
+        gnss_synchro = Gnss_Synchro();
+        fs_in = 12000000;
+        code_samples = 12000;
+        integration_time_ms = 4;
+        doppler_max = 5000;
+        doppler_step = 250;
+        expected_delay_samples = 3517;
+    }
+
+    ~GpsL5iPcpsAcquisitionTest() = default;
+
+    void generate_signal(double doppler_hz);
+    int run_acquisition(const std::vector<std::pair<std::string, std::string>> &properties, int doppler_center = 0, unsigned int doppler_window = 0);
+    double pmf_bin_hz() const;
+
+    Gnss_Synchro gnss_synchro{};
+    std::vector<gr_complex> samples;
+    int fs_in;
+    unsigned int code_samples;
+    unsigned int integration_time_ms;
+    unsigned int doppler_max;
+    unsigned int doppler_step;
+    unsigned int expected_delay_samples;
+};
+
+
+void GpsL5iPcpsAcquisitionTest::generate_signal(double doppler_hz)
+{
+    // Two dwells of PRN 1 at 45 dB-Hz, plus unit power noise. Primary code
+    // only: neither data nor the NH code change sign within a dwell.
+    const unsigned int PRN = 1;
+    const float amplitude = std::sqrt(std::pow(10.0, 4.5) / static_cast<double>(fs_in));
+    std::vector<gr_complex> code(code_samples);
+    gps_l5i_code_gen_complex_sampled(code.data(), PRN, fs_in);
+    std::default_random_engine e1(1);
+    std::normal_distribution<float> noise(0.0, std::sqrt(0.5));
+    samples.resize(2 * integration_time_ms * code_samples);
+    for (size_t n = 0; n < samples.size(); n++)
+        {
+            double phase = 2.0 * GPS_L5_PI * doppler_hz * static_cast<double>(n) / static_cast<double>(fs_in);
+            samples[n] = amplitude * code[(n + code_samples - expected_delay_samples) % code_samples] * gr_complex(std::cos(phase), std::sin(phase)) + gr_complex(noise(e1), noise(e1));
+        }
+}
+
+
+int GpsL5iPcpsAcquisitionTest::run_acquisition(const std::vector<std::pair<std::string, std::string>> &properties, int doppler_center, unsigned int doppler_window)
+{
+    gnss_synchro = Gnss_Synchro();
+    gnss_synchro.Channel_ID = 0;
+    gnss_synchro.System = 'G';
+    std::string signal = "L5";
+    signal.copy(gnss_synchro.Signal, 2, 0);
+    gnss_synchro.PRN = 1;
+
+    std::shared_ptr<InMemoryConfiguration> config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(fs_in));
+    config->set_property("Acquisition_L5.implementation", "GPS_L5i_PCPS_Acquisition");
+    config->set_property("Acquisition_L5.item_type", "gr_complex");
+    config->set_property("Acquisition_L5.coherent_integration_time_ms", std::to_string(integration_time_ms));
+    config->set_property("Acquisition_L5.doppler_max", std::to_string(doppler_max));
+    config->set_property("Acquisition_L5.doppler_step", std::to_string(doppler_step));
+    config->set_property("Acquisition_L5.pmf_fft", "true");
+    config->set_property("Acquisition_L5.dump", "false");
+    for (const auto &property : properties)
+        {
+            config->set_property(property.first, property.second);
+        }
+
+    gr::top_block_sptr top_block = gr::make_top_block("Acquisition test");
+    std::shared_ptr<GpsL5iPcpsAcquisition> acquisition = std::make_shared<GpsL5iPcpsAcquisition>(config.get(), "Acquisition_L5", 1, 0);
+    boost::shared_ptr<GpsL5iPcpsAcquisitionTest_msg_rx> msg_rx = GpsL5iPcpsAcquisitionTest_msg_rx_make();
+    acquisition->set_channel(1);
+    acquisition->set_gnss_synchro(&gnss_synchro);
+    acquisition->set_threshold(0.001);
+    acquisition->set_doppler_max(doppler_max);
+    acquisition->set_doppler_step(doppler_step);
+
+    EXPECT_NO_THROW({
+        acquisition->connect(top_block);
+        gr::blocks::vector_source_c::sptr source = gr::blocks::vector_source_c::make(samples);
+        top_block->connect(source, 0, acquisition->get_left_block(), 0);
+        top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+    }) << "Failure connecting the blocks of acquisition test.";
+
+    acquisition->set_local_code();
+    acquisition->set_state(1);  // Ensure that acquisition starts at the first sample
+    acquisition->init();
+    acquisition->set_doppler_window(doppler_center, doppler_window);
+
+    EXPECT_NO_THROW({
+        top_block->run();  // Start threads and wait
+    }) << "Failure running the top_block.";
+
+    std::cout << "Doppler " << gnss_synchro.Acq_doppler_hz << " Hz, code phase " << gnss_synchro.Acq_delay_samples << " samples" << std::endl;
+    return msg_rx->rx_message;
+}
+
+
+double GpsL5iPcpsAcquisitionTest::pmf_bin_hz() const
+{
+    // Blocks that divide the code period and span fs / (2 doppler_max),
+    // Doppler FFT zero padded to twice the number of blocks
+    unsigned int block_size = fs_in / (2 * doppler_max);
+    while (code_samples % block_size != 0)
+        {
+            block_size--;
+        }
+    unsigned int blocks = integration_time_ms * code_samples / block_size;
+    return static_cast<double>(fs_in) / (static_cast<double>(block_size) * static_cast<double>(gnss_sdr_fft_smooth_size(2 * blocks)));
+}
+
+
+TEST_F(GpsL5iPcpsAcquisitionTest, PmfFftCfar)
+{
+    // Off the bin centers, and not a multiple of doppler_step, which is not used
+    const double doppler_hz = 1680.0;
+    generate_signal(doppler_hz);
+    ASSERT_EQ(1, run_acquisition({{"Acquisition_L5.use_CFAR_algorithm", "true"}})) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+    EXPECT_NEAR(static_cast<double>(expected_delay_samples), gnss_synchro.Acq_delay_samples, 1.0);
+    EXPECT_NEAR(doppler_hz, gnss_synchro.Acq_doppler_hz, pmf_bin_hz());
+}
+
+
+TEST_F(GpsL5iPcpsAcquisitionTest, PmfFftFirstVsSecondPeak)
+{
+    const double doppler_hz = -2340.0;
+    generate_signal(doppler_hz);
+    ASSERT_EQ(1, run_acquisition({{"Acquisition_L5.use_CFAR_algorithm", "false"}})) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+    EXPECT_NEAR(static_cast<double>(expected_delay_samples), gnss_synchro.Acq_delay_samples, 1.0);
+    EXPECT_NEAR(doppler_hz, gnss_synchro.Acq_doppler_hz, pmf_bin_hz());
+}
+
+
+TEST_F(GpsL5iPcpsAcquisitionTest, PmfFftRecentered)
+{
+    // The Doppler FFT spans +/- doppler_max around its center. 7 kHz is only
+    // found once the window moves the center close to it, as in a reacquisition.
+    const double doppler_hz = 7000.0;
+    generate_signal(doppler_hz);
+    ASSERT_EQ(1, run_acquisition({}, 6500, 1000)) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+    EXPECT_NEAR(static_cast<double>(expected_delay_samples), gnss_synchro.Acq_delay_samples, 1.0);
+    EXPECT_NEAR(doppler_hz, gnss_synchro.Acq_doppler_hz, pmf_bin_hz());
+}
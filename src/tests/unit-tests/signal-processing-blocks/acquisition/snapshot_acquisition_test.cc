@@ -0,0 +1,97 @@
+/*!
+ * \file snapshot_acquisition_test.cc
+ * \brief  This file implements tests for the parallel acquisition of all
+ *         the satellites in a snapshot of samples
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "gps_sdr_signal_processing.h"
+#include "snapshot_acquisition.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+
+TEST(SnapshotAcquisitionTest, FindsSatellitesInSyntheticSnapshot)
+{
+    const int32_t fs = 4000000;
+    const uint32_t code_samples = 4000;
+    const uint32_t snapshot_ms = 20;
+    const uint32_t prn[2] = {7, 19};
+    const double doppler_hz[2] = {1250.0, -3000.0};
+    const uint32_t delay_samples[2] = {1000, 3217};
+    const float amplitude[2] = {0.05, 0.04};  // 40 and 38 dB-Hz with unit noise power at 4 Msps
+
+    std::default_random_engine e1(1);
+    std::normal_distribution<float> noise(0.0, std::sqrt(0.5));
+    std::vector<std::complex<float>> samples(code_samples * snapshot_ms);
+    for (auto& sample : samples)
+        {
+            sample = std::complex<float>(noise(e1), noise(e1));
+        }
+    std::vector<std::complex<float>> code(code_samples);
+    for (int s = 0; s < 2; s++)
+        {
+            gps_l1_ca_code_gen_complex_sampled(code.data(), prn[s], fs, 0);
+            for (size_t n = 0; n < samples.size(); n++)
+                {
+                    double phase = 2.0 * GPS_PI * doppler_hz[s] * static_cast<double>(n) / static_cast<double>(fs);
+                    samples[n] += amplitude[s] * code[(n + code_samples - delay_samples[s]) % code_samples] * std::complex<float>(std::cos(phase), std::sin(phase));
+                }
+        }
+
+    Snapshot_Acq_Conf conf;
+    conf.fs_in = fs;
+    conf.doppler_max = 5000;
+    conf.doppler_step = 250;
+    conf.num_threads = 4;
+    Snapshot_Acquisition acquisition(conf);
+    std::vector<Snapshot_Acq_Result> results = acquisition.run(samples.data(), samples.size());
+
+    ASSERT_EQ(results.size(), 32U);
+    for (const auto& result : results)
+        {
+            EXPECT_EQ(result.Signal, "1C");
+            EXPECT_EQ(result.dwells, snapshot_ms);
+            if (result.PRN == prn[0] or result.PRN == prn[1])
+                {
+                    int s = (result.PRN == prn[0] ? 0 : 1);
+                    EXPECT_TRUE(result.detected) << "PRN " << result.PRN;
+                    EXPECT_NEAR(result.doppler_hz, doppler_hz[s], static_cast<double>(conf.doppler_step));
+                    EXPECT_NEAR(result.code_phase_samples, static_cast<double>(delay_samples[s]), 1.0);
+                    EXPECT_NEAR(result.cn0_db_hz, 10.0 * std::log10(amplitude[s] * amplitude[s] * fs), 3.0);
+                }
+            else
+                {
+                    EXPECT_FALSE(result.detected) << "PRN " << result.PRN;
+                }
+        }
+    EXPECT_GT(results[prn[0] - 1].cn0_db_hz, results[prn[1] - 1].cn0_db_hz);
+}
@@ -0,0 +1,90 @@
+/*!
+ * \file lock_detectors_test.cc
+ * \brief This file implements tests for the Lock_Detectors class.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "lock_detectors.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+
+TEST(LockDetectorsTest, SlidingWindowMatchesBatchEstimators)
+{
+    const int N = 20;
+    const double T = 0.001;
+    std::mt19937 gen(1);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    std::vector<gr_complex> prompt;
+    Lock_Detectors detectors(N);
+    for (int i = 0; i < 5000; i++)
+        {
+            prompt.emplace_back(3.0 + noise(gen), 0.5 + noise(gen));
+            detectors.update(prompt.back());
+            if (i < N - 1)
+                {
+                    EXPECT_FALSE(detectors.ready());
+                    continue;
+                }
+            ASSERT_TRUE(detectors.ready());
+            if (i % 97 == 0 or i == 4999)  // across several renormalisations
+                {
+                    const gr_complex* window = prompt.data() + prompt.size() - N;
+                    EXPECT_NEAR(detectors.cn0_dB_Hz(T), cn0_svn_estimator(window, N, T), 1e-3);
+                    std::vector<gr_complex> copy(window, window + N);
+                    EXPECT_NEAR(detectors.carrier_lock(), carrier_lock_detector(copy.data(), N), 1e-5);
+                }
+        }
+
+    detectors.reset();
+    EXPECT_FALSE(detectors.ready());
+}
+
+
+TEST(LockDetectorsTest, M2M4Estimator)
+{
+    // Signal amplitude A and noise variance sigma^2 per component give SNR = A^2 / (2 sigma^2)
+    const int N = 10000;
+    const double T = 0.001;
+    const float A = 3.0;
+    const float sigma = 1.0;
+    const double expected_cn0 = 10.0 * log10(A * A / (2.0 * sigma * sigma)) - 10.0 * log10(T);
+    std::mt19937 gen(2);
+    std::normal_distribution<float> noise(0.0, sigma);
+    Lock_Detectors m2m4(N, Lock_Detectors::M2M4);
+    Lock_Detectors snv(N, Lock_Detectors::SNV);
+    for (int i = 0; i < N; i++)
+        {
+            // Rotating carrier phase: M2M4 does not depend on it
+            gr_complex value = std::polar(A, static_cast<float>(0.005 * i)) + gr_complex(noise(gen), noise(gen));
+            m2m4.update(value);
+            snv.update(value);
+        }
+    ASSERT_TRUE(m2m4.ready());
+    EXPECT_NEAR(m2m4.cn0_dB_Hz(T), expected_cn0, 0.5);
+    EXPECT_LT(snv.cn0_dB_Hz(T), expected_cn0 - 1.0);
+}
@@ -0,0 +1,107 @@
+/*!
+ * \file multichannel_correlator_engine_test.cc
+ * \brief  This file implements unit tests for the multichannel correlator
+ *         engine, which correlates several channels in one pass over the
+ *         input samples.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include "gps_sdr_signal_processing.h"
+#include "multichannel_correlator_engine.h"
+#include <gnuradio/gr_complex.h>
+#include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <complex>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+TEST(MultichannelCorrelatorEngineTest, MatchesPerChannelCorrelation)
+{
+    const int n_channels = 8;
+    const int n_taps = 3;
+    const int vector_length = 4000;  // 1 ms at 4 Msps
+    const double code_phase_step_chips = GPS_L1_CA_CODE_RATE_HZ / 4e6;
+
+    // All the channels read the same buffer, starting at different samples
+    std::vector<gr_complex> in(3 * vector_length);
+    std::default_random_engine e1(1);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    for (auto& sample : in)
+        {
+            sample = gr_complex(noise(e1), noise(e1));
+        }
+
+    float shifts_chips[n_taps] = {-0.5, 0.0, 0.5};
+    std::vector<std::vector<float>> codes(n_channels, std::vector<float>(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)));
+    std::vector<Cpu_Multicorrelator_Real_Codes> reference(n_channels);
+    std::vector<Cpu_Multicorrelator_Real_Codes> batched(n_channels);
+    std::vector<std::vector<gr_complex>> reference_outs(n_channels, std::vector<gr_complex>(n_taps));
+    std::vector<std::vector<gr_complex>> batched_outs(n_channels, std::vector<gr_complex>(n_taps));
+    std::vector<Correlation_Request> requests(n_channels);
+
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            gps_l1_ca_code_gen_float(codes[ch].data(), ch + 1, 0);
+            const gr_complex* channel_in = in.data() + 977 * ch;
+            double rem_carrier_phase_rad = 0.3 * ch;
+            double carrier_phase_step_rad = 0.01 * (ch + 1);
+            double rem_code_phase_chips = 0.7 + 0.1 * ch;
+            for (auto* correlator : {&reference[ch], &batched[ch]})
+                {
+                    correlator->set_high_dynamics_resampler(false);
+                    correlator->init(2 * vector_length, n_taps);
+                    correlator->set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), codes[ch].data(), shifts_chips);
+                }
+            reference[ch].set_input_output_vectors(reference_outs[ch].data(), channel_in);
+            batched[ch].set_input_output_vectors(batched_outs[ch].data(), channel_in);
+            reference[ch].Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_rad, carrier_phase_step_rad, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, vector_length);
+            requests[ch] = {&batched[ch], rem_carrier_phase_rad, carrier_phase_step_rad, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, vector_length};
+        }
+
+    // One thread per channel, as in the receiver flowgraph
+    std::vector<std::thread> threads;
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            threads.emplace_back([&requests, ch]() { Multichannel_Correlator_Engine::instance().correlate(&requests[ch], 1); });
+        }
+    for (auto& t : threads)
+        {
+            t.join();
+        }
+
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            for (int tap = 0; tap < n_taps; tap++)
+                {
+                    EXPECT_NEAR(batched_outs[ch][tap].real(), reference_outs[ch][tap].real(), 0.01) << "channel " << ch << ", tap " << tap;
+                    EXPECT_NEAR(batched_outs[ch][tap].imag(), reference_outs[ch][tap].imag(), 0.01) << "channel " << ch << ", tap " << tap;
+                }
+        }
+}
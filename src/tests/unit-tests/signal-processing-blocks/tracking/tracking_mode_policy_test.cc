@@ -0,0 +1,70 @@
+/*!
+ * \file tracking_mode_policy_test.cc
+ * \brief This file implements tests for the Tracking_Mode_Policy class.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "tracking_mode_policy.h"
+#include <gtest/gtest.h>
+
+
+TEST(TrackingModePolicyTest, NeedsDwellToChangeMode)
+{
+    Tracking_Mode_Policy policy;
+    policy.set_thresholds(45.0, 30.0, 3.0, 3);
+    EXPECT_EQ(policy.mode(), Tracking_Mode_Policy::NOMINAL);
+
+    EXPECT_EQ(policy.update(50.0), Tracking_Mode_Policy::NOMINAL);
+    EXPECT_EQ(policy.update(50.0), Tracking_Mode_Policy::NOMINAL);
+    EXPECT_EQ(policy.update(40.0), Tracking_Mode_Policy::NOMINAL);  // restarts the dwell count
+    EXPECT_EQ(policy.update(50.0), Tracking_Mode_Policy::NOMINAL);
+    EXPECT_EQ(policy.update(50.0), Tracking_Mode_Policy::NOMINAL);
+    EXPECT_EQ(policy.update(50.0), Tracking_Mode_Policy::STRONG);
+
+    for (int i = 0; i < 3; i++)
+        {
+            policy.update(25.0);
+        }
+    EXPECT_EQ(policy.mode(), Tracking_Mode_Policy::WEAK);
+
+    policy.reset();
+    EXPECT_EQ(policy.mode(), Tracking_Mode_Policy::NOMINAL);
+}
+
+
+TEST(TrackingModePolicyTest, Hysteresis)
+{
+    Tracking_Mode_Policy policy;
+    policy.set_thresholds(45.0, 30.0, 3.0, 1);
+
+    EXPECT_EQ(policy.update(29.0), Tracking_Mode_Policy::WEAK);
+    EXPECT_EQ(policy.update(32.0), Tracking_Mode_Policy::WEAK);  // within the hysteresis
+    EXPECT_EQ(policy.update(34.0), Tracking_Mode_Policy::NOMINAL);
+
+    EXPECT_EQ(policy.update(46.0), Tracking_Mode_Policy::STRONG);
+    EXPECT_EQ(policy.update(43.0), Tracking_Mode_Policy::STRONG);  // within the hysteresis
+    EXPECT_EQ(policy.update(41.0), Tracking_Mode_Policy::NOMINAL);
+}
@@ -0,0 +1,227 @@
+/*!
+ * \file main.cc
+ * \brief Acquires all the satellites of the selected signals in a snapshot
+ * of a recording and prints which ones are visible, with their Doppler,
+ * code phase and C/N0.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "snapshot_acquisition.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+DEFINE_string(filename, "", "File with the recorded baseband samples");
+DEFINE_string(item_type, "gr_complex", "Sample format: gr_complex (interleaved float32), ishort (interleaved int16) or ibyte (interleaved int8)");
+DEFINE_int64(fs, 4000000, "Sampling rate [samples/s]");
+DEFINE_string(signals, "1C", "Comma-separated list of signals: 1C (GPS L1 C/A), 1B (Galileo E1b), L5 (GPS L5I), 5X (Galileo E5a), B1 (BeiDou B1I), B3 (BeiDou B3I)");
+DEFINE_int32(skip_ms, 0, "Milliseconds skipped at the beginning of the file");
+DEFINE_int32(snapshot_ms, 100, "Milliseconds of samples used for the acquisition");
+DEFINE_int32(coherent_ms, 1, "Coherent integration time [ms]");
+DEFINE_int32(max_dwells, 0, "Maximum number of non-coherent integrations (0: the whole snapshot)");
+DEFINE_int32(doppler_max, 5000, "Maximum Doppler shift [Hz]");
+DEFINE_int32(doppler_step, 250, "Doppler step [Hz]");
+DEFINE_double(threshold, 2.5, "First to second peak ratio for a positive acquisition");
+DEFINE_int32(threads, 0, "Number of worker threads (0: one per hardware thread)");
+DEFINE_string(output, "", "If not empty, the results are also written to this CSV file");
+DEFINE_bool(show_all, false, "Print also the satellites not detected");
+
+
+namespace
+{
+bool read_snapshot(std::vector<std::complex<float>>& samples)
+{
+    std::ifstream file(FLAGS_filename, std::ios::binary);
+    if (!file.is_open())
+        {
+            std::cerr << "Unable to open file " << FLAGS_filename << std::endl;
+            return false;
+        }
+    size_t item_size;
+    if (FLAGS_item_type == "gr_complex")
+        {
+            item_size = 2 * sizeof(float);
+        }
+    else if (FLAGS_item_type == "ishort")
+        {
+            item_size = 2 * sizeof(int16_t);
+        }
+    else if (FLAGS_item_type == "ibyte")
+        {
+            item_size = 2 * sizeof(int8_t);
+        }
+    else
+        {
+            std::cerr << "Unknown item_type " << FLAGS_item_type << std::endl;
+            return false;
+        }
+
+    auto num_samples = static_cast<size_t>(FLAGS_fs / 1000 * FLAGS_snapshot_ms);
+    file.seekg(static_cast<std::streamoff>(FLAGS_fs / 1000 * FLAGS_skip_ms * static_cast<int64_t>(item_size)), std::ios::beg);
+    std::vector<char> raw(num_samples * item_size);
+    file.read(raw.data(), static_cast<std::streamsize>(raw.size()));
+    num_samples = static_cast<size_t>(file.gcount()) / item_size;
+
+    samples.resize(num_samples);
+    for (size_t i = 0; i < num_samples; i++)
+        {
+            if (FLAGS_item_type == "gr_complex")
+                {
+                    const auto* item = reinterpret_cast<const float*>(raw.data()) + 2 * i;
+                    samples[i] = std::complex<float>(item[0], item[1]);
+                }
+            else if (FLAGS_item_type == "ishort")
+                {
+                    const auto* item = reinterpret_cast<const int16_t*>(raw.data()) + 2 * i;
+                    samples[i] = std::complex<float>(item[0], item[1]);
+                }
+            else
+                {
+                    const auto* item = reinterpret_cast<const int8_t*>(raw.data()) + 2 * i;
+                    samples[i] = std::complex<float>(item[0], item[1]);
+                }
+        }
+    return true;
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\n snapshot-acq acquires all the satellites of the selected signals in a snapshot of a recording\n") +
+        "Copyright (C) 2010-2019 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License.\n \n" +
+        "Usage: \n" +
+        "   snapshot-acq --filename=<file> --fs=<sampling rate> [--signals=1C,1B,...]");
+
+    google::SetUsageMessage(intro_help);
+    google::SetVersionString("1.0");
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_filename.empty())
+        {
+            std::cerr << "Usage:" << std::endl;
+            std::cerr << "   " << argv[0]
+                      << " --filename=<file> --fs=<sampling rate> [--signals=1C,1B,...]"
+                      << std::endl;
+            google::ShutDownCommandLineFlags();
+            return 1;
+        }
+
+    Snapshot_Acq_Conf conf;
+    conf.fs_in = FLAGS_fs;
+    conf.coherent_ms = static_cast<uint32_t>(FLAGS_coherent_ms);
+    conf.max_dwells = static_cast<uint32_t>(FLAGS_max_dwells);
+    conf.doppler_max = static_cast<uint32_t>(FLAGS_doppler_max);
+    conf.doppler_step = static_cast<uint32_t>(FLAGS_doppler_step);
+    conf.threshold = static_cast<float>(FLAGS_threshold);
+    conf.num_threads = static_cast<uint32_t>(FLAGS_threads);
+    conf.signals.clear();
+    std::stringstream signal_list(FLAGS_signals);
+    std::string signal;
+    while (std::getline(signal_list, signal, ','))
+        {
+            if (!Snapshot_Acquisition::is_supported(signal))
+                {
+                    std::cerr << "Unsupported signal " << signal << std::endl;
+                    google::ShutDownCommandLineFlags();
+                    return 1;
+                }
+            conf.signals.push_back(signal);
+        }
+
+    std::vector<std::complex<float>> samples;
+    if (!read_snapshot(samples))
+        {
+            google::ShutDownCommandLineFlags();
+            return 1;
+        }
+
+    std::chrono::time_point<std::chrono::system_clock> start, end;
+    start = std::chrono::system_clock::now();
+    Snapshot_Acquisition acquisition(conf);
+    std::vector<Snapshot_Acq_Result> results = acquisition.run(samples.data(), samples.size());
+    end = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+
+    std::cout << "Sys Signal PRN  Doppler [Hz]  Code phase [chips]  C/N0 [dB-Hz]  Test statistic  Dwells" << std::endl;
+    uint32_t num_detected = 0;
+    for (const auto& result : results)
+        {
+            if (result.detected)
+                {
+                    num_detected++;
+                }
+            if (result.detected or FLAGS_show_all)
+                {
+                    std::cout << std::fixed << std::setprecision(1)
+                              << "  " << result.System << "     " << result.Signal
+                              << std::setw(5) << result.PRN
+                              << std::setw(14) << result.doppler_hz
+                              << std::setw(20) << std::setprecision(2) << result.code_phase_chips
+                              << std::setw(14) << std::setprecision(1) << result.cn0_db_hz
+                              << std::setw(16) << std::setprecision(2) << result.test_statistic
+                              << std::setw(8) << result.dwells
+                              << (result.detected ? "" : "  (not detected)") << std::endl;
+                }
+        }
+    std::cout << num_detected << " signals detected in " << samples.size() << " samples. Acquisition run time "
+              << elapsed_seconds.count() << " [seconds]" << std::endl;
+
+    if (!FLAGS_output.empty())
+        {
+            std::ofstream csv(FLAGS_output);
+            if (!csv.is_open())
+                {
+                    std::cerr << "Unable to write file " << FLAGS_output << std::endl;
+                    google::ShutDownCommandLineFlags();
+                    return 1;
+                }
+            csv << "system,signal,prn,detected,doppler_hz,code_phase_samples,code_phase_chips,cn0_db_hz,test_statistic,dwells" << std::endl;
+            for (const auto& result : results)
+                {
+                    csv << result.System << "," << result.Signal << "," << result.PRN << ","
+                        << (result.detected ? 1 : 0) << "," << result.doppler_hz << ","
+                        << result.code_phase_samples << "," << result.code_phase_chips << ","
+                        << result.cn0_db_hz << "," << result.test_statistic << "," << result.dwells << std::endl;
+                }
+            std::cout << "Generated file: " << FLAGS_output << std::endl;
+        }
+
+    google::ShutDownCommandLineFlags();
+    return 0;
+}